@@ -120,10 +120,13 @@ TypeExtendedInterface& getType(TensorOptions options) {
 // NOTE: We also check `at::NonVariableTypeMode`, and if it's enabled we always
 // return non-Variable type in this function.
 // See NOTE [ Treating Variables as non-Variables in type dispatch ]
+// Like `legacyTensorType()`, this returns the Variable type for all tensors in
+// inference mode. See NOTE [ Inference mode ]
 TypeExtendedInterface& getType(const TensorImpl* impl) {
   Backend backend = tensorTypeIdToBackend(impl->type_id());
   return globalContext().getType(
-            backend, typeMetaToScalarType(impl->dtype()), impl->is_variable() && !at::NonVariableTypeMode::is_enabled());
+            backend, typeMetaToScalarType(impl->dtype()),
+            (impl->is_variable() || at::InferenceMode::is_enabled()) && !at::NonVariableTypeMode::is_enabled());
 }
 
 TypeExtendedInterface& getType(const Tensor& t) {
@@ -23,7 +23,7 @@ struct CAFFE2_API OpaqueTensorImpl : public TensorImpl {
   :   TensorImpl(type_id, data_type, device),
       opaque_handle_(std::move(opaque_handle))
   {
-    sizes_ = sizes.vec();
+    sizes_and_strides_.set_sizes(sizes);
     refresh_numel();
   }
 
@@ -89,12 +89,11 @@ struct CAFFE2_API OpaqueTensorImpl : public TensorImpl {
 c10::intrusive_ptr<TensorImpl> shallow_copy_and_detach() const override {
   //AT_ASSERT(false);
   auto impl = c10::make_intrusive<OpaqueTensorImpl<OpaqueHandle>>(
-    type_id(), dtype(), device(), opaque_handle_, sizes_);
+    type_id(), dtype(), device(), opaque_handle_, sizes_and_strides_.sizes_arrayref());
   // TensorImpl general fields
   // Note that some of these fields are not used in opaque tensor code,
   // and we copy them here only for completeness.
-  impl->sizes_ = sizes_;
-  impl->strides_ = strides_;
+  impl->sizes_and_strides_ = sizes_and_strides_;
   impl->storage_offset_ = storage_offset_;
   impl->is_contiguous_ = is_contiguous_;
   impl->is_wrapped_number_ = is_wrapped_number_;
@@ -53,6 +53,9 @@ void set_num_threads(size_t nthreads) {
 // Use init_num_threads() during thread initialization to ensure
 // consistent size of parallel region in different threads
 size_t get_num_threads() {
+  if (c10::cpu_executor_enabled()) {
+    return c10::cpu_executor().numThreads();
+  }
 #ifdef _OPENMP
   return omp_get_max_threads();
 #else
@@ -76,6 +79,9 @@ std::shared_ptr<TaskThreadPoolBase> createC10ThreadPool(
     int device_id,
     int pool_size,
     bool create_new) {
+  if (c10::cpu_executor_enabled()) {
+    return c10::cpu_executor_task_pool();
+  }
   static std::shared_ptr<TaskThreadPoolBase> pool =
       std::make_shared<PTThreadPool>(pool_size);
   // For now, the only accepted device id is 0
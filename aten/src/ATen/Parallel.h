@@ -1,5 +1,6 @@
 #pragma once
 #include <ATen/ATen.h>
+#include <c10/core/CPUExecutor.h>
 #include <c10/core/thread_pool.h>
 
 #include <atomic>
@@ -36,6 +37,9 @@ CAFFE2_API size_t get_num_threads();
 // Returns the current thread number (starting from 0)
 // in the current parallel region, or 0 in the sequential region
 inline int get_thread_num() {
+  if (c10::cpu_executor_enabled()) {
+    return c10::CPUExecutor::currentSlot();
+  }
 #ifdef _OPENMP
   return omp_get_thread_num();
 #else
@@ -44,6 +48,9 @@ inline int get_thread_num() {
 }
 
 inline bool in_parallel_region() {
+  if (c10::CPUExecutor::inParallelRegion()) {
+    return true;
+  }
 #ifdef _OPENMP
   return omp_in_parallel();
 #else
@@ -51,12 +58,44 @@ inline bool in_parallel_region() {
 #endif
 }
 
+namespace internal {
+// parallel_for on the threads of c10::cpu_executor(), with one chunk per
+// thread as with OpenMP.
+template <class F>
+inline void parallel_for_cpu_executor(
+    const int64_t begin,
+    const int64_t end,
+    const int64_t grain_size,
+    const F& f) {
+  if (begin >= end) {
+    return;
+  }
+  auto& executor = c10::cpu_executor();
+  if (end - begin < grain_size || executor.numThreads() == 1 ||
+      c10::CPUExecutor::inParallelRegion()) {
+    f(begin, end);
+    return;
+  }
+  const int64_t chunk_size =
+      divup(end - begin, static_cast<int64_t>(executor.numThreads()));
+  executor.run(
+      divup(end - begin, chunk_size), 0, [&](size_t /* unused */, size_t chunk) {
+        const int64_t begin_chunk = begin + chunk * chunk_size;
+        f(begin_chunk, std::min(end, begin_chunk + chunk_size));
+      });
+}
+} // namespace internal
+
 template <class F>
 inline void parallel_for(
     const int64_t begin,
     const int64_t end,
     const int64_t grain_size,
     const F& f) {
+  if (c10::cpu_executor_enabled()) {
+    internal::parallel_for_cpu_executor(begin, end, grain_size, f);
+    return;
+  }
 #ifdef _OPENMP
   std::atomic_flag err_flag = ATOMIC_FLAG_INIT;
   std::exception_ptr eptr;
@@ -133,10 +172,18 @@ inline scalar_t parallel_reduce(
     const int64_t num_results = divup((end - begin), grain_size);
     std::vector<scalar_t> results(num_results);
     scalar_t* results_data = results.data();
+    if (c10::cpu_executor_enabled()) {
+      c10::cpu_executor().run(
+          num_results, 0, [&](size_t /* unused */, size_t id) {
+            int64_t i = begin + id * grain_size;
+            results_data[id] = f(i, i + std::min(end - i, grain_size), ident);
+          });
+    } else {
 #pragma omp parallel for if ((end - begin) >= grain_size)
-    for (int64_t id = 0; id < num_results; id++) {
-      int64_t i = begin + id * grain_size;
-      results_data[id] = f(i, i + std::min(end - i, grain_size), ident);
+      for (int64_t id = 0; id < num_results; id++) {
+        int64_t i = begin + id * grain_size;
+        results_data[id] = f(i, i + std::min(end - i, grain_size), ident);
+      }
     }
     return std::accumulate(
         results_data, results_data + results.size(), ident, sf);
@@ -23,6 +23,27 @@ namespace at {
 /// TODO: Since `torch::NoGradGuard` serves the same purpose in libtorch, we should
 /// merge these two thread-local guards.
 
+/// NOTE [ Inference mode ]
+///
+/// Even with `torch::NoGradGuard`, every operator called on a Variable goes
+/// through `VariableType`, which records the function for the profiler,
+/// checks whether gradients are required, bumps version counters and wraps
+/// its outputs into new Variables. For small tensors this bookkeeping costs
+/// more than the operator itself.
+///
+/// In inference mode, the generated `VariableType` functions skip all of it:
+/// they unwrap the Variables among their arguments (non-Variables are passed
+/// as they are), call the non-Variable type under `at::NonVariableTypeMode`
+/// and return the results without wrapping them. The results are plain
+/// tensors, which have no autograd metadata and no version counter, and so
+/// are the tensors created by the `torch::` factory functions. To let Variables
+/// (e.g. the parameters of a module) and plain tensors mix, every tensor is
+/// dispatched to `VariableType` in inference mode (see `legacyTensorType()`);
+/// the operators called from within the non-Variable type dispatch directly.
+///
+/// Plain tensors created in inference mode can only be used with autograd
+/// after wrapping them with `torch::autograd::make_variable()`.
+
 /// In the CAFFE2_FB_LIMITED_MOBILE_CAPABILITY build setting,
 /// thread_local is not supported. In that case, we don't provide
 /// `at::NonVariableTypeMode`.
@@ -38,6 +59,16 @@ void NonVariableTypeMode::set_enabled(bool enabled) {
   NonVariableTypeMode_enabled = enabled;
 }
 
+thread_local bool InferenceMode_enabled = false;
+
+bool InferenceMode::is_enabled() {
+  return InferenceMode_enabled;
+}
+
+void InferenceMode::set_enabled(bool enabled) {
+  InferenceMode_enabled = enabled;
+}
+
 #else // defined(C10_MOBILE) || defined(CAFFE2_FB_LIMITED_MOBILE_CAPABILITY)
 
 bool NonVariableTypeMode::is_enabled() {
@@ -48,6 +79,15 @@ void NonVariableTypeMode::set_enabled(bool enabled) {
   throw std::runtime_error("NonVariableTypeMode is not supported on mobile");
 }
 
+// Called for every dispatch, so this must not throw.
+bool InferenceMode::is_enabled() {
+  return false;
+}
+
+void InferenceMode::set_enabled(bool enabled) {
+  throw std::runtime_error("InferenceMode is not supported on mobile");
+}
+
 #endif
 
 // TODO: This could be bad juju if someone calls globalContext() in the
@@ -162,6 +162,13 @@ struct CAFFE2_API AutoNonVariableTypeMode {
   bool prev_mode;
 };
 
+// Thread local flag of inference mode. See NOTE [ Inference mode ] for
+// details; use `torch::autograd::AutoInferenceMode` to enable it.
+struct CAFFE2_API InferenceMode {
+  static bool is_enabled();
+  static void set_enabled(bool enabled);
+};
+
 /**
  * Return the Type object corresponding to this Tensor, which we can
  * use to do dynamic dispatch to operators from.  This method is NOT
@@ -171,6 +178,10 @@ struct CAFFE2_API AutoNonVariableTypeMode {
  * NOTE: We also check `at::NonVariableTypeMode`, and if it's enabled
  * we always return non-Variable type in this function.
  * See NOTE [ Treating Variables as non-Variables in type dispatch ]
+ *
+ * In inference mode, all tensors are dispatched to the Variable type, which
+ * unwraps Variables and forwards to the non-Variable type.
+ * See NOTE [ Inference mode ]
  */
 inline Type& legacyTensorType(const TensorImpl& tensor) {
   // NB: It's valid to use getTypeRaw here, because the TensorImpl
@@ -180,7 +191,8 @@ inline Type& legacyTensorType(const TensorImpl& tensor) {
   return *globalLegacyTypeDispatch().getTypeRaw(
       tensorTypeIdToBackend(tensor.type_id()),
       typeMetaToScalarType(tensor.dtype()),
-      tensor.is_variable() && !at::NonVariableTypeMode::is_enabled());
+      (tensor.is_variable() || at::InferenceMode::is_enabled()) &&
+          !at::NonVariableTypeMode::is_enabled());
 }
 
 inline void initializeLegacyTypeDispatchFor(const TensorImpl& tensor) {
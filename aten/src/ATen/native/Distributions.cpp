@@ -4,6 +4,7 @@
 #include <ATen/Dispatch.h>
 #include <ATen/ExpandUtils.h>
 #include <ATen/NativeFunctions.h>
+#include <ATen/LegacyTHFunctions.h>
 #include <c10/util/Exception.h>
 
 #include <ATen/CPUGenerator.h>
@@ -110,6 +111,23 @@ int64_t sample_poisson(double lambda, THGenerator* generator) {
 namespace at {
 namespace native {
 
+// Dense CPU float tensors are filled by the counter-based samplers in
+// native/cpu/DistributionsKernel.cpp, which generate in parallel without
+// holding the generator lock. Everything else goes through TH.
+static bool can_use_philox(const Tensor& self) {
+  return self.type().backend() == Backend::CPU && self.is_contiguous() &&
+      (self.scalar_type() == kFloat || self.scalar_type() == kDouble);
+}
+
+// Draws the key of a Philox stream from the CPU generator. Keys are taken
+// from the regular mt19937 stream, so manual_seed and get/set_rng_state keep
+// controlling all samples.
+static uint64_t philox_seed(Generator* gen) {
+  THGenerator* generator = get_generator(gen);
+  std::lock_guard<std::mutex> lock(generator->mutex);
+  return THRandom_random64(generator);
+}
+
 Tensor bernoulli(const Tensor& self, Generator* gen) {
   return at::empty_like(self).bernoulli_(self, gen);
 }
@@ -160,6 +178,10 @@ Tensor& bernoulli_scalar_cpu_(Tensor& self, double p, Generator* gen) {
     return self;
   }
 #endif
+  if (self.is_contiguous()) {
+    bernoulli_philox_stub(kCPU, self, p, philox_seed(gen));
+    return self;
+  }
   AT_DISPATCH_ALL_TYPES(self.scalar_type(), "bernoulli_scalar_cpu_", [&] {
     THGenerator* generator = get_generator(gen);
     std::lock_guard<std::mutex> lock(generator->mutex);
@@ -171,6 +193,27 @@ Tensor& bernoulli_scalar_cpu_(Tensor& self, double p, Generator* gen) {
   return self;
 }
 
+DEFINE_DISPATCH(uniform_philox_stub);
+DEFINE_DISPATCH(normal_philox_stub);
+DEFINE_DISPATCH(bernoulli_philox_stub);
+
+Tensor & uniform_(Tensor& self, double from, double to, Generator * gen) {
+  if (can_use_philox(self)) {
+    uniform_philox_stub(kCPU, self, from, to, philox_seed(gen));
+    return self;
+  }
+  return at::legacy::th::_th_uniform_(self, from, to, gen);
+}
+
+Tensor & normal_(Tensor& self, double mean, double std, Generator * gen) {
+  AT_CHECK(std > 0.0, "normal_ expects std > 0.0, but found std=", std);
+  if (can_use_philox(self)) {
+    normal_philox_stub(kCPU, self, mean, std, philox_seed(gen));
+    return self;
+  }
+  return at::legacy::th::_th_normal_(self, mean, std, gen);
+}
+
 
 Tensor _standard_gamma_grad_cpu(const Tensor& self, const Tensor& output) {
   Tensor ret = at::empty(self.sizes(), self.options());
@@ -0,0 +1,139 @@
+#include <ATen/ATen.h>
+#include <ATen/native/FusedOptimizers.h>
+
+namespace at { namespace native {
+
+DEFINE_DISPATCH(fused_sgd_stub);
+DEFINE_DISPATCH(fused_adam_stub);
+DEFINE_DISPATCH(fused_adagrad_stub);
+DEFINE_DISPATCH(fused_rmsprop_stub);
+
+namespace {
+
+void check_state_list(
+    TensorList params,
+    TensorList state,
+    const char* name,
+    bool required) {
+  if (!required && state.empty()) {
+    return;
+  }
+  AT_CHECK(
+      state.size() == params.size(),
+      "fused optimizer step: expected ", params.size(), " ", name,
+      " but got ", state.size());
+  for (size_t i = 0; i < params.size(); ++i) {
+    AT_CHECK(
+        fused_optimizer_supported(params[i], state[i]),
+        "fused optimizer step: ", name, "[", i, "] must be a contiguous CPU "
+        "tensor with the same dtype and number of elements as its parameter");
+  }
+}
+
+} // namespace
+
+bool fused_optimizer_supported(const Tensor& reference, TensorList tensors) {
+  if (!reference.defined() || reference.device().type() != kCPU ||
+      reference.layout() != kStrided || !reference.is_contiguous()) {
+    return false;
+  }
+  const auto scalar_type = reference.scalar_type();
+  if (scalar_type != kFloat && scalar_type != kDouble) {
+    return false;
+  }
+  for (const auto& tensor : tensors) {
+    if (!tensor.defined()) {
+      continue;
+    }
+    if (tensor.device().type() != kCPU || tensor.layout() != kStrided ||
+        !tensor.is_contiguous() || tensor.scalar_type() != scalar_type ||
+        tensor.numel() != reference.numel()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void fused_sgd_step_(
+    TensorList params,
+    TensorList grads,
+    TensorList momentum_buffers,
+    const FusedSGDOptions& options) {
+  check_state_list(params, grads, "grads", /*required=*/true);
+  check_state_list(
+      params, momentum_buffers, "momentum_buffers", options.momentum != 0);
+  if (params.empty()) {
+    return;
+  }
+  fused_sgd_stub(kCPU, params, grads, momentum_buffers, options);
+}
+
+void fused_adam_step_(
+    TensorList params,
+    TensorList grads,
+    TensorList exp_avgs,
+    TensorList exp_avg_sqs,
+    TensorList max_exp_avg_sqs,
+    ArrayRef<double> step_sizes,
+    const FusedAdamOptions& options) {
+  check_state_list(params, grads, "grads", /*required=*/true);
+  check_state_list(params, exp_avgs, "exp_avgs", /*required=*/true);
+  check_state_list(params, exp_avg_sqs, "exp_avg_sqs", /*required=*/true);
+  check_state_list(
+      params, max_exp_avg_sqs, "max_exp_avg_sqs", options.amsgrad);
+  AT_CHECK(
+      step_sizes.size() == params.size(),
+      "fused_adam_step_: expected ", params.size(), " step sizes but got ",
+      step_sizes.size());
+  if (params.empty()) {
+    return;
+  }
+  fused_adam_stub(
+      kCPU,
+      params,
+      grads,
+      exp_avgs,
+      exp_avg_sqs,
+      max_exp_avg_sqs,
+      step_sizes,
+      options);
+}
+
+void fused_adagrad_step_(
+    TensorList params,
+    TensorList grads,
+    TensorList sums,
+    ArrayRef<double> learning_rates,
+    const FusedAdagradOptions& options) {
+  check_state_list(params, grads, "grads", /*required=*/true);
+  check_state_list(params, sums, "sums", /*required=*/true);
+  AT_CHECK(
+      learning_rates.size() == params.size(),
+      "fused_adagrad_step_: expected ", params.size(),
+      " learning rates but got ", learning_rates.size());
+  if (params.empty()) {
+    return;
+  }
+  fused_adagrad_stub(kCPU, params, grads, sums, learning_rates, options);
+}
+
+void fused_rmsprop_step_(
+    TensorList params,
+    TensorList grads,
+    TensorList square_avgs,
+    TensorList momentum_buffers,
+    TensorList grad_avgs,
+    const FusedRMSpropOptions& options) {
+  check_state_list(params, grads, "grads", /*required=*/true);
+  check_state_list(params, square_avgs, "square_avgs", /*required=*/true);
+  check_state_list(
+      params, momentum_buffers, "momentum_buffers", options.momentum > 0);
+  check_state_list(params, grad_avgs, "grad_avgs", options.centered);
+  if (params.empty()) {
+    return;
+  }
+  fused_rmsprop_stub(
+      kCPU, params, grads, square_avgs, momentum_buffers, grad_avgs, options);
+}
+
+}} // namespace at::native
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <ATen/ATen.h>
+#include <ATen/native/DispatchStub.h>
+
+// Fused multi-tensor optimizer updates.
+//
+// The optimizers of the C++ frontend express one update as a sequence of
+// ATen ops per parameter (mul_, add_, addcmul_, sqrt, addcdiv_, ...), each of
+// which builds its own TensorIterator and some of which allocate temporaries.
+// For models with many small parameters that overhead dominates the step.
+// The kernels declared here perform the whole update for *all* parameters in a
+// single parallel pass: the parameters are split into fixed size chunks, the
+// chunks of every tensor are distributed with one parallel_for, and each chunk
+// is updated in registers without materializing intermediates.
+//
+// All tensors passed to these functions must satisfy
+// `fused_optimizer_supported` (dense, contiguous CPU float or double tensors
+// with matching dtype and number of elements). Optional state lists (e.g. the
+// momentum buffers when momentum is zero) are passed as empty lists.
+
+namespace at { namespace native {
+
+struct FusedSGDOptions {
+  double learning_rate;
+  double momentum;
+  // Scale applied to the gradient when accumulating it into the momentum
+  // buffer, i.e. 1 - dampening (or 1 on the very first step).
+  double dampening;
+  double weight_decay;
+  bool nesterov;
+};
+
+struct FusedAdamOptions {
+  double beta1;
+  double beta2;
+  double eps;
+  double weight_decay;
+  bool amsgrad;
+};
+
+struct FusedAdagradOptions {
+  double weight_decay;
+  double eps;
+};
+
+struct FusedRMSpropOptions {
+  double learning_rate;
+  double alpha;
+  double eps;
+  double weight_decay;
+  double momentum;
+  bool centered;
+};
+
+using fused_sgd_fn = void(*)(
+    TensorList params,
+    TensorList grads,
+    TensorList momentum_buffers,
+    const FusedSGDOptions& options);
+using fused_adam_fn = void(*)(
+    TensorList params,
+    TensorList grads,
+    TensorList exp_avgs,
+    TensorList exp_avg_sqs,
+    TensorList max_exp_avg_sqs,
+    ArrayRef<double> step_sizes,
+    const FusedAdamOptions& options);
+using fused_adagrad_fn = void(*)(
+    TensorList params,
+    TensorList grads,
+    TensorList sums,
+    ArrayRef<double> learning_rates,
+    const FusedAdagradOptions& options);
+using fused_rmsprop_fn = void(*)(
+    TensorList params,
+    TensorList grads,
+    TensorList square_avgs,
+    TensorList momentum_buffers,
+    TensorList grad_avgs,
+    const FusedRMSpropOptions& options);
+
+DECLARE_DISPATCH(fused_sgd_fn, fused_sgd_stub);
+DECLARE_DISPATCH(fused_adam_fn, fused_adam_stub);
+DECLARE_DISPATCH(fused_adagrad_fn, fused_adagrad_stub);
+DECLARE_DISPATCH(fused_rmsprop_fn, fused_rmsprop_stub);
+
+// Returns true if all defined tensors in `tensors` can be updated by the fused
+// kernels together with `reference`: dense, contiguous CPU tensors of the same
+// floating point dtype and number of elements as `reference`.
+CAFFE2_API bool fused_optimizer_supported(
+    const Tensor& reference,
+    TensorList tensors);
+
+// p <- p - lr * update, where update is the (optionally momentum and nesterov
+// corrected) gradient with weight decay applied. Updates `momentum_buffers`
+// in place if momentum is used.
+CAFFE2_API void fused_sgd_step_(
+    TensorList params,
+    TensorList grads,
+    TensorList momentum_buffers,
+    const FusedSGDOptions& options);
+
+// Adam update with a per parameter step size, which already contains the
+// learning rate and the bias corrections for the parameter's step count.
+CAFFE2_API void fused_adam_step_(
+    TensorList params,
+    TensorList grads,
+    TensorList exp_avgs,
+    TensorList exp_avg_sqs,
+    TensorList max_exp_avg_sqs,
+    ArrayRef<double> step_sizes,
+    const FusedAdamOptions& options);
+
+// Adagrad update with a per parameter (decayed) learning rate.
+CAFFE2_API void fused_adagrad_step_(
+    TensorList params,
+    TensorList grads,
+    TensorList sums,
+    ArrayRef<double> learning_rates,
+    const FusedAdagradOptions& options);
+
+CAFFE2_API void fused_rmsprop_step_(
+    TensorList params,
+    TensorList grads,
+    TensorList square_avgs,
+    TensorList momentum_buffers,
+    TensorList grad_avgs,
+    const FusedRMSpropOptions& options);
+
+}} // namespace at::native
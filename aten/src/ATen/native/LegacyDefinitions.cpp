@@ -231,14 +231,6 @@ Tensor & random_(Tensor& self, Generator * generator) {
   return at::legacy::th::_th_random_(self, generator);
 }
 
-Tensor & uniform_(Tensor& self, double from, double to, Generator * generator) {
-  return at::legacy::th::_th_uniform_(self, from, to, generator);
-}
-
-Tensor & normal_(Tensor& self, double mean, double std, Generator * generator) {
-  return at::legacy::th::_th_normal_(self, mean, std, generator);
-}
-
 Tensor & cauchy_(Tensor& self, double median, double sigma, Generator * generator) {
   return at::legacy::th::_th_cauchy_(self, median, sigma, generator);
 }
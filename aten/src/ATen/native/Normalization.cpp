@@ -1,9 +1,9 @@
 #include <ATen/ATen.h>
 #include <ATen/NativeFunctions.h>
 #include <ATen/AccumulateType.h>
-#include <ATen/CPUApplyUtils.h>
 #include <ATen/Parallel.h>
 #include <ATen/Config.h>
+#include <ATen/native/StridedView.h>
 
 #include <ATen/detail/CUDAHooksInterface.h>
 
@@ -152,10 +152,13 @@ std::tuple<Tensor,Tensor,Tensor> batch_norm_cpu_transform_input_template(
   auto running_mean_a = conditional_accessor_1d<scalar_t>(running_mean);
   auto running_var_a = conditional_accessor_1d<scalar_t>(running_var);
 
+  StridedView<scalar_t> input_v(input);
+  StridedView<scalar_t> output_v(output);
+
   parallel_for(0, n_input, 1, [&](int64_t b_begin, int64_t b_end) {
     for (int64_t f = b_begin; f < b_end; ++f) {
-      Tensor in = input.select(1, f);
-      Tensor out = output.select(1, f);
+      auto in = input_v.select(1, f);
+      auto out = output_v.select(1, f);
 
       scalar_t mean, invstd;
       if (train) {
@@ -170,7 +173,7 @@ std::tuple<Tensor,Tensor,Tensor> batch_norm_cpu_transform_input_template(
       scalar_t w = weight.defined() ? weight.data<scalar_t>()[f * weight.stride(0)] : 1;
       scalar_t b = bias.defined() ? bias.data<scalar_t>()[f * bias.stride(0)] : 0;
 
-      CPU_tensor_apply2<scalar_t,scalar_t>(out, in, [&](scalar_t& o, const scalar_t& i) {
+      strided_apply(out, in, [&](scalar_t& o, const scalar_t& i) {
         o = ((i - mean) * invstd) * w + b;
       });
     }
@@ -196,13 +199,15 @@ std::tuple<Tensor,Tensor> batch_norm_cpu_update_stats_template(
   auto running_mean_a = conditional_accessor_1d<scalar_t>(running_mean);
   auto running_var_a = conditional_accessor_1d<scalar_t>(running_var);
 
+  StridedView<scalar_t> input_v(input);
+
   parallel_for(0, n_input, 1, [&](int64_t b_begin, int64_t b_end) {
     for (int64_t f = b_begin; f < b_end; ++f) {
-      Tensor in = input.select(1, f);
+      auto in = input_v.select(1, f);
 
       // compute mean per input
       accscalar_t sum = 0;
-      CPU_tensor_apply1<scalar_t>(in, [&] (const scalar_t& i) {
+      strided_apply(in, [&] (const scalar_t& i) {
           sum += i;
         });
       scalar_t mean = sum / n;
@@ -210,7 +215,7 @@ std::tuple<Tensor,Tensor> batch_norm_cpu_update_stats_template(
 
       // compute variance per input
       accscalar_t var_sum = 0;
-      CPU_tensor_apply1<scalar_t>(in, [&] (const scalar_t& i) {
+      strided_apply(in, [&] (const scalar_t& i) {
         var_sum += (i - mean) * (i - mean);
       });
       save_var_transform_a[f] = VarTransform<accscalar_t>{}(var_sum / n, eps);
@@ -263,10 +268,13 @@ std::tuple<Tensor, Tensor, Tensor> batch_norm_backward_cpu_template(const Tensor
   auto running_var_a = conditional_accessor_1d<scalar_t>(running_var);
 
 
+  StridedView<scalar_t> input_v(input);
+  StridedView<scalar_t> grad_out_v(grad_out_);
+
   parallel_for(0, n_input, 1, [&](int64_t b_begin, int64_t b_end) {
       for (int64_t f = b_begin; f < b_end; ++f) {
-        Tensor in = input.select(1, f);
-        Tensor grad_out = grad_out_.select(1, f);
+        auto in = input_v.select(1, f);
+        auto grad_out = grad_out_v.select(1, f);
 
         scalar_t w = weight.defined() ? weight_a[f] : 1;
 
@@ -281,18 +289,18 @@ std::tuple<Tensor, Tensor, Tensor> batch_norm_backward_cpu_template(const Tensor
 
         // sum over all gradOutput in feature plane
         accscalar_t sum = 0;
-        CPU_tensor_apply1<scalar_t>(grad_out, [&](const scalar_t& g) {
+        strided_apply(grad_out, [&](const scalar_t& g) {
             sum += g;
           });
 
         // dot product of the Q(X) and gradOuput
         accscalar_t dotp = 0;
-        CPU_tensor_apply2<scalar_t,scalar_t>(in, grad_out, [&](const scalar_t& i, const scalar_t& go) {
+        strided_apply(in, grad_out, [&](const scalar_t& i, const scalar_t& go) {
             dotp += (i - mean) * go;
           });
 
         if (grad_input_mask[0]) {
-          Tensor grad_in = grad_input.select(1, f);
+          auto grad_in = StridedView<scalar_t>(grad_input).select(1, f);
           if (train) {
             // when in training mode
             // Q(X) = X - E[x] ; i.e. input centered to zero mean
@@ -302,12 +310,12 @@ std::tuple<Tensor, Tensor, Tensor> batch_norm_backward_cpu_template(const Tensor
             // projection of gradOutput on to output scaled by std
             scalar_t k = (scalar_t) dotp * invstd * invstd / n;
 
-            CPU_tensor_apply2<scalar_t,scalar_t>(grad_in, in, [&](scalar_t& gi, const scalar_t& i) {
+            strided_apply(grad_in, in, [&](scalar_t& gi, const scalar_t& i) {
                 gi = (i - mean)* k;
               });
 
             accscalar_t grad_mean = sum / n;
-            CPU_tensor_apply2<scalar_t,scalar_t>(grad_in, grad_out, [&](scalar_t& gi, const scalar_t& go) {
+            strided_apply(grad_in, grad_out, [&](scalar_t& gi, const scalar_t& go) {
             gi = (go - grad_mean - gi) * invstd * w;
               });
           } else {
@@ -315,7 +323,7 @@ std::tuple<Tensor, Tensor, Tensor> batch_norm_backward_cpu_template(const Tensor
             // Q(X) = X - running_mean  ; i.e. input centered to zero mean
             // Y = Q(X) / running_std    ; i.e. BN output before weight and bias
             // dL/dX = w / running_std
-            CPU_tensor_apply2<scalar_t,scalar_t>(grad_in, grad_out, [&](scalar_t& gi, const scalar_t& go) {
+            strided_apply(grad_in, grad_out, [&](scalar_t& gi, const scalar_t& go) {
                 gi = go * invstd * w;
               });
           }
@@ -1,13 +1,16 @@
 #include "ATen/ATen.h"
 #include "ATen/NativeFunctions.h"
+#include "ATen/Parallel.h"
 #include "ATen/WrapDimUtilsMulti.h"
 #include "ATen/cpp_custom_type_hack.h"
 
 #ifdef USE_FBGEMM
+#include "ATen/native/quantized/cpu/FbgemmPackCache.h"
 #include "fbgemm/Fbgemm.h"
 #include "fbgemm/QuantUtils.h"
 #endif // USE_FBGEMM
 
+#include <algorithm>
 #include <array>
 #include <cctype>
 #include <cmath>
@@ -18,10 +21,32 @@
 
 #include <chrono>
 
+#ifdef USE_FBGEMM
+namespace at {
+namespace native {
+
+// The weight of a linear layer quantized with a scale and zero point for
+// every output channel and packed for fbgemm, wrapped in the tensor returned
+// by fbgemm_linear_pack_weight.
+struct PackedLinearWeight {
+  std::shared_ptr<fbgemm::PackBMatrix<int8_t>> w;
+  // Sum of every row of the quantized weight, minus zero point * K.
+  std::vector<int32_t> col_offsets;
+  std::vector<float> w_scale;
+  std::vector<int32_t> w_zp;
+  int64_t K;
+  int64_t N;
+};
+
+} // namespace native
+} // namespace at
+#endif // USE_FBGEMM
+
 namespace caffe2 {
 #ifdef USE_FBGEMM
 // Required for cpp_custom_type_hack to work
-CAFFE_KNOWN_TYPE(fbgemm::PackBMatrix<int8_t>);
+CAFFE_KNOWN_TYPE(std::shared_ptr<fbgemm::PackBMatrix<int8_t>>);
+CAFFE_KNOWN_TYPE(at::native::PackedLinearWeight);
 #endif // USE_FBGEMM
 }
 
@@ -136,7 +161,9 @@ Tensor fbgemm_linear_int8_weight(
   auto buffer = at::zeros_like(output, output.options().dtype(at::kInt));
 
   // Pull out the PackBMatrix instance from the owning tensor
-  auto& packB = cpp_custom_type_hack::cast<fbgemm::PackBMatrix<int8_t>>(packed);
+  auto& packB =
+      *cpp_custom_type_hack::cast<std::shared_ptr<fbgemm::PackBMatrix<int8_t>>>(
+          packed);
 
   // Do the GEMM
   fbgemm::fbgemmPacked(
@@ -241,17 +268,313 @@ Tensor fbgemm_pack_quantized_matrix(
   AT_ASSERTM(fbgemm::fbgemmSupportedCPU(), "Your CPU does not support FBGEMM.");
   auto weight_contig = weight.contiguous();
   auto contiguous_ptr = weight_contig.data<int8_t>();
-  auto ptr = guts::make_unique<fbgemm::PackBMatrix<int8_t>>(
+  // Models and threads that hold copies of the same weight share the packed
+  // matrix through the cache.
+  auto ptr = guts::make_unique<std::shared_ptr<fbgemm::PackBMatrix<int8_t>>>(
+      FbgemmPackCache::get().getOrPack<int32_t>(
+          /*trans=*/fbgemm::matrix_op_t::Transpose,
+          /*nRow=*/K,
+          /*nCol=*/N,
+          /*smat=*/contiguous_ptr,
+          /*ld=*/K,
+          /*groups=*/1));
+  return cpp_custom_type_hack::create(std::move(ptr), weight.options());
+}
+
+namespace {
+
+// Chooses the parameters to quantize `len` floats at `data` to 8-bit unsigned
+// values.
+fbgemm::TensorQuantizationParams chooseInputQParams(
+    const float* data,
+    int64_t len) {
+  float x_min = 0, x_max = 0;
+  if (len > 0) {
+    fbgemm::FindMinMax(/*m=*/data, /*min=*/&x_min, /*max=*/&x_max, /*len=*/len);
+  }
+  auto q_params = fbgemm::ChooseQuantizationParams(
+      /*min=*/x_min,
+      /*max=*/x_max,
+      /*qmin=*/0,
+      /*qmax=*/255,
+      /*preserve_sparsity=*/false);
+  q_params.precision = 8;
+  return q_params;
+}
+
+// Multiplies the M x K `input`, quantized on the fly with `q_params`, by the
+// packed weight, on all threads. `makeOutputProcess` builds the output
+// pipeline of every thread from the row offsets of its packed input.
+template <typename OutT, typename MakeOutputProcess>
+void runPackedLinear(
+    const float* input_ptr,
+    int64_t M,
+    const PackedLinearWeight& packed,
+    const fbgemm::TensorQuantizationParams& q_params,
+    OutT* output_ptr,
+    int32_t* buffer_ptr,
+    const MakeOutputProcess& makeOutputProcess) {
+  // fbgemmPacked splits the rows of the output among the tasks.
+  const int num_tasks = M * packed.N * packed.K < at::internal::GRAIN_SIZE
+      ? 1
+      : at::get_num_threads();
+  at::parallel_for(0, num_tasks, 1, [&](int64_t begin, int64_t end) {
+    for (int64_t task_id = begin; task_id < end; ++task_id) {
+      fbgemm::PackAWithQuantRowOffset<uint8_t> packA(
+          /*trans=*/fbgemm::matrix_op_t::NoTranspose,
+          /*nRow=*/M,
+          /*nCol=*/packed.K,
+          /*smat=*/input_ptr,
+          /*ld=*/packed.K,
+          /*pmat=*/nullptr, // packA manages ownership of `pmat`
+          /*scale=*/q_params.scale,
+          /*zero_pt=*/q_params.zero_point);
+      auto outputProcObj = makeOutputProcess(packA.getRowOffsetBuffer());
+      fbgemm::fbgemmPacked(
+          /*packA=*/packA,
+          /*packB=*/*packed.w,
+          /*C=*/output_ptr,
+          /*C_buffer=*/buffer_ptr,
+          /*ldc=*/packed.N,
+          /*outProcess=*/outputProcObj,
+          /*thread_id=*/task_id,
+          /*num_threads=*/num_tasks);
+    }
+  });
+}
+
+const PackedLinearWeight& checkLinearInput(
+    const Tensor& input,
+    const Tensor& packed_weight,
+    const Tensor& bias) {
+  // We make a strong guarantee that models using these operators will have the
+  // same numerics across different machines. Therefore, we do not provide a
+  // fallback path and rather fail loudly if we cannot run FBGEMM.
+  AT_ASSERTM(fbgemm::fbgemmSupportedCPU(), "Your CPU does not support FBGEMM.");
+  auto& packed = cpp_custom_type_hack::cast<PackedLinearWeight>(packed_weight);
+  AT_CHECK(
+      input.dim() >= 1 && input.size(-1) == packed.K,
+      "Expected an input with ", packed.K, " features, but got sizes ",
+      input.sizes());
+  AT_CHECK(
+      !bias.defined() || (bias.dim() == 1 && bias.size(0) == packed.N),
+      "Expected a bias of size ", packed.N);
+  return packed;
+}
+
+std::vector<int64_t> linearOutputSizes(const Tensor& input, int64_t N) {
+  auto sizes = input.sizes().vec();
+  sizes.back() = N;
+  return sizes;
+}
+
+template <bool FUSE_RELU>
+void linearDynamic(
+    const float* input_ptr,
+    int64_t M,
+    const PackedLinearWeight& packed,
+    const float* bias_ptr,
+    float* output_ptr) {
+  const auto q_params = chooseInputQParams(input_ptr, M * packed.K);
+  fbgemm::DoNothing<float, float> doNothingObj{};
+  // After the uint8 * int8 matrix multiplication, ReQuantizeForFloat adds
+  // the row and column offsets, dequantizes with the scale of every output
+  // channel, adds the bias and applies the ReLU, in place in the output.
+  runPackedLinear(
+      input_ptr,
+      M,
+      packed,
+      q_params,
+      output_ptr,
+      reinterpret_cast<int32_t*>(output_ptr),
+      [&](const int32_t* row_offsets) {
+        return fbgemm::ReQuantizeForFloat<
+            FUSE_RELU,
+            fbgemm::QuantizationGranularity::OUT_CHANNEL>(
+            /*nextop=*/doNothingObj,
+            /*Aq_scale=*/q_params.scale,
+            /*Bq_scale=*/packed.w_scale.data(),
+            /*Aq_zero_point=*/q_params.zero_point,
+            /*Bq_zero_point=*/packed.w_zp.data(),
+            /*row_offsets=*/row_offsets,
+            /*col_offsets=*/packed.col_offsets.data(),
+            /*bias=*/bias_ptr,
+            /*ncol=*/packed.N);
+      });
+}
+
+template <bool FUSE_RELU>
+void linearDynamicRequantize(
+    const float* input_ptr,
+    int64_t M,
+    const PackedLinearWeight& packed,
+    const float* bias_ptr,
+    float output_scale,
+    int32_t output_zero_point,
+    uint8_t* output_ptr,
+    int32_t* buffer_ptr) {
+  const auto q_params = chooseInputQParams(input_ptr, M * packed.K);
+  // The accumulators of output channel j have a scale of
+  // input scale * weight scale j, and so does its quantized bias.
+  std::vector<float> multipliers(packed.N);
+  std::vector<int32_t> bias_int32(packed.N);
+  for (int64_t j = 0; j < packed.N; ++j) {
+    const float acc_scale = q_params.scale * packed.w_scale[j];
+    multipliers[j] = acc_scale / output_scale;
+    bias_int32[j] = std::lrint(bias_ptr[j] / acc_scale);
+  }
+  fbgemm::DoNothing<> doNothingObj{};
+  runPackedLinear(
+      input_ptr,
+      M,
+      packed,
+      q_params,
+      output_ptr,
+      buffer_ptr,
+      [&](const int32_t* row_offsets) {
+        return fbgemm::ReQuantizeOutput<
+            FUSE_RELU,
+            fbgemm::QuantizationGranularity::OUT_CHANNEL>(
+            /*nextop=*/doNothingObj,
+            /*C_multiplier=*/multipliers.data(),
+            /*C_zero_point=*/output_zero_point,
+            /*Aq_zero_point=*/q_params.zero_point,
+            /*Bq_zero_point=*/packed.w_zp.data(),
+            /*row_offsets=*/row_offsets,
+            /*col_offsets=*/packed.col_offsets.data(),
+            /*bias=*/bias_int32.data(),
+            /*ncol=*/packed.N);
+      });
+}
+
+} // namespace
+
+Tensor fbgemm_linear_pack_weight(const Tensor& weight, int64_t group_size) {
+  // We make a strong guarantee that models using these operators will have the
+  // same numerics across different machines. Therefore, we do not provide a
+  // fallback path and rather fail loudly if we cannot run FBGEMM.
+  AT_ASSERTM(fbgemm::fbgemmSupportedCPU(), "Your CPU does not support FBGEMM.");
+  AT_CHECK(weight.dim() == 2, "Expected a 2-D weight, but got ", weight.dim());
+  AT_CHECK(group_size > 0, "group_size must be positive");
+  auto weight_contig = weight.to(at::kFloat).contiguous();
+  const auto* weight_ptr = weight_contig.data<float>();
+  const int64_t N = weight.size(0);
+  const int64_t K = weight.size(1);
+
+  auto ptr = guts::make_unique<PackedLinearWeight>();
+  ptr->K = K;
+  ptr->N = N;
+  ptr->w_scale.resize(N);
+  ptr->w_zp.resize(N);
+  ptr->col_offsets.resize(N);
+
+  // Every group of output channels, i.e. of rows of the weight, is quantized
+  // as 8-bit signed integers with its own parameters.
+  std::vector<int8_t> quantized(N * K);
+  for (int64_t begin = 0; begin < N; begin += group_size) {
+    const int64_t end = std::min(begin + group_size, N);
+    float w_min = 0, w_max = 0;
+    if (K > 0) {
+      fbgemm::FindMinMax(
+          /*m=*/weight_ptr + begin * K,
+          /*min=*/&w_min,
+          /*max=*/&w_max,
+          /*len=*/(end - begin) * K);
+    }
+    auto q_params = fbgemm::ChooseQuantizationParams(
+        /*min=*/w_min,
+        /*max=*/w_max,
+        /*qmin=*/-128,
+        /*qmax=*/127,
+        /*preserve_sparsity=*/false);
+    q_params.precision = 8;
+    fbgemm::Quantize<int8_t>(
+        /*src=*/weight_ptr + begin * K,
+        /*dst=*/quantized.data() + begin * K,
+        /*len=*/(end - begin) * K,
+        /*qparams=*/q_params);
+    for (int64_t i = begin; i < end; ++i) {
+      ptr->w_scale[i] = q_params.scale;
+      ptr->w_zp[i] = q_params.zero_point;
+      calc_col_offsets_transpose(
+          /*K=*/K,
+          /*N=*/1,
+          /*Bint8=*/quantized.data() + i * K,
+          /*B_zero_point=*/q_params.zero_point,
+          /*col_offsets=*/ptr->col_offsets.data() + i);
+    }
+  }
+
+  ptr->w = FbgemmPackCache::get().getOrPack<int32_t>(
       /*trans=*/fbgemm::matrix_op_t::Transpose,
       /*nRow=*/K,
       /*nCol=*/N,
-      /*smat=*/contiguous_ptr,
+      /*smat=*/quantized.data(),
       /*ld=*/K,
-      /*pmat=*/nullptr, // PackBMatrix manages ownership of pmat
       /*groups=*/1);
   return cpp_custom_type_hack::create(std::move(ptr), weight.options());
 }
 
+Tensor fbgemm_linear_dynamic(
+    const Tensor& input,
+    const Tensor& packed_weight,
+    const Tensor& bias,
+    bool relu) {
+  const auto& packed = checkLinearInput(input, packed_weight, bias);
+  auto input_contig = input.to(at::kFloat).contiguous();
+  const int64_t M = input_contig.numel() / packed.K;
+  auto bias_contig = bias.defined()
+      ? bias.to(at::kFloat).contiguous()
+      : at::zeros({packed.N}, input_contig.options());
+
+  auto output = at::empty({M, packed.N}, input_contig.options());
+  if (M > 0) {
+    (relu ? linearDynamic<true> : linearDynamic<false>)(
+        input_contig.data<float>(),
+        M,
+        packed,
+        bias_contig.data<float>(),
+        output.data<float>());
+  }
+  return output.view(linearOutputSizes(input, packed.N));
+}
+
+Tensor fbgemm_linear_dynamic_requantize(
+    const Tensor& input,
+    const Tensor& packed_weight,
+    const Tensor& bias,
+    double output_scale,
+    int64_t output_zero_point,
+    bool relu) {
+  const auto& packed = checkLinearInput(input, packed_weight, bias);
+  AT_CHECK(output_scale > 0, "output_scale must be positive");
+  AT_CHECK(
+      output_zero_point >= 0 && output_zero_point <= 255,
+      "output_zero_point must be in [0, 255]");
+  auto input_contig = input.to(at::kFloat).contiguous();
+  const int64_t M = input_contig.numel() / packed.K;
+  auto bias_contig = bias.defined()
+      ? bias.to(at::kFloat).contiguous()
+      : at::zeros({packed.N}, input_contig.options());
+
+  auto output =
+      at::empty({M, packed.N}, input_contig.options().dtype(at::kByte));
+  auto buffer =
+      at::empty({M, packed.N}, input_contig.options().dtype(at::kInt));
+  if (M > 0) {
+    (relu ? linearDynamicRequantize<true> : linearDynamicRequantize<false>)(
+        input_contig.data<float>(),
+        M,
+        packed,
+        bias_contig.data<float>(),
+        static_cast<float>(output_scale),
+        static_cast<int32_t>(output_zero_point),
+        output.data<uint8_t>(),
+        buffer.data<int32_t>());
+  }
+  return output.view(linearOutputSizes(input, packed.N));
+}
+
 #else // USE_FBGEMM
 
 Tensor fbgemm_linear_int8_weight(
@@ -289,6 +612,42 @@ Tensor fbgemm_pack_quantized_matrix(
       false, "This PyTorch installation was not built with FBGEMM operators");
 }
 
+Tensor fbgemm_linear_pack_weight(
+    const Tensor& /*weight*/,
+    int64_t /*group_size*/) {
+  // We make a strong guarantee that models using these operators will have the
+  // same numerics across different machines. Therefore, we do not provide a
+  // fallback path and rather fail loudly if we cannot run FBGEMM.
+  AT_ASSERTM(
+      false, "This PyTorch installation was not built with FBGEMM operators");
+}
+
+Tensor fbgemm_linear_dynamic(
+    const Tensor& /*input*/,
+    const Tensor& /*packed_weight*/,
+    const Tensor& /*bias*/,
+    bool /*relu*/) {
+  // We make a strong guarantee that models using these operators will have the
+  // same numerics across different machines. Therefore, we do not provide a
+  // fallback path and rather fail loudly if we cannot run FBGEMM.
+  AT_ASSERTM(
+      false, "This PyTorch installation was not built with FBGEMM operators");
+}
+
+Tensor fbgemm_linear_dynamic_requantize(
+    const Tensor& /*input*/,
+    const Tensor& /*packed_weight*/,
+    const Tensor& /*bias*/,
+    double /*output_scale*/,
+    int64_t /*output_zero_point*/,
+    bool /*relu*/) {
+  // We make a strong guarantee that models using these operators will have the
+  // same numerics across different machines. Therefore, we do not provide a
+  // fallback path and rather fail loudly if we cannot run FBGEMM.
+  AT_ASSERTM(
+      false, "This PyTorch installation was not built with FBGEMM operators");
+}
+
 bool fbgemm_is_cpu_supported() {
   return false;
 }
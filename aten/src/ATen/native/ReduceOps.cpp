@@ -29,6 +29,9 @@ DEFINE_DISPATCH(and_stub);
 DEFINE_DISPATCH(or_stub);
 DEFINE_DISPATCH(min_values_stub);
 DEFINE_DISPATCH(max_values_stub);
+DEFINE_DISPATCH(logsumexp_stub);
+DEFINE_DISPATCH(aminmax_stub);
+DEFINE_DISPATCH(std_var_mean_stub);
 
 static inline Tensor integer_upcast(const Tensor& self, optional<ScalarType> dtype) {
   ScalarType scalarType = self.scalar_type();
@@ -114,6 +117,31 @@ static std::unique_ptr<TensorIterator> make_reduction(
   return TensorIterator::reduce_op(viewed_result, self.to(dtype));
 }
 
+// Reduction with two outputs of the same shape, e.g. a variance and a mean.
+static std::unique_ptr<TensorIterator> make_reduction(
+    const char* name, Tensor& result1, Tensor& result2, const Tensor& self,
+    IntArrayRef dim, bool keepdim, ScalarType dtype1, ScalarType dtype2)
+{
+  // check that result types and dtypes match if provided
+  AT_CHECK(
+      (!result1.defined() || result1.scalar_type() == dtype1) &&
+      (!result2.defined() || result2.scalar_type() == dtype2),
+      name, ": provided dtypes must match dtypes of results. Got ",
+      toString(result1.scalar_type()), " and ", toString(result2.scalar_type()),
+      " for ", toString(dtype1), " and ", toString(dtype2), ".");
+  int64_t ndim = self.dim();
+  auto mask = make_dim_mask(dim, ndim);
+  allocate_reduction_result(result1, self, mask, keepdim, dtype1);
+  allocate_reduction_result(result2, self, mask, keepdim, dtype2);
+  auto viewed_result1 = review_reduce_result(result1, ndim, mask, keepdim);
+  auto viewed_result2 = review_reduce_result(result2, ndim, mask, keepdim);
+
+  if (self.scalar_type() == dtype1) {
+    return TensorIterator::reduce_op(viewed_result1, viewed_result2, self);
+  }
+  return TensorIterator::reduce_op(viewed_result1, viewed_result2, self.to(dtype1));
+}
+
 static inline int64_t n_dim_size(const Tensor& self, IntArrayRef dim) {
   int64_t numel = 1;
   for (auto d : dim) {
@@ -397,6 +425,14 @@ static Tensor squeeze_multiple(const Tensor& self, IntArrayRef dims) {
 }
 
 Tensor& logsumexp_out(Tensor& result, const Tensor &self, IntArrayRef dims, bool keepdim) {
+  ScalarType dtype = get_dtype(result, self, c10::nullopt);
+  if (self.device().is_cpu() && self.numel() != 0 &&
+      (dtype == kFloat || dtype == kDouble)) {
+    // a single pass, with a running maximum
+    auto iter = make_reduction("logsumexp", result, self, dims, keepdim, dtype);
+    logsumexp_stub(kCPU, *iter);
+    return result;
+  }
   // can't take max of empty tensor
   if (self.numel() != 0) {
     auto maxes = at::max_values(self, dims, true);
@@ -597,6 +633,24 @@ Tensor max_values(const Tensor& self, IntArrayRef dims, bool keepdim) {
   }
 }
 
+static std::tuple<Tensor, Tensor> aminmax(const Tensor& self, IntArrayRef dim, bool keepdim) {
+  AT_CHECK(self.numel() > 0, "_aminmax on a tensor with no elements is not defined.");
+  Tensor min_result;
+  Tensor max_result;
+  ScalarType dtype = self.scalar_type();
+  auto iter = make_reduction("_aminmax", min_result, max_result, self, dim, keepdim, dtype, dtype);
+  aminmax_stub(iter->device_type(), *iter);
+  return std::make_tuple(min_result, max_result);
+}
+
+std::tuple<Tensor, Tensor> _aminmax_cpu(const Tensor& self) {
+  return aminmax(self, {}, false);
+}
+
+std::tuple<Tensor, Tensor> _aminmax_cpu(const Tensor& self, int64_t dim, bool keepdim) {
+  return aminmax(self, maybe_wrap_dim(dim, self.dim()), keepdim);
+}
+
 static Tensor &std_var_out(Tensor &result, const Tensor &self, IntArrayRef dim, bool unbiased, bool keepdim, bool take_sqrt) {
   AT_CHECK(self.type().backend() == Backend::CPU || self.type().backend() == Backend::CUDA,
            "std and var only support CPU AND CUDA backend, got: ", toString(self.type().backend()));
@@ -611,12 +665,59 @@ static Tensor &std_var_out(Tensor &result, const Tensor &self, IntArrayRef dim,
   return result;
 }
 
+static std::tuple<Tensor, Tensor> std_var_mean(
+    const char* fname, const Tensor& self, IntArrayRef dim, bool unbiased,
+    bool keepdim, bool take_sqrt) {
+  AT_CHECK(self.type().backend() == Backend::CPU || self.type().backend() == Backend::CUDA,
+           fname, " only supports CPU AND CUDA backend, got: ", toString(self.type().backend()));
+  AT_CHECK(at::isFloatingType(self.scalar_type()), fname, " only supports floating-point dtypes");
+  if (self.is_cuda()) {
+    Tensor result = at::empty({0}, self.options());
+    std_var_out(result, self, dim, unbiased, keepdim, take_sqrt);
+    return std::make_tuple(result, at::mean(self, dim, keepdim));
+  }
+  Tensor result1;
+  Tensor result2;
+  ScalarType dtype = self.scalar_type();
+  auto iter = make_reduction(fname, result1, result2, self, dim, keepdim, dtype, dtype);
+  if (iter->numel() == 0) {
+    result1.fill_(NAN);
+    result2.fill_(NAN);
+  } else {
+    std_var_mean_stub(iter->device_type(), *iter, unbiased, take_sqrt);
+  }
+  return std::make_tuple(result1, result2);
+}
+
+std::tuple<Tensor, Tensor> var_mean(const Tensor& self, IntArrayRef dim, bool unbiased, bool keepdim) {
+  return std_var_mean("var_mean", self, dim, unbiased, keepdim, false);
+}
+
+std::tuple<Tensor, Tensor> var_mean(const Tensor& self, bool unbiased) {
+  return std_var_mean("var_mean", self, {}, unbiased, false, false);
+}
+
+std::tuple<Tensor, Tensor> std_mean(const Tensor& self, IntArrayRef dim, bool unbiased, bool keepdim) {
+  return std_var_mean("std_mean", self, dim, unbiased, keepdim, true);
+}
+
+std::tuple<Tensor, Tensor> std_mean(const Tensor& self, bool unbiased) {
+  return std_var_mean("std_mean", self, {}, unbiased, false, true);
+}
+
 Tensor var(const Tensor& self, bool unbiased) {
   AT_CHECK(self.type().backend() == Backend::CPU || self.type().backend() == Backend::CUDA,
            "var only supports CPU AND CUDA backend, got: ", toString(self.type().backend()));
   AT_CHECK(at::isFloatingType(self.scalar_type()), "var only supports floating-point dtypes");
   auto trivial_return = _allreduce_return_trivial(self, std::numeric_limits<double>::quiet_NaN());
-  return trivial_return.has_value() ? trivial_return.value() : at::legacy::th::_th_var(self, unbiased);
+  if (trivial_return.has_value()) {
+    return trivial_return.value();
+  }
+  if (self.is_cuda()) {
+    return at::legacy::th::_th_var(self, unbiased);
+  }
+  Tensor result;
+  return std_var_out(result, self, {}, unbiased, false, false);
 }
 
 Tensor var(const Tensor& self, IntArrayRef dim, bool unbiased, bool keepdim) {
@@ -633,7 +734,14 @@ Tensor std(const Tensor& self, bool unbiased) {
            "std only supports CPU AND CUDA backend, got: ", toString(self.type().backend()));
   AT_CHECK(at::isFloatingType(self.scalar_type()), "std only supports floating-point dtypes");
   auto trivial_return = _allreduce_return_trivial(self, std::numeric_limits<double>::quiet_NaN());
-  return trivial_return.has_value() ? trivial_return.value() : at::legacy::th::_th_std(self, unbiased);
+  if (trivial_return.has_value()) {
+    return trivial_return.value();
+  }
+  if (self.is_cuda()) {
+    return at::legacy::th::_th_std(self, unbiased);
+  }
+  Tensor result;
+  return std_var_out(result, self, {}, unbiased, false, true);
 }
 
 Tensor std(const Tensor& self, IntArrayRef dim, bool unbiased, bool keepdim) {
@@ -19,10 +19,13 @@ DECLARE_DISPATCH(reduce_fn, and_stub);
 DECLARE_DISPATCH(reduce_fn, or_stub);
 DECLARE_DISPATCH(reduce_fn, min_values_stub);
 DECLARE_DISPATCH(reduce_fn, max_values_stub);
+DECLARE_DISPATCH(reduce_fn, logsumexp_stub);
+DECLARE_DISPATCH(reduce_fn, aminmax_stub);
 
 using reduce_std_var_function =
   void (*)(TensorIterator&, bool unbiased, bool take_sqrt);
 DECLARE_DISPATCH(reduce_std_var_function, std_var_stub);
+DECLARE_DISPATCH(reduce_std_var_function, std_var_mean_stub);
 
 using reduce_norm_fn =
     void (*)(Tensor&, const Tensor&, Scalar, c10::optional<int64_t>);
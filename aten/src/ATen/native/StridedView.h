@@ -0,0 +1,178 @@
+#pragma once
+
+#include <ATen/ATen.h>
+#include <ATen/DimVector.h>
+#include <ATen/WrapDimUtils.h>
+
+#include <algorithm>
+#include <utility>
+
+namespace at { namespace native {
+
+// A non-owning view of the data of a strided CPU tensor.
+//
+// Kernels that loop over slices of a tensor (e.g. over the features of batch
+// norm) can select and narrow a StridedView instead of creating a Tensor per
+// slice, which costs a TensorImpl, storage refcounting and the dispatch of
+// as_strided. Up to five sizes and strides are stored inline, so views of
+// such tensors are never allocated on the heap.
+//
+// The view does not keep the data alive; the tensor it was created from must
+// outlive it.
+template <typename scalar_t>
+struct StridedView {
+  explicit StridedView(const Tensor& tensor)
+    : data_(tensor.data<scalar_t>())
+    , sizes_(tensor.sizes().begin(), tensor.sizes().end())
+    , strides_(tensor.strides().begin(), tensor.strides().end()) {}
+
+  StridedView(scalar_t* data, IntArrayRef sizes, IntArrayRef strides)
+    : data_(data)
+    , sizes_(sizes.begin(), sizes.end())
+    , strides_(strides.begin(), strides.end()) {
+    AT_ASSERT(sizes.size() == strides.size());
+  }
+
+  scalar_t* data() const { return data_; }
+  int64_t dim() const { return sizes_.size(); }
+  IntArrayRef sizes() const { return sizes_; }
+  IntArrayRef strides() const { return strides_; }
+  int64_t size(int64_t dim) const { return sizes_[maybe_wrap_dim(dim, this->dim())]; }
+  int64_t stride(int64_t dim) const { return strides_[maybe_wrap_dim(dim, this->dim())]; }
+
+  int64_t numel() const {
+    int64_t n = 1;
+    for (auto size : sizes_) {
+      n *= size;
+    }
+    return n;
+  }
+
+  StridedView select(int64_t dim, int64_t index) const {
+    AT_CHECK(this->dim() > 0, "select() cannot be applied to a 0-dim view");
+    dim = maybe_wrap_dim(dim, this->dim());
+    const auto size = sizes_[dim];
+    if (index < -size || index >= size) {
+      AT_INDEX_ERROR("select(): index ", index, " out of range for view of size ",
+                     sizes(), " at dimension ", dim);
+    }
+    if (index < 0) {
+      index += size;
+    }
+    StridedView result(data_ + index * strides_[dim]);
+    result.sizes_.append(sizes_.begin(), sizes_.begin() + dim);
+    result.sizes_.append(sizes_.begin() + dim + 1, sizes_.end());
+    result.strides_.append(strides_.begin(), strides_.begin() + dim);
+    result.strides_.append(strides_.begin() + dim + 1, strides_.end());
+    return result;
+  }
+
+  StridedView narrow(int64_t dim, int64_t start, int64_t length) const {
+    AT_CHECK(this->dim() > 0, "narrow() cannot be applied to a 0-dim view");
+    dim = maybe_wrap_dim(dim, this->dim());
+    AT_CHECK(start >= 0 && length >= 0 && start + length <= sizes_[dim],
+             "narrow(): start (", start, ") + length (", length,
+             ") exceeds dimension size (", sizes_[dim], ")");
+    StridedView result = *this;
+    result.data_ += start * strides_[dim];
+    result.sizes_[dim] = length;
+    return result;
+  }
+
+  StridedView transpose(int64_t dim0, int64_t dim1) const {
+    dim0 = maybe_wrap_dim(dim0, dim());
+    dim1 = maybe_wrap_dim(dim1, dim());
+    StridedView result = *this;
+    std::swap(result.sizes_[dim0], result.sizes_[dim1]);
+    std::swap(result.strides_[dim0], result.strides_[dim1]);
+    return result;
+  }
+
+  StridedView unsqueeze(int64_t dim) const {
+    dim = maybe_wrap_dim(dim, this->dim() + 1);
+    StridedView result = *this;
+    const int64_t stride = dim >= this->dim() ? 1 : sizes_[dim] * strides_[dim];
+    result.sizes_.insert(result.sizes_.begin() + dim, 1);
+    result.strides_.insert(result.strides_.begin() + dim, stride);
+    return result;
+  }
+
+ private:
+  explicit StridedView(scalar_t* data) : data_(data) {}
+
+  scalar_t* data_;
+  DimVector sizes_;
+  DimVector strides_;
+};
+
+// Calls `op(n, counter)` for every row of `sizes` in row-major order, where
+// `n` is the size of the innermost dimension and `counter` the index of the
+// row in the outer dimensions.
+template <typename Op>
+void strided_apply_loop(IntArrayRef sizes, const Op& op) {
+  const int64_t ndim = sizes.size();
+  for (auto size : sizes) {
+    if (size == 0) {
+      return;
+    }
+  }
+  const int64_t inner_size = ndim > 0 ? sizes[ndim - 1] : 1;
+  DimVector counter(std::max<int64_t>(ndim - 1, 0), 0);
+  while (true) {
+    op(inner_size, counter);
+    // Advance the counter of the outer dimensions.
+    int64_t d = ndim - 2;
+    for (; d >= 0; --d) {
+      if (++counter[d] < sizes[d]) {
+        break;
+      }
+      counter[d] = 0;
+    }
+    if (d < 0) {
+      return;
+    }
+  }
+}
+
+inline int64_t strided_outer_offset(IntArrayRef strides, const DimVector& counter) {
+  int64_t offset = 0;
+  for (size_t d = 0; d < counter.size(); ++d) {
+    offset += counter[d] * strides[d];
+  }
+  return offset;
+}
+
+inline int64_t strided_inner_stride(IntArrayRef strides) {
+  return strides.empty() ? 0 : strides.back();
+}
+
+// Calls `op` on every element of `a`, like CPU_tensor_apply1.
+template <typename scalar1_t, typename Op>
+void strided_apply(const StridedView<scalar1_t>& a, const Op& op) {
+  const auto a_stride = strided_inner_stride(a.strides());
+  strided_apply_loop(a.sizes(), [&](int64_t n, const DimVector& counter) {
+    scalar1_t* a_ptr = a.data() + strided_outer_offset(a.strides(), counter);
+    for (int64_t i = 0; i < n; ++i) {
+      op(a_ptr[i * a_stride]);
+    }
+  });
+}
+
+// Calls `op` on the matching elements of `a` and `b`, like CPU_tensor_apply2.
+// The views must have the same sizes.
+template <typename scalar1_t, typename scalar2_t, typename Op>
+void strided_apply(const StridedView<scalar1_t>& a, const StridedView<scalar2_t>& b, const Op& op) {
+  AT_CHECK(a.sizes().equals(b.sizes()),
+           "strided_apply: sizes ", a.sizes(), " and ", b.sizes(), " do not match");
+  const auto a_stride = strided_inner_stride(a.strides());
+  const auto b_stride = strided_inner_stride(b.strides());
+  strided_apply_loop(a.sizes(), [&](int64_t n, const DimVector& counter) {
+    scalar1_t* a_ptr = a.data() + strided_outer_offset(a.strides(), counter);
+    scalar2_t* b_ptr = b.data() + strided_outer_offset(b.strides(), counter);
+    for (int64_t i = 0; i < n; ++i) {
+      op(a_ptr[i * a_stride], b_ptr[i * b_stride]);
+    }
+  });
+}
+
+}} // namespace at::native
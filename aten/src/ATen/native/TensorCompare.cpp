@@ -133,7 +133,7 @@ std::tuple<Tensor &,Tensor &> mode_out(Tensor& values, Tensor& indices,
 
 std::tuple<Tensor &,Tensor &> _max_out_cpu(Tensor& max, Tensor& max_indices,
                                         const Tensor& self, int64_t dim, bool keepdim) {
-  if (self.is_contiguous() && max.is_contiguous() && max_indices.is_contiguous()) {
+  if (max.is_contiguous() && max_indices.is_contiguous()) {
     _dimreduce_setup(max, self, dim);
     _dimreduce_setup(max_indices, self, dim);
     max_kernel(kCPU, max, max_indices, self, dim);
@@ -172,7 +172,7 @@ std::tuple<Tensor &,Tensor &> max_out(Tensor& max, Tensor& max_indices,
 
 std::tuple<Tensor &,Tensor &> _min_out_cpu(Tensor& min, Tensor& min_indices,
                                         const Tensor& self, int64_t dim, bool keepdim) {
-  if (self.is_contiguous() && min.is_contiguous() && min_indices.is_contiguous()) {
+  if (min.is_contiguous() && min_indices.is_contiguous()) {
     _dimreduce_setup(min, self, dim);
     _dimreduce_setup(min_indices, self, dim);
     min_kernel(kCPU, min, min_indices, self, dim);
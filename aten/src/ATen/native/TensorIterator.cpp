@@ -350,6 +350,16 @@ static loop2d_t loop_wrapper(const loop_t& loop) {
 }
 
 void TensorIterator::for_each(const loop_t& loop) {
+  int64_t numel = this->numel();
+  if (ndim() == 1 && numel > 0 &&
+      (numel < internal::GRAIN_SIZE || at::get_num_threads() == 1)) {
+    // Call the inner loop directly for 1-d iterations, like contiguous
+    // elementwise ops, instead of through the 2-d loop and a DimCounter.
+    auto ptrs = get_base_ptrs();
+    auto strides = get_inner_strides();
+    loop(ntensors(), ptrs.data(), strides.data(), numel);
+    return;
+  }
   for_each(loop_wrapper(loop));
 }
 
@@ -497,6 +507,25 @@ std::unique_ptr<TensorIterator> TensorIterator::reduce_op(Tensor& out, const Ten
   return builder.build();
 }
 
+std::unique_ptr<TensorIterator> TensorIterator::reduce_op(Tensor& out1, Tensor& out2, const Tensor& a) {
+  AT_ASSERT(out1.defined());
+  AT_ASSERT(out2.defined());
+  AT_CHECK(out1.sizes().equals(out2.sizes()) && out1.strides().equals(out2.strides()),
+      "reduce_op(): expected both outputs to have the same sizes and strides, but got ",
+      out1.sizes(), " and ", out2.sizes(), " with strides ", out1.strides(),
+      " and ", out2.strides());
+  auto builder = TensorIterator::Builder();
+  builder.add_output(out1);
+  builder.add_output(out2);
+  builder.add_input(a);
+  builder.iter_->promote_gpu_output_dtypes_ = true;
+  builder.iter_->resize_outputs_ = false;
+  builder.iter_->is_reduction_ = true;
+  // the outputs may have different dtypes, e.g. values and indices
+  builder.iter_->compute_common_dtype_ = false;
+  return builder.build();
+}
+
 void TensorIterator::mark_outputs() {
   for (int i = 0; i < num_outputs_; i++) {
     operands_[i].is_output = true;
@@ -513,6 +542,76 @@ void TensorIterator::mark_outputs() {
   }
 }
 
+// Sets up the iterator directly when every operand is contiguous with the same
+// shape, backend and dtype, except for scalar inputs that are broadcast. This
+// is the common case of elementwise ops, for which compute_shape(),
+// compute_strides(), reorder_dimensions(), compute_types() and
+// coalesce_dimensions() would end up with a single dimension anyway, and it
+// matters for small tensors. Returns false, and leaves the iterator
+// unchanged, if the operands need the general set up.
+bool TensorIterator::fast_set_up() {
+  if (is_reduction_) {
+    return false;
+  }
+  // Like compute_shape(), take the shape from the inputs only, and not from
+  // write-only outputs, which are resized to it.
+  const Tensor* first = nullptr;
+  for (auto& op : operands_) {
+    if (resize_outputs_ && op.is_output && !op.is_read_write) continue;
+    if (op.tensor.defined() && op.tensor.dim() > 0) {
+      first = &op.tensor;
+      break;
+    }
+  }
+  if (!first) {
+    return false;
+  }
+  auto shape = first->sizes();
+  auto backend = first->type().backend();
+  auto dtype = first->scalar_type();
+
+  for (auto& op : operands_) {
+    if (!op.tensor.defined()) {
+      // an output to allocate
+      if (op.is_type_defined() && !op.is_type_equal(backend, dtype)) {
+        return false;
+      }
+      continue;
+    }
+    auto op_backend = op.tensor.type().backend();
+    auto op_dtype = op.tensor.scalar_type();
+    if (!op.is_type_equal(op_backend, op_dtype) || op_backend != backend) {
+      return false;
+    }
+    if (!op.is_output && op.tensor.dim() == 0) {
+      // a scalar input, which compute_types() casts to the common dtype
+      if (op_dtype != dtype && !compute_common_dtype_) {
+        return false;
+      }
+      continue;
+    }
+    if (op_dtype != dtype || !op.tensor.sizes().equals(shape) ||
+        !op.tensor.is_contiguous()) {
+      return false;
+    }
+  }
+
+  for (auto& op : operands_) {
+    if (!op.tensor.defined()) {
+      op.set_type(backend, dtype);
+      op.tensor = at::empty(shape, op.options());
+    } else if (op.tensor.scalar_type() != dtype) {
+      op.set_type(backend, dtype);
+      op.tensor = op.tensor.to(op.options());
+    }
+    op.stride_bytes =
+        DimVector(1, op.tensor.dim() == 0 ? 0 : op.tensor.element_size());
+  }
+  shape_ = DimVector(1, first->numel());
+  has_coalesced_dimensions_ = true;
+  return true;
+}
+
 void TensorIterator::compute_shape() {
   for (auto& op : operands_) {
     if (!op.tensor.defined()) continue;
@@ -634,18 +733,21 @@ SplitUntil32Bit TensorIterator::with_32bit_indexing() const {
 std::unique_ptr<TensorIterator> TensorIterator::Builder::build() {
   // set is_output and is_read_write flags on appropriate tensors
   iter_->mark_outputs();
-  // compute the broadcasted shape
-  iter_->compute_shape();
-  // compute each tensor's stride after broadcasting
-  iter_->compute_strides();
-  // re-order dimensions to improve coalescing
-  iter_->reorder_dimensions();
-  // compute the result dtype and backend
-  iter_->compute_types();
-  // allocate the output tensor if it's not provided
-  iter_->allocate_outputs();
-  // coalesce adjacent dimensions when possible
-  iter_->coalesce_dimensions();
+  // contiguous operands of the same shape and type skip the steps below
+  if (!iter_->fast_set_up()) {
+    // compute the broadcasted shape
+    iter_->compute_shape();
+    // compute each tensor's stride after broadcasting
+    iter_->compute_strides();
+    // re-order dimensions to improve coalescing
+    iter_->reorder_dimensions();
+    // compute the result dtype and backend
+    iter_->compute_types();
+    // allocate the output tensor if it's not provided
+    iter_->allocate_outputs();
+    // coalesce adjacent dimensions when possible
+    iter_->coalesce_dimensions();
+  }
 
   for (auto& op : iter_->operands_) {
     AT_ASSERT(op.tensor.defined());
@@ -147,11 +147,15 @@ struct CAFFE2_API TensorIterator {
   static std::unique_ptr<TensorIterator> binary_op(Tensor& out, const Tensor& a, const Tensor& b);
   static std::unique_ptr<TensorIterator> unary_op(Tensor& out, const Tensor& a);
   static std::unique_ptr<TensorIterator> reduce_op(Tensor& out, const Tensor& a);
+  /// Reduction with two outputs of the same shape, which may have different
+  /// dtypes, such as the values and the indices of a max.
+  static std::unique_ptr<TensorIterator> reduce_op(Tensor& out1, Tensor& out2, const Tensor& a);
 
   int ndim() const { return shape_.size(); }
   IntArrayRef shape() const { return shape_; }
   int64_t numel() const;
   int ntensors() const { return operands_.size(); }
+  int noutputs() const { return num_outputs_; }
 
   /// number of elements in the output operand. this is the same as numel() for
   /// operations that are not reductions.
@@ -247,6 +251,7 @@ struct CAFFE2_API TensorIterator {
 
 protected:
   void mark_outputs();
+  bool fast_set_up();
   void compute_shape();
   void compute_strides();
   void reorder_dimensions();
@@ -117,7 +117,8 @@ static void parallel_dim_reduction(TensorIterator& iter, const loop2d_t& loop) {
 }
 
 void TensorIterator::foreach_reduced_elt(const loop_subiter_t &loop, bool parallelize) {
-  AT_ASSERT(ntensors() == 2 && num_outputs_ == 1);
+  AT_ASSERT(ntensors() - num_outputs_ == 1);
+  AT_ASSERT(num_outputs_ >= 1);
 
   auto shape = this->shape();
   if (tensor(0).numel() == 0) {
@@ -126,8 +127,12 @@ void TensorIterator::foreach_reduced_elt(const loop_subiter_t &loop, bool parall
   if (tensor(0).numel() == 1) {
     loop(*this);
   }
+  // With fewer outputs than threads, splitting the outputs would leave
+  // threads idle, so the outputs are reduced one after the other, and `loop`
+  // is free to split the reduction of each one.
   else if (numel() < at::internal::GRAIN_SIZE || at::get_num_threads() == 1 ||
-      at::in_parallel_region() || !parallelize) {
+      at::in_parallel_region() || !parallelize ||
+      tensor(0).numel() < at::get_num_threads()) {
     auto reduce_dims = num_reduce_dims();
 
     auto non_reduced_shape = shape.slice(reduce_dims, shape.size() - reduce_dims);
@@ -42,6 +42,12 @@ DECLARE_DISPATCH(unary_fn, trunc_stub);
 
 DECLARE_DISPATCH(void(*)(Tensor&, const double, Generator *), bernoulli_mkl_stub);
 
+// Counter-based samplers, see native/cpu/PhiloxRNG.h. The last argument is the
+// Philox key, drawn once per call from the CPU generator.
+DECLARE_DISPATCH(void(*)(Tensor&, double, double, uint64_t), uniform_philox_stub);
+DECLARE_DISPATCH(void(*)(Tensor&, double, double, uint64_t), normal_philox_stub);
+DECLARE_DISPATCH(void(*)(Tensor&, double, uint64_t), bernoulli_philox_stub);
+
 // Missing unary functions
 // digamma
 // lgamma
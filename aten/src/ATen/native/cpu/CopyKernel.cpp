@@ -7,11 +7,298 @@
 #include <ATen/native/TensorIterator.h>
 #include <ATen/native/cpu/Loops.h>
 #include <ATen/native/Copy.h>
+#include <ATen/Parallel.h>
 
 namespace at {
 namespace native {
 namespace {
 
+// Copies of a non-contiguous tensor to a contiguous one smaller than this go
+// through TensorIterator.
+constexpr int64_t PERMUTE_MIN_NUMEL = 4096;
+
+// Transposes a square tile of `width()` x `width()` elements held in
+// registers. src holds the rows of the tile with a leading dimension of
+// ld_src, and dst receives its columns with a leading dimension of ld_dst.
+// width() is 0 when there is no such kernel for the element type.
+template <typename T>
+struct TransposeMicroKernel {
+  static constexpr int64_t width() {
+    return 0;
+  }
+  static void run(const T* src, int64_t ld_src, T* dst, int64_t ld_dst) {}
+};
+
+#if defined(__AVX__) && !defined(_MSC_VER)
+
+template <>
+struct TransposeMicroKernel<uint32_t> {
+  static constexpr int64_t width() {
+    return 8;
+  }
+  static void run(
+      const uint32_t* src,
+      int64_t ld_src,
+      uint32_t* dst,
+      int64_t ld_dst) {
+    // The shuffles only move bits around, so going through floats is exact
+    // for any 32-bit element.
+    const float* s = reinterpret_cast<const float*>(src);
+    float* d = reinterpret_cast<float*>(dst);
+    __m256 r0 = _mm256_loadu_ps(s + 0 * ld_src);
+    __m256 r1 = _mm256_loadu_ps(s + 1 * ld_src);
+    __m256 r2 = _mm256_loadu_ps(s + 2 * ld_src);
+    __m256 r3 = _mm256_loadu_ps(s + 3 * ld_src);
+    __m256 r4 = _mm256_loadu_ps(s + 4 * ld_src);
+    __m256 r5 = _mm256_loadu_ps(s + 5 * ld_src);
+    __m256 r6 = _mm256_loadu_ps(s + 6 * ld_src);
+    __m256 r7 = _mm256_loadu_ps(s + 7 * ld_src);
+
+    __m256 t0 = _mm256_unpacklo_ps(r0, r1);
+    __m256 t1 = _mm256_unpackhi_ps(r0, r1);
+    __m256 t2 = _mm256_unpacklo_ps(r2, r3);
+    __m256 t3 = _mm256_unpackhi_ps(r2, r3);
+    __m256 t4 = _mm256_unpacklo_ps(r4, r5);
+    __m256 t5 = _mm256_unpackhi_ps(r4, r5);
+    __m256 t6 = _mm256_unpacklo_ps(r6, r7);
+    __m256 t7 = _mm256_unpackhi_ps(r6, r7);
+
+    __m256 u0 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+    __m256 u1 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+    __m256 u2 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+    __m256 u3 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+    __m256 u4 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(1, 0, 1, 0));
+    __m256 u5 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(3, 2, 3, 2));
+    __m256 u6 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(1, 0, 1, 0));
+    __m256 u7 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(3, 2, 3, 2));
+
+    _mm256_storeu_ps(d + 0 * ld_dst, _mm256_permute2f128_ps(u0, u4, 0x20));
+    _mm256_storeu_ps(d + 1 * ld_dst, _mm256_permute2f128_ps(u1, u5, 0x20));
+    _mm256_storeu_ps(d + 2 * ld_dst, _mm256_permute2f128_ps(u2, u6, 0x20));
+    _mm256_storeu_ps(d + 3 * ld_dst, _mm256_permute2f128_ps(u3, u7, 0x20));
+    _mm256_storeu_ps(d + 4 * ld_dst, _mm256_permute2f128_ps(u0, u4, 0x31));
+    _mm256_storeu_ps(d + 5 * ld_dst, _mm256_permute2f128_ps(u1, u5, 0x31));
+    _mm256_storeu_ps(d + 6 * ld_dst, _mm256_permute2f128_ps(u2, u6, 0x31));
+    _mm256_storeu_ps(d + 7 * ld_dst, _mm256_permute2f128_ps(u3, u7, 0x31));
+  }
+};
+
+template <>
+struct TransposeMicroKernel<uint64_t> {
+  static constexpr int64_t width() {
+    return 4;
+  }
+  static void run(
+      const uint64_t* src,
+      int64_t ld_src,
+      uint64_t* dst,
+      int64_t ld_dst) {
+    const double* s = reinterpret_cast<const double*>(src);
+    double* d = reinterpret_cast<double*>(dst);
+    __m256d r0 = _mm256_loadu_pd(s + 0 * ld_src);
+    __m256d r1 = _mm256_loadu_pd(s + 1 * ld_src);
+    __m256d r2 = _mm256_loadu_pd(s + 2 * ld_src);
+    __m256d r3 = _mm256_loadu_pd(s + 3 * ld_src);
+
+    __m256d t0 = _mm256_unpacklo_pd(r0, r1);
+    __m256d t1 = _mm256_unpackhi_pd(r0, r1);
+    __m256d t2 = _mm256_unpacklo_pd(r2, r3);
+    __m256d t3 = _mm256_unpackhi_pd(r2, r3);
+
+    _mm256_storeu_pd(d + 0 * ld_dst, _mm256_permute2f128_pd(t0, t2, 0x20));
+    _mm256_storeu_pd(d + 1 * ld_dst, _mm256_permute2f128_pd(t1, t3, 0x20));
+    _mm256_storeu_pd(d + 2 * ld_dst, _mm256_permute2f128_pd(t0, t2, 0x31));
+    _mm256_storeu_pd(d + 3 * ld_dst, _mm256_permute2f128_pd(t1, t3, 0x31));
+  }
+};
+
+#endif
+
+// Copies a rows x cols tile to dst, whose rows are contiguous with a leading
+// dimension of ld_dst, from src, whose rows and columns have the strides
+// src_row_stride and src_col_stride. The tiles come from transposes, where
+// src_row_stride is usually 1.
+template <typename T>
+void copy_tile(
+    const T* src,
+    int64_t src_row_stride,
+    int64_t src_col_stride,
+    T* dst,
+    int64_t ld_dst,
+    int64_t rows,
+    int64_t cols) {
+  using Micro = TransposeMicroKernel<T>;
+  constexpr int64_t w = Micro::width();
+  int64_t r = 0;
+  if (w > 0 && src_row_stride == 1) {
+    for (; r + w <= rows; r += w) {
+      int64_t c = 0;
+      for (; c + w <= cols; c += w) {
+        Micro::run(
+            src + r + c * src_col_stride,
+            src_col_stride,
+            dst + r * ld_dst + c,
+            ld_dst);
+      }
+      for (int64_t rr = r; rr < r + w; rr++) {
+        for (int64_t cc = c; cc < cols; cc++) {
+          dst[rr * ld_dst + cc] = src[rr + cc * src_col_stride];
+        }
+      }
+    }
+  }
+  for (; r < rows; r++) {
+    for (int64_t c = 0; c < cols; c++) {
+      dst[r * ld_dst + c] = src[r * src_row_stride + c * src_col_stride];
+    }
+  }
+}
+
+// Copies a tensor with the given sizes and strides to the contiguous buffer
+// dst. dim is the dimension of src with the smallest stride, and the last
+// dimension is the contiguous one of dst. The two dimensions are traversed by
+// square tiles that fit in L1, so that both the reads and the writes of a
+// tile hit a few cache lines, and the tiles of all the other dimensions are
+// spread over the threads.
+template <typename T>
+void permute_copy(
+    T* dst,
+    const T* src,
+    const DimVector& sizes,
+    const DimVector& strides,
+    int64_t dim) {
+  const int64_t ndim = sizes.size();
+  const int64_t last = ndim - 1;
+  constexpr int64_t block = sizeof(T) <= 4 ? 64 : 32;
+
+  DimVector dst_strides(ndim, 0);
+  int64_t numel = 1;
+  for (int64_t i = last; i >= 0; i--) {
+    dst_strides[i] = numel;
+    numel *= sizes[i];
+  }
+
+  const int64_t rows = sizes[dim];
+  const int64_t cols = sizes[last];
+  const int64_t row_tiles = (rows + block - 1) / block;
+  const int64_t col_tiles = (cols + block - 1) / block;
+  const int64_t num_tiles = numel / (rows * cols) * row_tiles * col_tiles;
+
+  const int64_t grain_size =
+      std::max<int64_t>(1, internal::GRAIN_SIZE / (block * block));
+  at::parallel_for(0, num_tiles, grain_size, [&](int64_t begin, int64_t end) {
+    for (int64_t tile = begin; tile < end; tile++) {
+      int64_t index = tile;
+      const int64_t c0 = (index % col_tiles) * block;
+      index /= col_tiles;
+      const int64_t r0 = (index % row_tiles) * block;
+      index /= row_tiles;
+
+      int64_t src_offset = r0 * strides[dim] + c0 * strides[last];
+      int64_t dst_offset = r0 * dst_strides[dim] + c0;
+      for (int64_t i = last - 1; i >= 0; i--) {
+        if (i == dim) {
+          continue;
+        }
+        const int64_t idx = index % sizes[i];
+        index /= sizes[i];
+        src_offset += idx * strides[i];
+        dst_offset += idx * dst_strides[i];
+      }
+
+      copy_tile(
+          src + src_offset,
+          strides[dim],
+          strides[last],
+          dst + dst_offset,
+          dst_strides[dim],
+          std::min(block, rows - r0),
+          std::min(block, cols - c0));
+    }
+  });
+}
+
+// Copies src to self through permute_copy when self is contiguous and src is
+// a permutation, possibly of a slice, of a contiguous tensor, such as a
+// transposed matrix or an NHWC view of an NCHW tensor. Returns false when
+// the copy is better left to TensorIterator.
+//
+// self may have another shape than src, as long as they have the same number
+// of elements, since _copy_same_type_ copies in the order of the elements of
+// src.
+bool copy_permute(Tensor& self, const Tensor& src) {
+  const int64_t numel = src.numel();
+  if (numel < PERMUTE_MIN_NUMEL || self.numel() != numel ||
+      !self.is_contiguous() || src.is_contiguous()) {
+    return false;
+  }
+
+  // Drops the dimensions of size 1, and merges the dimensions that are
+  // contiguous with each other in src, as they are in self.
+  DimVector sizes;
+  DimVector strides;
+  for (int64_t i = 0; i < src.dim(); i++) {
+    const int64_t size = src.size(i);
+    const int64_t stride = src.stride(i);
+    if (size == 1) {
+      continue;
+    }
+    if (stride == 0) {
+      // Expanded tensors are not worth it.
+      return false;
+    }
+    if (!sizes.empty() && strides.back() == stride * size) {
+      sizes.back() *= size;
+      strides.back() = stride;
+    } else {
+      sizes.push_back(size);
+      strides.push_back(stride);
+    }
+  }
+
+  // The dimensions with the worst mismatch are the last one, which is
+  // contiguous in self, and the one with the smallest stride in src.
+  const int64_t last = sizes.size() - 1;
+  int64_t dim = last;
+  for (int64_t i = 0; i < last; i++) {
+    if (strides[i] < strides[dim]) {
+      dim = i;
+    }
+  }
+  if (dim == last) {
+    return false;
+  }
+
+  switch (self.element_size()) {
+    case 1:
+      permute_copy(
+          static_cast<uint8_t*>(self.data_ptr()),
+          static_cast<const uint8_t*>(src.data_ptr()),
+          sizes, strides, dim);
+      return true;
+    case 2:
+      permute_copy(
+          static_cast<uint16_t*>(self.data_ptr()),
+          static_cast<const uint16_t*>(src.data_ptr()),
+          sizes, strides, dim);
+      return true;
+    case 4:
+      permute_copy(
+          static_cast<uint32_t*>(self.data_ptr()),
+          static_cast<const uint32_t*>(src.data_ptr()),
+          sizes, strides, dim);
+      return true;
+    case 8:
+      permute_copy(
+          static_cast<uint64_t*>(self.data_ptr()),
+          static_cast<const uint64_t*>(src.data_ptr()),
+          sizes, strides, dim);
+      return true;
+    default:
+      return false;
+  }
+}
+
 template <typename self_T>
 void copy_kernel_cast_t_impl(Tensor& self, const Tensor& src) {
   auto builder = TensorIterator::Builder();
@@ -40,6 +327,10 @@ static void copy_kernel_cast_impl(Tensor& self, const Tensor& src) {
 }
 
 static void copy_kernel_same_type_impl(Tensor& self, const Tensor& src) {
+  if (copy_permute(self, src)) {
+    return;
+  }
+
   auto builder = TensorIterator::Builder();
   builder.add_output(self);
   builder.add_input(src);
@@ -0,0 +1,132 @@
+#include <ATen/native/UnaryOps.h>
+
+#include <algorithm>
+#include <cmath>
+
+#include <ATen/Dispatch.h>
+#include <ATen/Parallel.h>
+#include <ATen/cpu/vec256/vec256.h>
+#include <ATen/native/cpu/PhiloxRNG.h>
+
+namespace at { namespace native {
+namespace {
+
+// Number of samples generated per call into Philox4x32::fill, sized so that
+// the random words of a block stay on the stack.
+constexpr int64_t kSampleBlock = 256;
+
+// The normal sampler works on blocks of 16 samples: Box-Muller turns the
+// uniforms 0-7 and 8-15 of a block into the normal samples 0-7 (cosine part)
+// and 8-15 (sine part). Parallel chunks always cover whole blocks.
+constexpr int64_t kNormalBlock = 16;
+
+template <typename scalar_t>
+void uniform_philox(Tensor& self, double from, double to, uint64_t seed) {
+  constexpr int64_t words_per_sample = PhiloxWordsPerSample<scalar_t>::value;
+  const Philox4x32 philox(seed);
+  const scalar_t from_ = static_cast<scalar_t>(from);
+  const scalar_t range = static_cast<scalar_t>(to - from);
+  scalar_t* data = self.data<scalar_t>();
+  parallel_for(
+      0, self.numel(), internal::GRAIN_SIZE / 4, [&](int64_t begin, int64_t end) {
+        uint32_t words[kSampleBlock * words_per_sample];
+        for (int64_t i = begin; i < end; i += kSampleBlock) {
+          const int64_t n = std::min(kSampleBlock, end - i);
+          philox.fill(i * words_per_sample, n * words_per_sample, words);
+          for (int64_t j = 0; j < n; ++j) {
+            data[i + j] =
+                philox_uniform<scalar_t>(words + j * words_per_sample) * range +
+                from_;
+          }
+        }
+      });
+}
+
+template <typename scalar_t>
+void normal_philox(Tensor& self, double mean, double std, uint64_t seed) {
+  using Vec = vec256::Vec256<scalar_t>;
+  constexpr int64_t words_per_sample = PhiloxWordsPerSample<scalar_t>::value;
+  constexpr int64_t half = kNormalBlock / 2;
+  static_assert(
+      half % Vec::size() == 0,
+      "normal block must be a multiple of the vector width");
+  const Philox4x32 philox(seed);
+  const Vec mean_vec(static_cast<scalar_t>(mean));
+  const Vec std_vec(static_cast<scalar_t>(std));
+  const Vec one(static_cast<scalar_t>(1));
+  const Vec minus_two(static_cast<scalar_t>(-2));
+  const Vec two_pi(static_cast<scalar_t>(2 * M_PI));
+  scalar_t* data = self.data<scalar_t>();
+  const int64_t numel = self.numel();
+  const int64_t num_blocks = divup(numel, kNormalBlock);
+  parallel_for(
+      0, num_blocks, internal::GRAIN_SIZE / (4 * kNormalBlock),
+      [&](int64_t begin, int64_t end) {
+        uint32_t words[kNormalBlock * words_per_sample];
+        scalar_t uniform[kNormalBlock];
+        scalar_t normal[kNormalBlock];
+        for (int64_t b = begin; b < end; ++b) {
+          philox.fill(
+              b * kNormalBlock * words_per_sample,
+              kNormalBlock * words_per_sample,
+              words);
+          for (int64_t j = 0; j < kNormalBlock; ++j) {
+            uniform[j] = philox_uniform<scalar_t>(words + j * words_per_sample);
+          }
+          for (int64_t j = 0; j < half; j += Vec::size()) {
+            // 1 - u lies in (0, 1], which keeps the logarithm finite.
+            const Vec u1 = one - Vec::loadu(uniform + j);
+            const Vec u2 = Vec::loadu(uniform + half + j);
+            const Vec radius = (minus_two * u1.log()).sqrt();
+            const Vec theta = two_pi * u2;
+            (radius * theta.cos() * std_vec + mean_vec).store(normal + j);
+            (radius * theta.sin() * std_vec + mean_vec).store(normal + half + j);
+          }
+          const int64_t offset = b * kNormalBlock;
+          const int64_t n = std::min(kNormalBlock, numel - offset);
+          std::copy(normal, normal + n, data + offset);
+        }
+      });
+}
+
+void uniform_philox_kernel(Tensor& self, double from, double to, uint64_t seed) {
+  AT_DISPATCH_FLOATING_TYPES(self.scalar_type(), "uniform_philox_cpu", [&] {
+    uniform_philox<scalar_t>(self, from, to, seed);
+  });
+}
+
+void normal_philox_kernel(Tensor& self, double mean, double std, uint64_t seed) {
+  AT_DISPATCH_FLOATING_TYPES(self.scalar_type(), "normal_philox_cpu", [&] {
+    normal_philox<scalar_t>(self, mean, std, seed);
+  });
+}
+
+void bernoulli_philox_kernel(Tensor& self, double p, uint64_t seed) {
+  // Bernoulli samples always compare against a double uniform, like
+  // THRandom_bernoulli, so that small p are honored for every output dtype.
+  constexpr int64_t words_per_sample = PhiloxWordsPerSample<double>::value;
+  const Philox4x32 philox(seed);
+  AT_DISPATCH_ALL_TYPES(self.scalar_type(), "bernoulli_philox_cpu", [&] {
+    scalar_t* data = self.data<scalar_t>();
+    parallel_for(
+        0, self.numel(), internal::GRAIN_SIZE / 4, [&](int64_t begin, int64_t end) {
+          uint32_t words[kSampleBlock * words_per_sample];
+          for (int64_t i = begin; i < end; i += kSampleBlock) {
+            const int64_t n = std::min(kSampleBlock, end - i);
+            philox.fill(i * words_per_sample, n * words_per_sample, words);
+            for (int64_t j = 0; j < n; ++j) {
+              data[i + j] = static_cast<scalar_t>(
+                  philox_uniform<double>(words + j * words_per_sample) < p);
+            }
+          }
+        });
+  });
+}
+
+} // anonymous namespace
+
+REGISTER_DISPATCH(uniform_philox_stub, &uniform_philox_kernel);
+REGISTER_DISPATCH(normal_philox_stub, &normal_philox_kernel);
+REGISTER_DISPATCH(bernoulli_philox_stub, &bernoulli_philox_kernel);
+
+}} // namespace at::native
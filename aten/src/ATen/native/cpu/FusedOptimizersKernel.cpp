@@ -0,0 +1,228 @@
+#include <ATen/native/FusedOptimizers.h>
+
+#include <algorithm>
+#include <vector>
+
+#include <ATen/Dispatch.h>
+#include <ATen/Parallel.h>
+#include <ATen/cpu/vec256/vec256.h>
+
+namespace at { namespace native { namespace {
+
+// Number of elements updated by a single task. Large parameters are split into
+// several chunks so that the work is balanced across threads, small
+// parameters make up one chunk each.
+constexpr int64_t kChunkSize = 16384;
+
+struct TensorChunk {
+  size_t tensor;
+  int64_t begin;
+  int64_t end;
+};
+
+// Calls f(tensor_index, begin, end) for every chunk of every tensor in
+// `params`, distributing all chunks over the thread pool with a single
+// parallel_for.
+template <typename F>
+void multi_tensor_apply(TensorList params, const F& f) {
+  std::vector<TensorChunk> chunks;
+  int64_t total_numel = 0;
+  for (size_t t = 0; t < params.size(); ++t) {
+    const int64_t numel = params[t].numel();
+    for (int64_t begin = 0; begin < numel; begin += kChunkSize) {
+      chunks.push_back({t, begin, std::min(numel, begin + kChunkSize)});
+    }
+    total_numel += numel;
+  }
+  const int64_t num_chunks = chunks.size();
+  // Only fan out if the update as a whole is worth it.
+  const int64_t grain_size =
+      total_numel < internal::GRAIN_SIZE ? num_chunks + 1 : 1;
+  parallel_for(0, num_chunks, grain_size, [&](int64_t begin, int64_t end) {
+    for (int64_t c = begin; c < end; ++c) {
+      const auto& chunk = chunks[c];
+      f(chunk.tensor, chunk.begin, chunk.end);
+    }
+  });
+}
+
+template <typename scalar_t>
+inline scalar_t* data_or_null(TensorList tensors, size_t index) {
+  return tensors.empty() ? nullptr : tensors[index].data<scalar_t>();
+}
+
+void fused_sgd_kernel(
+    TensorList params,
+    TensorList grads,
+    TensorList momentum_buffers,
+    const FusedSGDOptions& options) {
+  AT_DISPATCH_FLOATING_TYPES(params[0].scalar_type(), "fused_sgd", [&] {
+    using Vec = vec256::Vec256<scalar_t>;
+    const bool use_momentum = options.momentum != 0;
+    const Vec lr(static_cast<scalar_t>(options.learning_rate));
+    const Vec momentum(static_cast<scalar_t>(options.momentum));
+    const Vec dampening(static_cast<scalar_t>(options.dampening));
+    const Vec weight_decay(static_cast<scalar_t>(options.weight_decay));
+    multi_tensor_apply(params, [&](size_t t, int64_t begin, int64_t end) {
+      scalar_t* param = params[t].data<scalar_t>();
+      const scalar_t* grad = grads[t].data<scalar_t>();
+      scalar_t* buf = data_or_null<scalar_t>(momentum_buffers, t);
+      for (int64_t i = begin; i < end; i += Vec::size()) {
+        const int64_t n = std::min<int64_t>(Vec::size(), end - i);
+        Vec p = Vec::loadu(param + i, n);
+        Vec update = Vec::loadu(grad + i, n);
+        if (options.weight_decay > 0) {
+          update = update + weight_decay * p;
+        }
+        if (use_momentum) {
+          Vec b = momentum * Vec::loadu(buf + i, n) + dampening * update;
+          b.store(buf + i, n);
+          update = options.nesterov ? update + momentum * b : b;
+        }
+        p = p - lr * update;
+        p.store(param + i, n);
+      }
+    });
+  });
+}
+
+void fused_adam_kernel(
+    TensorList params,
+    TensorList grads,
+    TensorList exp_avgs,
+    TensorList exp_avg_sqs,
+    TensorList max_exp_avg_sqs,
+    ArrayRef<double> step_sizes,
+    const FusedAdamOptions& options) {
+  AT_DISPATCH_FLOATING_TYPES(params[0].scalar_type(), "fused_adam", [&] {
+    using Vec = vec256::Vec256<scalar_t>;
+    const Vec beta1(static_cast<scalar_t>(options.beta1));
+    const Vec one_minus_beta1(static_cast<scalar_t>(1 - options.beta1));
+    const Vec beta2(static_cast<scalar_t>(options.beta2));
+    const Vec one_minus_beta2(static_cast<scalar_t>(1 - options.beta2));
+    const Vec eps(static_cast<scalar_t>(options.eps));
+    const Vec weight_decay(static_cast<scalar_t>(options.weight_decay));
+    multi_tensor_apply(params, [&](size_t t, int64_t begin, int64_t end) {
+      scalar_t* param = params[t].data<scalar_t>();
+      const scalar_t* grad = grads[t].data<scalar_t>();
+      scalar_t* exp_avg = exp_avgs[t].data<scalar_t>();
+      scalar_t* exp_avg_sq = exp_avg_sqs[t].data<scalar_t>();
+      scalar_t* max_exp_avg_sq = data_or_null<scalar_t>(max_exp_avg_sqs, t);
+      const Vec step_size(static_cast<scalar_t>(step_sizes[t]));
+      for (int64_t i = begin; i < end; i += Vec::size()) {
+        const int64_t n = std::min<int64_t>(Vec::size(), end - i);
+        Vec p = Vec::loadu(param + i, n);
+        Vec g = Vec::loadu(grad + i, n);
+        if (options.weight_decay > 0) {
+          g = g + weight_decay * p;
+        }
+        const Vec m = beta1 * Vec::loadu(exp_avg + i, n) + one_minus_beta1 * g;
+        const Vec v =
+            beta2 * Vec::loadu(exp_avg_sq + i, n) + one_minus_beta2 * g * g;
+        m.store(exp_avg + i, n);
+        v.store(exp_avg_sq + i, n);
+        Vec denom = v;
+        if (options.amsgrad) {
+          denom = vec256::maximum(Vec::loadu(max_exp_avg_sq + i, n), v);
+          denom.store(max_exp_avg_sq + i, n);
+        }
+        p = p - step_size * m / (denom.sqrt() + eps);
+        p.store(param + i, n);
+      }
+    });
+  });
+}
+
+void fused_adagrad_kernel(
+    TensorList params,
+    TensorList grads,
+    TensorList sums,
+    ArrayRef<double> learning_rates,
+    const FusedAdagradOptions& options) {
+  AT_DISPATCH_FLOATING_TYPES(params[0].scalar_type(), "fused_adagrad", [&] {
+    using Vec = vec256::Vec256<scalar_t>;
+    const Vec eps(static_cast<scalar_t>(options.eps));
+    const Vec weight_decay(static_cast<scalar_t>(options.weight_decay));
+    multi_tensor_apply(params, [&](size_t t, int64_t begin, int64_t end) {
+      scalar_t* param = params[t].data<scalar_t>();
+      const scalar_t* grad = grads[t].data<scalar_t>();
+      scalar_t* sum = sums[t].data<scalar_t>();
+      const Vec lr(static_cast<scalar_t>(learning_rates[t]));
+      for (int64_t i = begin; i < end; i += Vec::size()) {
+        const int64_t n = std::min<int64_t>(Vec::size(), end - i);
+        Vec p = Vec::loadu(param + i, n);
+        Vec g = Vec::loadu(grad + i, n);
+        if (options.weight_decay > 0) {
+          g = g + weight_decay * p;
+        }
+        const Vec s = Vec::loadu(sum + i, n) + g * g;
+        s.store(sum + i, n);
+        p = p - lr * g / (s.sqrt() + eps);
+        p.store(param + i, n);
+      }
+    });
+  });
+}
+
+void fused_rmsprop_kernel(
+    TensorList params,
+    TensorList grads,
+    TensorList square_avgs,
+    TensorList momentum_buffers,
+    TensorList grad_avgs,
+    const FusedRMSpropOptions& options) {
+  AT_DISPATCH_FLOATING_TYPES(params[0].scalar_type(), "fused_rmsprop", [&] {
+    using Vec = vec256::Vec256<scalar_t>;
+    const bool use_momentum = options.momentum > 0;
+    const Vec lr(static_cast<scalar_t>(options.learning_rate));
+    const Vec alpha(static_cast<scalar_t>(options.alpha));
+    const Vec one_minus_alpha(static_cast<scalar_t>(1 - options.alpha));
+    const Vec eps(static_cast<scalar_t>(options.eps));
+    const Vec momentum(static_cast<scalar_t>(options.momentum));
+    const Vec weight_decay(static_cast<scalar_t>(options.weight_decay));
+    multi_tensor_apply(params, [&](size_t t, int64_t begin, int64_t end) {
+      scalar_t* param = params[t].data<scalar_t>();
+      const scalar_t* grad = grads[t].data<scalar_t>();
+      scalar_t* square_avg = square_avgs[t].data<scalar_t>();
+      scalar_t* buf = data_or_null<scalar_t>(momentum_buffers, t);
+      scalar_t* grad_avg = data_or_null<scalar_t>(grad_avgs, t);
+      for (int64_t i = begin; i < end; i += Vec::size()) {
+        const int64_t n = std::min<int64_t>(Vec::size(), end - i);
+        Vec p = Vec::loadu(param + i, n);
+        Vec g = Vec::loadu(grad + i, n);
+        if (options.weight_decay > 0) {
+          g = g + weight_decay * p;
+        }
+        const Vec sq =
+            alpha * Vec::loadu(square_avg + i, n) + one_minus_alpha * g * g;
+        sq.store(square_avg + i, n);
+        Vec avg;
+        if (options.centered) {
+          const Vec ga =
+              alpha * Vec::loadu(grad_avg + i, n) + one_minus_alpha * g;
+          ga.store(grad_avg + i, n);
+          avg = (sq - ga * ga).sqrt() + eps;
+        } else {
+          avg = sq.sqrt() + eps;
+        }
+        if (use_momentum) {
+          const Vec b = momentum * Vec::loadu(buf + i, n) + g / avg;
+          b.store(buf + i, n);
+          p = p - lr * b;
+        } else {
+          p = p - lr * g / avg;
+        }
+        p.store(param + i, n);
+      }
+    });
+  });
+}
+
+} // anonymous namespace
+
+REGISTER_DISPATCH(fused_sgd_stub, &fused_sgd_kernel);
+REGISTER_DISPATCH(fused_adam_stub, &fused_adam_kernel);
+REGISTER_DISPATCH(fused_adagrad_stub, &fused_adagrad_kernel);
+REGISTER_DISPATCH(fused_rmsprop_stub, &fused_rmsprop_kernel);
+
+}} // namespace at::native
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <cstdint>
+
+// Philox4x32-10 counter-based random number generator, see
+// Salmon et al., "Parallel Random Numbers: As Easy as 1, 2, 3" (SC'11).
+//
+// Unlike the mt19937 generator behind THGenerator, Philox has no sequential
+// state: the 4 random words for counter `c` are a pure function of the key
+// and `c`. A random stream can therefore be split at any offset, so that the
+// chunks of a parallel_for generate their part of a tensor independently and
+// the result does not depend on how the work was split between threads.
+//
+// The CPU samplers draw a fresh 64 bit key from the (locked) default generator
+// once per call and then address the random stream by element index, which
+// keeps manual_seed and get/set_rng_state working as before.
+
+namespace at { namespace native { namespace {
+
+class Philox4x32 {
+ public:
+  explicit Philox4x32(uint64_t seed)
+      : key0_(static_cast<uint32_t>(seed)),
+        key1_(static_cast<uint32_t>(seed >> 32)) {}
+
+  // Writes the 4 random words at counter `counter` to `out`.
+  inline void operator()(uint64_t counter, uint32_t* out) const {
+    uint32_t c0 = static_cast<uint32_t>(counter);
+    uint32_t c1 = static_cast<uint32_t>(counter >> 32);
+    uint32_t c2 = 0;
+    uint32_t c3 = 0;
+    uint32_t k0 = key0_;
+    uint32_t k1 = key1_;
+    for (int round = 0; round < 10; ++round) {
+      if (round > 0) {
+        k0 += kPhiloxW32A;
+        k1 += kPhiloxW32B;
+      }
+      const uint64_t p0 = static_cast<uint64_t>(kPhiloxM4x32A) * c0;
+      const uint64_t p1 = static_cast<uint64_t>(kPhiloxM4x32B) * c2;
+      const uint32_t hi0 = static_cast<uint32_t>(p0 >> 32);
+      const uint32_t lo0 = static_cast<uint32_t>(p0);
+      const uint32_t hi1 = static_cast<uint32_t>(p1 >> 32);
+      const uint32_t lo1 = static_cast<uint32_t>(p1);
+      c0 = hi1 ^ c1 ^ k0;
+      c1 = lo1;
+      c2 = hi0 ^ c3 ^ k1;
+      c3 = lo0;
+    }
+    out[0] = c0;
+    out[1] = c1;
+    out[2] = c2;
+    out[3] = c3;
+  }
+
+  // Fills `out` with the words [offset, offset + n) of the random stream,
+  // where word i is output i % 4 of counter i / 4.
+  inline void fill(uint64_t offset, int64_t n, uint32_t* out) const {
+    uint32_t block[4];
+    int64_t i = 0;
+    // Leading words up to the next counter boundary.
+    if (offset % 4 != 0) {
+      (*this)(offset / 4, block);
+      for (uint64_t w = offset % 4; w < 4 && i < n; ++w) {
+        out[i++] = block[w];
+      }
+    }
+    uint64_t counter = (offset + i) / 4;
+    for (; i + 4 <= n; i += 4) {
+      (*this)(counter++, out + i);
+    }
+    if (i < n) {
+      (*this)(counter, block);
+      for (int w = 0; i < n; ++w) {
+        out[i++] = block[w];
+      }
+    }
+  }
+
+ private:
+  static constexpr uint32_t kPhiloxW32A = 0x9E3779B9;
+  static constexpr uint32_t kPhiloxW32B = 0xBB67AE85;
+  static constexpr uint32_t kPhiloxM4x32A = 0xD2511F53;
+  static constexpr uint32_t kPhiloxM4x32B = 0xCD9E8D57;
+
+  uint32_t key0_;
+  uint32_t key1_;
+};
+
+// Number of 32 bit random words consumed per uniform sample of type scalar_t.
+template <typename scalar_t>
+struct PhiloxWordsPerSample {
+  static constexpr int64_t value = 2;
+};
+template <>
+struct PhiloxWordsPerSample<float> {
+  static constexpr int64_t value = 1;
+};
+
+// Maps the random words of one sample to a uniform value in [0, 1).
+template <typename scalar_t>
+inline scalar_t philox_uniform(const uint32_t* words) {
+  const uint64_t bits =
+      ((static_cast<uint64_t>(words[0]) << 32) | words[1]) >> 11;
+  return static_cast<scalar_t>(bits * (1.0 / (UINT64_C(1) << 53)));
+}
+template <>
+inline float philox_uniform<float>(const uint32_t* words) {
+  return (words[0] >> 8) * (1.0f / (1u << 24));
+}
+
+}}} // namespace at::native::<anonymous>
@@ -4,7 +4,10 @@
 #include <ATen/Parallel.h>
 #include <c10/util/TypeList.h>
 
+#include <limits>
 #include <sstream>
+#include <tuple>
+#include <type_traits>
 
 namespace at { namespace native { namespace {
 
@@ -25,12 +28,95 @@ static inline bool is_outer_reduction(const int64_t* strides) {
          strides[3] == sizeof(typename traits::arg2_t);
 }
 
+// The largest and the smallest values of T, infinities included, which are
+// the identities of min and max.
+template <typename T>
+static inline T upper_bound() {
+  using lim = std::numeric_limits<T>;
+  return lim::has_infinity ? lim::infinity() : lim::max();
+}
+
+template <typename T>
+static inline T lower_bound() {
+  using lim = std::numeric_limits<T>;
+  return lim::has_infinity ? -lim::infinity() : lim::lowest();
+}
+
 template <typename T, typename... Args>
 struct all_same : c10::guts::conjunction<
   std::is_same<T, Args>...
 > {};
 
-// data_t is the input/output data type.
+// Writes the result of `project` to the outputs of the reduction: one value
+// per output, or a tuple with an element per output.
+template <typename res_t>
+static inline void set_results(const res_t result, const TensorIterator& iter) {
+  AT_ASSERT(iter.noutputs() == 1);
+  *(res_t*)iter.data_ptr(0) = result;
+}
+
+template <std::size_t i = 0, typename... res_t>
+static inline typename std::enable_if<i == sizeof...(res_t), void>::type
+set_results(const std::tuple<res_t...>& result, const TensorIterator& iter) {
+  AT_ASSERT(iter.noutputs() == sizeof...(res_t));
+}
+
+template <std::size_t i = 0, typename... res_t>
+static inline typename std::enable_if<i < sizeof...(res_t), void>::type
+set_results(const std::tuple<res_t...>& result, const TensorIterator& iter) {
+  using T = typename std::tuple_element<i, std::tuple<res_t...>>::type;
+  *(T*)iter.data_ptr(i) = std::get<i>(result);
+  set_results<i + 1, res_t...>(result, iter);
+}
+
+// Whether ops_t has a reduce_contiguous(acc_t, const data_t*, int64_t) that
+// adds a contiguous run of data points at once, e.g. with Vec256.
+template <typename ops_t, typename acc_t, typename data_t, typename = void>
+struct has_reduce_contiguous : std::false_type {};
+
+template <typename ops_t, typename acc_t, typename data_t>
+struct has_reduce_contiguous<ops_t, acc_t, data_t, decltype((void)
+    std::declval<const ops_t&>().reduce_contiguous(
+        std::declval<acc_t>(), std::declval<const data_t*>(), int64_t()))>
+  : std::true_type {};
+
+template <typename ops_t, typename acc_t, typename data_t>
+static inline acc_t reduce_one(
+    const ops_t& ops, acc_t acc, data_t data, int64_t idx,
+    std::false_type /*takes_index*/) {
+  return ops.reduce(acc, data);
+}
+
+template <typename ops_t, typename acc_t, typename data_t>
+static inline acc_t reduce_one(
+    const ops_t& ops, acc_t acc, data_t data, int64_t idx,
+    std::true_type /*takes_index*/) {
+  return ops.reduce(acc, data, idx);
+}
+
+template <typename ops_t, typename acc_t, typename data_t, typename takes_index_t>
+static inline acc_t reduce_run(
+    const ops_t& ops, acc_t acc, const char* in, int64_t stride, int64_t size,
+    int64_t idx, takes_index_t takes_index, std::false_type /*has_contiguous*/) {
+  for (int64_t i = 0; i < size; ++i) {
+    acc = reduce_one(ops, acc, *(const data_t*)in, idx + i, takes_index);
+    in += stride;
+  }
+  return acc;
+}
+
+template <typename ops_t, typename acc_t, typename data_t, typename takes_index_t>
+static inline acc_t reduce_run(
+    const ops_t& ops, acc_t acc, const char* in, int64_t stride, int64_t size,
+    int64_t idx, takes_index_t takes_index, std::true_type /*has_contiguous*/) {
+  if (stride == sizeof(data_t)) {
+    return ops.reduce_contiguous(acc, (const data_t*)in, size);
+  }
+  return reduce_run<ops_t, acc_t, data_t>(
+      ops, acc, in, stride, size, idx, takes_index, std::false_type());
+}
+
+// data_t is the input data type.
 // acc_t is a type that contains all the necessary data
 // to continue reducing.
 //
@@ -38,21 +124,32 @@ struct all_same : c10::guts::conjunction<
 // the following.
 // reduce: (acc_t, data_t) -> acc_t adds one data point to the accumulated value.
 // combine: (acc_t, acc_t) -> acc_t combines two accumulated values into one.
-// project: acc_t -> data_t finishes the reduction, getting the required output.
+// project: acc_t -> out_t finishes the reduction, getting the required output.
 //
 // Additionally, acc_t must be default-constructible:
 // acc_t {} is an identity for combine,
 // and project(acc_t {}) is the value of the operation on zero elements.
 //
+// The reduction may have several outputs, in which case out_t is a
+// std::tuple with one element per output, e.g. the value and the index of a
+// max. reduce may also take the index of the data point as a third argument,
+// (acc_t, data_t, int64_t) -> acc_t. The index counts the data points of one
+// output in the order of the iterator, so it is the position along the
+// reduced dimension when there is only one.
+//
+// ops_t may have a reduce_contiguous: (acc_t, const data_t*, int64_t) -> acc_t
+// as well, which adds a contiguous run of data points at once. It is used
+// instead of reduce whenever the input is contiguous along the reduction.
+//
 // The point of `combine` is to support parallelization -
 // the idea is to one sequence of `reduce` calls per thread of execution,
 // and then to combine them at the end with `combine`.
 //
-// If there is more than one output element,
+// If there are at least as many output elements as threads,
 // our parallelization strategy is to use one thread for each of them,
 // which means that `combine` will never be called.
 //
-// If, on the other hand, there is only one, then we split the input into
+// If, on the other hand, there are fewer, then we split the input of each
 // into several pieces, reduce each separately, and then combine them.
 
 template <typename ops_t, typename init_t>
@@ -64,7 +161,9 @@ void binary_kernel_reduce(TensorIterator& iter, ops_t ops, init_t init) {
   using c_traits = binary_function_traits<cf_t>;
   using p_traits = unary_function_traits<pf_t>;
   using acc_t = typename p_traits::arg1_t;
-  using data_t = typename p_traits::result_type;
+  using data_t = typename r_traits::arg2_t;
+  using takes_index_t = std::integral_constant<bool, function_traits<rf_t>::arity == 3>;
+  using has_contiguous_t = has_reduce_contiguous<ops_t, acc_t, data_t>;
   static_assert(
     all_same<
       acc_t,
@@ -75,23 +174,20 @@ void binary_kernel_reduce(TensorIterator& iter, ops_t ops, init_t init) {
       typename c_traits::arg2_t,
       typename c_traits::result_type>::value,
     "all accumulate types must match");
-  static_assert(
-    std::is_same<data_t, typename r_traits::arg2_t>::value,
-    "all data types must match");
   static_assert(
     std::is_default_constructible<acc_t>::value,
     "the accumulate type must be default-constructible"
   );
+  const int num_outputs = iter.noutputs();
   iter.foreach_reduced_elt([&](TensorIterator &sub_iter) {
     auto reduction_body = [&](acc_t acc, int64_t begin, int64_t end) -> acc_t {
-      sub_iter.serial_for_each([&acc, &ops](int ntensors, char** data, const int64_t* strides, int64_t size) {
-        AT_ASSERT(ntensors == 2);
-        char *in = data[1];
-        int64_t stride = strides[1];
-        for (int64_t i = 0; i < size; ++i) {
-          acc = ops.reduce(acc, *(data_t*)in);
-          in += stride;
-        }
+      int64_t idx = begin;
+      sub_iter.serial_for_each([&acc, &ops, &idx, num_outputs](int ntensors, char** data, const int64_t* strides, int64_t size) {
+        AT_ASSERT(ntensors - num_outputs == 1);
+        acc = reduce_run<ops_t, acc_t, data_t>(
+            ops, acc, data[ntensors - 1], strides[ntensors - 1], size, idx,
+            takes_index_t(), has_contiguous_t());
+        idx += size;
       }, {begin, end});
       return acc;
     };
@@ -118,8 +214,7 @@ void binary_kernel_reduce(TensorIterator& iter, ops_t ops, init_t init) {
         total_acc = ops.combine(total_acc, buffer[i]);
       }
     }
-    char *out = (char *)sub_iter.data_ptr(0);
-    *(data_t*)out = ops.project(total_acc);
+    set_results(ops.project(total_acc), sub_iter);
   });
 }
 
@@ -3,6 +3,7 @@
 #include <algorithm>
 
 #include <ATen/Dispatch.h>
+#include <ATen/NumericUtils.h>
 #include <ATen/cpu/vec256/vec256.h>
 #include <ATen/native/ReduceOps.h>
 #include <ATen/native/TensorIterator.h>
@@ -14,8 +15,205 @@ namespace at { namespace native { namespace {
 
 using namespace vec256;
 
+// Number of elements of the contiguous runs that reduce_contiguous reduces
+// at a time, which stay in L1 between the passes over them.
+constexpr int64_t kReduceChunkSize = 256;
+
+// Sums the lanes of a vector in acc_t.
+template <typename acc_t, typename scalar_t>
+static inline acc_t sum_lanes(const Vec256<scalar_t>& v) {
+  scalar_t lanes[Vec256<scalar_t>::size()];
+  v.store(lanes);
+  acc_t sum = 0;
+  for (int i = 0; i != Vec256<scalar_t>::size(); i++) {
+    sum += lanes[i];
+  }
+  return sum;
+}
+
+// Cascade summation. The values are added in chunks of kCascadeChunk, with
+// four independent accumulators, and the sums of the chunks go through a
+// cascade of partial sums, each level of which adds up to kCascadeChunk sums
+// of the level below before passing its own sum to the next one. The rounding
+// error then grows with the logarithm of the number of values rather than
+// linearly, which makes float sums about as accurate as double ones, at the
+// cost of a few additions per chunk.
+constexpr int64_t kCascadeChunk = 16;
+constexpr int kCascadeLevels = 8;
+
+// The partial sums of the cascade, with acc_t a scalar or a Vec256.
+template <typename acc_t>
+struct CascadeSum {
+  acc_t partial[kCascadeLevels];
+  int64_t count[kCascadeLevels];
+
+  CascadeSum() {
+    for (int level = 0; level < kCascadeLevels; level++) {
+      partial[level] = acc_t(0);
+      count[level] = 0;
+    }
+  }
+
+  // Adds the sum of a chunk.
+  inline void add(acc_t chunk_sum) {
+    partial[0] = partial[0] + chunk_sum;
+    for (int level = 0;
+         level + 1 < kCascadeLevels && ++count[level] == kCascadeChunk;
+         level++) {
+      partial[level + 1] = partial[level + 1] + partial[level];
+      partial[level] = acc_t(0);
+      count[level] = 0;
+    }
+  }
+
+  inline acc_t sum() const {
+    acc_t sum = partial[0];
+    for (int level = 1; level < kCascadeLevels; level++) {
+      sum = sum + partial[level];
+    }
+    return sum;
+  }
+};
+
+// Sums load(i) ... load(i + kCascadeChunk - 1).
+template <typename acc_t, typename load_t>
+static inline acc_t chunk_sum(const load_t& load, int64_t i) {
+  acc_t acc[4] = { load(i), load(i + 1), load(i + 2), load(i + 3) };
+  for (int64_t j = i + 4; j < i + kCascadeChunk; j += 4) {
+    acc[0] = acc[0] + load(j);
+    acc[1] = acc[1] + load(j + 1);
+    acc[2] = acc[2] + load(j + 2);
+    acc[3] = acc[3] + load(j + 3);
+  }
+  return (acc[0] + acc[1]) + (acc[2] + acc[3]);
+}
+
+// Sums load(0) ... load(n - 1).
+template <typename acc_t, typename load_t>
+static inline acc_t cascade_sum(int64_t n, const load_t& load) {
+  CascadeSum<acc_t> cascade;
+  int64_t i = 0;
+  for (; i + kCascadeChunk <= n; i += kCascadeChunk) {
+    cascade.add(chunk_sum<acc_t>(load, i));
+  }
+  acc_t tail(0);
+  for (; i < n; i++) {
+    tail = tail + load(i);
+  }
+  return tail + cascade.sum();
+}
+
+// Sums map(data[0]) ... map(data[n - 1]), with vmap doing the same as map on
+// vectors.
+template <typename scalar_t, typename map_t, typename vec_map_t>
+static inline scalar_t cascade_sum_contiguous(
+    const scalar_t* data, int64_t n, const map_t& map, const vec_map_t& vmap) {
+  using Vec = Vec256<scalar_t>;
+  int64_t vec_end = n - n % Vec::size();
+  auto vec_sum = cascade_sum<Vec>(vec_end / Vec::size(), [&](int64_t i) {
+    return vmap(Vec::loadu(data + i * Vec::size()));
+  });
+  scalar_t sum = sum_lanes<scalar_t>(vec_sum);
+  for (int64_t i = vec_end; i < n; i++) {
+    sum += map(data[i]);
+  }
+  return sum;
+}
+
+template <typename scalar_t>
+static inline scalar_t cascade_row_sum(const char* in, int64_t stride, int64_t n) {
+  if (stride == sizeof(scalar_t)) {
+    return cascade_sum_contiguous(
+        (const scalar_t*)in, n,
+        [](scalar_t x) { return x; },
+        [](Vec256<scalar_t> x) { return x; });
+  }
+  return cascade_sum<scalar_t>(n, [=](int64_t i) {
+    return *(const scalar_t*)(in + i * stride);
+  });
+}
+
+// Number of vectors of the columns that cascade_outer_sum reduces at a time.
+constexpr int64_t kOuterSumBlock = 8;
+
+// out[j] += in[0][j] + ... + in[rows - 1][j] for the `cols` contiguous
+// columns of `in`. Every column has its own cascade, and the rows are read
+// kCascadeChunk at a time for a block of columns, which stays in L1.
+template <typename scalar_t>
+static void cascade_outer_sum(
+    char* out, const char* in, int64_t row_stride, int64_t rows, int64_t cols) {
+  using Vec = Vec256<scalar_t>;
+  int64_t vec_cols = cols / Vec::size();
+  for (int64_t begin = 0; begin < vec_cols; begin += kOuterSumBlock) {
+    int64_t block = std::min(kOuterSumBlock, vec_cols - begin);
+    const char* block_in = in + begin * sizeof(Vec);
+    CascadeSum<Vec> cascades[kOuterSumBlock];
+    int64_t i = 0;
+    for (; i + kCascadeChunk <= rows; i += kCascadeChunk) {
+      for (int64_t j = 0; j < block; j++) {
+        cascades[j].add(chunk_sum<Vec>([&](int64_t row) {
+          return Vec::loadu(block_in + row * row_stride + j * sizeof(Vec));
+        }, i));
+      }
+    }
+    for (int64_t j = 0; j < block; j++) {
+      Vec tail(0);
+      for (int64_t row = i; row < rows; row++) {
+        tail = tail + Vec::loadu(block_in + row * row_stride + j * sizeof(Vec));
+      }
+      char* dst = out + (begin + j) * sizeof(Vec);
+      (Vec::loadu(dst) + (tail + cascades[j].sum())).store(dst);
+    }
+  }
+  for (int64_t j = vec_cols * Vec::size(); j < cols; j++) {
+    *(scalar_t*)(out + j * sizeof(scalar_t)) +=
+        cascade_row_sum<scalar_t>(in + j * sizeof(scalar_t), row_stride, rows);
+  }
+}
+
+// Sums floating point inputs with cascade summation. Reduced dimensions come
+// first in TensorIterator, so strides[0] == 0 whenever anything is reduced.
+template <typename scalar_t>
+static void cascade_sum_kernel(TensorIterator& iter) {
+  iter.output().fill_(0);
+  iter.parallel_reduce([&](int ntensor, char** data, const int64_t* strides, int64_t size0, int64_t size1) {
+    char* out = data[0];
+    const char* in = data[1];
+    if (strides[0] == 0 && strides[2] == 0) {
+      // every row is added to the same output
+      *(scalar_t*)out += cascade_sum<scalar_t>(size1, [&](int64_t j) {
+        return cascade_row_sum<scalar_t>(in + j * strides[3], strides[1], size0);
+      });
+    } else if (strides[0] == 0) {
+      if (strides[2] == sizeof(scalar_t) && strides[3] == sizeof(scalar_t)) {
+        // the columns of the input are added to contiguous outputs
+        cascade_outer_sum<scalar_t>(out, in, strides[1], size0, size1);
+      } else {
+        for (int64_t j = 0; j < size1; j++) {
+          *(scalar_t*)(out + j * strides[2]) +=
+              cascade_row_sum<scalar_t>(in + j * strides[3], strides[1], size0);
+        }
+      }
+    } else {
+      // nothing is reduced in these dimensions
+      for (int64_t j = 0; j < size1; j++) {
+        for (int64_t i = 0; i < size0; i++) {
+          *(scalar_t*)(out + i * strides[0] + j * strides[2]) +=
+              *(const scalar_t*)(in + i * strides[1] + j * strides[3]);
+        }
+      }
+    }
+  });
+}
+
 static void sum_kernel_impl(TensorIterator& iter) {
-  AT_DISPATCH_ALL_TYPES(iter.dtype(), "sum_cpu", [&] {
+  if (isFloatingType(iter.dtype())) {
+    AT_DISPATCH_FLOATING_TYPES(iter.dtype(), "sum_cpu", [&] {
+      cascade_sum_kernel<scalar_t>(iter);
+    });
+    return;
+  }
+  AT_DISPATCH_INTEGRAL_TYPES(iter.dtype(), "sum_cpu", [&] {
     binary_kernel_reduce_vec(
       iter,
       [=](scalar_t a, scalar_t b) -> scalar_t { return a + b; },
@@ -34,16 +232,211 @@ static void mean_kernel_impl(TensorIterator& iter) {
   });
 }
 
+// WelfordOps that adds contiguous runs of float and double by chunks: the
+// mean and the sum of squared deviations of a chunk are computed with
+// Vec256, and merged into the accumulator with the pairwise combine.
+template <typename scalar_t>
+struct WelfordCPUOps : public WelfordOps<scalar_t, double, int64_t, double> {
+  using Base = WelfordOps<scalar_t, double, int64_t, double>;
+  using acc_t = typename Base::acc_t;
+  using Base::Base;
+
+  template <typename T = scalar_t,
+            typename = typename std::enable_if<std::is_floating_point<T>::value>::type>
+  acc_t reduce_contiguous(acc_t acc, const T* data, int64_t n) const {
+    using Vec = Vec256<T>;
+    for (int64_t begin = 0; begin < n; begin += kReduceChunkSize) {
+      const T* x = data + begin;
+      const int64_t len = std::min(kReduceChunkSize, n - begin);
+      const int64_t vec_len = len - len % Vec::size();
+
+      Vec vec_sum(T(0));
+      for (int64_t i = 0; i < vec_len; i += Vec::size()) {
+        vec_sum = vec_sum + Vec::loadu(x + i);
+      }
+      double sum = sum_lanes<double>(vec_sum);
+      for (int64_t i = vec_len; i < len; i++) {
+        sum += x[i];
+      }
+      const T mean = sum / len;
+
+      const Vec vec_mean(mean);
+      Vec vec_m2(T(0));
+      for (int64_t i = 0; i < vec_len; i += Vec::size()) {
+        Vec delta = Vec::loadu(x + i) - vec_mean;
+        vec_m2 = vec_m2 + delta * delta;
+      }
+      double m2 = sum_lanes<double>(vec_m2);
+      for (int64_t i = vec_len; i < len; i++) {
+        double delta = x[i] - mean;
+        m2 += delta * delta;
+      }
+      acc = Base::combine(acc, acc_t(mean, m2, len, len));
+    }
+    return acc;
+  }
+};
+
+// Outputs the mean besides the variance or standard deviation.
+template <typename scalar_t>
+struct WelfordMeanCPUOps : public WelfordCPUOps<scalar_t> {
+  using Base = WelfordCPUOps<scalar_t>;
+  using acc_t = typename Base::acc_t;
+  using Base::Base;
+
+  std::tuple<scalar_t, scalar_t> project(acc_t acc) const {
+    return std::tuple<scalar_t, scalar_t>(
+        Base::project(acc), static_cast<scalar_t>(acc.mean));
+  }
+};
+
 static void std_var_kernel_impl(TensorIterator &iter, bool unbiased, bool take_sqrt) {
   AT_DISPATCH_FLOATING_TYPES_AND_HALF(iter.dtype(), "std_cpu", [&] {
     binary_kernel_reduce(
       iter,
-      WelfordOps<scalar_t, double, int64_t, double> { unbiased, take_sqrt },
+      WelfordCPUOps<scalar_t> { unbiased, take_sqrt },
+      WelfordData<double, int64_t, double>()
+    );
+  });
+}
+
+static void std_var_mean_kernel_impl(TensorIterator &iter, bool unbiased, bool take_sqrt) {
+  AT_DISPATCH_FLOATING_TYPES_AND_HALF(iter.dtype(), "std_mean_cpu", [&] {
+    binary_kernel_reduce(
+      iter,
+      WelfordMeanCPUOps<scalar_t> { unbiased, take_sqrt },
       WelfordData<double, int64_t, double>()
     );
   });
 }
 
+// The running maximum of the data points, and the sum of their exponentials
+// relative to it, so that logsumexp reads its input once.
+template <typename scalar_t>
+struct LogSumExpData {
+  scalar_t max;
+  scalar_t sum;
+  LogSumExpData() : max(-std::numeric_limits<scalar_t>::infinity()), sum(0) {}
+  LogSumExpData(scalar_t max, scalar_t sum) : max(max), sum(sum) {}
+};
+
+template <typename scalar_t>
+struct LogSumExpOps {
+  using acc_t = LogSumExpData<scalar_t>;
+
+  inline acc_t reduce(acc_t acc, scalar_t data) const {
+    if (data > acc.max) {
+      return acc_t(data, acc.sum * std::exp(acc.max - data) + 1);
+    } else if (data == acc.max) {
+      // also covers infinities, for which data - acc.max is NaN
+      return acc_t(acc.max, acc.sum + 1);
+    }
+    // NaNs, in either of them, end up in the sum
+    return acc_t(acc.max, acc.sum + std::exp(data - acc.max));
+  }
+
+  inline acc_t combine(acc_t a, acc_t b) const {
+    if (a.max < b.max) {
+      std::swap(a, b);
+    }
+    if (b.sum == 0) {
+      return a;
+    } else if (a.max == b.max) {
+      return acc_t(a.max, a.sum + b.sum);
+    }
+    return acc_t(a.max, a.sum + b.sum * std::exp(b.max - a.max));
+  }
+
+  inline scalar_t project(acc_t acc) const {
+    return acc.max + std::log(acc.sum);
+  }
+
+  template <typename T = scalar_t,
+            typename = typename std::enable_if<std::is_floating_point<T>::value>::type>
+  acc_t reduce_contiguous(acc_t acc, const T* data, int64_t n) const {
+    using Vec = Vec256<T>;
+    for (int64_t begin = 0; begin < n; begin += kReduceChunkSize) {
+      const T* x = data + begin;
+      const int64_t len = std::min(kReduceChunkSize, n - begin);
+      const int64_t vec_len = len - len % Vec::size();
+
+      Vec vec_max(-std::numeric_limits<T>::infinity());
+      for (int64_t i = 0; i < vec_len; i += Vec::size()) {
+        vec_max = maximum(vec_max, Vec::loadu(x + i));
+      }
+      T lanes[Vec::size()];
+      vec_max.store(lanes);
+      T max = -std::numeric_limits<T>::infinity();
+      for (int i = 0; i != Vec::size(); i++) {
+        max = _isnan(lanes[i]) || lanes[i] > max ? lanes[i] : max;
+      }
+      for (int64_t i = vec_len; i < len; i++) {
+        max = _isnan(x[i]) || x[i] > max ? x[i] : max;
+      }
+      if (!std::isfinite(max)) {
+        // infinities and NaNs take the special cases of reduce
+        for (int64_t i = 0; i < len; i++) {
+          acc = reduce(acc, x[i]);
+        }
+        continue;
+      }
+
+      const Vec vec_chunk_max(max);
+      Vec vec_sum(T(0));
+      for (int64_t i = 0; i < vec_len; i += Vec::size()) {
+        vec_sum = vec_sum + (Vec::loadu(x + i) - vec_chunk_max).exp();
+      }
+      T sum = sum_lanes<T>(vec_sum);
+      for (int64_t i = vec_len; i < len; i++) {
+        sum += std::exp(x[i] - max);
+      }
+      acc = combine(acc, acc_t(max, sum));
+    }
+    return acc;
+  }
+};
+
+static void logsumexp_kernel_impl(TensorIterator& iter) {
+  AT_DISPATCH_FLOATING_TYPES(iter.dtype(), "logsumexp_cpu", [&] {
+    binary_kernel_reduce(
+      iter,
+      LogSumExpOps<scalar_t>(),
+      LogSumExpData<scalar_t>()
+    );
+  });
+}
+
+// The minimum and the maximum, propagating NaN like min and max.
+template <typename scalar_t>
+struct MinMaxOps {
+  using acc_t = std::pair<scalar_t, scalar_t>;
+
+  inline acc_t reduce(acc_t acc, scalar_t data) const {
+    return combine(acc, acc_t(data, data));
+  }
+
+  inline acc_t combine(acc_t a, acc_t b) const {
+    return acc_t(
+        _isnan(a.first) || a.first < b.first ? a.first : b.first,
+        _isnan(a.second) || a.second > b.second ? a.second : b.second);
+  }
+
+  inline std::tuple<scalar_t, scalar_t> project(acc_t acc) const {
+    return std::tuple<scalar_t, scalar_t>(acc.first, acc.second);
+  }
+};
+
+static void aminmax_kernel_impl(TensorIterator& iter) {
+  AT_DISPATCH_ALL_TYPES(iter.dtype(), "aminmax_cpu", [&] {
+    binary_kernel_reduce(
+      iter,
+      MinMaxOps<scalar_t>(),
+      std::pair<scalar_t, scalar_t>(
+          upper_bound<scalar_t>(), lower_bound<scalar_t>())
+    );
+  });
+}
+
 static void prod_kernel_impl(TensorIterator& iter) {
   AT_DISPATCH_ALL_TYPES(iter.dtype(), "prod_cpu", [&] {
     binary_kernel_reduce_vec(
@@ -54,6 +447,50 @@ static void prod_kernel_impl(TensorIterator& iter) {
   });
 }
 
+// The norm ops add contiguous runs with cascade_sum_contiguous. p = 1 and
+// p = 2 have their own ops, which avoid pow on strided inputs as well.
+template <typename scalar_t>
+struct NormOneCPUOps : public NormOneOps<scalar_t> {
+  using Vec = Vec256<scalar_t>;
+
+  scalar_t reduce_contiguous(scalar_t acc, const scalar_t* data, int64_t n) const {
+    return acc + cascade_sum_contiguous(data, n,
+        [](scalar_t x) { return std::abs(x); },
+        [](Vec x) { return x.abs(); });
+  }
+};
+
+template <typename scalar_t>
+struct NormTwoCPUOps : public NormOps<scalar_t> {
+  using Vec = Vec256<scalar_t>;
+
+  NormTwoCPUOps(): NormOps<scalar_t>(2) {}
+
+  inline scalar_t reduce(scalar_t acc, scalar_t data) const {
+    return acc + data * data;
+  }
+
+  scalar_t reduce_contiguous(scalar_t acc, const scalar_t* data, int64_t n) const {
+    return acc + cascade_sum_contiguous(data, n,
+        [](scalar_t x) { return x * x; },
+        [](Vec x) { return x * x; });
+  }
+};
+
+template <typename scalar_t>
+struct NormCPUOps : public NormOps<scalar_t> {
+  using Vec = Vec256<scalar_t>;
+
+  NormCPUOps(scalar_t norm): NormOps<scalar_t>(norm) {}
+
+  scalar_t reduce_contiguous(scalar_t acc, const scalar_t* data, int64_t n) const {
+    const scalar_t p = this->norm;
+    return acc + cascade_sum_contiguous(data, n,
+        [=](scalar_t x) { return std::pow(std::abs(x), p); },
+        [=](Vec x) { return x.abs().pow(Vec(p)); });
+  }
+};
+
 static void norm_kernel_tensor_iterator_impl(
     TensorIterator& iter,
     Scalar p) {
@@ -79,7 +516,15 @@ static void norm_kernel_tensor_iterator_impl(
     AT_DISPATCH_FLOATING_TYPES(iter.dtype(), "norm_cpu", [&] {
       binary_kernel_reduce(
         iter,
-        NormOneOps<scalar_t>(),
+        NormOneCPUOps<scalar_t>(),
+        scalar_t(0)
+      );
+    });
+  } else if (val == 2) {
+    AT_DISPATCH_FLOATING_TYPES(iter.dtype(), "norm_cpu", [&] {
+      binary_kernel_reduce(
+        iter,
+        NormTwoCPUOps<scalar_t>(),
         scalar_t(0)
       );
     });
@@ -103,7 +548,7 @@ static void norm_kernel_tensor_iterator_impl(
     AT_DISPATCH_FLOATING_TYPES(iter.dtype(), "norm_cpu", [&] {
       binary_kernel_reduce(
         iter,
-        NormOps<scalar_t> { scalar_t(val) },
+        NormCPUOps<scalar_t> { scalar_t(val) },
         scalar_t(0)
       );
     });
@@ -170,6 +615,9 @@ static void max_values_kernel_impl(TensorIterator& iter) {
 
 REGISTER_DISPATCH(sum_stub, &sum_kernel_impl);
 REGISTER_DISPATCH(std_var_stub, &std_var_kernel_impl);
+REGISTER_DISPATCH(std_var_mean_stub, &std_var_mean_kernel_impl);
+REGISTER_DISPATCH(logsumexp_stub, &logsumexp_kernel_impl);
+REGISTER_DISPATCH(aminmax_stub, &aminmax_kernel_impl);
 REGISTER_DISPATCH(prod_stub, &prod_kernel_impl);
 REGISTER_DISPATCH(mean_stub, &mean_kernel_impl);
 REGISTER_DISPATCH(norm_stub, &norm_kernel_tensor_iterator_impl);
@@ -7,6 +7,8 @@
 #include <ATen/Dispatch.h>
 #include <ATen/Parallel.h>
 #include <ATen/NumericUtils.h>
+#include <ATen/native/TensorIterator.h>
+#include <ATen/native/cpu/Reduce.h>
 #include <c10/util/Optional.h>
 
 namespace at { namespace native { namespace {
@@ -78,14 +80,73 @@ struct Reduction {
   }
 };
 
+// The value and the index of the max, or of the min, of the reduced
+// dimension. Like Reduction, it takes the first NaN, and otherwise the first
+// of equal values, whatever the order in which the threads combine.
+template <typename scalar_t, bool greater>
+struct ValueIndexOps {
+  using acc_t = std::pair<scalar_t, int64_t>;
+
+  static inline bool takes_over(acc_t a, acc_t b) {
+    if (_isnan(b.first)) {
+      return _isnan(a.first) && a.second < b.second;
+    }
+    if (_isnan(a.first)) {
+      return true;
+    }
+    if (a.first == b.first) {
+      return a.second < b.second;
+    }
+    return greater ? a.first > b.first : a.first < b.first;
+  }
+
+  inline acc_t reduce(acc_t acc, scalar_t data, int64_t idx) const {
+    return combine(acc, acc_t(data, idx));
+  }
+
+  inline acc_t combine(acc_t a, acc_t b) const {
+    return takes_over(b, a) ? b : a;
+  }
+
+  inline std::tuple<scalar_t, int64_t> project(acc_t acc) const {
+    return std::tuple<scalar_t, int64_t>(acc.first, acc.second);
+  }
+};
+
+// Reduction splits the outputs over the threads, and reads contiguous
+// inputs directly, which is best when there are enough outputs to go around.
+// Otherwise, or when self is not contiguous, TensorIterator also splits the
+// reduced dimension.
+template <bool greater>
+static void value_index_kernel(
+    Tensor& result,
+    Tensor& result_indices,
+    const Tensor& self,
+    int64_t dim) {
+  if (self.is_contiguous() && result.numel() >= at::get_num_threads()) {
+    AT_DISPATCH_ALL_TYPES(self.scalar_type(), greater ? "max" : "min", [&] {
+      Reduction<scalar_t, int64_t>::apply(
+          result, result_indices, self, dim, greater);
+    });
+    return;
+  }
+  auto iter = TensorIterator::reduce_op(result, result_indices, self);
+  AT_DISPATCH_ALL_TYPES(self.scalar_type(), greater ? "max" : "min", [&] {
+    binary_kernel_reduce(
+        *iter,
+        ValueIndexOps<scalar_t, greater>(),
+        std::pair<scalar_t, int64_t>(
+            greater ? lower_bound<scalar_t>() : upper_bound<scalar_t>(),
+            std::numeric_limits<int64_t>::max()));
+  });
+}
+
 static void max_kernel_impl(
     Tensor& max,
     Tensor& max_indices,
     const Tensor& self,
     c10::optional<int64_t> dim) {
-  AT_DISPATCH_ALL_TYPES(self.scalar_type(), "max", [&] {
-    Reduction<scalar_t, int64_t>::apply(max, max_indices, self, dim, true);
-  });
+  value_index_kernel<true>(max, max_indices, self, *dim);
 }
 
 static void min_kernel_impl(
@@ -93,9 +154,7 @@ static void min_kernel_impl(
     Tensor& min_indices,
     const Tensor& self,
     c10::optional<int64_t> dim) {
-  AT_DISPATCH_ALL_TYPES(self.scalar_type(), "min", [&] {
-    Reduction<scalar_t, int64_t>::apply(min, min_indices, self, dim, false);
-  });
+  value_index_kernel<false>(min, min_indices, self, *dim);
 }
 
 } // anonymous namespace
@@ -0,0 +1,215 @@
+#ifdef USE_FBGEMM
+
+#include <ATen/native/quantized/cpu/FbgemmPackCache.h>
+
+#include <c10/util/Exception.h>
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+namespace at {
+namespace native {
+
+namespace {
+
+constexpr size_t kDefaultCapacity = 256 << 20;
+
+// Multipliers of the two halves of the hash: the one of MurmurHash64A, and
+// the golden ratio.
+constexpr uint64_t kMul0 = 0xc6a4a7935bd1e995ULL;
+constexpr uint64_t kMul1 = 0x9e3779b97f4a7c15ULL;
+
+inline uint64_t mix(uint64_t h, uint64_t word, uint64_t mul) {
+  word *= mul;
+  word ^= word >> 47;
+  word *= mul;
+  h ^= word;
+  return h * mul;
+}
+
+inline uint64_t finalize(uint64_t h, uint64_t mul) {
+  h ^= h >> 47;
+  h *= mul;
+  return h ^ (h >> 47);
+}
+
+// Hashes the `rows` x `cols` matrix at `data`, with leading dimension `ld`,
+// eight bytes at a time. The padding between rows is not read.
+std::pair<uint64_t, uint64_t>
+hashMatrix(const int8_t* data, int64_t rows, int64_t cols, int64_t ld) {
+  uint64_t h0 = kMul1 ^ (rows * kMul0);
+  uint64_t h1 = kMul0 ^ (cols * kMul1);
+  for (int64_t i = 0; i < rows; ++i) {
+    const int8_t* row = data + i * ld;
+    int64_t j = 0;
+    for (; j + 8 <= cols; j += 8) {
+      uint64_t word;
+      std::memcpy(&word, row + j, sizeof(word));
+      h0 = mix(h0, word, kMul0);
+      h1 = mix(h1, word, kMul1);
+    }
+    if (j < cols) {
+      uint64_t word = 0;
+      std::memcpy(&word, row + j, cols - j);
+      h0 = mix(h0, word, kMul0);
+      h1 = mix(h1, word, kMul1);
+    }
+  }
+  return {finalize(h0, kMul0), finalize(h1, kMul1)};
+}
+
+template <typename ACC_T>
+size_t packedBytes(const fbgemm::PackBMatrix<int8_t, ACC_T>& packed) {
+  return static_cast<size_t>(packed.numGroups()) * packed.blockRows() *
+      packed.blockRowSize() * packed.blockCols() * packed.blockColSize() *
+      sizeof(int8_t);
+}
+
+} // namespace
+
+FbgemmPackCache::FbgemmPackCache() : capacity_(kDefaultCapacity), clock_(0) {}
+
+FbgemmPackCache& FbgemmPackCache::get() {
+  // Leaked, so that static destructors of other translation units can still
+  // release their packed matrices.
+  static FbgemmPackCache* cache = new FbgemmPackCache();
+  return *cache;
+}
+
+template <typename ACC_T>
+std::shared_ptr<fbgemm::PackBMatrix<int8_t, ACC_T>> FbgemmPackCache::getOrPack(
+    fbgemm::matrix_op_t trans,
+    int32_t nRow,
+    int32_t nCol,
+    const int8_t* smat,
+    int32_t ld,
+    int groups) {
+  using Packed = fbgemm::PackBMatrix<int8_t, ACC_T>;
+  AT_CHECK(groups > 0 && nRow % groups == 0,
+      "Cannot split ", nRow, " rows in ", groups, " groups");
+
+  // The packing reads nRow / groups elements of groups * nCol rows when the
+  // matrix is transposed, and nCol elements of nRow rows otherwise.
+  const bool transposed = trans == fbgemm::matrix_op_t::Transpose;
+  const auto hash = hashMatrix(
+      smat,
+      transposed ? static_cast<int64_t>(groups) * nCol : nRow,
+      transposed ? nRow / groups : nCol,
+      ld);
+  const Key key(
+      static_cast<int>(trans),
+      nRow,
+      nCol,
+      ld,
+      groups,
+      sizeof(ACC_T),
+      hash.first,
+      hash.second);
+
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    auto it = entries_.find(key);
+    if (it != entries_.end()) {
+      ++stats_.hits;
+      it->second.lastUse = ++clock_;
+      return std::static_pointer_cast<Packed>(it->second.packed);
+    }
+    ++stats_.misses;
+  } // release the lock while packing
+
+  auto packed = std::make_shared<Packed>(
+      trans,
+      nRow,
+      nCol,
+      smat,
+      ld,
+      nullptr, // pmat
+      groups);
+  const auto bytes = packedBytes(*packed);
+
+  std::lock_guard<std::mutex> guard(mutex_);
+  auto result = entries_.emplace(key, Entry{packed, bytes, ++clock_});
+  if (!result.second) {
+    // Another thread packed the same matrix in the meantime.
+    result.first->second.lastUse = clock_;
+    return std::static_pointer_cast<Packed>(result.first->second.packed);
+  }
+  ++stats_.entries;
+  stats_.bytes += bytes;
+  evictLocked(capacity_);
+  return packed;
+}
+
+void FbgemmPackCache::evictLocked(size_t capacity) {
+  if (static_cast<size_t>(stats_.bytes) <= capacity) {
+    return;
+  }
+  std::vector<std::map<Key, Entry>::iterator> unused;
+  for (auto it = entries_.begin(); it != entries_.end(); ++it) {
+    if (it->second.packed.use_count() == 1) {
+      unused.push_back(it);
+    }
+  }
+  std::sort(
+      unused.begin(),
+      unused.end(),
+      [](const std::map<Key, Entry>::iterator& a,
+         const std::map<Key, Entry>::iterator& b) {
+        return a->second.lastUse < b->second.lastUse;
+      });
+  for (auto it : unused) {
+    if (static_cast<size_t>(stats_.bytes) <= capacity) {
+      break;
+    }
+    stats_.bytes -= it->second.bytes;
+    --stats_.entries;
+    ++stats_.evictions;
+    entries_.erase(it);
+  }
+}
+
+size_t FbgemmPackCache::capacity() const {
+  std::lock_guard<std::mutex> guard(mutex_);
+  return capacity_;
+}
+
+void FbgemmPackCache::setCapacity(size_t bytes) {
+  std::lock_guard<std::mutex> guard(mutex_);
+  capacity_ = bytes;
+  evictLocked(capacity_);
+}
+
+FbgemmPackCache::Stats FbgemmPackCache::stats() const {
+  std::lock_guard<std::mutex> guard(mutex_);
+  return stats_;
+}
+
+void FbgemmPackCache::clear() {
+  std::lock_guard<std::mutex> guard(mutex_);
+  evictLocked(0);
+}
+
+template std::shared_ptr<fbgemm::PackBMatrix<int8_t, int16_t>>
+FbgemmPackCache::getOrPack<int16_t>(
+    fbgemm::matrix_op_t trans,
+    int32_t nRow,
+    int32_t nCol,
+    const int8_t* smat,
+    int32_t ld,
+    int groups);
+
+template std::shared_ptr<fbgemm::PackBMatrix<int8_t, int32_t>>
+FbgemmPackCache::getOrPack<int32_t>(
+    fbgemm::matrix_op_t trans,
+    int32_t nRow,
+    int32_t nCol,
+    const int8_t* smat,
+    int32_t ld,
+    int groups);
+
+} // namespace native
+} // namespace at
+
+#endif // USE_FBGEMM
@@ -0,0 +1,93 @@
+#pragma once
+
+#ifdef USE_FBGEMM
+
+#include <c10/macros/Export.h>
+#include "fbgemm/Fbgemm.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <tuple>
+
+namespace at {
+namespace native {
+
+// A process-wide cache of weight matrices packed for fbgemm, shared by the
+// ATen fbgemm_* functions and the caffe2 DNNLOWP operators.
+//
+// A packed matrix is found by a 128-bit hash of the contents of the quantized
+// matrix, together with its shape, layout and accumulation type, so that
+// copies of the same weight loaded by different models, predictor instances
+// or threads share a single packed matrix wherever they live. A hit costs a
+// pass over the quantized matrix to hash it instead of a pass to pack it,
+// and no allocation.
+//
+// The cache holds a reference to every packed matrix. When the packed
+// matrices take more than capacity() bytes, the least recently used ones that
+// nobody else refers to are released. Matrices in use are never evicted,
+// since that would not free any memory, so the cache may exceed its capacity
+// while they are alive.
+class CAFFE2_API FbgemmPackCache {
+ public:
+  struct Stats {
+    int64_t hits = 0;
+    int64_t misses = 0;
+    int64_t evictions = 0;
+    int64_t entries = 0;
+    int64_t bytes = 0;
+  };
+
+  static FbgemmPackCache& get();
+
+  // Returns the packed matrix for the arguments of the fbgemm::PackBMatrix
+  // constructor, packing it on a miss.
+  template <typename ACC_T>
+  std::shared_ptr<fbgemm::PackBMatrix<int8_t, ACC_T>> getOrPack(
+      fbgemm::matrix_op_t trans,
+      int32_t nRow,
+      int32_t nCol,
+      const int8_t* smat,
+      int32_t ld,
+      int groups = 1);
+
+  size_t capacity() const;
+  void setCapacity(size_t bytes);
+
+  Stats stats() const;
+
+  // Releases every packed matrix that nobody else refers to.
+  void clear();
+
+ private:
+  // trans, nRow, nCol, ld, groups, sizeof(ACC_T) and the two halves of the
+  // hash of the contents.
+  using Key =
+      std::tuple<int, int32_t, int32_t, int32_t, int, size_t, uint64_t, uint64_t>;
+
+  struct Entry {
+    // A fbgemm::PackBMatrix<int8_t, ACC_T>, with ACC_T given by the key.
+    std::shared_ptr<void> packed;
+    size_t bytes;
+    uint64_t lastUse;
+  };
+
+  FbgemmPackCache();
+
+  // Releases unused entries, least recently used first, until the cache fits
+  // in `capacity` bytes.
+  void evictLocked(size_t capacity);
+
+  mutable std::mutex mutex_;
+  std::map<Key, Entry> entries_;
+  size_t capacity_;
+  uint64_t clock_;
+  Stats stats_;
+};
+
+} // namespace native
+} // namespace at
+
+#endif // USE_FBGEMM
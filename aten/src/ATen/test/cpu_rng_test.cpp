@@ -0,0 +1,65 @@
+#include <gtest/gtest.h>
+
+#include <ATen/ATen.h>
+#include <ATen/Parallel.h>
+
+#include <functional>
+
+using namespace at;
+
+// Samples `fn` with a fixed seed on one and on several threads.
+static void expectIndependentOfThreadCount(std::function<Tensor()> fn) {
+  const auto num_threads = get_num_threads();
+
+  set_num_threads(1);
+  manual_seed(123);
+  auto serial = fn();
+
+  set_num_threads(4);
+  manual_seed(123);
+  auto parallel = fn();
+
+  set_num_threads(num_threads);
+  ASSERT_TRUE(serial.equal(parallel));
+}
+
+TEST(CPURNGTest, UniformIndependentOfThreadCount) {
+  expectIndependentOfThreadCount([] { return rand({1 << 20}); });
+  expectIndependentOfThreadCount(
+      [] { return rand({1 << 20}, kDouble).mul_(2).sub_(1); });
+}
+
+TEST(CPURNGTest, NormalIndependentOfThreadCount) {
+  expectIndependentOfThreadCount([] { return randn({(1 << 20) + 5}); });
+  expectIndependentOfThreadCount([] { return randn({1027}, kDouble); });
+}
+
+TEST(CPURNGTest, BernoulliIndependentOfThreadCount) {
+  expectIndependentOfThreadCount(
+      [] { return empty({1 << 20}).bernoulli_(0.3); });
+}
+
+TEST(CPURNGTest, ManualSeedReproduces) {
+  manual_seed(42);
+  auto a = randn({1000});
+  auto b = randn({1000});
+  manual_seed(42);
+  ASSERT_TRUE(a.equal(randn({1000})));
+  ASSERT_TRUE(b.equal(randn({1000})));
+  ASSERT_FALSE(a.equal(b));
+}
+
+TEST(CPURNGTest, Moments) {
+  manual_seed(0);
+  auto u = rand({1 << 20}, kDouble);
+  ASSERT_GE(u.min().item<double>(), 0);
+  ASSERT_LT(u.max().item<double>(), 1);
+  ASSERT_NEAR(u.mean().item<double>(), 0.5, 1e-2);
+
+  auto n = empty({1 << 20}).normal_(2, 3);
+  ASSERT_NEAR(n.mean().item<float>(), 2, 2e-2);
+  ASSERT_NEAR(n.std().item<float>(), 3, 2e-2);
+
+  auto b = empty({1 << 20}, kDouble).bernoulli_(0.25);
+  ASSERT_NEAR(b.mean().item<double>(), 0.25, 1e-2);
+}
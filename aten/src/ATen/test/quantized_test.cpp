@@ -10,6 +10,9 @@
 // For quantize_uint8
 #include <ATen/quantized/Quantizer.h>
 #include <c10/core/ScalarType.h>
+#ifdef USE_FBGEMM
+#include <ATen/native/quantized/cpu/FbgemmPackCache.h>
+#endif
 
 using namespace at;
 
@@ -96,3 +99,54 @@ TEST(TestQTensor, EmptyQuantized) {
     ASSERT_EQ(r_data[i], (val - zero_point) * scale);
   }
 }
+
+#ifdef USE_FBGEMM
+TEST(TestQTensor, FbgemmPackCache) {
+  if (!fbgemm::fbgemmSupportedCPU()) {
+    return;
+  }
+  auto& cache = at::native::FbgemmPackCache::get();
+  cache.clear();
+  const auto before = cache.stats();
+
+  const int K = 64, N = 48;
+  Tensor w = at::randint(-128, 128, {N, K}, at::kChar);
+  Tensor copy = w.clone();
+  auto packed = cache.getOrPack<int32_t>(
+      fbgemm::matrix_op_t::Transpose, K, N, w.data<int8_t>(), K);
+  // Another copy of the same weight shares the packed matrix, whatever its
+  // address.
+  ASSERT_EQ(
+      packed,
+      cache.getOrPack<int32_t>(
+          fbgemm::matrix_op_t::Transpose, K, N, copy.data<int8_t>(), K));
+  // A different accumulation type or different contents do not.
+  auto acc16 = cache.getOrPack<int16_t>(
+      fbgemm::matrix_op_t::Transpose, K, N, w.data<int8_t>(), K);
+  copy.data<int8_t>()[0] ^= 1;
+  auto other = cache.getOrPack<int32_t>(
+      fbgemm::matrix_op_t::Transpose, K, N, copy.data<int8_t>(), K);
+  ASSERT_NE(packed, other);
+
+  auto stats = cache.stats();
+  ASSERT_EQ(stats.hits - before.hits, 1);
+  ASSERT_EQ(stats.misses - before.misses, 3);
+  ASSERT_EQ(stats.entries - before.entries, 3);
+
+  // Packed matrices in use are never evicted.
+  const auto capacity = cache.capacity();
+  cache.setCapacity(0);
+  ASSERT_EQ(cache.stats().entries - before.entries, 3);
+  acc16.reset();
+  other.reset();
+  cache.setCapacity(0);
+  stats = cache.stats();
+  ASSERT_EQ(stats.entries - before.entries, 1);
+  ASSERT_EQ(stats.evictions - before.evictions, 2);
+  ASSERT_EQ(
+      packed,
+      cache.getOrPack<int32_t>(
+          fbgemm::matrix_op_t::Transpose, K, N, w.data<int8_t>(), K));
+  cache.setCapacity(capacity);
+}
+#endif // USE_FBGEMM
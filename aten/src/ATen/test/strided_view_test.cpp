@@ -0,0 +1,55 @@
+#include <gtest/gtest.h>
+
+#include <ATen/ATen.h>
+#include <ATen/native/StridedView.h>
+
+using namespace at;
+using at::native::StridedView;
+using at::native::strided_apply;
+
+namespace {
+
+// Checks that `view` has the geometry and the elements of `expected`.
+void expectEqual(const StridedView<float>& view, const Tensor& expected) {
+  ASSERT_EQ(view.sizes(), expected.sizes());
+  ASSERT_EQ(view.strides(), expected.strides());
+  ASSERT_EQ(view.data(), expected.data<float>());
+  auto values = at::empty(expected.sizes(), expected.options());
+  strided_apply(StridedView<float>(values), view, [](float& v, const float& x) {
+    v = x;
+  });
+  ASSERT_TRUE(values.equal(expected));
+}
+
+} // namespace
+
+TEST(StridedViewTest, MatchesTensorViews) {
+  auto t = at::randn({3, 4, 5});
+  StridedView<float> view(t);
+  expectEqual(view, t);
+  expectEqual(view.select(1, 2), t.select(1, 2));
+  expectEqual(view.select(-1, -1), t.select(-1, -1));
+  expectEqual(view.narrow(2, 1, 3), t.narrow(2, 1, 3));
+  expectEqual(view.transpose(0, 2), t.transpose(0, 2));
+  expectEqual(view.unsqueeze(1), t.unsqueeze(1));
+  expectEqual(view.unsqueeze(3), t.unsqueeze(3));
+  expectEqual(
+      view.transpose(0, 1).select(2, 4).narrow(0, 1, 2),
+      t.transpose(0, 1).select(2, 4).narrow(0, 1, 2));
+}
+
+TEST(StridedViewTest, HandlesEdgeCases) {
+  auto t = at::randn({5});
+  auto scalar = t.select(0, 3);
+  expectEqual(StridedView<float>(t).select(0, 3), scalar);
+
+  int64_t count = 0;
+  strided_apply(StridedView<float>(at::empty({2, 0, 3})), [&](float&) {
+    ++count;
+  });
+  ASSERT_EQ(count, 0);
+
+  ASSERT_ANY_THROW(StridedView<float>(t).select(0, 5));
+  ASSERT_ANY_THROW(StridedView<float>(scalar).select(0, 0));
+  ASSERT_ANY_THROW(StridedView<float>(t).narrow(0, 3, 3));
+}
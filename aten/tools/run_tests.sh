@@ -8,6 +8,7 @@ pushd $1
 VALGRIND=${VALGRIND:=ON}
 ./basic
 ./atest
+./cpu_rng_test
 ./scalar_test
 ./broadcast_test
 ./wrapdim_test
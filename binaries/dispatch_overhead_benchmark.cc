@@ -0,0 +1,69 @@
+// Measures the per-op overhead of dispatch for small tensors: Variables with
+// and without grad mode, Variables and plain tensors in inference mode, and
+// plain tensors dispatched to the non-Variable type outside of it (which is
+// the lower bound).
+//
+// The argument is the number of elements per tensor.
+
+#include "benchmark/benchmark.h"
+
+#include <torch/csrc/autograd/variable.h>
+#include <torch/types.h>
+#include <torch/utils.h>
+
+namespace {
+
+// A few typical ops of an eager inference loop, in place and out of place.
+void run_ops(benchmark::State& state, const at::Tensor& a, const at::Tensor& b) {
+  auto c = a.clone();
+  while (state.KeepRunning()) {
+    auto d = at::add(a, b);
+    c.mul_(b);
+    auto e = d.view({-1}).select(0, 0);
+    benchmark::DoNotOptimize(e);
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * 4);
+}
+
+void BM_Variable(benchmark::State& state) {
+  auto a = torch::randn({state.range(0)});
+  auto b = torch::randn({state.range(0)});
+  run_ops(state, a, b);
+}
+
+void BM_VariableNoGrad(benchmark::State& state) {
+  auto a = torch::randn({state.range(0)});
+  auto b = torch::randn({state.range(0)});
+  torch::NoGradGuard guard;
+  run_ops(state, a, b);
+}
+
+void BM_VariableInferenceMode(benchmark::State& state) {
+  auto a = torch::randn({state.range(0)});
+  auto b = torch::randn({state.range(0)});
+  torch::InferenceModeGuard guard;
+  run_ops(state, a, b);
+}
+
+void BM_PlainInferenceMode(benchmark::State& state) {
+  torch::InferenceModeGuard guard;
+  auto a = torch::randn({state.range(0)});
+  auto b = torch::randn({state.range(0)});
+  run_ops(state, a, b);
+}
+
+void BM_PlainTensor(benchmark::State& state) {
+  auto a = at::randn({state.range(0)});
+  auto b = at::randn({state.range(0)});
+  run_ops(state, a, b);
+}
+
+} // namespace
+
+BENCHMARK(BM_Variable)->Arg(1)->Arg(64)->Arg(4096);
+BENCHMARK(BM_VariableNoGrad)->Arg(1)->Arg(64)->Arg(4096);
+BENCHMARK(BM_VariableInferenceMode)->Arg(1)->Arg(64)->Arg(4096);
+BENCHMARK(BM_PlainInferenceMode)->Arg(1)->Arg(64)->Arg(4096);
+BENCHMARK(BM_PlainTensor)->Arg(1)->Arg(64)->Arg(4096);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,178 @@
+// Compares the fused multi-tensor optimizer kernels
+// (ATen/native/FusedOptimizers.h) against the sequence of ATen ops per
+// parameter that the C++ frontend optimizers run otherwise.
+//
+// Arguments are {number of parameters, elements per parameter}.
+
+#include "benchmark/benchmark.h"
+
+#include <ATen/ATen.h>
+#include <ATen/native/FusedOptimizers.h>
+
+#include <vector>
+
+namespace {
+
+struct OptimizerState {
+  OptimizerState(int64_t num_params, int64_t numel) {
+    for (int64_t i = 0; i < num_params; ++i) {
+      params.push_back(at::randn({numel}));
+      grads.push_back(at::randn({numel}));
+      first_moments.push_back(at::zeros({numel}));
+      second_moments.push_back(at::zeros({numel}));
+    }
+  }
+
+  std::vector<at::Tensor> params;
+  std::vector<at::Tensor> grads;
+  std::vector<at::Tensor> first_moments;
+  std::vector<at::Tensor> second_moments;
+};
+
+void set_items_processed(benchmark::State& state) {
+  state.SetItemsProcessed(
+      static_cast<int64_t>(state.iterations()) * state.range(0) *
+      state.range(1));
+}
+
+void BM_SGDMomentumUnfused(benchmark::State& state) {
+  OptimizerState s(state.range(0), state.range(1));
+  const double lr = 0.1, momentum = 0.9, weight_decay = 1e-4;
+  while (state.KeepRunning()) {
+    for (size_t i = 0; i < s.params.size(); ++i) {
+      auto update = s.grads[i] + weight_decay * s.params[i];
+      s.first_moments[i] = momentum * s.first_moments[i] + update;
+      s.params[i].add_(s.first_moments[i], -lr);
+    }
+  }
+  set_items_processed(state);
+}
+
+void BM_SGDMomentumFused(benchmark::State& state) {
+  OptimizerState s(state.range(0), state.range(1));
+  at::native::FusedSGDOptions options;
+  options.learning_rate = 0.1;
+  options.momentum = 0.9;
+  options.dampening = 1;
+  options.weight_decay = 1e-4;
+  options.nesterov = false;
+  while (state.KeepRunning()) {
+    at::native::fused_sgd_step_(s.params, s.grads, s.first_moments, options);
+  }
+  set_items_processed(state);
+}
+
+void BM_AdamUnfused(benchmark::State& state) {
+  OptimizerState s(state.range(0), state.range(1));
+  const double beta1 = 0.9, beta2 = 0.999, eps = 1e-8, step_size = 1e-3;
+  while (state.KeepRunning()) {
+    for (size_t i = 0; i < s.params.size(); ++i) {
+      s.first_moments[i].mul_(beta1).add_(s.grads[i], 1 - beta1);
+      s.second_moments[i].mul_(beta2).addcmul_(
+          s.grads[i], s.grads[i], 1 - beta2);
+      s.params[i].addcdiv_(
+          s.first_moments[i], s.second_moments[i].sqrt() + eps, -step_size);
+    }
+  }
+  set_items_processed(state);
+}
+
+void BM_AdamFused(benchmark::State& state) {
+  OptimizerState s(state.range(0), state.range(1));
+  at::native::FusedAdamOptions options;
+  options.beta1 = 0.9;
+  options.beta2 = 0.999;
+  options.eps = 1e-8;
+  options.weight_decay = 0;
+  options.amsgrad = false;
+  const std::vector<double> step_sizes(s.params.size(), 1e-3);
+  while (state.KeepRunning()) {
+    at::native::fused_adam_step_(
+        s.params,
+        s.grads,
+        s.first_moments,
+        s.second_moments,
+        {},
+        step_sizes,
+        options);
+  }
+  set_items_processed(state);
+}
+
+void BM_AdagradUnfused(benchmark::State& state) {
+  OptimizerState s(state.range(0), state.range(1));
+  const double lr = 0.01;
+  while (state.KeepRunning()) {
+    for (size_t i = 0; i < s.params.size(); ++i) {
+      s.first_moments[i].addcmul_(s.grads[i], s.grads[i], 1.0);
+      const auto std = s.first_moments[i].sqrt().add_(1e-10);
+      s.params[i].addcdiv_(s.grads[i], std, -lr);
+    }
+  }
+  set_items_processed(state);
+}
+
+void BM_AdagradFused(benchmark::State& state) {
+  OptimizerState s(state.range(0), state.range(1));
+  at::native::FusedAdagradOptions options;
+  options.weight_decay = 0;
+  options.eps = 1e-10;
+  const std::vector<double> learning_rates(s.params.size(), 0.01);
+  while (state.KeepRunning()) {
+    at::native::fused_adagrad_step_(
+        s.params, s.grads, s.first_moments, learning_rates, options);
+  }
+  set_items_processed(state);
+}
+
+void BM_RMSpropUnfused(benchmark::State& state) {
+  OptimizerState s(state.range(0), state.range(1));
+  const double lr = 0.01, alpha = 0.99, eps = 1e-8;
+  while (state.KeepRunning()) {
+    for (size_t i = 0; i < s.params.size(); ++i) {
+      s.second_moments[i].mul_(alpha).addcmul_(
+          s.grads[i], s.grads[i], 1.0 - alpha);
+      const auto average = s.second_moments[i].sqrt().add_(eps);
+      s.params[i].addcdiv_(s.grads[i], average, -lr);
+    }
+  }
+  set_items_processed(state);
+}
+
+void BM_RMSpropFused(benchmark::State& state) {
+  OptimizerState s(state.range(0), state.range(1));
+  at::native::FusedRMSpropOptions options;
+  options.learning_rate = 0.01;
+  options.alpha = 0.99;
+  options.eps = 1e-8;
+  options.weight_decay = 0;
+  options.momentum = 0;
+  options.centered = false;
+  while (state.KeepRunning()) {
+    at::native::fused_rmsprop_step_(
+        s.params, s.grads, s.second_moments, {}, {}, options);
+  }
+  set_items_processed(state);
+}
+
+// Many small parameters (overhead bound) down to a few large ones
+// (bandwidth bound).
+void OptimizerArgs(benchmark::internal::Benchmark* b) {
+  b->Args({4096, 64});
+  b->Args({1024, 1024});
+  b->Args({64, 65536});
+  b->Args({4, 1 << 22});
+}
+
+} // namespace
+
+BENCHMARK(BM_SGDMomentumUnfused)->Apply(OptimizerArgs);
+BENCHMARK(BM_SGDMomentumFused)->Apply(OptimizerArgs);
+BENCHMARK(BM_AdamUnfused)->Apply(OptimizerArgs);
+BENCHMARK(BM_AdamFused)->Apply(OptimizerArgs);
+BENCHMARK(BM_AdagradUnfused)->Apply(OptimizerArgs);
+BENCHMARK(BM_AdagradFused)->Apply(OptimizerArgs);
+BENCHMARK(BM_RMSpropUnfused)->Apply(OptimizerArgs);
+BENCHMARK(BM_RMSpropFused)->Apply(OptimizerArgs);
+
+BENCHMARK_MAIN();
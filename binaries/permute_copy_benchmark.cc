@@ -0,0 +1,115 @@
+// Measures .contiguous() of permuted tensors, which goes through the tiled
+// permute copy: transposed matrices, NCHW <-> NHWC, and the permute(0, 2, 1, 3)
+// of attention heads.
+//
+// Every BM_<Case> is paired with a BM_<Case>Strided, which writes the same
+// output through the strided TensorIterator loop that such copies took before
+// the tiled copy, by multiplying by one into a preallocated contiguous tensor.
+//
+// The argument is the size of the last dimension of the output.
+
+#include "benchmark/benchmark.h"
+
+#include <ATen/ATen.h>
+
+namespace {
+
+at::Tensor transposed(int64_t n, at::ScalarType type) {
+  return at::randn({n, n}).to(type).t();
+}
+
+at::Tensor nchw_to_nhwc(int64_t c) {
+  return at::randn({32, c, 56, 56}).permute({0, 2, 3, 1});
+}
+
+at::Tensor nhwc_to_nchw(int64_t w) {
+  return at::randn({32, 64, w, w}).permute({0, 2, 3, 1})
+      .contiguous().permute({0, 3, 1, 2});
+}
+
+at::Tensor split_heads(int64_t head_dim) {
+  // (batch, heads, sequence, head_dim) -> (batch, sequence, heads, head_dim)
+  return at::randn({32, 16, 128, head_dim}).permute({0, 2, 1, 3});
+}
+
+void runContiguous(benchmark::State& state, const at::Tensor& src) {
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(src.contiguous());
+  }
+  state.SetBytesProcessed(
+      state.iterations() * src.numel() * src.element_size() * 2);
+}
+
+void runStrided(benchmark::State& state, const at::Tensor& src) {
+  auto out = at::empty(src.sizes(), src.options());
+  while (state.KeepRunning()) {
+    at::mul_out(out, src, at::ones({}, src.options()));
+  }
+  state.SetBytesProcessed(
+      state.iterations() * src.numel() * src.element_size() * 2);
+}
+
+void BM_TransposeFloat(benchmark::State& state) {
+  runContiguous(state, transposed(state.range(0), at::kFloat));
+}
+
+void BM_TransposeFloatStrided(benchmark::State& state) {
+  runStrided(state, transposed(state.range(0), at::kFloat));
+}
+
+void BM_TransposeDouble(benchmark::State& state) {
+  runContiguous(state, transposed(state.range(0), at::kDouble));
+}
+
+void BM_TransposeDoubleStrided(benchmark::State& state) {
+  runStrided(state, transposed(state.range(0), at::kDouble));
+}
+
+void BM_TransposeByte(benchmark::State& state) {
+  runContiguous(state, transposed(state.range(0), at::kByte));
+}
+
+void BM_TransposeByteStrided(benchmark::State& state) {
+  runStrided(state, transposed(state.range(0), at::kByte));
+}
+
+void BM_NCHWToNHWC(benchmark::State& state) {
+  runContiguous(state, nchw_to_nhwc(state.range(0)));
+}
+
+void BM_NCHWToNHWCStrided(benchmark::State& state) {
+  runStrided(state, nchw_to_nhwc(state.range(0)));
+}
+
+void BM_NHWCToNCHW(benchmark::State& state) {
+  runContiguous(state, nhwc_to_nchw(state.range(0)));
+}
+
+void BM_NHWCToNCHWStrided(benchmark::State& state) {
+  runStrided(state, nhwc_to_nchw(state.range(0)));
+}
+
+void BM_SplitHeads(benchmark::State& state) {
+  runContiguous(state, split_heads(state.range(0)));
+}
+
+void BM_SplitHeadsStrided(benchmark::State& state) {
+  runStrided(state, split_heads(state.range(0)));
+}
+
+} // namespace
+
+BENCHMARK(BM_TransposeFloat)->Arg(256)->Arg(1024)->Arg(4096);
+BENCHMARK(BM_TransposeFloatStrided)->Arg(256)->Arg(1024)->Arg(4096);
+BENCHMARK(BM_TransposeDouble)->Arg(256)->Arg(1024)->Arg(4096);
+BENCHMARK(BM_TransposeDoubleStrided)->Arg(256)->Arg(1024)->Arg(4096);
+BENCHMARK(BM_TransposeByte)->Arg(256)->Arg(1024)->Arg(4096);
+BENCHMARK(BM_TransposeByteStrided)->Arg(256)->Arg(1024)->Arg(4096);
+BENCHMARK(BM_NCHWToNHWC)->Arg(3)->Arg(64)->Arg(256);
+BENCHMARK(BM_NCHWToNHWCStrided)->Arg(3)->Arg(64)->Arg(256);
+BENCHMARK(BM_NHWCToNCHW)->Arg(14)->Arg(56);
+BENCHMARK(BM_NHWCToNCHWStrided)->Arg(14)->Arg(56);
+BENCHMARK(BM_SplitHeads)->Arg(64);
+BENCHMARK(BM_SplitHeadsStrided)->Arg(64);
+
+BENCHMARK_MAIN();
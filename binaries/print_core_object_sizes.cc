@@ -0,0 +1,89 @@
+// Prints the sizes of the core tensor objects and the number of heap
+// allocations of a few common tensor operations, for plain tensors and
+// Variables. The GPU counterpart is print_core_object_sizes_gpu.
+//
+// Allocations are counted by replacing the global operator new, so the
+// numbers include every allocation on the calling thread (storage, TensorImpl,
+// autograd metadata, graph nodes, ...).
+
+#include <atomic>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <new>
+#include <string>
+
+#include <c10/core/StorageImpl.h>
+#include <c10/core/TensorImpl.h>
+#include <c10/core/impl/SizesAndStrides.h>
+#include <torch/csrc/autograd/variable.h>
+#include <torch/types.h>
+#include <torch/utils.h>
+
+namespace {
+std::atomic<int64_t> num_allocations{0};
+} // namespace
+
+void* operator new(size_t size) {
+  num_allocations.fetch_add(1, std::memory_order_relaxed);
+  if (void* ptr = std::malloc(size)) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept {
+  std::free(ptr);
+}
+
+#define PRINT_SIZE(cls) \
+  std::cout << "Size of " #cls ": " << sizeof(cls) << " bytes." \
+            << std::endl;
+
+namespace {
+
+constexpr int kIterations = 1000;
+
+// Prints the average number of allocations of `op`, after a warm-up run that
+// fills the caches and pools.
+void print_allocations(const std::string& name, const std::function<void()>& op) {
+  op();
+  const int64_t before = num_allocations.load();
+  for (int i = 0; i < kIterations; ++i) {
+    op();
+  }
+  const double per_op =
+      static_cast<double>(num_allocations.load() - before) / kIterations;
+  std::cout << "Allocations of " << name << ": " << per_op << std::endl;
+}
+
+void print_tensor_allocations(const std::string& kind, const at::Tensor& x) {
+  auto y = x.clone();
+  print_allocations(kind + " empty", [&] { at::empty({4, 8}, x.options()); });
+  print_allocations(kind + " select", [&] { x.select(0, 1); });
+  print_allocations(kind + " view", [&] { x.view({-1}); });
+  print_allocations(kind + " transpose", [&] { x.t(); });
+  print_allocations(kind + " add", [&] { at::add(x, y); });
+  print_allocations(kind + " add_", [&] { y.add_(x); });
+}
+
+} // namespace
+
+int main(int /* unused */, char** /* unused */) {
+  PRINT_SIZE(c10::TensorImpl);
+  PRINT_SIZE(c10::impl::SizesAndStrides);
+  PRINT_SIZE(c10::StorageImpl);
+  PRINT_SIZE(c10::VariableVersion);
+  PRINT_SIZE(at::Tensor);
+  PRINT_SIZE(torch::autograd::Variable::AutogradMeta);
+
+  print_tensor_allocations("plain", at::randn({4, 8}));
+  print_tensor_allocations("variable", torch::randn({4, 8}));
+  print_tensor_allocations(
+      "variable (requires grad)", torch::randn({4, 8}, torch::requires_grad()));
+  {
+    torch::NoGradGuard guard;
+    print_tensor_allocations("variable (no grad)", torch::randn({4, 8}));
+  }
+  return 0;
+}
@@ -0,0 +1,102 @@
+// Compares the default torch::serialize archives with the streaming format
+// (torch/serialize/stream.h): save and load throughput, and the time until a
+// training loop may continue after an asynchronous save.
+//
+// Arguments are {number of tensors, elements per tensor}.
+
+#include "benchmark/benchmark.h"
+
+#include <c10/util/tempfile.h>
+#include <torch/serialize.h>
+#include <torch/types.h>
+
+#include <vector>
+
+namespace {
+
+std::vector<torch::Tensor> make_tensors(benchmark::State& state) {
+  std::vector<torch::Tensor> tensors;
+  for (int64_t i = 0; i < state.range(0); ++i) {
+    tensors.push_back(torch::randn({state.range(1)}));
+  }
+  return tensors;
+}
+
+void set_bytes_processed(benchmark::State& state) {
+  state.SetBytesProcessed(
+      static_cast<int64_t>(state.iterations()) * state.range(0) *
+      state.range(1) * sizeof(float));
+}
+
+void BM_Save(benchmark::State& state) {
+  const auto tensors = make_tensors(state);
+  const auto tempfile = c10::make_tempfile();
+  while (state.KeepRunning()) {
+    torch::save(tensors, tempfile.name);
+  }
+  set_bytes_processed(state);
+}
+
+void BM_SaveStreaming(benchmark::State& state) {
+  const auto tensors = make_tensors(state);
+  const auto tempfile = c10::make_tempfile();
+  while (state.KeepRunning()) {
+    torch::save_streaming(tensors, tempfile.name);
+  }
+  set_bytes_processed(state);
+}
+
+// Only the time until `save_async` returns, i.e. the time the caller is
+// blocked. The file is completed outside of the timed region.
+void BM_SaveAsync(benchmark::State& state) {
+  const auto tensors = make_tensors(state);
+  const auto tempfile = c10::make_tempfile();
+  while (state.KeepRunning()) {
+    auto done = torch::save_async(tensors, tempfile.name);
+    state.PauseTiming();
+    done.get();
+    state.ResumeTiming();
+  }
+  set_bytes_processed(state);
+}
+
+void BM_Load(benchmark::State& state) {
+  const auto tempfile = c10::make_tempfile();
+  torch::save(make_tensors(state), tempfile.name);
+  std::vector<torch::Tensor> tensors;
+  while (state.KeepRunning()) {
+    torch::load(tensors, tempfile.name);
+  }
+  set_bytes_processed(state);
+}
+
+// Loading maps the file; the data is read when the tensors are first used,
+// which the sum does.
+void BM_LoadStreaming(benchmark::State& state) {
+  const auto tempfile = c10::make_tempfile();
+  torch::save_streaming(make_tensors(state), tempfile.name);
+  std::vector<torch::Tensor> tensors;
+  while (state.KeepRunning()) {
+    torch::load(tensors, tempfile.name);
+    for (const auto& tensor : tensors) {
+      benchmark::DoNotOptimize(tensor.sum());
+    }
+  }
+  set_bytes_processed(state);
+}
+
+void SerializeArgs(benchmark::internal::Benchmark* b) {
+  b->Args({1024, 256});
+  b->Args({64, 1 << 16});
+  b->Args({8, 1 << 23});
+}
+
+} // namespace
+
+BENCHMARK(BM_Save)->Apply(SerializeArgs);
+BENCHMARK(BM_SaveStreaming)->Apply(SerializeArgs);
+BENCHMARK(BM_SaveAsync)->Apply(SerializeArgs);
+BENCHMARK(BM_Load)->Apply(SerializeArgs);
+BENCHMARK(BM_LoadStreaming)->Apply(SerializeArgs);
+
+BENCHMARK_MAIN();
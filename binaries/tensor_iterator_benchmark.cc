@@ -0,0 +1,83 @@
+// Measures the time per op of small elementwise ops, for which setting up the
+// TensorIterator can cost more than the kernel: add and mul of contiguous
+// tensors, add of a scalar, and relu, in and out of place. Ops on transposed
+// tensors go through the general set up, for comparison.
+//
+// The argument is the number of elements per tensor; the reported time is
+// in nanoseconds per op.
+
+#include "benchmark/benchmark.h"
+
+#include <ATen/ATen.h>
+
+namespace {
+
+void BM_Add(benchmark::State& state) {
+  auto a = at::randn({state.range(0)});
+  auto b = at::randn({state.range(0)});
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(at::add(a, b));
+  }
+}
+
+void BM_AddInPlace(benchmark::State& state) {
+  auto a = at::randn({state.range(0)});
+  auto b = at::randn({state.range(0)});
+  while (state.KeepRunning()) {
+    a.add_(b);
+  }
+}
+
+void BM_AddScalar(benchmark::State& state) {
+  auto a = at::randn({state.range(0)});
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(at::add(a, 2));
+  }
+}
+
+void BM_Mul(benchmark::State& state) {
+  auto a = at::randn({state.range(0)});
+  auto b = at::randn({state.range(0)});
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(at::mul(a, b));
+  }
+}
+
+void BM_Relu(benchmark::State& state) {
+  auto a = at::randn({state.range(0)});
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(at::relu(a));
+  }
+}
+
+void BM_ReluInPlace(benchmark::State& state) {
+  auto a = at::randn({state.range(0)});
+  while (state.KeepRunning()) {
+    a.relu_();
+  }
+}
+
+void BM_AddTransposed(benchmark::State& state) {
+  auto a = at::randn({2, state.range(0) / 2}).t();
+  auto b = at::randn({2, state.range(0) / 2}).t();
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(at::add(a, b));
+  }
+}
+
+void sizes(benchmark::internal::Benchmark* b) {
+  b->RangeMultiplier(4)->Range(1, 4096)->Unit(benchmark::kNanosecond);
+}
+
+} // namespace
+
+BENCHMARK(BM_Add)->Apply(sizes);
+BENCHMARK(BM_AddInPlace)->Apply(sizes);
+BENCHMARK(BM_AddScalar)->Apply(sizes);
+BENCHMARK(BM_Mul)->Apply(sizes);
+BENCHMARK(BM_Relu)->Apply(sizes);
+BENCHMARK(BM_ReluInPlace)->Apply(sizes);
+BENCHMARK(BM_AddTransposed)->RangeMultiplier(4)->Range(4, 4096)->Unit(
+    benchmark::kNanosecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,72 @@
+// Measures the rate at which views are created in a select loop, as in
+// indexing-heavy code like attention or beam search: for plain tensors, for
+// Variables with and without autograd views, and for StridedView, which
+// kernels use to slice tensors without creating any.
+//
+// The argument is the number of rows selected per iteration.
+
+#include "benchmark/benchmark.h"
+
+#include <ATen/native/StridedView.h>
+#include <torch/csrc/autograd/variable.h>
+#include <torch/types.h>
+#include <torch/utils.h>
+
+namespace {
+
+constexpr int64_t kRowSize = 64;
+
+void select_rows(benchmark::State& state, const at::Tensor& x) {
+  const int64_t rows = state.range(0);
+  while (state.KeepRunning()) {
+    for (int64_t i = 0; i < rows; ++i) {
+      auto row = x.select(0, i);
+      benchmark::DoNotOptimize(row);
+    }
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * rows);
+}
+
+void BM_SelectPlain(benchmark::State& state) {
+  select_rows(state, at::randn({state.range(0), kRowSize}));
+}
+
+void BM_SelectVariable(benchmark::State& state) {
+  select_rows(state, torch::randn({state.range(0), kRowSize}));
+}
+
+void BM_SelectVariableNoGrad(benchmark::State& state) {
+  auto x = torch::randn({state.range(0), kRowSize});
+  torch::NoGradGuard guard;
+  select_rows(state, x);
+}
+
+// Creates differentiable views, which track their base and get a grad_fn.
+void BM_SelectVariableRequiresGrad(benchmark::State& state) {
+  select_rows(
+      state,
+      torch::randn({state.range(0), kRowSize}, torch::requires_grad()));
+}
+
+void BM_SelectStridedView(benchmark::State& state) {
+  const int64_t rows = state.range(0);
+  auto x = at::randn({rows, kRowSize});
+  at::native::StridedView<float> view(x);
+  while (state.KeepRunning()) {
+    for (int64_t i = 0; i < rows; ++i) {
+      auto row = view.select(0, i);
+      benchmark::DoNotOptimize(row);
+    }
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * rows);
+}
+
+} // namespace
+
+BENCHMARK(BM_SelectPlain)->Arg(16)->Arg(1024);
+BENCHMARK(BM_SelectVariable)->Arg(16)->Arg(1024);
+BENCHMARK(BM_SelectVariableNoGrad)->Arg(16)->Arg(1024);
+BENCHMARK(BM_SelectVariableRequiresGrad)->Arg(16)->Arg(1024);
+BENCHMARK(BM_SelectStridedView)->Arg(16)->Arg(1024);
+
+BENCHMARK_MAIN();
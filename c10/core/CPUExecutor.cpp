@@ -0,0 +1,332 @@
+#include <c10/core/CPUExecutor.h>
+
+#include <algorithm>
+#include <exception>
+
+#include <c10/util/thread_name.h>
+
+C10_DEFINE_bool(
+    caffe2_cpu_executor,
+    false,
+    "If set, the caffe2 and ATen CPU thread pools run their work on a single "
+    "process-wide executor");
+
+C10_DEFINE_int(
+    caffe2_cpu_executor_num_threads,
+    0,
+    "Total number of threads of the process-wide CPU executor, including "
+    "the threads that start parallel regions; 0 for one per core");
+
+namespace c10 {
+
+namespace {
+
+thread_local bool is_worker_thread = false;
+thread_local size_t parallel_region_depth = 0;
+thread_local size_t current_slot = 0;
+
+using Clock = std::chrono::steady_clock;
+
+uint64_t nanoseconds_since(Clock::time_point start) {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             Clock::now() - start)
+      .count();
+}
+
+} // namespace
+
+struct CPUExecutor::Region {
+  Region(
+      const std::function<void(size_t, size_t)>* fn,
+      size_t num_tasks,
+      size_t max_participants)
+      : fn(fn), num_tasks(num_tasks), max_participants(max_participants) {}
+
+  const std::function<void(size_t, size_t)>* const fn;
+  const size_t num_tasks;
+  const size_t max_participants;
+  std::atomic<size_t> next_task{0};
+  std::atomic<bool> failed{false};
+  std::exception_ptr error;
+  // Guarded by the executor mutex. Slot 0 belongs to the caller.
+  size_t next_slot = 1;
+  size_t active_workers = 0;
+};
+
+CPUExecutor::CPUExecutor(size_t num_threads) {
+  const size_t num_workers = num_threads > 1 ? num_threads - 1 : 0;
+  workers_.reserve(num_workers);
+  for (size_t i = 0; i < num_workers; ++i) {
+    workers_.emplace_back([this]() { workerLoop(); });
+  }
+}
+
+CPUExecutor::~CPUExecutor() {
+  {
+    auto guard = lock();
+    running_ = false;
+    work_available_.notify_all();
+  }
+  for (auto& worker : workers_) {
+    worker.join();
+  }
+}
+
+std::unique_lock<std::mutex> CPUExecutor::lock() const {
+  std::unique_lock<std::mutex> guard(mutex_, std::try_to_lock);
+  if (!guard.owns_lock()) {
+    lock_contentions_.fetch_add(1, std::memory_order_relaxed);
+    guard.lock();
+  }
+  return guard;
+}
+
+size_t CPUExecutor::runTasks(Region* region, size_t slot) {
+  const size_t outer_slot = current_slot;
+  current_slot = slot;
+  ++parallel_region_depth;
+  size_t num_tasks = 0;
+  while (true) {
+    const size_t task =
+        region->next_task.fetch_add(1, std::memory_order_relaxed);
+    if (task >= region->num_tasks) {
+      break;
+    }
+    ++num_tasks;
+    // Once a task failed, the remaining ones are skipped.
+    if (region->failed.load(std::memory_order_relaxed)) {
+      continue;
+    }
+    try {
+      (*region->fn)(slot, task);
+    } catch (...) {
+      if (!region->failed.exchange(true)) {
+        region->error = std::current_exception();
+      }
+    }
+  }
+  --parallel_region_depth;
+  current_slot = outer_slot;
+  return num_tasks;
+}
+
+void CPUExecutor::run(
+    size_t num_tasks,
+    size_t max_parallelism,
+    const std::function<void(size_t, size_t)>& fn) {
+  if (num_tasks == 0) {
+    return;
+  }
+  size_t max_participants = std::min(num_tasks, numThreads());
+  if (max_parallelism > 0) {
+    max_participants = std::min(max_participants, max_parallelism);
+  }
+
+  Region region(&fn, num_tasks, max_participants);
+  if (max_participants <= 1 || inParallelRegion()) {
+    inline_regions_.fetch_add(1, std::memory_order_relaxed);
+    runTasks(&region, 0);
+  } else {
+    parallel_regions_.fetch_add(1, std::memory_order_relaxed);
+    {
+      auto guard = lock();
+      regions_.push_back(&region);
+      const size_t wakeups = std::min(max_participants - 1, idle_workers_);
+      for (size_t i = 0; i < wakeups; ++i) {
+        work_available_.notify_one();
+      }
+    }
+    runTasks(&region, 0);
+    {
+      // No worker joins the region once it is out of the queue, so it is done
+      // when the workers that joined it have returned.
+      auto guard = lock();
+      regions_.erase(std::find(regions_.begin(), regions_.end(), &region));
+      region_done_.wait(guard, [&]() { return region.active_workers == 0; });
+    }
+  }
+  if (region.error) {
+    std::rethrow_exception(region.error);
+  }
+}
+
+void CPUExecutor::submit(std::function<void()> task) {
+  async_tasks_submitted_.fetch_add(1, std::memory_order_relaxed);
+  if (workers_.empty()) {
+    // Without workers, the only thread is the caller.
+    try {
+      task();
+    } catch (const std::exception&) {
+    }
+    async_tasks_completed_.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  auto guard = lock();
+  async_tasks_.push_back(AsyncTask{std::move(task), Clock::now()});
+  if (idle_workers_ > 0) {
+    work_available_.notify_one();
+  }
+}
+
+void CPUExecutor::workerLoop() {
+  setThreadName("CPUExecutor");
+  is_worker_thread = true;
+
+  auto guard = lock();
+  while (true) {
+    Region* region = nullptr;
+    for (auto* r : regions_) {
+      if (r->next_slot < r->max_participants &&
+          r->next_task.load(std::memory_order_relaxed) < r->num_tasks) {
+        region = r;
+        break;
+      }
+    }
+    if (region) {
+      const size_t slot = region->next_slot++;
+      ++region->active_workers;
+      guard.unlock();
+
+      const auto start = Clock::now();
+      stolen_tasks_.fetch_add(
+          runTasks(region, slot), std::memory_order_relaxed);
+      worker_busy_ns_.fetch_add(
+          nanoseconds_since(start), std::memory_order_relaxed);
+
+      guard.lock();
+      if (--region->active_workers == 0) {
+        region_done_.notify_all();
+      }
+      continue;
+    }
+
+    if (!async_tasks_.empty()) {
+      {
+        AsyncTask task = std::move(async_tasks_.front());
+        async_tasks_.pop_front();
+        guard.unlock();
+
+        const auto start = Clock::now();
+        async_queue_wait_ns_.fetch_add(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                start - task.submitted)
+                .count(),
+            std::memory_order_relaxed);
+        // Exceptions of async tasks are dropped, as in c10::ThreadPool.
+        try {
+          task.fn();
+        } catch (const std::exception&) {
+        }
+        worker_busy_ns_.fetch_add(
+            nanoseconds_since(start), std::memory_order_relaxed);
+        async_tasks_completed_.fetch_add(1, std::memory_order_relaxed);
+        // The task is destroyed before taking the lock again, in case it
+        // holds resources that are released by other work.
+      }
+      guard.lock();
+      continue;
+    }
+
+    if (!running_) {
+      break;
+    }
+    ++idle_workers_;
+    const auto start = Clock::now();
+    work_available_.wait(guard);
+    --idle_workers_;
+    worker_idle_ns_.fetch_add(
+        nanoseconds_since(start), std::memory_order_relaxed);
+    worker_wakeups_.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+size_t CPUExecutor::numIdleWorkers() const {
+  auto guard = lock();
+  return idle_workers_;
+}
+
+bool CPUExecutor::inWorkerThread() {
+  return is_worker_thread;
+}
+
+bool CPUExecutor::inParallelRegion() {
+  return parallel_region_depth > 0;
+}
+
+size_t CPUExecutor::currentSlot() {
+  return current_slot;
+}
+
+CPUExecutorStats CPUExecutor::stats() const {
+  CPUExecutorStats stats;
+  stats.parallel_regions = parallel_regions_.load();
+  stats.inline_regions = inline_regions_.load();
+  stats.stolen_tasks = stolen_tasks_.load();
+  stats.async_tasks_submitted = async_tasks_submitted_.load();
+  stats.async_tasks_completed = async_tasks_completed_.load();
+  stats.async_queue_wait_ns = async_queue_wait_ns_.load();
+  stats.lock_contentions = lock_contentions_.load();
+  stats.worker_idle_ns = worker_idle_ns_.load();
+  stats.worker_busy_ns = worker_busy_ns_.load();
+  stats.worker_wakeups = worker_wakeups_.load();
+  return stats;
+}
+
+void CPUExecutor::resetStats() {
+  parallel_regions_ = 0;
+  inline_regions_ = 0;
+  stolen_tasks_ = 0;
+  async_tasks_submitted_ = 0;
+  async_tasks_completed_ = 0;
+  async_queue_wait_ns_ = 0;
+  lock_contentions_ = 0;
+  worker_idle_ns_ = 0;
+  worker_busy_ns_ = 0;
+  worker_wakeups_ = 0;
+}
+
+bool cpu_executor_enabled() {
+  return FLAGS_caffe2_cpu_executor;
+}
+
+CPUExecutor& cpu_executor() {
+  static CPUExecutor* executor = []() {
+    int num_threads = FLAGS_caffe2_cpu_executor_num_threads;
+    if (num_threads <= 0) {
+      num_threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    return new CPUExecutor(num_threads);
+  }();
+  return *executor;
+}
+
+namespace {
+
+class CPUExecutorTaskPool final : public TaskThreadPoolBase {
+ public:
+  void run(const std::function<void()>& func) override {
+    cpu_executor().submit(func);
+  }
+
+  size_t size() const override {
+    return cpu_executor().numThreads() - 1;
+  }
+
+  size_t numAvailable() const override {
+    return cpu_executor().numIdleWorkers();
+  }
+
+  bool inThreadPool() const override {
+    return CPUExecutor::inWorkerThread();
+  }
+};
+
+} // namespace
+
+std::shared_ptr<TaskThreadPoolBase> cpu_executor_task_pool() {
+  static std::shared_ptr<TaskThreadPoolBase> pool =
+      std::make_shared<CPUExecutorTaskPool>();
+  return pool;
+}
+
+} // namespace c10
@@ -0,0 +1,162 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <c10/core/thread_pool.h>
+#include <c10/macros/Macros.h>
+#include <c10/util/Flags.h>
+
+C10_DECLARE_bool(caffe2_cpu_executor);
+C10_DECLARE_int(caffe2_cpu_executor_num_threads);
+
+namespace c10 {
+
+/**
+ * Counters of a CPUExecutor, accumulated since its creation or the last
+ * resetStats().
+ */
+struct CPUExecutorStats {
+  // Parallel regions that were offered to the worker threads.
+  uint64_t parallel_regions = 0;
+  // Parallel regions that ran on the calling thread only, because they were
+  // nested in another region, had a single task, or the executor has no
+  // workers.
+  uint64_t inline_regions = 0;
+  // Tasks of parallel regions run by worker threads rather than the callers.
+  uint64_t stolen_tasks = 0;
+  uint64_t async_tasks_submitted = 0;
+  uint64_t async_tasks_completed = 0;
+  // Total time that async tasks waited in the queue before they started.
+  uint64_t async_queue_wait_ns = 0;
+  // Number of times a thread found the executor lock held by another thread.
+  uint64_t lock_contentions = 0;
+  // Total time worker threads spent parked without work, and running work.
+  uint64_t worker_idle_ns = 0;
+  uint64_t worker_busy_ns = 0;
+  // Number of times a parked worker thread was woken up.
+  uint64_t worker_wakeups = 0;
+};
+
+/**
+ * A process-wide pool of CPU threads shared by the thread pools of caffe2
+ * and ATen, so that a process runs a single set of threads instead of one
+ * per pool.
+ *
+ * It runs two kinds of work:
+ *  - parallel regions (run), where the calling thread and any idle workers
+ *    claim the tasks of the region until all are done. The caller always
+ *    takes part, so a region completes even when all workers are busy, and
+ *    a region started within another region runs inline on the calling
+ *    thread, as with OpenMP.
+ *  - async tasks (submit), which are queued and run by workers. Workers pick
+ *    up parallel regions before async tasks.
+ *
+ * Idle workers park on a condition variable instead of spinning.
+ *
+ * With --caffe2_cpu_executor, caffe2::ThreadPool (and the pthreadpool
+ * interface built on it for NNPACK), at::parallel_for / at::parallel_reduce
+ * and the CPU pools of the async nets and of the JIT inter-op work queue all
+ * run on cpu_executor(), which has --caffe2_cpu_executor_num_threads threads
+ * in total, callers included.
+ */
+class C10_API CPUExecutor {
+ public:
+  // Creates an executor for `num_threads` threads: `num_threads - 1` workers
+  // plus the thread calling run().
+  explicit CPUExecutor(size_t num_threads);
+  ~CPUExecutor();
+
+  C10_DISABLE_COPY_AND_ASSIGN(CPUExecutor);
+
+  // Total number of threads, counting the caller of run().
+  size_t numThreads() const {
+    return workers_.size() + 1;
+  }
+
+  // Calls fn(slot, task) for every task in [0, num_tasks) on the calling
+  // thread and on up to `max_parallelism - 1` idle workers (0 for no limit),
+  // and returns when all tasks are done. `slot` identifies the thread running
+  // the task among those taking part in this call and is less than
+  // `max_parallelism`; the calling thread has slot 0. Rethrows the first
+  // exception thrown by fn, after all the tasks that started have finished.
+  void run(
+      size_t num_tasks,
+      size_t max_parallelism,
+      const std::function<void(size_t, size_t)>& fn);
+
+  // Queues a task to run on a worker thread.
+  void submit(std::function<void()> task);
+
+  // Number of worker threads waiting for work.
+  size_t numIdleWorkers() const;
+
+  // Returns true on the worker threads of any CPUExecutor.
+  static bool inWorkerThread();
+
+  // Returns true within the tasks of a parallel region.
+  static bool inParallelRegion();
+
+  // The slot of the current thread in the innermost parallel region, or 0
+  // outside of parallel regions.
+  static size_t currentSlot();
+
+  CPUExecutorStats stats() const;
+  void resetStats();
+
+ private:
+  struct Region;
+  struct AsyncTask {
+    std::function<void()> fn;
+    std::chrono::steady_clock::time_point submitted;
+  };
+
+  std::unique_lock<std::mutex> lock() const;
+  void workerLoop();
+  // Runs tasks of the region until none is left, and returns how many.
+  static size_t runTasks(Region* region, size_t slot);
+
+  std::vector<std::thread> workers_;
+  mutable std::mutex mutex_;
+  std::condition_variable work_available_;
+  std::condition_variable region_done_;
+  // Guarded by mutex_.
+  std::deque<Region*> regions_;
+  std::deque<AsyncTask> async_tasks_;
+  size_t idle_workers_ = 0;
+  bool running_ = true;
+
+  mutable std::atomic<uint64_t> parallel_regions_{0};
+  mutable std::atomic<uint64_t> inline_regions_{0};
+  mutable std::atomic<uint64_t> stolen_tasks_{0};
+  mutable std::atomic<uint64_t> async_tasks_submitted_{0};
+  mutable std::atomic<uint64_t> async_tasks_completed_{0};
+  mutable std::atomic<uint64_t> async_queue_wait_ns_{0};
+  mutable std::atomic<uint64_t> lock_contentions_{0};
+  mutable std::atomic<uint64_t> worker_idle_ns_{0};
+  mutable std::atomic<uint64_t> worker_busy_ns_{0};
+  mutable std::atomic<uint64_t> worker_wakeups_{0};
+};
+
+// Returns true if the thread pools should delegate to cpu_executor().
+C10_API bool cpu_executor_enabled();
+
+// The process-wide executor, created on first use with
+// --caffe2_cpu_executor_num_threads threads, or one per core if 0. It is
+// never destroyed, so that it can be used during static destruction.
+C10_API CPUExecutor& cpu_executor();
+
+// A TaskThreadPoolBase that submits its tasks to cpu_executor(), which the
+// async net and JIT inter-op thread pool registries return instead of their
+// own pools when cpu_executor_enabled().
+C10_API std::shared_ptr<TaskThreadPoolBase> cpu_executor_task_pool();
+
+} // namespace c10
@@ -2,6 +2,7 @@
 
 #include <c10/core/Backend.h>
 #include <c10/core/WrapDimMinimal.h>
+#include <c10/core/impl/LocalBlockPool.h>
 #include <c10/util/Optional.h>
 
 C10_DEFINE_bool(
@@ -33,6 +34,14 @@ const at::Tensor& TensorImpl::grad() const {
   }
 }
 
+void* TensorImpl::operator new(size_t size) {
+  return impl::local_pool_allocate(size);
+}
+
+void TensorImpl::operator delete(void* ptr, size_t size) {
+  impl::local_pool_free(ptr, size);
+}
+
 TensorImpl::TensorImpl(Storage&& storage, TensorTypeId type_id)
     : TensorImpl(std::move(storage), type_id, storage.dtype(), storage.device()) {}
 
@@ -42,43 +51,47 @@ TensorImpl::TensorImpl(TensorTypeId type_id, const caffe2::TypeMeta& data_type,
 TensorImpl::TensorImpl(Storage&& storage, TensorTypeId type_id, const caffe2::TypeMeta& data_type,
                        c10::optional<c10::Device> device_opt)
     : storage_(std::move(storage)),
-      sizes_{0},
       storage_offset_(0),
       numel_(0),
       data_type_(data_type),
       device_opt_(device_opt),
-      type_id_(type_id) {
+      type_id_(type_id),
+      is_contiguous_(true),
+      is_wrapped_number_(false),
+      allow_tensor_metadata_change_(true),
+      reserved_(false) {
   AT_ASSERT(type_id == UndefinedTensorId() || data_type.id() ==  caffe2::TypeIdentifier::uninitialized() ||
             device_opt_.has_value());
   // we would also like to check that non-cpu devices have an index, but some Caffe2 operators create
   // Storages with default devices.
-  strides_.push_back(1);
 }
 
 IntArrayRef TensorImpl::sizes() const {
-  return sizes_;
+  return sizes_and_strides_.sizes_arrayref();
 }
 
 IntArrayRef TensorImpl::strides() const {
-  return strides_;
+  return sizes_and_strides_.strides_arrayref();
 }
 
 bool TensorImpl::compute_contiguous() const {
-  bool is_contiguous = true;
-  if (is_empty())
-    return is_contiguous;
+  if (numel_ == 0)
+    return true;
+  // Reads the fields directly: this runs on every change of sizes or strides,
+  // and the virtual accessors would wrap every dimension.
+  const int64_t* sizes = sizes_and_strides_.sizes_data();
+  const int64_t* strides = sizes_and_strides_.strides_data();
   int64_t z = 1;
-  for (int64_t d = dim() - 1; d >= 0; d--) {
-    if (size(d) != 1) {
-      if (stride(d) == z) {
-        z *= size(d);
+  for (int64_t d = static_cast<int64_t>(sizes_and_strides_.size()) - 1; d >= 0; d--) {
+    if (sizes[d] != 1) {
+      if (strides[d] == z) {
+        z *= sizes[d];
       } else {
-        is_contiguous = false;
-        break;
+        return false;
       }
     }
   }
-  return is_contiguous;
+  return true;
 }
 
 void TensorImpl::release_resources() {
@@ -88,17 +101,17 @@ void TensorImpl::release_resources() {
 }
 
 int64_t TensorImpl::dim() const {
-  return sizes_.size();
+  return sizes_and_strides_.size();
 }
 
 int64_t TensorImpl::size(int64_t d) const {
   d = at::maybe_wrap_dim(d, dim(), false);
-  return sizes_[d];
+  return sizes_and_strides_.size_at(d);
 }
 
 int64_t TensorImpl::stride(int64_t d) const {
   d = at::maybe_wrap_dim(d, dim(), false);
-  return strides_[d];
+  return sizes_and_strides_.stride_at(d);
 }
 
 TensorImpl* TensorImpl::maybe_zero_dim(bool condition_when_zero_dim) {
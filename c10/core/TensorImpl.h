@@ -10,6 +10,7 @@
 #include <c10/core/TensorTypeId.h>
 #include <c10/core/TensorTypeIdRegistration.h>
 #include <c10/core/CopyBytes.h>
+#include <c10/core/impl/SizesAndStrides.h>
 
 #include <c10/util/Exception.h>
 #include <c10/util/Optional.h>
@@ -290,6 +291,14 @@ struct C10_API TensorImpl : public c10::intrusive_ptr_target {
   TensorImpl(TensorImpl&&) = default;
   TensorImpl& operator=(TensorImpl&&) = default;
 
+  /**
+   * Views and temporaries create and free TensorImpls at a high rate, so
+   * TensorImpls (including those of subclasses) are allocated from
+   * per-thread free lists. See c10/core/impl/LocalBlockPool.h.
+   */
+  static void* operator new(size_t size);
+  static void operator delete(void* ptr, size_t size);
+
   /**
    * Release (decref) storage, and any other external allocations.  This
    * override is for `intrusive_ptr_target` and is used to implement weak
@@ -736,8 +745,7 @@ struct C10_API TensorImpl : public c10::intrusive_ptr_target {
    */
   virtual void resize_dim(int64_t ndim) {
     AT_CHECK(allow_tensor_metadata_change(), "resize_dim is not allowed on Tensor created from .data or .detach()");
-    sizes_.resize(ndim, 0);
-    strides_.resize(ndim, 0);
+    sizes_and_strides_.resize(ndim);
     refresh_numel();
     refresh_contiguous();
   }
@@ -752,7 +760,11 @@ struct C10_API TensorImpl : public c10::intrusive_ptr_target {
    */
   virtual void set_size(int64_t dim, int64_t new_size) {
     AT_CHECK(allow_tensor_metadata_change(), "set_size is not allowed on Tensor created from .data or .detach()");
-    sizes_.at(dim) = new_size;
+    AT_CHECK(
+        dim >= 0 && static_cast<size_t>(dim) < sizes_and_strides_.size(),
+        "dimension ", dim, " out of range for a tensor of dimension ",
+        sizes_and_strides_.size());
+    sizes_and_strides_.size_at(dim) = new_size;
     refresh_numel();
     refresh_contiguous();
   }
@@ -765,7 +777,7 @@ struct C10_API TensorImpl : public c10::intrusive_ptr_target {
    */
   virtual void set_stride(int64_t dim, int64_t new_stride) {
     AT_CHECK(allow_tensor_metadata_change(), "set_stride is not allowed on Tensor created from .data or .detach()");
-    strides_[dim] = new_stride;
+    sizes_and_strides_.stride_at(dim) = new_stride;
     refresh_numel();
     refresh_contiguous();
   }
@@ -795,13 +807,8 @@ struct C10_API TensorImpl : public c10::intrusive_ptr_target {
   void set_sizes_contiguous(IntArrayRef new_size) {
     AT_CHECK(allow_tensor_metadata_change(), "set_sizes_contiguous is not allowed on Tensor created from .data or .detach()");
     AT_ASSERT(!is_variable());  // TODO: remove this when Variable and Tensor are merged
-    auto old_dim = sizes_.size();
-    auto new_dim = new_size.size();
-
-    sizes_.resize(new_dim);
-    for (size_t dim = 0; dim < new_dim; ++dim) {
-      sizes_[dim] = new_size[dim];
-    }
+    auto old_dim = sizes_and_strides_.size();
+    sizes_and_strides_.set_sizes(new_size);
 
     update_to_contiguous_strides(old_dim);
     refresh_numel();
@@ -829,25 +836,23 @@ struct C10_API TensorImpl : public c10::intrusive_ptr_target {
         ")");
     auto new_dim = new_size.size();
 
-    sizes_.resize(new_dim);
-    for (size_t dim = 0; dim < new_dim; ++dim) {
-      sizes_[dim] = new_size[dim];
-    }
+    sizes_and_strides_.set_sizes(new_size);
 
-    strides_.resize(new_dim);
     if (new_dim > 0) {
+      int64_t* strides = sizes_and_strides_.strides_data();
+      const int64_t* sizes = sizes_and_strides_.sizes_data();
       for (size_t dim = new_dim - 1; ; dim--) {
         if (new_stride[dim] >= 0) {
-          strides_[dim] = new_stride[dim];
+          strides[dim] = new_stride[dim];
         } else {
           // XXX: This behavior is surprising and may need to be removed to
           // support negative strides. Some pytorch functions rely on it:
           // for example, torch.cat (run TestTorch.test_cat_empty).
           if (dim == new_dim - 1) {
-            strides_[dim] = 1;
+            strides[dim] = 1;
           } else {
             // Keep stride monotonically increasing to match NumPy.
-            strides_[dim] = std::max<int64_t>(sizes_[dim + 1], 1) * strides_[dim + 1];
+            strides[dim] = std::max<int64_t>(sizes[dim + 1], 1) * strides[dim + 1];
           }
         }
         if (dim == 0) break;
@@ -992,12 +997,12 @@ struct C10_API TensorImpl : public c10::intrusive_ptr_target {
    * This op is auto-asynchronous if the underlying device (CUDA) supports it.
    */
   void Extend(int64_t num, float growthPct) {
-    AT_ASSERT(sizes_.size() >= 1u);
+    AT_ASSERT(sizes_and_strides_.size() >= 1u);
     AT_ASSERTM(num >= 0, "`num` must be non-negative for Extend");
     AT_ASSERTM(
         is_contiguous_,
         "Right now Extend is only supported for contiguous Tensor.");
-    auto newDims = sizes_;
+    auto newDims = sizes_and_strides_.sizes_arrayref().vec();
     newDims[0] += num;
     if (!storage_.data()) {
       Resize(newDims);
@@ -1009,16 +1014,16 @@ struct C10_API TensorImpl : public c10::intrusive_ptr_target {
         static_cast<int64_t>(1),
         std::multiplies<int64_t>());
     if (newNumel * storage_.itemsize() <= storage_.capacity()) {
-      sizes_ = newDims;
+      sizes_and_strides_.set_sizes(newDims);
       numel_ = newNumel;
       return;
     }
-    auto newCapacity = sizes_;
+    auto newCapacity = sizes_and_strides_.sizes_arrayref().vec();
     newCapacity[0] = std::max<size_t>(
-        newDims[0], std::ceil(sizes_[0] * (growthPct + 100) / 100));
+        newDims[0],
+        std::ceil(sizes_and_strides_.size_at(0) * (growthPct + 100) / 100));
     auto oldData = std::move(storage_.data_ptr());
     auto oldSize = numel_;
-    auto oldDims = sizes_;
     Resize(newCapacity);
     auto* newData = raw_mutable_data(data_type_);
     if (data_type_.copy()) {
@@ -1045,7 +1050,7 @@ struct C10_API TensorImpl : public c10::intrusive_ptr_target {
           true); // non-blocking
     }
     reserved_ = true;
-    sizes_ = newDims;
+    sizes_and_strides_.set_sizes(newDims);
     numel_ = newNumel;
   }
 
@@ -1062,7 +1067,7 @@ struct C10_API TensorImpl : public c10::intrusive_ptr_target {
         "Right now ReserveSpace is only supported for contiguous Tensor.");
     AT_ASSERTM(
         storage_.unique(), "Can't call ReserveSpace on shared storage.");
-    auto newCapacity = sizes_;
+    auto newCapacity = sizes_and_strides_.sizes_arrayref().vec();
     newCapacity[0] = outer_dim;
     auto newNumel = std::accumulate(
         newCapacity.begin(),
@@ -1075,11 +1080,11 @@ struct C10_API TensorImpl : public c10::intrusive_ptr_target {
     // Old data is discarded
     storage_.data_ptr().clear();
     auto oldSize = numel_;
-    auto oldDims = sizes_;
+    auto oldDims = sizes_and_strides_.sizes_arrayref().vec();
     Resize(newCapacity);
     // Allocate new memory but don't copy over the data
     raw_mutable_data(data_type_);
-    sizes_ = oldDims;
+    sizes_and_strides_.set_sizes(oldDims);
     numel_ = oldSize;
     reserved_ = true;
   }
@@ -1148,8 +1153,8 @@ struct C10_API TensorImpl : public c10::intrusive_ptr_target {
         " The old caffe2 mixes Reshape and Resize but this behavior has "
         "been changed. If you find this error, most likely you will need "
         "to change corresponding code from Reshape to Resize.");
-    auto old_dim = sizes_.size();
-    sizes_ = dims;
+    auto old_dim = sizes_and_strides_.size();
+    sizes_and_strides_.set_sizes(dims);
     update_to_contiguous_strides(old_dim);
   }
 
@@ -1366,12 +1371,12 @@ private:
       typename = typename std::enable_if<std::is_integral<T>::value>::type>
   bool SetDimsTemplate(ArrayRef<T> src) {
     auto old_numel = numel_;
-    auto old_dim = sizes_.size();
-    sizes_.resize(src.size());
+    auto old_dim = sizes_and_strides_.size();
+    sizes_and_strides_.resize(src.size());
     int64_t new_numel = 1;
     for (size_t i = 0; i < src.size(); ++i) {
       new_numel *= src[i];
-      sizes_[i] = src[i];
+      sizes_and_strides_.size_at(i) = src[i];
     }
     update_to_contiguous_strides(old_dim);
     numel_ = new_numel;
@@ -1411,12 +1416,13 @@ private:
   }
 
   inline void update_to_contiguous_strides(size_t old_dim) {
-    strides_.resize(sizes_.size(), 0);
-    if (dim() > 0) {
-      int last_idx = dim() - 1;
-      strides_[last_idx] = 1;
-      for (auto i = last_idx - 1; i >= 0; --i) {
-        strides_[i] = strides_[i + 1] * std::max<int64_t>(sizes_[i + 1], 1);
+    const int64_t ndim = sizes_and_strides_.size();
+    if (ndim > 0) {
+      int64_t* strides = sizes_and_strides_.strides_data();
+      const int64_t* sizes = sizes_and_strides_.sizes_data();
+      strides[ndim - 1] = 1;
+      for (auto i = ndim - 2; i >= 0; --i) {
+        strides[i] = strides[i + 1] * std::max<int64_t>(sizes[i + 1], 1);
       }
     }
     is_contiguous_ = true;
@@ -1469,18 +1475,13 @@ protected:
 
   PyObject* pyobj_ = nullptr; // weak reference
 
-  // We could save a word or two by combining the SmallVector structs,
-  // since their size is redundant, and if we need to overflow the buffer space
-  // we could keep the two pointers together. However, that would require
-  // implementing another struct from scratch, so only do this if we're desperate.
-  SmallVector<int64_t,5> sizes_;
-  SmallVector<int64_t,5> strides_;
+  // Sizes and strides share the dimension count and, for up to five
+  // dimensions, live inline.  Starts out with sizes {0} and strides {1}.
+  impl::SizesAndStrides sizes_and_strides_;
 
   int64_t storage_offset_ = 0;
   // If sizes and strides are empty, the numel is 1!!  However, most of the
   // time, we will immediately set sizes to {0} and reset numel to 0.
-  // (Can't do that in the default initializers, because there's no way to
-  // spell "allocate a one-element array" for strides_).
   int64_t numel_ = 1;
 
   // INVARIANT: When storage is non-null, this type meta must
@@ -1498,11 +1499,12 @@ protected:
   // agree with the type meta in storage.
   c10::optional<c10::Device> device_opt_;
 
-  // You get to have eight byte-size fields here, before you
-  // should pack this into a bitfield.
+  // The type id and the flags below share a word with device_opt_.  The
+  // flags are bit fields, which cannot have default member initializers, so
+  // the constructor initializes them.
   TensorTypeId type_id_;
-  bool is_contiguous_ = true;
-  bool is_wrapped_number_ = false;
+  bool is_contiguous_ : 1;
+  bool is_wrapped_number_ : 1;
 
   // Previously, if we change the tensor metadata (e.g. sizes / strides / storage / storage_offset)
   // of a derived tensor (i.e. tensors created from Python `tensor.data` or Python/C++ `tensor.detach()`),
@@ -1513,13 +1515,13 @@ protected:
   //
   // NOTE: For a full list of tensor metadata fields, please see `shallow_copy_and_detach()` in TensorImpl
   // and its subclasses to find which fields are copied by value.
-  bool allow_tensor_metadata_change_ = true;
+  bool allow_tensor_metadata_change_ : 1;
 
   // we decide to keep reserved_ and it will
   // live in Tensor after the split
   // The logic is that if Extend() or ReserveSpace() were ever called,
   // then subsequent Resize()s will not free up Storage.
-  bool reserved_ = false;
+  bool reserved_ : 1;
 
 };
 
@@ -1540,7 +1542,7 @@ protected:
 // For reference, we OOMed at 160 bytes (20 words) per TensorImpl.
 // This is not counting overhead from strides out-of-line allocation and
 // StorageImpl space and this is from before we inlined sizes and strides
-// directly into TensorImpl as SmallVectors.
+// directly into TensorImpl (first as SmallVectors, now as SizesAndStrides).
 //
 // Our memory usage on 32-bit systems is suboptimal, but we're not checking
 // for it at the moment (to help avoid rage inducing cycles when the
@@ -1556,30 +1558,24 @@ protected:
 //    version counter (word 0)
 //    version counter (word 1)
 //    PyObject pointer
-//    sizes SmallVector (begin)
-//    sizes SmallVector (end)
-//    sizes SmallVector (capacity)
-//    sizes SmallVector (pre-allocated 0)
-//    sizes SmallVector (pre-allocated 1)
-//    sizes SmallVector (pre-allocated 2)
-//    sizes SmallVector (pre-allocated 3)
-//    sizes SmallVector (pre-allocated 4)
-//    strides SmallVector (begin)
-//    strides SmallVector (end)
-//    strides SmallVector (capacity)
-//    strides SmallVector (pre-allocated 0)
-//    strides SmallVector (pre-allocated 1)
-//    strides SmallVector (pre-allocated 2)
-//    strides SmallVector (pre-allocated 3)
-//    strides SmallVector (pre-allocated 4)
+//    SizesAndStrides size
+//    SizesAndStrides sizes (pre-allocated 0)
+//    SizesAndStrides sizes (pre-allocated 1)
+//    SizesAndStrides sizes (pre-allocated 2)
+//    SizesAndStrides sizes (pre-allocated 3)
+//    SizesAndStrides sizes (pre-allocated 4)
+//    SizesAndStrides strides (pre-allocated 0)
+//    SizesAndStrides strides (pre-allocated 1)
+//    SizesAndStrides strides (pre-allocated 2)
+//    SizesAndStrides strides (pre-allocated 3)
+//    SizesAndStrides strides (pre-allocated 4)
 //    storage offset
 //    numel
 //    data type pointer
-//    (optional) device
-//    miscellaneous bitfield
+//    (optional) device + type id + miscellaneous bitfield
 //
 static_assert(sizeof(void*) != sizeof(int64_t) || // if 64-bit...
-              sizeof(TensorImpl) == sizeof(int64_t) * 29,
+              sizeof(TensorImpl) == sizeof(int64_t) * 23,
               "You changed the size of TensorImpl on 64-bit arch."
               "See Note [TensorImpl size constraints] on how to proceed.");
 
@@ -0,0 +1,90 @@
+#include <c10/core/impl/LocalBlockPool.h>
+
+#include <new>
+
+namespace c10 {
+namespace impl {
+
+namespace {
+
+// Number of block sizes each thread keeps, e.g. TensorImpl, the Variable
+// impls and their autograd metadata.
+constexpr size_t kNumSizeClasses = 8;
+// Number of free blocks each thread keeps per size. Blocks beyond this go
+// back to the heap, so a thread that frees many tensors at once (e.g. when
+// a graph is destroyed) does not hold on to the memory.
+constexpr size_t kMaxFreeBlocks = 256;
+// Larger objects are not worth pooling.
+constexpr size_t kMaxBlockSize = 512;
+
+struct FreeList {
+  // Size of the blocks in the list, or 0 while it is unused.
+  size_t block_size = 0;
+  size_t count = 0;
+  void* blocks[kMaxFreeBlocks];
+};
+
+struct LocalBlockPool {
+  FreeList lists[kNumSizeClasses];
+
+  ~LocalBlockPool();
+
+  FreeList* list_for(size_t size) {
+    for (auto& list : lists) {
+      if (list.block_size == 0) {
+        list.block_size = size;
+      }
+      if (list.block_size == size) {
+        return &list;
+      }
+    }
+    return nullptr;
+  }
+};
+
+// Tensors may be freed by thread-local destructors that run after the pool
+// of the thread was destroyed. This flag is trivially destructible, so it can
+// still be read then.
+thread_local bool pool_destroyed = false;
+
+LocalBlockPool::~LocalBlockPool() {
+  pool_destroyed = true;
+  for (auto& list : lists) {
+    for (size_t i = 0; i < list.count; ++i) {
+      ::operator delete(list.blocks[i]);
+    }
+  }
+}
+
+FreeList* free_list_for(size_t size) {
+  if (size > kMaxBlockSize || pool_destroyed) {
+    return nullptr;
+  }
+  static thread_local LocalBlockPool pool;
+  return pool.list_for(size);
+}
+
+} // namespace
+
+void* local_pool_allocate(size_t size) {
+  auto* list = free_list_for(size);
+  if (list && list->count > 0) {
+    return list->blocks[--list->count];
+  }
+  return ::operator new(size);
+}
+
+void local_pool_free(void* ptr, size_t size) {
+  if (!ptr) {
+    return;
+  }
+  auto* list = free_list_for(size);
+  if (list && list->count < kMaxFreeBlocks) {
+    list->blocks[list->count++] = ptr;
+    return;
+  }
+  ::operator delete(ptr);
+}
+
+} // namespace impl
+} // namespace c10
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstddef>
+
+#include <c10/macros/Macros.h>
+
+namespace c10 {
+namespace impl {
+
+/**
+ * Per-thread free lists for the small objects that are created for every
+ * tensor, such as TensorImpls and autograd metadata.
+ *
+ * Views and temporaries are freed soon after they are allocated, usually on
+ * the same thread, so most allocations can reuse a block that the thread
+ * freed before. Each thread keeps a bounded number of free blocks for a few
+ * block sizes; other sizes, and blocks beyond the bound, go to the heap.
+ *
+ * A block may be freed on a different thread than the one that allocated
+ * it, but `size` must be the size it was allocated with.
+ */
+C10_API void* local_pool_allocate(size_t size);
+C10_API void local_pool_free(void* ptr, size_t size);
+
+} // namespace impl
+} // namespace c10
@@ -0,0 +1,275 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#include <c10/macros/Macros.h>
+#include <c10/util/ArrayRef.h>
+
+#define C10_SIZES_AND_STRIDES_MAX_INLINE_SIZE 5
+
+namespace c10 {
+namespace impl {
+
+/**
+ * The sizes and strides of a TensorImpl, packed into one object.
+ *
+ * Two SmallVectors need three words of bookkeeping each (begin, end,
+ * capacity), although the number of sizes and strides is always the same.
+ * This class stores the number of dimensions once, and the sizes and strides
+ * of tensors with up to C10_SIZES_AND_STRIDES_MAX_INLINE_SIZE dimensions
+ * inline. Larger tensors keep both in a single out-of-line allocation, sizes
+ * first.
+ *
+ * Like SmallVector, resize() keeps the existing entries and zero-fills the
+ * new ones.
+ */
+class SizesAndStrides {
+ public:
+  // Matches the sizes {0} and strides {1} of a default TensorImpl.
+  SizesAndStrides() : size_(1) {
+    sizes_data()[0] = 0;
+    strides_data()[0] = 1;
+  }
+
+  ~SizesAndStrides() {
+    if (C10_UNLIKELY(!is_inline())) {
+      std::free(out_of_line_storage_);
+    }
+  }
+
+  SizesAndStrides(const SizesAndStrides& rhs) : size_(rhs.size_) {
+    if (C10_LIKELY(rhs.is_inline())) {
+      copy_inline_from(rhs);
+    } else {
+      allocate_out_of_line(size_);
+      copy_out_of_line_from(rhs);
+    }
+  }
+
+  SizesAndStrides& operator=(const SizesAndStrides& rhs) {
+    if (this == &rhs) {
+      return *this;
+    }
+    if (C10_LIKELY(rhs.is_inline())) {
+      if (C10_UNLIKELY(!is_inline())) {
+        std::free(out_of_line_storage_);
+      }
+      copy_inline_from(rhs);
+    } else {
+      if (is_inline()) {
+        allocate_out_of_line(rhs.size_);
+      } else if (size_ != rhs.size_) {
+        reallocate_out_of_line(rhs.size_);
+      }
+      copy_out_of_line_from(rhs);
+    }
+    size_ = rhs.size_;
+    return *this;
+  }
+
+  // The moved-from object is left with zero dimensions.
+  SizesAndStrides(SizesAndStrides&& rhs) noexcept : size_(rhs.size_) {
+    if (C10_LIKELY(rhs.is_inline())) {
+      copy_inline_from(rhs);
+    } else {
+      out_of_line_storage_ = rhs.out_of_line_storage_;
+      rhs.out_of_line_storage_ = nullptr;
+    }
+    rhs.size_ = 0;
+  }
+
+  SizesAndStrides& operator=(SizesAndStrides&& rhs) noexcept {
+    if (this == &rhs) {
+      return *this;
+    }
+    if (C10_UNLIKELY(!is_inline())) {
+      std::free(out_of_line_storage_);
+    }
+    if (C10_LIKELY(rhs.is_inline())) {
+      copy_inline_from(rhs);
+    } else {
+      out_of_line_storage_ = rhs.out_of_line_storage_;
+      rhs.out_of_line_storage_ = nullptr;
+    }
+    size_ = rhs.size_;
+    rhs.size_ = 0;
+    return *this;
+  }
+
+  size_t size() const noexcept {
+    return size_;
+  }
+
+  const int64_t* sizes_data() const noexcept {
+    return C10_LIKELY(is_inline()) ? &inline_storage_[0] : &out_of_line_storage_[0];
+  }
+
+  int64_t* sizes_data() noexcept {
+    return C10_LIKELY(is_inline()) ? &inline_storage_[0] : &out_of_line_storage_[0];
+  }
+
+  const int64_t* strides_data() const noexcept {
+    return C10_LIKELY(is_inline())
+        ? &inline_storage_[C10_SIZES_AND_STRIDES_MAX_INLINE_SIZE]
+        : &out_of_line_storage_[size_];
+  }
+
+  int64_t* strides_data() noexcept {
+    return C10_LIKELY(is_inline())
+        ? &inline_storage_[C10_SIZES_AND_STRIDES_MAX_INLINE_SIZE]
+        : &out_of_line_storage_[size_];
+  }
+
+  IntArrayRef sizes_arrayref() const noexcept {
+    return IntArrayRef{sizes_data(), size_};
+  }
+
+  IntArrayRef strides_arrayref() const noexcept {
+    return IntArrayRef{strides_data(), size_};
+  }
+
+  int64_t size_at(size_t idx) const noexcept {
+    return sizes_data()[idx];
+  }
+
+  int64_t& size_at(size_t idx) noexcept {
+    return sizes_data()[idx];
+  }
+
+  int64_t stride_at(size_t idx) const noexcept {
+    return strides_data()[idx];
+  }
+
+  int64_t& stride_at(size_t idx) noexcept {
+    return strides_data()[idx];
+  }
+
+  /// Sets the sizes and resizes the strides to match; the strides of the
+  /// new dimensions are zero.
+  void set_sizes(IntArrayRef new_sizes) {
+    resize(new_sizes.size());
+    std::copy(new_sizes.begin(), new_sizes.end(), sizes_data());
+  }
+
+  void resize(size_t new_size) {
+    const size_t old_size = size_;
+    if (new_size == old_size) {
+      return;
+    }
+    if (C10_LIKELY(
+            new_size <= C10_SIZES_AND_STRIDES_MAX_INLINE_SIZE && is_inline())) {
+      if (old_size < new_size) {
+        const size_t bytes = (new_size - old_size) * sizeof(int64_t);
+        std::memset(&inline_storage_[old_size], 0, bytes);
+        std::memset(
+            &inline_storage_[C10_SIZES_AND_STRIDES_MAX_INLINE_SIZE + old_size],
+            0,
+            bytes);
+      }
+      size_ = new_size;
+      return;
+    }
+    resize_slow_path(new_size, old_size);
+  }
+
+ private:
+  bool is_inline() const noexcept {
+    return size_ <= C10_SIZES_AND_STRIDES_MAX_INLINE_SIZE;
+  }
+
+  void copy_inline_from(const SizesAndStrides& rhs) {
+    std::memcpy(inline_storage_, rhs.inline_storage_, sizeof(inline_storage_));
+  }
+
+  void copy_out_of_line_from(const SizesAndStrides& rhs) {
+    std::memcpy(
+        out_of_line_storage_,
+        rhs.out_of_line_storage_,
+        storage_bytes(rhs.size_));
+  }
+
+  static size_t storage_bytes(size_t size) {
+    return size * 2 * sizeof(int64_t);
+  }
+
+  void allocate_out_of_line(size_t size) {
+    out_of_line_storage_ =
+        static_cast<int64_t*>(std::malloc(storage_bytes(size)));
+    if (!out_of_line_storage_) {
+      throw std::bad_alloc();
+    }
+  }
+
+  void reallocate_out_of_line(size_t size) {
+    auto* storage = static_cast<int64_t*>(
+        std::realloc(out_of_line_storage_, storage_bytes(size)));
+    if (!storage) {
+      throw std::bad_alloc();
+    }
+    out_of_line_storage_ = storage;
+  }
+
+  void resize_slow_path(size_t new_size, size_t old_size) {
+    const size_t kept = std::min(new_size, old_size);
+    if (new_size <= C10_SIZES_AND_STRIDES_MAX_INLINE_SIZE) {
+      // Out of line to inline, which keeps all new entries. The pointer
+      // overlaps with the inline buffer, so it must be read first.
+      int64_t* storage = out_of_line_storage_;
+      std::memcpy(&inline_storage_[0], &storage[0], kept * sizeof(int64_t));
+      std::memcpy(
+          &inline_storage_[C10_SIZES_AND_STRIDES_MAX_INLINE_SIZE],
+          &storage[old_size],
+          kept * sizeof(int64_t));
+      std::free(storage);
+    } else if (is_inline()) {
+      // Inline to out of line.
+      int64_t tmp[C10_SIZES_AND_STRIDES_MAX_INLINE_SIZE * 2];
+      std::memcpy(tmp, inline_storage_, sizeof(inline_storage_));
+      allocate_out_of_line(new_size);
+      std::memcpy(&out_of_line_storage_[0], &tmp[0], kept * sizeof(int64_t));
+      std::memcpy(
+          &out_of_line_storage_[new_size],
+          &tmp[C10_SIZES_AND_STRIDES_MAX_INLINE_SIZE],
+          kept * sizeof(int64_t));
+      zero_new_entries(out_of_line_storage_, new_size, kept);
+    } else {
+      // Out of line to out of line. The strides move with the size.
+      if (new_size < old_size) {
+        std::memmove(
+            &out_of_line_storage_[new_size],
+            &out_of_line_storage_[old_size],
+            kept * sizeof(int64_t));
+        reallocate_out_of_line(new_size);
+      } else {
+        reallocate_out_of_line(new_size);
+        std::memmove(
+            &out_of_line_storage_[new_size],
+            &out_of_line_storage_[old_size],
+            kept * sizeof(int64_t));
+        zero_new_entries(out_of_line_storage_, new_size, kept);
+      }
+    }
+    size_ = new_size;
+  }
+
+  static void zero_new_entries(int64_t* storage, size_t size, size_t kept) {
+    if (kept < size) {
+      const size_t bytes = (size - kept) * sizeof(int64_t);
+      std::memset(&storage[kept], 0, bytes);
+      std::memset(&storage[size + kept], 0, bytes);
+    }
+  }
+
+  size_t size_;
+  union {
+    int64_t* out_of_line_storage_;
+    int64_t inline_storage_[C10_SIZES_AND_STRIDES_MAX_INLINE_SIZE * 2];
+  };
+};
+
+} // namespace impl
+} // namespace c10
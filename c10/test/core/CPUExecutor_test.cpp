@@ -0,0 +1,135 @@
+#include <gtest/gtest.h>
+
+#include <c10/core/CPUExecutor.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <vector>
+
+using c10::CPUExecutor;
+
+TEST(CPUExecutorTest, RunsEveryTaskOnce) {
+  CPUExecutor executor(4);
+  EXPECT_EQ(executor.numThreads(), 4);
+  for (size_t num_tasks : {0, 1, 3, 1000}) {
+    std::vector<std::atomic<int>> counts(num_tasks);
+    for (auto& count : counts) {
+      count = 0;
+    }
+    executor.run(num_tasks, 0, [&](size_t /*unused*/, size_t task) {
+      ++counts[task];
+    });
+    for (auto& count : counts) {
+      EXPECT_EQ(count.load(), 1);
+    }
+  }
+}
+
+TEST(CPUExecutorTest, SlotsAreBoundedAndExclusive) {
+  CPUExecutor executor(8);
+  const size_t max_parallelism = 3;
+  std::vector<std::atomic<int>> running(max_parallelism);
+  for (auto& r : running) {
+    r = 0;
+  }
+  std::atomic<bool> overlap(false);
+  executor.run(10000, max_parallelism, [&](size_t slot, size_t /*unused*/) {
+    ASSERT_LT(slot, max_parallelism);
+    EXPECT_EQ(CPUExecutor::currentSlot(), slot);
+    if (running[slot]++ != 0) {
+      overlap = true;
+    }
+    --running[slot];
+  });
+  EXPECT_FALSE(overlap.load());
+}
+
+TEST(CPUExecutorTest, NestedRegionsRunInline) {
+  CPUExecutor executor(4);
+  EXPECT_FALSE(CPUExecutor::inParallelRegion());
+  std::atomic<int> total(0);
+  executor.run(8, 0, [&](size_t /*unused*/, size_t /*unused*/) {
+    EXPECT_TRUE(CPUExecutor::inParallelRegion());
+    const auto thread = std::this_thread::get_id();
+    executor.run(8, 0, [&](size_t slot, size_t /*unused*/) {
+      EXPECT_EQ(slot, 0);
+      EXPECT_EQ(std::this_thread::get_id(), thread);
+      ++total;
+    });
+  });
+  EXPECT_EQ(total.load(), 64);
+  EXPECT_FALSE(CPUExecutor::inParallelRegion());
+  EXPECT_EQ(executor.stats().inline_regions, 8);
+}
+
+TEST(CPUExecutorTest, RethrowsExceptions) {
+  CPUExecutor executor(4);
+  EXPECT_THROW(
+      executor.run(
+          100,
+          0,
+          [](size_t /*unused*/, size_t task) {
+            if (task == 42) {
+              throw std::runtime_error("task failed");
+            }
+          }),
+      std::runtime_error);
+  // The executor is still usable.
+  std::atomic<int> count(0);
+  executor.run(100, 0, [&](size_t /*unused*/, size_t /*unused*/) { ++count; });
+  EXPECT_EQ(count.load(), 100);
+}
+
+TEST(CPUExecutorTest, RunsAsyncTasksOnWorkers) {
+  CPUExecutor executor(3);
+  std::mutex mutex;
+  std::condition_variable done;
+  int remaining = 100;
+  std::atomic<bool> on_worker(true);
+  for (int i = 0; i < 100; ++i) {
+    executor.submit([&]() {
+      if (!CPUExecutor::inWorkerThread()) {
+        on_worker = false;
+      }
+      std::lock_guard<std::mutex> guard(mutex);
+      if (--remaining == 0) {
+        done.notify_one();
+      }
+    });
+  }
+  std::unique_lock<std::mutex> lock(mutex);
+  done.wait(lock, [&]() { return remaining == 0; });
+  EXPECT_TRUE(on_worker.load());
+  EXPECT_FALSE(CPUExecutor::inWorkerThread());
+  EXPECT_EQ(executor.stats().async_tasks_submitted, 100);
+}
+
+TEST(CPUExecutorTest, SingleThreadRunsOnCaller) {
+  CPUExecutor executor(1);
+  EXPECT_EQ(executor.numThreads(), 1);
+  const auto thread = std::this_thread::get_id();
+  bool ran = false;
+  executor.submit([&]() {
+    EXPECT_EQ(std::this_thread::get_id(), thread);
+    ran = true;
+  });
+  EXPECT_TRUE(ran);
+  executor.run(10, 0, [&](size_t slot, size_t /*unused*/) {
+    EXPECT_EQ(slot, 0);
+    EXPECT_EQ(std::this_thread::get_id(), thread);
+  });
+}
+
+TEST(CPUExecutorTest, DrainsAsyncTasksOnDestruction) {
+  std::atomic<int> count(0);
+  {
+    CPUExecutor executor(2);
+    for (int i = 0; i < 100; ++i) {
+      executor.submit([&]() { ++count; });
+    }
+  }
+  EXPECT_EQ(count.load(), 100);
+}
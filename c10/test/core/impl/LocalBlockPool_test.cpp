@@ -0,0 +1,58 @@
+#include <gtest/gtest.h>
+
+#include <c10/core/impl/LocalBlockPool.h>
+
+#include <cstring>
+#include <thread>
+#include <vector>
+
+using namespace c10::impl;
+
+TEST(LocalBlockPoolTest, ReusesFreedBlocks) {
+  void* a = local_pool_allocate(48);
+  local_pool_free(a, 48);
+  void* b = local_pool_allocate(48);
+  EXPECT_EQ(a, b);
+  local_pool_free(b, 48);
+}
+
+TEST(LocalBlockPoolTest, KeepsSizesApart) {
+  void* a = local_pool_allocate(64);
+  local_pool_free(a, 64);
+  void* b = local_pool_allocate(72);
+  EXPECT_NE(a, b);
+  // The whole block is usable.
+  std::memset(b, 0, 72);
+  local_pool_free(b, 72);
+}
+
+TEST(LocalBlockPoolTest, HandlesManySizes) {
+  // More sizes than the pool keeps, and blocks too large to be pooled.
+  std::vector<std::pair<void*, size_t>> blocks;
+  for (size_t size = 8; size <= 4096; size += 8) {
+    void* block = local_pool_allocate(size);
+    std::memset(block, 0, size);
+    blocks.emplace_back(block, size);
+  }
+  for (const auto& block : blocks) {
+    local_pool_free(block.first, block.second);
+  }
+  local_pool_free(nullptr, 8);
+}
+
+TEST(LocalBlockPoolTest, FreesOnOtherThreads) {
+  std::vector<void*> blocks;
+  for (int i = 0; i < 1000; ++i) {
+    blocks.push_back(local_pool_allocate(96));
+  }
+  std::thread thread([&] {
+    for (void* block : blocks) {
+      local_pool_free(block, 96);
+    }
+    // Blocks of the other thread are reused here.
+    void* block = local_pool_allocate(96);
+    EXPECT_NE(block, nullptr);
+    local_pool_free(block, 96);
+  });
+  thread.join();
+}
@@ -0,0 +1,100 @@
+#include <gtest/gtest.h>
+
+#include <c10/core/impl/SizesAndStrides.h>
+
+#include <vector>
+
+using namespace c10;
+using namespace c10::impl;
+
+static void checkData(
+    const SizesAndStrides& sz,
+    IntArrayRef sizes,
+    IntArrayRef strides) {
+  ASSERT_EQ(sizes.size(), strides.size());
+  ASSERT_EQ(sz.size(), sizes.size());
+  for (size_t i = 0; i < sizes.size(); ++i) {
+    EXPECT_EQ(sz.size_at(i), sizes[i]) << "index " << i;
+    EXPECT_EQ(sz.stride_at(i), strides[i]) << "index " << i;
+  }
+  EXPECT_EQ(sz.sizes_arrayref(), sizes);
+  EXPECT_EQ(sz.strides_arrayref(), strides);
+}
+
+static void fill(SizesAndStrides& sz, int64_t base) {
+  for (size_t i = 0; i < sz.size(); ++i) {
+    sz.size_at(i) = base + i;
+    sz.stride_at(i) = 2 * (base + i);
+  }
+}
+
+static void checkFilled(const SizesAndStrides& sz, int64_t base, size_t kept) {
+  for (size_t i = 0; i < sz.size(); ++i) {
+    if (i < kept) {
+      EXPECT_EQ(sz.size_at(i), base + static_cast<int64_t>(i)) << "index " << i;
+      EXPECT_EQ(sz.stride_at(i), 2 * (base + static_cast<int64_t>(i)))
+          << "index " << i;
+    } else {
+      EXPECT_EQ(sz.size_at(i), 0) << "index " << i;
+      EXPECT_EQ(sz.stride_at(i), 0) << "index " << i;
+    }
+  }
+}
+
+TEST(SizesAndStridesTest, DefaultConstructor) {
+  SizesAndStrides sz;
+  checkData(sz, {0}, {1});
+}
+
+TEST(SizesAndStridesTest, SetSizes) {
+  SizesAndStrides sz;
+  sz.set_sizes({5, 6, 7, 8});
+  checkData(sz, {5, 6, 7, 8}, {1, 0, 0, 0});
+}
+
+TEST(SizesAndStridesTest, ResizeKeepsEntries) {
+  // Every combination of inline and out-of-line sizes, growing and
+  // shrinking.
+  for (size_t from : {0, 1, 3, 5, 6, 8}) {
+    for (size_t to : {0, 1, 2, 5, 6, 7, 10}) {
+      SizesAndStrides sz;
+      sz.resize(from);
+      fill(sz, 3);
+      sz.resize(to);
+      ASSERT_EQ(sz.size(), to);
+      checkFilled(sz, 3, std::min(from, to));
+    }
+  }
+}
+
+TEST(SizesAndStridesTest, CopyAndMove) {
+  for (size_t from : {2, 5, 7}) {
+    for (size_t to : {1, 5, 6, 9}) {
+      SizesAndStrides source;
+      source.resize(from);
+      fill(source, 1);
+
+      SizesAndStrides copy(source);
+      checkFilled(copy, 1, from);
+
+      SizesAndStrides assigned;
+      assigned.resize(to);
+      fill(assigned, 7);
+      assigned = source;
+      checkFilled(assigned, 1, from);
+      // The copies are independent.
+      assigned.size_at(0) = 42;
+      EXPECT_EQ(source.size_at(0), 1);
+
+      SizesAndStrides moved(std::move(copy));
+      checkFilled(moved, 1, from);
+      EXPECT_EQ(copy.size(), 0);
+
+      SizesAndStrides move_assigned;
+      move_assigned.resize(to);
+      move_assigned = std::move(moved);
+      checkFilled(move_assigned, 1, from);
+      EXPECT_EQ(moved.size(), 0);
+    }
+  }
+}
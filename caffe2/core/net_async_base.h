@@ -1,6 +1,7 @@
 #ifndef CAFFE2_CORE_NET_ASYNC_BASE_H_
 #define CAFFE2_CORE_NET_ASYNC_BASE_H_
 
+#include "c10/core/CPUExecutor.h"
 #include "c10/core/thread_pool.h"
 #include "c10/util/Registry.h"
 #include "caffe2/core/common.h"
@@ -181,6 +182,12 @@ class AsyncNetExecutorHelper : public ExecutorHelper {
 template <class TaskThreadPoolImpl, int device_type>
 std::shared_ptr<TaskThreadPoolBase>
 GetAsyncNetThreadPool(int device_id, int pool_size, bool create_new) {
+  if (device_type == PROTO_CPU && c10::cpu_executor_enabled()) {
+    // All CPU pools share the threads of the process-wide executor, whatever
+    // their size and NUMA node.
+    return c10::cpu_executor_task_pool();
+  }
+
   static std::unordered_map<
       int,
       std::unordered_map<int, std::weak_ptr<TaskThreadPoolBase>>>
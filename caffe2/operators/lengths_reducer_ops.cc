@@ -48,7 +48,11 @@ SparseWeightedSum
         3,
         "LENGTHS",
         "Vector with the same sum of elements as the first dimension of DATA")
-    .Output(0, "output", "output");
+    .Output(0, "output", "output")
+    .Arg(
+        "num_threads",
+        "Default 1. Number of threads of the workspace thread pool that look "
+        "up ranges of segments in parallel, 0 for all of them.");
 
 REGISTER_CPU_OPERATOR_STR(
     "SparseLengthsPositionalWeightedSum",
@@ -80,6 +84,10 @@ OPERATOR_SCHEMA(SparseLengthsSum)
     .SetDoc(FormatDoc<SparseLengthsSumDef>())
     .Output(0, "OUTPUT", "Aggregated tensor")
     .FillUsing(SparseLengthsSumDef::PopulateSchema)
+    .Arg(
+        "num_threads",
+        "Default 1. Number of threads of the workspace thread pool that look "
+        "up ranges of segments in parallel, 0 for all of them.")
     .InheritOnnxSchema();
 REGISTER_CPU_OPERATOR(
     SparseLengthsSumGradient,
@@ -107,6 +115,10 @@ OPERATOR_SCHEMA(SparseLengthsWeightedSum)
     .SetDoc(FormatDoc<SparseLengthsWeightedSumDef>())
     .Output(0, "OUTPUT", "Aggregated tensor")
     .FillUsing(SparseLengthsWeightedSumDef::PopulateSchema)
+    .Arg(
+        "num_threads",
+        "Default 1. Number of threads of the workspace thread pool that look "
+        "up ranges of segments in parallel, 0 for all of them.")
     .InheritOnnxSchema();
 REGISTER_CPU_OPERATOR(
     SparseLengthsWeightedSumGradient,
@@ -134,7 +146,11 @@ OPERATOR_SCHEMA(SparseLengthsMean)
         SparseLengthsMeanOp::LENGTHS)
     .SetDoc(FormatDoc<SparseLengthsMeanDef>())
     .Output(0, "OUTPUT", "Aggregated tensor")
-    .FillUsing(SparseLengthsMeanDef::PopulateSchema);
+    .FillUsing(SparseLengthsMeanDef::PopulateSchema)
+    .Arg(
+        "num_threads",
+        "Default 1. Number of threads of the workspace thread pool that look "
+        "up ranges of segments in parallel, 0 for all of them.");
 REGISTER_CPU_OPERATOR(
     SparseLengthsMeanGradient,
     SparseLengthsMeanDef::BackwardOp);
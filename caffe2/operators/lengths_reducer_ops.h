@@ -1,11 +1,21 @@
 #pragma once
+#include <algorithm>
+#include <exception>
+#include <mutex>
+
 #include "caffe2/core/context.h"
 #include "caffe2/core/operator.h"
+#include "caffe2/core/workspace.h"
 #include "caffe2/perfkernels/embedding_lookup.h"
+#include "caffe2/utils/threadpool/ThreadPool.h"
 
 namespace caffe2 {
 
 // A templated class that implements SparseLengths[Sum,WeightedSum,Mean].
+//
+// With the argument "num_threads" other than 1, the segments are split into
+// ranges of about the same number of indices, which are looked up on the
+// threads of the workspace thread pool; 0 uses all of its threads.
 template <
     typename T, // output type
     class InputTypes, // supported input types, such as TensorTypes<float>
@@ -18,11 +28,17 @@ template <
 class CPUSparseLengthsReductionOp : public Operator<CPUContext> {
  public:
   USE_OPERATOR_FUNCTIONS(CPUContext);
-  template <class... Args>
-  explicit CPUSparseLengthsReductionOp(Args&&... args)
-      : Operator<CPUContext>(std::forward<Args>(args)...) {
+  // Ranges of fewer elements (indices times block size) are looked up on the
+  // calling thread.
+  static constexpr int64_t kMinElementsPerRange = 1 << 15;
+
+  CPUSparseLengthsReductionOp(const OperatorDef& operator_def, Workspace* ws)
+      : Operator<CPUContext>(operator_def, ws),
+        ws_(ws),
+        num_threads_(this->template GetSingleArgument<int>("num_threads", 1)) {
     static_assert(
         !(USE_WEIGHT & USE_MEAN), "Cannot both specify weight and mean.");
+    CAFFE_ENFORCE_GE(num_threads_, 0, "num_threads must not be negative");
   }
 
   ~CPUSparseLengthsReductionOp() {}
@@ -76,22 +92,102 @@ class CPUSparseLengthsReductionOp : public Operator<CPUContext> {
       in_weight = weightInput.template data<T>();
     }
 
-    // delegate work to perfkernel that branches based on architecture
-    EmbeddingLookup<IndexType, InputType, T, USE_POSITIONAL_WEIGHT>(
-        D,
-        M,
+    const int64_t num_ranges = NumRanges(M, indices_size * D);
+    if (num_ranges <= 1) {
+      // delegate work to perfkernel that branches based on architecture
+      EmbeddingLookup<IndexType, InputType, T, USE_POSITIONAL_WEIGHT>(
+          D,
+          M,
+          indices_size,
+          N,
+          in_data,
+          indices,
+          lengths,
+          in_weight,
+          nullptr, // scale_bias field is only used in SparseLengths8BitsRowwiseOp
+          USE_MEAN,
+          out_data);
+      return true;
+    }
+
+    // Offsets of the segments into the indices. Every range is a complete
+    // lookup of its segments, so the lengths must add up here.
+    offsets_.resize(M + 1);
+    offsets_[0] = 0;
+    for (int64_t i = 0; i < M; ++i) {
+      CAFFE_ENFORCE_GE(lengths[i], 0, "LENGTHS must not be negative");
+      offsets_[i + 1] = offsets_[i] + lengths[i];
+    }
+    CAFFE_ENFORCE_EQ(
+        offsets_[M],
         indices_size,
-        N,
-        in_data,
-        indices,
-        lengths,
-        in_weight,
-        nullptr, // scale_bias field is only used in SparseLengths8BitsRowwiseOp
-        USE_MEAN,
-        out_data);
+        "Your input seems to be incorrect: the sum of lengths values should be "
+        "the size of the indices tensor, but it appears not.");
+
+    // Range r holds the segments that start in the r-th part of the indices.
+    const auto range_begin = [&](int64_t range) -> int64_t {
+      if (range == num_ranges) {
+        return M;
+      }
+      return std::lower_bound(
+                 offsets_.begin(),
+                 offsets_.end(),
+                 range * indices_size / num_ranges) -
+          offsets_.begin();
+    };
+
+    // The threads of the pool cannot throw, so the first error of an out of
+    // range index is rethrown once all ranges are done.
+    std::exception_ptr error;
+    std::mutex error_mutex;
+    ws_->GetThreadPool()->run(
+        [&](int /* unused */, size_t range) {
+          const int64_t begin = range_begin(range);
+          const int64_t end = range_begin(range + 1);
+          if (begin >= end) {
+            return;
+          }
+          try {
+            EmbeddingLookup<IndexType, InputType, T, USE_POSITIONAL_WEIGHT>(
+                D,
+                end - begin,
+                offsets_[end] - offsets_[begin],
+                N,
+                in_data,
+                indices + offsets_[begin],
+                lengths + begin,
+                in_weight && !USE_POSITIONAL_WEIGHT
+                    ? in_weight + offsets_[begin]
+                    : in_weight,
+                nullptr,
+                USE_MEAN,
+                out_data + begin * D);
+          } catch (...) {
+            std::lock_guard<std::mutex> guard(error_mutex);
+            if (!error) {
+              error = std::current_exception();
+            }
+          }
+        },
+        num_ranges);
+    if (error) {
+      std::rethrow_exception(error);
+    }
     return true;
   }
 
+  // Returns the number of ranges to split a lookup of `elements` elements
+  // into.
+  int64_t NumRanges(int64_t num_segments, int64_t elements) {
+    if (num_threads_ == 1 || elements < 2 * kMinElementsPerRange) {
+      return 1;
+    }
+    const int64_t num_threads =
+        num_threads_ > 0 ? num_threads_ : ws_->GetThreadPool()->getNumThreads();
+    return std::min(
+        {num_threads, num_segments, elements / kMinElementsPerRange});
+  }
+
   enum {
     DATA = 0, // Data input.
     WEIGHT = 1, // Weight input used in SparseLengthsWeightedSum
@@ -100,6 +196,11 @@ class CPUSparseLengthsReductionOp : public Operator<CPUContext> {
     LENGTHS = 2 + USE_WEIGHT, // 2 in SparseLengths[Sum, Mean],
                               // 3 in SparseLengthsWeightedSum
   };
+
+ private:
+  Workspace* ws_;
+  int num_threads_;
+  std::vector<int64_t> offsets_;
 };
 
 } // namespace caffe2
@@ -15,13 +15,28 @@ std::unique_ptr<RecurrentNetworkExecutorBase> createRNNExecutor<CPUContext>(
     std::map<string, string>& recurrent_input_map,
     std::string timestep_blob,
     ArgumentHelper rnn_args) {
-  auto* exec = new ThreadedRecurrentNetworkExecutor(
-      step_net_def, recurrent_input_map, timestep_blob);
+  const auto type = rnn_args.GetSingleArgument<std::string>(
+      "rnn_executor.type", "threaded");
   int num_threads =
       rnn_args.GetSingleArgument<int>("rnn_executor.num_threads", 0);
-  if (num_threads > 0) {
-    exec->setNumThreads(num_threads);
-    LOG(INFO) << "Set num threads: " << num_threads;
+  RecurrentNetworkExecutorBase* exec;
+  if (type == "wavefront") {
+    auto* wavefront_exec = new WavefrontRecurrentNetworkExecutor(
+        step_net_def, recurrent_input_map, timestep_blob);
+    if (num_threads > 0) {
+      wavefront_exec->setNumThreads(num_threads);
+      LOG(INFO) << "Set num threads: " << num_threads;
+    }
+    exec = wavefront_exec;
+  } else {
+    CAFFE_ENFORCE_EQ(type, "threaded", "Unknown RNN executor type: ", type);
+    auto* threaded_exec = new ThreadedRecurrentNetworkExecutor(
+        step_net_def, recurrent_input_map, timestep_blob);
+    if (num_threads > 0) {
+      threaded_exec->setNumThreads(num_threads);
+      LOG(INFO) << "Set num threads: " << num_threads;
+    }
+    exec = threaded_exec;
   }
   exec->debug_ = rnn_args.GetSingleArgument<int>("rnn_executor_debug", 0);
   return std::unique_ptr<RecurrentNetworkExecutorBase>(exec);
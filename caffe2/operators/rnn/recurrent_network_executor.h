@@ -1,7 +1,12 @@
 #ifndef CAFFE2_OPERATORS_RECURRENT_NETWORK_EXECUTOR_H_
 #define CAFFE2_OPERATORS_RECURRENT_NETWORK_EXECUTOR_H_
 
+#include <atomic>
+#include <condition_variable>
 #include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
 #include <unordered_set>
 #include <vector>
 
@@ -24,9 +29,10 @@ namespace caffe2 {
  * next timestep's lower layer can start executing at the same time as
  * the same timestep's upper layer.
  *
- * There are two implementations of the RNN executor: one for CPUs
- * (ThreadedRecurrentNetworkExecutor) and another for GPUs
- * (CUDARecurrentNetworkExecutor).
+ * There are two implementations of the RNN executor for CPUs
+ * (ThreadedRecurrentNetworkExecutor, and WavefrontRecurrentNetworkExecutor
+ * which is selected with the rnn_executor.type="wavefront" argument) and
+ * one for GPUs (CUDARecurrentNetworkExecutor).
  */
 class RecurrentNetworkExecutorBase {
  protected:
@@ -524,6 +530,90 @@ class CAFFE2_API ThreadedRecurrentNetworkExecutor : public RecurrentNetworkExecu
   int num_threads_ = 4;
 };
 
+/**
+ * CPU executor that schedules the (timestep, op) pairs of a run as a
+ * wavefront. A task is ranked by the distance of its timestep from the
+ * first one plus the depth of the op within the step net, so that the lower
+ * layers of later timesteps are started as soon as possible and the upper
+ * layers follow them diagonally.
+ *
+ * Every worker keeps its ready tasks in a heap ordered by that rank; ops
+ * made ready by a worker go to its own heap, and workers without work steal
+ * from the others. The calling thread is one of the workers, and workers
+ * spin for a short while before they go to sleep, which keeps the per-op
+ * overhead low for small hidden sizes. All bookkeeping is allocated on the
+ * first run and reused afterwards.
+ */
+class CAFFE2_API WavefrontRecurrentNetworkExecutor
+    : public RecurrentNetworkExecutorBase {
+ public:
+  WavefrontRecurrentNetworkExecutor(
+      const NetDef& step_net_def,
+      std::map<string, string>& recurrent_input_map,
+      std::string timestep_blob)
+      : RecurrentNetworkExecutorBase(
+            step_net_def,
+            recurrent_input_map,
+            timestep_blob) {}
+
+  ~WavefrontRecurrentNetworkExecutor();
+
+  bool Run(int T) override;
+
+  bool RunBackwards(int T) override;
+
+  bool ignoreLinkDependencies() override {
+    return false;
+  }
+
+  // Only has an effect before the first run, which starts the threads.
+  void setNumThreads(int n) {
+    num_threads_ = n;
+  }
+
+ protected:
+  void AnalyzeOps() override;
+
+ private:
+  struct Worker {
+    std::mutex mutex;
+    std::vector<OpTask> tasks;
+  };
+
+  int Rank(const OpTask& task) const;
+
+  void Push(int worker, const OpTask& task);
+
+  bool Pop(int worker, OpTask* task);
+
+  void Exec(int T, int direction);
+
+  void WorkerLoop(int worker, bool caller);
+
+  void RunOp(const OpTask& job, int worker);
+
+  bool Defer(const OpTask& job);
+
+  // Depth of each op in the dependency graph within one timestep.
+  std::vector<int> levels_;
+
+  std::vector<std::unique_ptr<Worker>> workers_;
+  std::vector<std::thread> threads_;
+  // Number of tasks in the heaps of all workers.
+  std::atomic<int> pending_{0};
+  std::atomic<int> countdown_{0};
+  std::atomic<int> finished_timesteps_{0};
+  std::atomic<int> sleeping_{0};
+  std::atomic<bool> failed_{false};
+  std::atomic<bool> stop_{false};
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  // Tasks held back by max_parallel_timesteps_, guarded by mutex_.
+  std::vector<OpTask> deferred_;
+  int num_threads_ = 4;
+};
+
 } // namespace caffe2
 
 #endif // CAFFE2_OPERATORS_RECURRENT_NETWORK_EXECUTOR_H_
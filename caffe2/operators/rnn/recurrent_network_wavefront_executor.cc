@@ -0,0 +1,297 @@
+#include "caffe2/operators/rnn/recurrent_network_executor.h"
+
+#include <algorithm>
+
+namespace caffe2 {
+
+namespace {
+
+// Number of times an idle worker looks for work before it goes to sleep.
+// Ops of small RNNs take a few microseconds, so sleeping between them would
+// dominate the run time.
+constexpr int kSpinIterations = 1000;
+
+} // namespace
+
+WavefrontRecurrentNetworkExecutor::~WavefrontRecurrentNetworkExecutor() {
+  {
+    std::lock_guard<std::mutex> lk(mutex_);
+    stop_ = true;
+    cv_.notify_all();
+  }
+  for (auto& thread : threads_) {
+    thread.join();
+  }
+}
+
+/**
+ * The depth of an op is the length of the longest chain of dependencies
+ * within a timestep that ends in it.
+ */
+void WavefrontRecurrentNetworkExecutor::AnalyzeOps() {
+  levels_.assign(timestep_ops_template_.size(), 0);
+  for (auto& rnn_op : timestep_ops_template_) {
+    for (int dep : rnn_op.dependencies) {
+      if (dep > rnn_op.order) {
+        levels_[dep] = std::max(levels_[dep], levels_[rnn_op.order] + 1);
+      }
+    }
+  }
+}
+
+int WavefrontRecurrentNetworkExecutor::Rank(const OpTask& task) const {
+  const int step = task.forward() ? task.timestep : task.T - 1 - task.timestep;
+  return step + levels_[task.op_idx];
+}
+
+bool WavefrontRecurrentNetworkExecutor::Run(int T) {
+  CAFFE_ENFORCE_GE(T, 0, "Negative number of steps");
+  if (T == 0) {
+    return true;
+  }
+  Exec(T, 1);
+  return true;
+}
+
+bool WavefrontRecurrentNetworkExecutor::RunBackwards(int T) {
+  CAFFE_ENFORCE_GE(T, 0, "Negative number of steps");
+  if (T == 0) {
+    return true;
+  }
+  Exec(T, -1);
+  return true;
+}
+
+void WavefrontRecurrentNetworkExecutor::Push(int worker, const OpTask& task) {
+  auto& w = *workers_[worker];
+  {
+    std::lock_guard<std::mutex> lk(w.mutex);
+    w.tasks.push_back(task);
+    std::push_heap(
+        w.tasks.begin(), w.tasks.end(), [this](const OpTask& a, const OpTask& b) {
+          return Rank(a) > Rank(b);
+        });
+  }
+  pending_.fetch_add(1);
+  if (sleeping_ > 0) {
+    std::lock_guard<std::mutex> lk(mutex_);
+    cv_.notify_one();
+  }
+}
+
+/**
+ * Takes the task with the lowest rank from the heap of the worker, or
+ * steals one from another worker if it has none.
+ */
+bool WavefrontRecurrentNetworkExecutor::Pop(int worker, OpTask* task) {
+  if (pending_ == 0) {
+    return false;
+  }
+  const int num_workers = workers_.size();
+  for (int i = 0; i < num_workers; i++) {
+    auto& w = *workers_[(worker + i) % num_workers];
+    std::lock_guard<std::mutex> lk(w.mutex);
+    if (!w.tasks.empty()) {
+      std::pop_heap(
+          w.tasks.begin(),
+          w.tasks.end(),
+          [this](const OpTask& a, const OpTask& b) {
+            return Rank(a) > Rank(b);
+          });
+      *task = w.tasks.back();
+      w.tasks.pop_back();
+      pending_.fetch_sub(1);
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * Holds back a task that would start too many timesteps at once; it is
+ * scheduled again when the next timestep finishes. Returns false if the task
+ * can run right away.
+ */
+bool WavefrontRecurrentNetworkExecutor::Defer(const OpTask& job) {
+  const int step = job.forward() ? job.timestep : job.T - 1 - job.timestep;
+  if (step - finished_timesteps_ < max_parallel_timesteps_) {
+    return false;
+  }
+  std::lock_guard<std::mutex> lk(mutex_);
+  // Check again, a timestep may have finished in the meantime.
+  if (step - finished_timesteps_ < max_parallel_timesteps_) {
+    return false;
+  }
+  deferred_.push_back(job);
+  return true;
+}
+
+/**
+ * Runs a single op and updates its dependencies when finished. Ops that
+ * became ready are pushed to the heap of this worker.
+ */
+void WavefrontRecurrentNetworkExecutor::RunOp(const OpTask& job, int worker) {
+  bool first_timestep =
+      ((job.forward() && job.timestep == 0) ||
+       (job.backward() && job.timestep == job.T - 1));
+  bool last_timestep =
+      ((job.backward() && job.timestep == 0) ||
+       (job.forward() && job.timestep == job.T - 1));
+  auto& rnn_op = timestep_ops_[job.timestep][job.op_idx];
+  if (rnn_op.num_dynamic_inputs > 0 && !rnn_op.frontier) {
+    CAFFE_ENFORCE_EQ(
+        rnn_op.proc_inputs,
+        rnn_op.num_dynamic_inputs -
+            first_timestep * rnn_op.num_recurrent_inputs,
+        "Error at operator ",
+        job.op_idx,
+        " on timestep ",
+        job.timestep,
+        " T=",
+        job.T,
+        " first =",
+        first_timestep);
+  }
+
+  rnn_op.proc_inputs = 0;
+  rnn_op.op->Run();
+
+  for (int depidx : rnn_op.dependencies) {
+    int t = job.timestep;
+    bool for_next_timestep = depidx <= rnn_op.order;
+    if (!last_timestep && for_next_timestep) {
+      t += job.direction;
+    } else if (for_next_timestep) {
+      continue;
+    }
+
+    auto& dep_op = timestep_ops_[t][depidx];
+    int proc_inputs = dep_op.proc_inputs.fetch_add(1) + 1;
+
+    int num_req_inputs = dep_op.num_dynamic_inputs;
+    if (first_timestep && !for_next_timestep) {
+      num_req_inputs -= dep_op.num_recurrent_inputs;
+    }
+
+    if (proc_inputs == num_req_inputs || num_req_inputs == 0) {
+      Push(worker, OpTask(t, depidx, job.T, job.direction));
+    }
+  }
+
+  if (job.op_idx == timestep_ops_template_.size() - 1) {
+    finished_timesteps_.fetch_add(1);
+    if (max_parallel_timesteps_ > 0) {
+      std::vector<OpTask> deferred;
+      {
+        std::lock_guard<std::mutex> lk(mutex_);
+        deferred.swap(deferred_);
+      }
+      for (const auto& task : deferred) {
+        Push(worker, task);
+      }
+    }
+  }
+
+  // The last op wakes up the caller.
+  if (countdown_.fetch_sub(1) == 1) {
+    std::lock_guard<std::mutex> lk(mutex_);
+    cv_.notify_all();
+  }
+}
+
+/**
+ * Run-loop of a worker. The caller's loop returns when the run is finished,
+ * the helper threads' loops when the executor is destroyed.
+ */
+void WavefrontRecurrentNetworkExecutor::WorkerLoop(int worker, bool caller) {
+  int idle = 0;
+  while (true) {
+    OpTask job;
+    if (Pop(worker, &job)) {
+      idle = 0;
+      if (failed_) {
+        // Drain the heaps of a failed run.
+        continue;
+      }
+      if (max_parallel_timesteps_ > 0 && Defer(job)) {
+        continue;
+      }
+      try {
+        RunOp(job, worker);
+      } catch (::caffe2::EnforceNotMet& enf) {
+        std::lock_guard<std::mutex> lk(mutex_);
+        LOG(ERROR) << "Crash at worker " << worker << " timestep "
+                   << job.timestep
+                   << " op:" << ProtoDebugString(step_net_def_.op(job.op_idx))
+                   << enf.what();
+        failed_ = true;
+        cv_.notify_all();
+      }
+      continue;
+    }
+
+    if (caller && (countdown_ == 0 || failed_)) {
+      return;
+    }
+    if (!caller && stop_) {
+      return;
+    }
+    if (++idle < kSpinIterations) {
+      std::this_thread::yield();
+      continue;
+    }
+
+    std::unique_lock<std::mutex> lk(mutex_);
+    sleeping_.fetch_add(1);
+    cv_.wait(lk, [&] {
+      return pending_ > 0 || (caller ? countdown_ == 0 || failed_ : stop_);
+    });
+    sleeping_.fetch_sub(1);
+    idle = 0;
+  }
+}
+
+/**
+ * Starts the helper threads on the first run, pushes the frontier ops of
+ * the first timestep and runs tasks on the calling thread until all tasks
+ * finished, or a failure.
+ */
+void WavefrontRecurrentNetworkExecutor::Exec(int T, int direction) {
+  CAFFE_ENFORCE_EQ(
+      false, failed_, "Tried to execute a previously failed RNN executor");
+  CAFFE_ENFORCE(timestep_ops_.size() >= T);
+
+  // The helper threads keep indexing workers_ between runs, so it is only
+  // sized once, before they are started.
+  if (workers_.empty()) {
+    const int num_workers = std::max(num_threads_, 1);
+    for (int i = 0; i < num_workers; i++) {
+      workers_.emplace_back(new Worker());
+    }
+    for (int i = 1; i < num_workers; i++) {
+      VLOG(1) << "Start RNN worker " << i << " / " << num_threads_;
+      threads_.emplace_back(
+          &WavefrontRecurrentNetworkExecutor::WorkerLoop, this, i, false);
+    }
+  }
+
+  countdown_ = T * timestep_ops_[0].size();
+  finished_timesteps_ = 0;
+  CHECK(pending_ == 0);
+
+  const int first = direction == 1 ? 0 : T - 1;
+  for (auto& rnn_op : timestep_ops_[first]) {
+    if (rnn_op.frontier) {
+      Push(0, OpTask(first, rnn_op.order, T, direction));
+    }
+  }
+
+  WorkerLoop(0, true);
+
+  CAFFE_ENFORCE_EQ(
+      false,
+      failed_,
+      "RNN executor encountered failure. See prior error logs for details.");
+}
+
+} // namespace caffe2
@@ -7,30 +7,84 @@ import sys
 sizeof = {"float": 4, "at::Half": 2, "uint8_t": 1}
 
 
+class Isa(object):
+    """Vector width and intrinsic names of an instruction set.
+
+    The code below is written with the names of AVX2 and formatted with the
+    fields of this class, e.g. "{mm}_fmadd_ps" becomes _mm512_fmadd_ps for
+    AVX-512.
+    """
+
+    def __init__(self, name, suffix, width, mm, vec, half_load, half_vec, u8_load):
+        self.name = name
+        # suffix of the generated functions, as expected by the *_DO macros
+        self.suffix = suffix
+        # number of floats in a vector register
+        self.width = width
+        self.mm = mm
+        self.vec = vec
+        # load of `width` halfs, and its integer vector type
+        self.half_load = half_load
+        self.half_vec = half_vec
+        # load of `width` uint8_t values
+        self.u8_load = u8_load
+
+    def format(self, line):
+        return line.format(**self.__dict__)
+
+
+isas = {
+    "avx2": Isa(
+        "avx2",
+        "__avx2_fma",
+        8,
+        "_mm256",
+        "__m256",
+        "_mm_loadu_si128",
+        "__m128i",
+        "_mm_loadl_epi64",
+    ),
+    "avx512": Isa(
+        "avx512",
+        "__avx512",
+        16,
+        "_mm512",
+        "__m512",
+        "_mm256_loadu_si256",
+        "__m256i",
+        "_mm_loadu_si128",
+    ),
+}
+
+
 def unroll(uf, IndexType, InType, OutType, use_weights, isa, fused):
     def compute(regid, InType, use_weights, isa, prefetch):
         code = []
 
         if InType == "float":
             code.append(
-                "        vop%d = _mm256_fmadd_ps(vwgt, _mm256_loadu_ps(ip + (%d)), vop%d);"  # noqa
+                isa.format("        vop%d = {mm}_fmadd_ps(vwgt, {mm}_loadu_ps(ip + (%d)), vop%d);")  # noqa
                 % (regid, regid, regid)
             )
         elif InType == "at::Half":
             code.append(
-                "        vop%d = _mm256_fmadd_ps(\n"
-                "            vwgt,\n"
-                "            _mm256_cvtph_ps(\n"
-                "                _mm_loadu_si128(reinterpret_cast<const __m128i*>(ip + (%d)))),\n"  # noqa
-                "            vop%d);" % (regid, regid, regid)
+                isa.format(
+                    "        vop%d = {mm}_fmadd_ps(\n"
+                    "            vwgt,\n"
+                    "            {mm}_cvtph_ps(\n"
+                    "                {half_load}(reinterpret_cast<const {half_vec}*>(ip + (%d)))),\n"  # noqa
+                    "            vop%d);"
+                ) % (regid, regid, regid)
             )
         elif InType == "uint8_t":
             code.append(
-                "        vop%d = _mm256_fmadd_ps(\n"
-                "            vwgt,\n"
-                "            _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(\n"
-                "                _mm_loadl_epi64(reinterpret_cast<const __m128i*>(ip + (%d))))),\n"  # noqa
-                "            _mm256_add_ps(vop%d, vbio));" % (regid, regid, regid)
+                isa.format(
+                    "        vop%d = {mm}_fmadd_ps(\n"
+                    "            vwgt,\n"
+                    "            {mm}_cvtepi32_ps({mm}_cvtepu8_epi32(\n"
+                    "                {u8_load}(reinterpret_cast<const __m128i*>(ip + (%d))))),\n"  # noqa
+                    "            {mm}_add_ps(vop%d, vbio));"
+                ) % (regid, regid, regid)
             )
         else:
             assert False
@@ -57,8 +111,8 @@ def unroll(uf, IndexType, InType, OutType, use_weights, isa, fused):
     )
     code.append("      " + OutType + "* op = &out[rangeIndex * block_size];")
     for i in range(0, uf):
-        j = 8 * i
-        code.append("      __m256 vop" + str(j) + " = _mm256_setzero_ps();")
+        j = isa.width * i
+        code.append(isa.format("      {vec} vop" + str(j) + " = {mm}_setzero_ps();"))
 
     # inner loop
     code.append(
@@ -96,7 +150,7 @@ def unroll(uf, IndexType, InType, OutType, use_weights, isa, fused):
         else:
             code.append("        bio = wgt * scale_bias[2 * idx + 1];")
             code.append("        wgt = wgt * scale_bias[2 * idx];")
-        code.append("        __m256 vbio = _mm256_set1_ps(bio);")
+        code.append(isa.format("        {vec} vbio = {mm}_set1_ps(bio);"))
     else:
         code.append("        " + OutType + " wgt = 1.f;")
         code.append("        if (weights) {")
@@ -104,7 +158,7 @@ def unroll(uf, IndexType, InType, OutType, use_weights, isa, fused):
             "          wgt = weights[IS_WEIGHT_POSITIONAL ? (dataInd - start) : dataInd];"  # noqa
         )
         code.append("        }")
-    code.append("        __m256 vwgt = _mm256_set1_ps(wgt);")
+    code.append(isa.format("        {vec} vwgt = {mm}_set1_ps(wgt);"))
 
     code.append("        const {}* ip = &input[idx * fused_block_size];".format(InType))
     code.append(
@@ -126,7 +180,7 @@ def unroll(uf, IndexType, InType, OutType, use_weights, isa, fused):
     )
 
     for i in range(0, uf):
-        j = 8 * i
+        j = isa.width * i
         cachelinesize = 64
         byteoffset = sizeof[InType] * j
         prefetch = (byteoffset % cachelinesize) == 0
@@ -135,17 +189,25 @@ def unroll(uf, IndexType, InType, OutType, use_weights, isa, fused):
 
     code.append("      if (!normalize_by_lengths || lengths[rangeIndex] == 0) {")
     for i in range(0, uf):
-        j = 8 * i
-        code.append("        _mm256_storeu_ps(&op[" + str(j) + "], vop" + str(j) + ");")
+        j = isa.width * i
+        code.append(
+            isa.format("        {mm}_storeu_ps(&op[")
+            + str(j)
+            + "], vop"
+            + str(j)
+            + ");"
+        )
     code.append("      } else {")
     # inv of length
-    code.append("        __m256 vlen_inv = _mm256_set1_ps(1.0f / lengths[rangeIndex]);")
+    code.append(
+        isa.format("        {vec} vlen_inv = {mm}_set1_ps(1.0f / lengths[rangeIndex]);")
+    )
     for i in range(0, uf):
-        j = 8 * i
+        j = isa.width * i
         code.append(
-            "        _mm256_storeu_ps(&op["
+            isa.format("        {mm}_storeu_ps(&op[")
             + str(j)
-            + "], _mm256_mul_ps("
+            + isa.format("], {mm}_mul_ps(")
             + "vop"
             + str(j)
             + ", vlen_inv));"
@@ -161,30 +223,36 @@ def generic(IndexType, InType, OutType, use_weights, isa, fused):
         code = []
         if InType == "float":
             code.append(
-                "          _mm256_storeu_ps(\n"
-                "              &op[j],\n"
-                "              _mm256_fmadd_ps(\n"
-                "                  vwgt, _mm256_loadu_ps(&ip[j]), _mm256_loadu_ps(&op[j])));"  # noqa
+                isa.format(
+                    "          {mm}_storeu_ps(\n"
+                    "              &op[j],\n"
+                    "              {mm}_fmadd_ps(\n"
+                    "                  vwgt, {mm}_loadu_ps(&ip[j]), {mm}_loadu_ps(&op[j])));"  # noqa
+                )
             )
         elif InType == "at::Half":
             code.append(
-                "          _mm256_storeu_ps(\n"
-                "              &op[j],\n"
-                "              _mm256_fmadd_ps(\n"
-                "                  vwgt,\n"
-                "                  _mm256_cvtph_ps(_mm_loadu_si128(\n"
-                "                      reinterpret_cast<const __m128i*>(&ip[j]))),\n"
-                "                  _mm256_loadu_ps(&op[j])));"
+                isa.format(
+                    "          {mm}_storeu_ps(\n"
+                    "              &op[j],\n"
+                    "              {mm}_fmadd_ps(\n"
+                    "                  vwgt,\n"
+                    "                  {mm}_cvtph_ps({half_load}(\n"
+                    "                      reinterpret_cast<const {half_vec}*>(&ip[j]))),\n"
+                    "                  {mm}_loadu_ps(&op[j])));"
+                )
             )
         elif InType == "uint8_t":
             code.append(
-                "          _mm256_storeu_ps(\n"
-                "              &op[j],\n"
-                "              _mm256_fmadd_ps(\n"
-                "                  vwgt,\n"
-                "                  _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(_mm_loadl_epi64(\n"  # noqa
-                "                      reinterpret_cast<const __m128i*>(&ip[j])))),\n"
-                "                  _mm256_add_ps(_mm256_loadu_ps(&op[j]), vbio)));"
+                isa.format(
+                    "          {mm}_storeu_ps(\n"
+                    "              &op[j],\n"
+                    "              {mm}_fmadd_ps(\n"
+                    "                  vwgt,\n"
+                    "                  {mm}_cvtepi32_ps({mm}_cvtepu8_epi32({u8_load}(\n"  # noqa
+                    "                      reinterpret_cast<const __m128i*>(&ip[j])))),\n"
+                    "                  {mm}_add_ps({mm}_loadu_ps(&op[j]), vbio)));"
+                )
             )
         else:
             assert False
@@ -206,8 +274,8 @@ def generic(IndexType, InType, OutType, use_weights, isa, fused):
 
     # initialize to 0
     code.append("      int64_t j = 0;")
-    code.append("      for (; j + 8 <= block_size; j += 8) {")
-    code.append("        _mm256_storeu_ps(op + j, _mm256_setzero_ps());")
+    code.append(isa.format("      for (; j + {width} <= block_size; j += {width}) {{"))
+    code.append(isa.format("        {mm}_storeu_ps(op + j, {mm}_setzero_ps());"))
     code.append("      }")
     code.append("      for (; j < block_size; j++) {")
     code.append("        op[j] = 0.0f;")
@@ -249,7 +317,7 @@ def generic(IndexType, InType, OutType, use_weights, isa, fused):
         else:
             code.append("        bio = wgt * scale_bias[2 * idx + 1];")
             code.append("        wgt = wgt * scale_bias[2 * idx];")
-        code.append("        __m256 vbio = _mm256_set1_ps(bio);")
+        code.append(isa.format("        {vec} vbio = {mm}_set1_ps(bio);"))
     else:
         code.append("        " + OutType + " wgt = 1.f;")
         code.append("        if (weights) {")
@@ -257,7 +325,7 @@ def generic(IndexType, InType, OutType, use_weights, isa, fused):
             "          wgt = weights[IS_WEIGHT_POSITIONAL ? (dataInd - start) : dataInd];"  # noqa
         )
         code.append("        }")
-    code.append("        __m256 vwgt = _mm256_set1_ps(wgt);")
+    code.append(isa.format("        {vec} vwgt = {mm}_set1_ps(wgt);"))
 
     code.append("        const {}* ip = &input[idx * fused_block_size];".format(InType))
     code.append(
@@ -279,7 +347,7 @@ def generic(IndexType, InType, OutType, use_weights, isa, fused):
 
     # compute and store main loop
     code.append("        j = 0;")
-    code.append("        for (; j + 8 <= block_size; j += 8) {")
+    code.append(isa.format("        for (; j + {width} <= block_size; j += {width}) {{"))
     code.extend(compute(InType, use_weights, isa))
     code.append("        }")
     # leftover
@@ -303,12 +371,14 @@ def generic(IndexType, InType, OutType, use_weights, isa, fused):
 
     code.append("      if (normalize_by_lengths && lengths[rangeIndex]) {")
     code.append("        float len_inv = 1.0f / lengths[rangeIndex];")
-    code.append("        __m256 vlen_inv = _mm256_set1_ps(len_inv);")
+    code.append(isa.format("        {vec} vlen_inv = {mm}_set1_ps(len_inv);"))
     code.append("        j = 0;")
-    code.append("        for (; j + 8 <= block_size; j += 8) {")
+    code.append(isa.format("        for (; j + {width} <= block_size; j += {width}) {{"))
     code.append(
-        "          _mm256_storeu_ps(\n"
-        "              &op[j], _mm256_mul_ps(_mm256_loadu_ps(&op[j]), vlen_inv));"
+        isa.format(
+            "          {mm}_storeu_ps(\n"
+            "              &op[j], {mm}_mul_ps({mm}_loadu_ps(&op[j]), vlen_inv));"
+        )
     )
     code.append("        }")
     code.append("        for (; j < block_size; j++) {")
@@ -325,13 +395,21 @@ def generic(IndexType, InType, OutType, use_weights, isa, fused):
 parser = argparse.ArgumentParser()
 parser.add_argument("-f", "--filename", help="file name")
 parser.add_argument("--fused", action="store_true")
+parser.add_argument("--isa", choices=sorted(isas.keys()), default="avx2")
+parser.add_argument(
+    "--prefetch",
+    type=int,
+    default=16,
+    help="number of indices to look ahead when prefetching rows",
+)
 opts = parser.parse_args()
+isa = isas[opts.isa]
 if opts.filename:
     filename = opts.filename
 elif opts.fused:
-    filename = "embedding_lookup_fused_8bit_rowwise_avx2.cc"
+    filename = "embedding_lookup_fused_8bit_rowwise_{}.cc".format(isa.name)
 else:
-    filename = "embedding_lookup_avx2.cc"
+    filename = "embedding_lookup_{}.cc".format(isa.name)
 
 options = [
     ["int32_t", "int", "float", "float", "float", "float"],
@@ -363,7 +441,7 @@ for o in options:
     fn_base = "{}EmbeddingLookup_{}_{}_{}".format(
         prefix, IndexTypeName, InTypeName, OutTypeName
     )
-    suffix = "__avx2_fma"
+    suffix = isa.suffix
     fn = "static bool " + fn_base + suffix
     code.append(fn + "(")
 
@@ -382,7 +460,7 @@ for o in options:
     args.append("    " + OutType + "* out) {")
     code += args
 
-    code.append("  const " + IndexType + " prefdist_T0 = 16;")
+    code.append("  const {} prefdist_T0 = {};".format(IndexType, opts.prefetch))
     # block_size is the number of elements and fused_block_size is the size of
     # an entire row, including scale and bias.
     offset = (8 // sizeof[InType]) if opts.fused else 0
@@ -393,17 +471,17 @@ for o in options:
 
     # code.append("printf(\"calling " + fn + "\\n\");");
 
-    code.append("  if (block_size == 128) {")
-    code += unroll(16, IndexType, InType, OutType, True, "AVX2", opts.fused)
-    code.append("  } else if (block_size == 64) {")
-    code += unroll(8, IndexType, InType, OutType, True, "AVX2", opts.fused)
-    code.append("  } else if (block_size == 32) {")
-    code += unroll(4, IndexType, InType, OutType, True, "AVX2", opts.fused)
-    code.append("  } else if (block_size == 16) {")
-    code += unroll(2, IndexType, InType, OutType, True, "AVX2", opts.fused)
+    # keep the rows of common sizes in registers
+    for i, block_size in enumerate([128, 64, 32, 16]):
+        code.append(
+            "  {}if (block_size == {}) {{".format("} else " if i else "", block_size)
+        )
+        code += unroll(
+            block_size // isa.width, IndexType, InType, OutType, True, isa, opts.fused
+        )
     code.append("  } else {")
     code.append("    // generic code")
-    code += generic(IndexType, InType, OutType, True, "AVX2", opts.fused)
+    code += generic(IndexType, InType, OutType, True, isa, opts.fused)
     code.append("  }")
     code.append("  return dataInd == index_size;")
 
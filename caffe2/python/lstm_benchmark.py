@@ -156,6 +156,7 @@ def create_model(args, queue, label_queue, input_shape):
                     op,
                     num_threads=args.rnn_executor_num_threads,
                     max_cuda_streams=args.rnn_executor_max_cuda_streams,
+                    executor_type=args.rnn_executor_type,
                 )
     return model, output
 
@@ -325,6 +326,12 @@ def GetArgumentParser():
         default=None,
         help="Maximum number of CUDA streams used by RNN executor on GPU"
     )
+    parser.add_argument(
+        "--rnn_executor_type",
+        type=str,
+        default=None,
+        help="CPU RNN executor: 'threaded' (default) or 'wavefront'"
+    )
     return parser
 
 
@@ -216,3 +216,153 @@ class TestAdagrad(serial.SerializedTestCase):
             dc,
             row_wise=True,
         )
+
+    @given(
+        num_rows=st.integers(min_value=256, max_value=1024),
+        block_size=st.integers(min_value=1, max_value=16),
+        num_threads=st.sampled_from([0, 1, 4]),
+        num_lock_stripes=st.sampled_from([0, 7]),
+        row_wise=st.booleans(),
+        **hu.gcs_cpu_only
+    )
+    def test_sparse_adagrad_parallel(
+        self, num_rows, block_size, num_threads, num_lock_stripes, row_wise, gc, dc
+    ):
+        param = np.random.rand(num_rows, block_size).astype(np.float32)
+        if row_wise:
+            momentum = np.random.rand(num_rows).astype(np.float32)
+        else:
+            momentum = np.random.rand(num_rows, block_size).astype(np.float32)
+        # Unique indices, so that the result does not depend on the order of
+        # the parallel row updates.
+        indices = np.random.choice(
+            num_rows, size=np.random.randint(num_rows), replace=False
+        ).astype(np.int64)
+        grad = np.random.rand(indices.size, block_size).astype(np.float32)
+        lr = np.array([0.1], dtype=np.float32)
+        epsilon = 1e-5
+
+        op = core.CreateOperator(
+            "RowWiseSparseAdagrad" if row_wise else "SparseAdagrad",
+            ["param", "momentum", "indices", "grad", "lr"],
+            ["param", "momentum"],
+            epsilon=epsilon,
+            num_threads=num_threads,
+            num_lock_stripes=num_lock_stripes,
+            device_option=gc,
+        )
+
+        def ref_sparse(param, momentum, indices, grad, lr):
+            param_out = np.copy(param)
+            momentum_out = np.copy(momentum)
+            for i, index in enumerate(indices):
+                param_out[index], momentum_out[index] = ref_adagrad(
+                    param[index],
+                    momentum[index],
+                    grad[i],
+                    lr,
+                    epsilon,
+                    row_wise=row_wise,
+                )
+            return (param_out, momentum_out)
+
+        self.assertReferenceChecks(
+            gc, op, [param, momentum, indices, grad, lr], ref_sparse
+        )
+
+    def _test_sparse_adagrad_fused(
+        self, param, momentum, indices, grad, lengths, row_wise, gc, **kwargs
+    ):
+        lr = np.array([0.1], dtype=np.float32)
+        epsilon = 1e-5
+
+        op = core.CreateOperator(
+            "RowWiseSparseAdagradFusedWithSparseLengthsSumGradient"
+            if row_wise
+            else "SparseAdagradFusedWithSparseLengthsSumGradient",
+            ["param", "momentum", "indices", "grad", "lr", "lengths"],
+            ["param", "momentum"],
+            epsilon=epsilon,
+            device_option=gc,
+            **kwargs
+        )
+
+        def ref_fused(param, momentum, indices, grad, lr, lengths):
+            param_out = np.copy(param)
+            momentum_out = np.copy(momentum)
+            # The gradient of SparseLengthsSum, one row per index.
+            index_grad = np.repeat(grad, lengths, axis=0)
+            for i, index in enumerate(indices):
+                param_out[index], momentum_out[index] = ref_adagrad(
+                    param_out[index],
+                    momentum_out[index],
+                    index_grad[i],
+                    lr,
+                    epsilon,
+                    row_wise=row_wise,
+                )
+            return (param_out, momentum_out)
+
+        self.assertReferenceChecks(
+            gc, op, [param, momentum, indices, grad, lr, lengths], ref_fused
+        )
+
+    @given(
+        num_rows=st.integers(min_value=1, max_value=64),
+        block_size=st.integers(min_value=1, max_value=16),
+        num_segments=st.integers(min_value=0, max_value=32),
+        num_threads=st.sampled_from([1, 4]),
+        row_wise=st.booleans(),
+        **hu.gcs_cpu_only
+    )
+    def test_sparse_adagrad_fused_with_sparse_lengths_sum_gradient(
+        self, num_rows, block_size, num_segments, num_threads, row_wise, gc, dc
+    ):
+        param = np.random.rand(num_rows, block_size).astype(np.float32)
+        if row_wise:
+            momentum = np.random.rand(num_rows).astype(np.float32)
+        else:
+            momentum = np.random.rand(num_rows, block_size).astype(np.float32)
+        lengths = np.random.randint(0, 8, size=num_segments).astype(np.int32)
+        # Repeated indices are only deterministic on a single thread.
+        replace = num_threads == 1
+        hypothesis.assume(replace or lengths.sum() <= num_rows)
+        indices = np.random.choice(
+            num_rows, size=lengths.sum(), replace=replace
+        ).astype(np.int64)
+        grad = np.random.rand(num_segments, block_size).astype(np.float32)
+        self._test_sparse_adagrad_fused(
+            param, momentum, indices, grad, lengths, row_wise, gc,
+            num_threads=num_threads,
+        )
+
+    @given(
+        num_rows=st.integers(min_value=512, max_value=1024),
+        block_size=st.integers(min_value=1, max_value=16),
+        num_segments=st.integers(min_value=32, max_value=64),
+        num_threads=st.sampled_from([0, 4]),
+        num_lock_stripes=st.sampled_from([0, 7]),
+        row_wise=st.booleans(),
+        **hu.gcs_cpu_only
+    )
+    def test_sparse_adagrad_fused_parallel(
+        self, num_rows, block_size, num_segments, num_threads,
+        num_lock_stripes, row_wise, gc, dc
+    ):
+        param = np.random.rand(num_rows, block_size).astype(np.float32)
+        if row_wise:
+            momentum = np.random.rand(num_rows).astype(np.float32)
+        else:
+            momentum = np.random.rand(num_rows, block_size).astype(np.float32)
+        # At least 128 indices, so that the update is split across threads,
+        # and unique ones, so that the result does not depend on the order of
+        # the parallel row updates.
+        lengths = np.random.randint(4, 9, size=num_segments).astype(np.int32)
+        indices = np.random.choice(
+            num_rows, size=lengths.sum(), replace=False
+        ).astype(np.int64)
+        grad = np.random.rand(num_segments, block_size).astype(np.float32)
+        self._test_sparse_adagrad_fused(
+            param, momentum, indices, grad, lengths, row_wise, gc,
+            num_threads=num_threads, num_lock_stripes=num_lock_stripes,
+        )
@@ -0,0 +1,141 @@
+from __future__ import absolute_import
+from __future__ import division
+from __future__ import print_function
+from __future__ import unicode_literals
+
+import argparse
+import numpy as np
+import datetime
+
+from caffe2.python import core, workspace
+
+DTYPES = ['float', 'float16', 'uint8_fused']
+
+OPERATORS = {
+    ('float', 'adagrad'): 'SparseAdagrad',
+    ('float', 'rowwise_adagrad'): 'RowWiseSparseAdagrad',
+    ('float16', 'adagrad'): 'SparseAdagradFp16',
+    ('float16', 'rowwise_adagrad'): 'RowWiseSparseAdagradFp16',
+    ('float16', 'sgd'): 'SparseSGDFp16',
+    ('uint8_fused', 'adagrad'): 'SparseAdagradFused8BitRowwise',
+    ('uint8_fused', 'rowwise_adagrad'): 'RowWiseSparseAdagradFused8BitRowwise',
+    ('uint8_fused', 'sgd'): 'SparseSGDFused8BitRowwise',
+}
+
+
+def benchmark_sparse_update(
+        dtype_str,
+        optimizer,
+        categorical_limit,
+        embedding_size,
+        batch_size,
+        iterations,
+        num_threads,
+        stochastic_rounding):
+    print('Preparing lookup table. ' + str(datetime.datetime.now()))
+
+    data = np.random.rand(categorical_limit, embedding_size).astype(np.float32)
+    if dtype_str == 'uint8_fused':
+        workspace.FeedBlob("X_float", data)
+        workspace.RunOperatorOnce(core.CreateOperator(
+            "FloatToFused8BitRowwiseQuantized", ["X_float"], ["X"]))
+        workspace.FeedBlob("X_float", np.empty(0, dtype=np.float32))
+    elif dtype_str == 'float16':
+        workspace.FeedBlob("X", data.astype(np.float16))
+    else:
+        workspace.FeedBlob("X", data)
+    del data
+
+    if optimizer == 'rowwise_adagrad':
+        moment = np.zeros(categorical_limit, dtype=np.float32)
+    else:
+        moment_dtype = np.float16 if dtype_str == 'float16' else np.float32
+        moment = np.zeros([categorical_limit, embedding_size], dtype=moment_dtype)
+    if optimizer != 'sgd':
+        workspace.FeedBlob("moment", moment)
+
+    table_bytes = workspace.FetchBlob("X").nbytes
+    moment_bytes = 0 if optimizer == 'sgd' else moment.nbytes
+    print('Table: {:.1f} MB, optimizer state: {:.1f} MB, total: {:.1f} MB'.format(
+        table_bytes / 2.0**20,
+        moment_bytes / 2.0**20,
+        (table_bytes + moment_bytes) / 2.0**20))
+
+    # Random indices and gradients of one batch, generated in the net as in
+    # sparse_lengths_sum_benchmark.py.
+    def f(_, outputs):
+        indices = np.random.randint(
+            0, categorical_limit, batch_size).astype(np.int64)
+        outputs[0].feed(indices)
+
+    workspace.FeedBlob(
+        "grad", np.random.rand(batch_size, embedding_size).astype(np.float32))
+    workspace.FeedBlob("lr", np.array([-0.01], dtype=np.float32))
+
+    net = core.Net("mynet")
+    net.Python(f)([], ["indices"])
+    if (dtype_str, optimizer) == ('float', 'sgd'):
+        # The sparse SGD update of fp32 tables.
+        workspace.FeedBlob("one", np.array([1.0], dtype=np.float32))
+        net.ScatterWeightedSum(
+            ["X", "one", "indices", "grad", "lr"], ["X"])
+    else:
+        kwargs = {'num_threads': num_threads}
+        if dtype_str != 'float':
+            kwargs['stochastic_rounding'] = stochastic_rounding
+        op_type = OPERATORS[(dtype_str, optimizer)]
+        if optimizer == 'sgd':
+            getattr(net, op_type)(
+                ["X", "indices", "grad", "lr"], ["X"], **kwargs)
+        else:
+            getattr(net, op_type)(
+                ["X", "moment", "indices", "grad", "lr"], ["X", "moment"],
+                **kwargs)
+    workspace.CreateNet(net)
+
+    np.random.seed(1701)
+
+    print('Preparation finished. ' + str(datetime.datetime.now()))
+
+    workspace.BenchmarkNet(net.Name(), 1, iterations, True)
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(
+        description="minimal benchmark for sparse optimizer updates of fp32, "
+        "fp16 and fused 8-bit rowwise embedding tables.")
+    parser.add_argument(
+        '-d', "--dtype", choices=DTYPES, default="float",
+        help="The data type of the embedding table.")
+    parser.add_argument(
+        '-o', "--optimizer", choices=['adagrad', 'rowwise_adagrad', 'sgd'],
+        default='rowwise_adagrad', help="The sparse optimizer.")
+    parser.add_argument(
+        '-e', "--embedding-size", type=int, default=1000000,
+        help="Lookup table size.")
+    parser.add_argument(
+        "--embedding-dim", type=int, default=64,
+        help="Embedding dimension.")
+    parser.add_argument(
+        "--batch_size", type=int, default=2700,
+        help="The number of rows updated per iteration.")
+    parser.add_argument(
+        '-i', "--iteration", type=int, default=10000,
+        help="The number of iterations.")
+    parser.add_argument(
+        "--num_threads", type=int, default=1,
+        help="Threads updating rows, 0 for the whole workspace thread pool.")
+    parser.add_argument(
+        "--no_stochastic_rounding", action='store_true',
+        help="Round updated fp16 and 8-bit rows to nearest.")
+    args, extra_args = parser.parse_known_args()
+    core.GlobalInit(['python'] + extra_args)
+    benchmark_sparse_update(
+        args.dtype,
+        args.optimizer,
+        args.embedding_size,
+        args.embedding_dim,
+        args.batch_size,
+        args.iteration,
+        args.num_threads,
+        not args.no_stochastic_rounding)
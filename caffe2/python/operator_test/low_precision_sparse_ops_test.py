@@ -0,0 +1,246 @@
+from __future__ import absolute_import, division, print_function, unicode_literals
+
+import caffe2.python.hypothesis_test_util as hu
+import hypothesis.strategies as st
+import numpy as np
+from caffe2.python import core, workspace
+from caffe2.python.fused_8bit_rowwise_conversion_ops_test import (
+    fused_rowwise_8bit_quantize_dequantize_reference,
+)
+from caffe2.python.operator_test.adagrad_test_helper import ref_adagrad
+from hypothesis import given
+
+
+def ref_sparse_update(param, momentum, indices, grad, lr, epsilon, optimizer):
+    param_out = np.copy(param)
+    momentum_out = None if momentum is None else np.copy(momentum)
+    for i, index in enumerate(indices):
+        if optimizer == "sgd":
+            param_out[index] = param[index] + lr * grad[i]
+        else:
+            param_out[index], momentum_out[index] = ref_adagrad(
+                param[index],
+                momentum[index],
+                grad[i],
+                lr,
+                epsilon,
+                row_wise=optimizer == "row_wise_adagrad",
+            )
+    return param_out, momentum_out
+
+
+def create_update_op(op_name, optimizer, **kwargs):
+    if optimizer == "sgd":
+        return core.CreateOperator(
+            op_name, ["param", "indices", "grad", "lr"], ["param"], **kwargs
+        )
+    return core.CreateOperator(
+        op_name,
+        ["param", "momentum", "indices", "grad", "lr"],
+        ["param", "momentum"],
+        **kwargs
+    )
+
+
+OP_NAMES = {
+    ("fp16", "adagrad"): "SparseAdagradFp16",
+    ("fp16", "row_wise_adagrad"): "RowWiseSparseAdagradFp16",
+    ("fp16", "sgd"): "SparseSGDFp16",
+    ("fused_8bit", "adagrad"): "SparseAdagradFused8BitRowwise",
+    ("fused_8bit", "row_wise_adagrad"): "RowWiseSparseAdagradFused8BitRowwise",
+    ("fused_8bit", "sgd"): "SparseSGDFused8BitRowwise",
+}
+
+
+def quantize(param_float):
+    workspace.FeedBlob("param_float", param_float.astype(np.float32))
+    workspace.RunOperatorOnce(
+        core.CreateOperator(
+            "FloatToFused8BitRowwiseQuantized", ["param_float"], ["param_q"]
+        )
+    )
+    return workspace.FetchBlob("param_q")
+
+
+def dequantize(param_q):
+    workspace.FeedBlob("param_q", param_q)
+    workspace.RunOperatorOnce(
+        core.CreateOperator(
+            "Fused8BitRowwiseQuantizedToFloat", ["param_q"], ["param_float"]
+        )
+    )
+    return workspace.FetchBlob("param_float")
+
+
+class TestLowPrecisionSparseOps(hu.HypothesisTestCase):
+    def _inputs(self, num_rows, block_size, optimizer, momentum_dtype):
+        param = np.random.rand(num_rows, block_size).astype(np.float32)
+        if optimizer == "sgd":
+            momentum = None
+        elif optimizer == "row_wise_adagrad":
+            momentum = np.random.rand(num_rows).astype(np.float32)
+        else:
+            momentum = np.random.rand(num_rows, block_size).astype(momentum_dtype)
+        indices = np.random.choice(
+            num_rows, size=np.random.randint(num_rows + 1), replace=False
+        ).astype(np.int64)
+        grad = np.random.rand(indices.size, block_size).astype(np.float32)
+        lr = np.array([-0.1], dtype=np.float32)
+        return param, momentum, indices, grad, lr
+
+    def _run(self, op, param, momentum, indices, grad, lr):
+        workspace.FeedBlob("param", param)
+        if momentum is not None:
+            workspace.FeedBlob("momentum", momentum)
+        workspace.FeedBlob("indices", indices)
+        workspace.FeedBlob("grad", grad)
+        workspace.FeedBlob("lr", lr)
+        workspace.RunOperatorOnce(op)
+        return (
+            workspace.FetchBlob("param"),
+            None if momentum is None else workspace.FetchBlob("momentum"),
+        )
+
+    @given(
+        num_rows=st.integers(min_value=1, max_value=300),
+        block_size=st.integers(min_value=1, max_value=16),
+        optimizer=st.sampled_from(["adagrad", "row_wise_adagrad", "sgd"]),
+        momentum_dtype=st.sampled_from([np.float32, np.float16]),
+        num_threads=st.sampled_from([1, 4]),
+    )
+    def test_fp16_table(
+        self, num_rows, block_size, optimizer, momentum_dtype, num_threads
+    ):
+        param, momentum, indices, grad, lr = self._inputs(
+            num_rows, block_size, optimizer, momentum_dtype
+        )
+        param = param.astype(np.float16)
+        epsilon = 1e-5
+        op = create_update_op(
+            OP_NAMES[("fp16", optimizer)],
+            optimizer,
+            epsilon=epsilon,
+            stochastic_rounding=False,
+            num_threads=num_threads,
+        )
+        param_out, momentum_out = self._run(
+            op, param, momentum, indices, grad, lr
+        )
+
+        ref_param, ref_momentum = ref_sparse_update(
+            param.astype(np.float32),
+            None if momentum is None else momentum.astype(np.float32),
+            indices,
+            grad,
+            lr,
+            epsilon,
+            optimizer,
+        )
+        self.assertEqual(param_out.dtype, np.float16)
+        np.testing.assert_allclose(
+            param_out, ref_param.astype(np.float16), rtol=1e-3, atol=1e-3
+        )
+        if momentum is not None:
+            np.testing.assert_allclose(
+                momentum_out,
+                ref_momentum.astype(momentum.dtype),
+                rtol=1e-3,
+                atol=1e-3,
+            )
+
+    @given(
+        num_rows=st.integers(min_value=1, max_value=300),
+        block_size=st.integers(min_value=1, max_value=16),
+        optimizer=st.sampled_from(["adagrad", "row_wise_adagrad", "sgd"]),
+        stochastic_rounding=st.booleans(),
+        num_threads=st.sampled_from([1, 4]),
+    )
+    def test_fused_8bit_rowwise_table(
+        self, num_rows, block_size, optimizer, stochastic_rounding, num_threads
+    ):
+        param, momentum, indices, grad, lr = self._inputs(
+            num_rows, block_size, optimizer, np.float32
+        )
+        epsilon = 1e-5
+        op = create_update_op(
+            OP_NAMES[("fused_8bit", optimizer)],
+            optimizer,
+            epsilon=epsilon,
+            stochastic_rounding=stochastic_rounding,
+            num_threads=num_threads,
+        )
+        param_out, momentum_out = self._run(
+            op, quantize(param), momentum, indices, grad, lr
+        )
+
+        ref_param, ref_momentum = ref_sparse_update(
+            fused_rowwise_8bit_quantize_dequantize_reference(param),
+            momentum,
+            indices,
+            grad,
+            lr,
+            epsilon,
+            optimizer,
+        )
+        # Rounding moves every value by less than one quantization step, which
+        # is the range of its row divided by 255.
+        step = np.ptp(ref_param, axis=1, keepdims=True) / 255.0
+        np.testing.assert_array_less(
+            np.abs(dequantize(param_out) - ref_param), step + 1e-5
+        )
+        if momentum is not None:
+            np.testing.assert_allclose(
+                momentum_out, ref_momentum, rtol=1e-5, atol=1e-5
+            )
+
+    @given(
+        table=st.sampled_from(["fp16", "fused_8bit"]),
+        stochastic_rounding=st.booleans(),
+    )
+    def test_stochastic_rounding_keeps_small_updates(
+        self, table, stochastic_rounding
+    ):
+        # Each update is much smaller than the precision of the table: it is
+        # lost when rounding to nearest, and kept on average otherwise. The
+        # first and last values of the rows are not updated, so that the scale
+        # and bias of the 8-bit rows stay the same.
+        num_rows, block_size, num_steps, update = 64, 8, 100, 1e-4
+        param = np.tile(
+            np.linspace(1, 2, block_size, dtype=np.float32), (num_rows, 1)
+        )
+        grad = np.ones((num_rows, block_size), dtype=np.float32)
+        grad[:, 0] = grad[:, -1] = 0
+        if table == "fp16":
+            param = param.astype(np.float16)
+            workspace.FeedBlob("param", param)
+            param = param.astype(np.float32)
+        else:
+            workspace.FeedBlob("param", quantize(param))
+            param = fused_rowwise_8bit_quantize_dequantize_reference(param)
+        workspace.FeedBlob("indices", np.arange(num_rows, dtype=np.int64))
+        workspace.FeedBlob("grad", grad)
+        workspace.FeedBlob("lr", np.array([update], dtype=np.float32))
+        op = core.CreateOperator(
+            OP_NAMES[(table, "sgd")],
+            ["param", "indices", "grad", "lr"],
+            ["param"],
+            stochastic_rounding=stochastic_rounding,
+        )
+        for _ in range(num_steps):
+            workspace.RunOperatorOnce(op)
+
+        if table == "fp16":
+            param_out = workspace.FetchBlob("param").astype(np.float32)
+        else:
+            param_out = dequantize(workspace.FetchBlob("param"))
+        drift = np.mean((param_out - param)[:, 1:-1])
+        if stochastic_rounding:
+            np.testing.assert_allclose(drift, num_steps * update, rtol=0.2)
+        else:
+            self.assertLess(abs(drift), 0.2 * num_steps * update)
+
+
+if __name__ == "__main__":
+    import unittest
+
+    unittest.main()
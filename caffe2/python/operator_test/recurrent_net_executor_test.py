@@ -5,6 +5,7 @@ from __future__ import unicode_literals
 
 from caffe2.proto import caffe2_pb2
 from caffe2.python import model_helper, workspace, core, rnn_cell, test_util
+from caffe2.python import recurrent
 from caffe2.python.attention import AttentionType
 
 import numpy as np
@@ -218,6 +219,28 @@ class TestRNNExecutor(test_util.TestCase):
             model, _ = self.init_lstm_model(T, num_layers, forward_only)
             self._compare(model, forward_only)
 
+    @given(
+        num_layers=st.integers(1, 8),
+        T=st.integers(4, 100),
+        forward_only=st.booleans(),
+        num_threads=st.integers(1, 4))
+    def test_lstm_wavefront_equal_simplenet(
+            self, num_layers, T, forward_only, num_threads):
+        '''
+        Test that the wavefront CPU executor produces same results as
+        running step nets as sequence of simple nets.
+        '''
+        self.Tseq = [T, T // 2, T // 2 + T // 4, T, T // 2 + 1]
+
+        workspace.ResetWorkspace()
+        with core.DeviceScope(caffe2_pb2.DeviceOption()):
+            model, _ = self.init_lstm_model(T, num_layers, forward_only)
+            for op in model.net.Proto().op:
+                if op.type.startswith("RecurrentNetwork"):
+                    recurrent.set_rnn_executor_config(
+                        op, num_threads=num_threads, executor_type='wavefront')
+            self._compare(model, forward_only)
+
     def _compare(self, model, forward_only):
         # Store list of blobs that exist in the beginning
         workspace.RunNetOnce(model.param_init_net)
@@ -636,6 +636,52 @@ class TestSegmentOps(hu.HypothesisTestCase):
         with self.assertRaises(RuntimeError):
             workspace.RunOperatorOnce(op)
 
+    @given(
+        op_type=st.sampled_from([
+            "SparseLengthsSum",
+            "SparseLengthsMean",
+            "SparseLengthsWeightedSum",
+            "SparseLengthsPositionalWeightedSum",
+        ]),
+        block_size=st.sampled_from([20, 64]),
+        num_threads=st.sampled_from([0, 3]),
+        seed=st.integers(min_value=0, max_value=100),
+        **hu.gcs_cpu_only
+    )
+    def test_sparse_lengths_num_threads(
+            self, op_type, block_size, num_threads, seed, gc, dc):
+        np.random.seed(seed)
+        # Enough indices to split the lookup into ranges, with empty
+        # segments in between and at the end.
+        L = np.random.randint(0, 20, size=1000).astype(np.int32)
+        L[-10:] = 0
+        D = np.random.rand(500, block_size).astype(np.float32)
+        I = np.random.randint(0, 500, size=L.sum()).astype(np.int64)
+        W = np.random.rand(
+            20 if op_type == "SparseLengthsPositionalWeightedSum" else I.size
+        ).astype(np.float32)
+        inputs = ["D", "I", "L"]
+        if "Weighted" in op_type:
+            inputs = ["D", "W", "I", "L"]
+        workspace.FeedBlob("D", D)
+        workspace.FeedBlob("W", W)
+        workspace.FeedBlob("I", I)
+        workspace.FeedBlob("L", L)
+
+        workspace.RunOperatorOnce(core.CreateOperator(
+            op_type, inputs, "expected"))
+        workspace.RunOperatorOnce(core.CreateOperator(
+            op_type, inputs, "out", num_threads=num_threads))
+        np.testing.assert_array_equal(
+            workspace.FetchBlob("expected"), workspace.FetchBlob("out"))
+
+        # Errors of the threads of the pool are rethrown.
+        I[-1] = 500
+        workspace.FeedBlob("I", I)
+        with self.assertRaises(RuntimeError):
+            workspace.RunOperatorOnce(core.CreateOperator(
+                op_type, inputs, "out", num_threads=num_threads))
+
     @serial.given(**hu.gcs_cpu_only)
     def test_sparse_lengths_positional_weighted_sum(
             self, gc, dc):
@@ -17,13 +17,7 @@ DTYPES = {
 }
 
 
-def benchmark_sparse_lengths_sum(
-        dtype_str,
-        categorical_limit,
-        embedding_size,
-        average_len,
-        batch_size,
-        iterations):
+def feed_lookup_table(dtype_str, categorical_limit, embedding_size):
     print('Preparing lookup table. ' + str(datetime.datetime.now()))
 
     # We will use a constant, but non-trivial value so we save initialization
@@ -41,6 +35,27 @@ def benchmark_sparse_lengths_sum(
     print('Data has shape {} {}'.format(data.shape, datetime.datetime.now()))
     workspace.FeedBlob("X", data.astype(DTYPES[dtype_str]))
 
+
+def add_sparse_lengths_sum(net, dtype_str, num_threads):
+    if dtype_str == "uint8":
+        net.SparseLengthsSum8BitsRowwise(["X", "indices", "lengths", "scale_bias"], "Y")
+    elif dtype_str == "uint8_fused":
+        net.SparseLengthsSumFused8BitRowwise(["X", "indices", "lengths"], "Y")
+    else:
+        net.SparseLengthsSum(
+            ["X", "indices", "lengths"], "Y", num_threads=num_threads)
+
+
+def benchmark_sparse_lengths_sum(
+        dtype_str,
+        categorical_limit,
+        embedding_size,
+        average_len,
+        batch_size,
+        iterations,
+        num_threads=1):
+    feed_lookup_table(dtype_str, categorical_limit, embedding_size)
+
     # In order to produce truly random lengths and indices, we will embed a
     # Python operator in the net to generate them.
     def f(_, outputs):
@@ -55,12 +70,7 @@ def benchmark_sparse_lengths_sum(
 
     net = core.Net("mynet")
     net.Python(f)([], ["indices", "lengths", ])
-    if dtype_str == "uint8":
-        net.SparseLengthsSum8BitsRowwise(["X", "indices", "lengths", "scale_bias"], "Y")
-    elif dtype_str == "uint8_fused":
-        net.SparseLengthsSumFused8BitRowwise(["X", "indices", "lengths"], "Y")
-    else:
-        net.SparseLengthsSum(["X", "indices", "lengths"], "Y")
+    add_sparse_lengths_sum(net, dtype_str, num_threads)
     workspace.CreateNet(net)
 
     # Set random seed, so that repeated runs will keep the same sequence of
@@ -72,6 +82,47 @@ def benchmark_sparse_lengths_sum(
     workspace.BenchmarkNet(net.Name(), 1, iterations, True)
 
 
+def sweep_sparse_lengths_sum(
+        dtype_str,
+        categorical_limit,
+        average_len,
+        iterations,
+        num_threads,
+        batch_sizes,
+        embedding_sizes):
+    """Prints the time per lookup for every batch size and embedding size.
+
+    The indices are generated once per batch size, so that only the lookup is
+    timed.
+    """
+    print('{:>10} {:>10} {:>12} {:>12}'.format(
+        'dim', 'batch', 'ms/iter', 'GB/s'))
+    for embedding_size in embedding_sizes:
+        workspace.ResetWorkspace()
+        feed_lookup_table(dtype_str, categorical_limit, embedding_size)
+        row_bytes = embedding_size * np.dtype(DTYPES[dtype_str]).itemsize
+        for batch_size in batch_sizes:
+            np.random.seed(1701)
+            lengths = np.random.randint(
+                int(average_len * 0.75),
+                int(average_len * 1.25),
+                batch_size).astype(np.int32)
+            indices = np.random.randint(
+                0, categorical_limit, np.sum(lengths)).astype(np.int64)
+            workspace.FeedBlob("indices", indices)
+            workspace.FeedBlob("lengths", lengths)
+
+            net = core.Net("sweep_{}_{}".format(embedding_size, batch_size))
+            add_sparse_lengths_sum(net, dtype_str, num_threads)
+            workspace.CreateNet(net)
+            ms = workspace.BenchmarkNet(net.Name(), 10, iterations, False)[0]
+            print('{:>10} {:>10} {:>12.4f} {:>12.2f}'.format(
+                embedding_size,
+                batch_size,
+                ms,
+                len(indices) * row_bytes / (ms * 1e6)))
+
+
 if __name__ == "__main__":
     parser = argparse.ArgumentParser(
         description="minimal benchmark for sparse lengths sum.")
@@ -93,12 +144,39 @@ if __name__ == "__main__":
     parser.add_argument(
         '-i', "--iteration", type=int, default=100000,
         help="The number of iterations.")
+    parser.add_argument(
+        "--num_threads", type=int, default=1,
+        help="Threads of the workspace thread pool that look up segments, "
+        "0 for all of them (float and float16 only).")
+    parser.add_argument(
+        "--sweep", action="store_true",
+        help="Time the lookup alone for every combination of --batch_sizes "
+        "and --embedding_dims, instead of a single configuration.")
+    parser.add_argument(
+        "--batch_sizes", type=int, nargs='+',
+        default=[16, 64, 256, 1024, 4096],
+        help="The batch sizes of the sweep.")
+    parser.add_argument(
+        "--embedding_dims", type=int, nargs='+',
+        default=[16, 32, 64, 128, 256],
+        help="The embedding dimensions of the sweep.")
     args, extra_args = parser.parse_known_args()
     core.GlobalInit(['python'] + extra_args)
-    benchmark_sparse_lengths_sum(
-        args.dtype,
-        args.embedding_size,
-        args.embedding_dim,
-        args.average_len,
-        args.batch_size,
-        args.iteration)
+    if args.sweep:
+        sweep_sparse_lengths_sum(
+            args.dtype,
+            args.embedding_size,
+            args.average_len,
+            args.iteration,
+            args.num_threads,
+            args.batch_sizes,
+            args.embedding_dims)
+    else:
+        benchmark_sparse_lengths_sum(
+            args.dtype,
+            args.embedding_size,
+            args.embedding_dim,
+            args.average_len,
+            args.batch_size,
+            args.iteration,
+            args.num_threads)
@@ -286,20 +286,29 @@ def recurrent_net(
     return results[:-1]
 
 
-def set_rnn_executor_config(rnn_op, num_threads=None, max_cuda_streams=None):
+def set_rnn_executor_config(rnn_op, num_threads=None, max_cuda_streams=None,
+                            executor_type=None):
+    '''
+    executor_type: on CPU, either 'threaded' (default) or 'wavefront'
+    '''
     from caffe2.proto import caffe2_pb2
     assert rnn_op.type in {'RecurrentNetwork', 'RecurrentNetworkGradient'}
 
     def add_arg(s, v):
         a = caffe2_pb2.Argument()
         a.name = "rnn_executor." + s
-        a.i = v
+        if isinstance(v, int):
+            a.i = v
+        else:
+            a.s = v.encode('utf-8')
         rnn_op.arg.extend([a])
 
     if num_threads is not None:
         add_arg('num_threads', num_threads)
     if max_cuda_streams is not None:
         add_arg('max_cuda_streams', max_cuda_streams)
+    if executor_type is not None:
+        add_arg('type', executor_type)
 
 
 def retrieve_step_blobs(net, prefix='rnn'):
@@ -47,6 +47,39 @@ def Compare(args):
     print("Ratio average: {}".format(ratio_sum / len(results)))
 
 
+@utils.debug
+def CompareExecutors(args):
+    '''
+    Compares the threaded and the wavefront RNN executors on CPU for
+    seq2seq-sized LSTMs of varying hidden size.
+    '''
+    results = []
+    num_iters = 100
+    args.gpu = False
+    args.rnn_executor = True
+    args.implementation = 'own'
+    for num_layers in [2, 4]:
+        for hidden_dim in [32, 128, 512, 1024]:
+            args.num_layers = num_layers
+            args.hidden_dim = hidden_dim
+            args.data_size = args.batch_size * args.seq_length * num_iters
+            args.iters_to_report = num_iters // 3
+
+            times = {}
+            for executor_type in ['threaded', 'wavefront']:
+                args.rnn_executor_type = executor_type
+                times[executor_type] = float(lstm_benchmark.Benchmark(args))
+                workspace.ResetWorkspace()
+            results.append((copy(args), times))
+
+    for args, times in results:
+        print("hidden_dim: {}, num_layers: {}, seq_length: {}, batch_size: {}:"
+              " threaded time: {}, wavefront time: {}, speedup: {}".format(
+                  args.hidden_dim, args.num_layers, args.seq_length,
+                  args.batch_size, times['threaded'], times['wavefront'],
+                  times['threaded'] / times['wavefront']))
+
+
 if __name__ == '__main__':
     args = lstm_benchmark.GetArgumentParser().parse_args()
 
@@ -56,4 +89,8 @@ if __name__ == '__main__':
         '--caffe2_print_blob_sizes_at_exit=0',
         '--caffe2_gpu_memory_tracking=1'])
 
-    Compare(args)
+    # With --rnn_executor, compare the CPU executors instead of cuDNN.
+    if args.rnn_executor:
+        CompareExecutors(args)
+    else:
+        Compare(args)
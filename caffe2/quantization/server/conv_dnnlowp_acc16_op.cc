@@ -12,6 +12,7 @@
 #include "caffe2/core/logging.h"
 #include "dnnlowp_op.h"
 #include "dnnlowp_partition.h"
+#include "fbgemm_pack_matrix_cache.h"
 #include "fbgemm_pack_op.h"
 #include "im2col_dnnlowp.h"
 
@@ -246,14 +247,13 @@ bool ConvDNNLowPAcc16Op<ReluFused>::GetQuantizationParameters_() {
   }
 
   if (packW && !Wq_acc16_packed_) {
-    Wq_acc16_packed_.reset(new fbgemm::PackBMatrix<int8_t, int16_t>(
+    Wq_acc16_packed_ = GetOrCreateFbgemmPackBMatrix<int16_t>(
         fbgemm::matrix_op_t::Transpose,
         group_ * kernel_dim,
         num_out_channels / group_,
         W_quantized_.data(),
         kernel_dim, // ld
-        nullptr, // pmat
-        group_));
+        group_);
     vector<int8_t>().swap(W_quantized_);
   }
 
@@ -16,6 +16,7 @@
 
 #include "dnnlowp_op.h"
 #include "dnnlowp_partition.h"
+#include "fbgemm_pack_matrix_cache.h"
 #include "fbgemm_pack_op.h"
 #include "im2col_dnnlowp.h"
 #include "mmio.h"
@@ -467,14 +468,13 @@ void ConvDNNLowPOp<T, ReluFused>::QuantizeWeight_() {
         Wq_packed_ = packed_filter.W;
       } else {
         // fast path using fbgemm
-        Wq_packed_.reset(new fbgemm::PackBMatrix<int8_t>(
+        Wq_packed_ = GetOrCreateFbgemmPackBMatrix<int32_t>(
             fbgemm::matrix_op_t::Transpose,
             group_ * kernel_dim,
             M / group_,
             reinterpret_cast<const int8_t*>(W_quantized_.data()),
             kernel_dim, // ld
-            nullptr, // pmat
-            group_));
+            group_);
       }
     } else {
       string reason;
@@ -5,9 +5,12 @@
 namespace caffe2 {
 
 /**
- * If there's an existing packed matrix for the same matrix, reuse it.
- * Create a new one otherwise. This can save memory usage if many threads are
- * sharing the same weight.
+ * If there's an existing packed matrix with the same contents, reuse it.
+ * Create a new one otherwise. This saves memory when many threads, nets or
+ * predictor instances share copies of the same weight. The packed matrices
+ * live in the process-wide at::native::FbgemmPackCache, which is shared with
+ * the ATen fbgemm functions, and whose capacity is set by
+ * --caffe2_dnnlowp_packed_weight_cache_mb.
  */
 template <typename ACC_T>
 std::shared_ptr<fbgemm::PackBMatrix<int8_t, ACC_T>>
@@ -15,8 +18,8 @@ GetOrCreateFbgemmPackBMatrix(
     fbgemm::matrix_op_t trans,
     std::int32_t m,
     std::int32_t n,
-    const void* orig_data,
     const std::int8_t* quantized_data,
-    std::int32_t ld);
+    std::int32_t ld,
+    int groups = 1);
 
 } // namespace caffe2
@@ -3,6 +3,7 @@
 #include "caffe2/core/tensor_int8.h"
 
 #include "caffe2_dnnlowp_utils.h"
+#include "fbgemm_pack_matrix_cache.h"
 
 C10_DECLARE_int32(caffe2_dnnlowp_nbits_in_non_outlier);
 C10_DECLARE_double(caffe2_dnnlowp_acc16_density_threshold);
@@ -287,23 +288,19 @@ bool FullyConnectedDNNLowPPackWeightOp::RunOnDevice() {
     }
 
     Y->nbits_in_non_outlier = nbits_in_non_outlier_;
-    Y->W_acc16.reset(new fbgemm::PackBMatrix<int8_t, int16_t>(
+    Y->W_acc16 = GetOrCreateFbgemmPackBMatrix<int16_t>(
         fbgemm::matrix_op_t::Transpose,
         K,
         N,
         W_quantized.data(),
-        K,
-        nullptr, // pmat
-        1)); // group
+        K); // ld
   } else {
-    Y->W.reset(new fbgemm::PackBMatrix<int8_t>(
+    Y->W = GetOrCreateFbgemmPackBMatrix<int32_t>(
         fbgemm::matrix_op_t::Transpose,
         K,
         N,
         W_quantized.data(),
-        K,
-        nullptr, // pmat
-        1)); // group
+        K); // ld
   }
 
   // Quantize bias
@@ -498,14 +495,13 @@ bool ConvDNNLowPPackWeightOp::RunOnDevice() {
 
     if (!fallback_to_32_bit_accumulation) {
       Y->nbits_in_non_outlier = nbits_in_non_outlier_;
-      Y->W_acc16.reset(new fbgemm::PackBMatrix<int8_t, int16_t>(
+      Y->W_acc16 = GetOrCreateFbgemmPackBMatrix<int16_t>(
           fbgemm::matrix_op_t::Transpose,
           group_ * kernel_dim,
           M / group_,
           W_quantized.data(),
-          kernel_dim,
-          nullptr, // pmat
-          group_));
+          kernel_dim, // ld
+          group_);
     }
   }
 
@@ -537,14 +533,13 @@ bool ConvDNNLowPPackWeightOp::RunOnDevice() {
       Y->W_gconv.reset(new fbgemm::PackWeightMatrixForGConv<int8_t>(
           fbgemm::matrix_op_t::Transpose, conv_p, W_quantized.data()));
     } else {
-      Y->W.reset(new fbgemm::PackBMatrix<int8_t>(
+      Y->W = GetOrCreateFbgemmPackBMatrix<int32_t>(
           fbgemm::matrix_op_t::Transpose,
           group_ * kernel_dim,
           M / group_,
           W_quantized.data(),
-          kernel_dim,
-          nullptr, // pmat
-          group_));
+          kernel_dim, // ld
+          group_);
     }
   }
 
@@ -626,7 +626,6 @@ bool FullyConnectedDNNLowPOp<T, ReluFused>::GetQuantizationParameters_() {
               fbgemm::matrix_op_t::Transpose,
               K,
               N,
-              W.raw_data(),
               reinterpret_cast<const int8_t*>(W_quantized_.data()),
               K); // ld
         }
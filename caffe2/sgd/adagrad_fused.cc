@@ -0,0 +1,80 @@
+#include "caffe2/sgd/adagrad_fused.h"
+
+namespace caffe2 {
+
+REGISTER_CPU_OPERATOR(
+    SparseAdagradFusedWithSparseLengthsSumGradient,
+    SparseAdagradFusedWithSparseLengthsSumGradientOp<float, CPUContext, false>);
+OPERATOR_SCHEMA(SparseAdagradFusedWithSparseLengthsSumGradient)
+    .NumInputs(6)
+    .NumOutputs(2)
+    .EnforceOneToOneInplace()
+    .SetDoc(R"DOC(
+
+Fused operator of SparseLengthsSumGradient followed by SparseAdagrad.
+Given inputs (param, moment, indices, grad, lr, lengths), where grad is the
+gradient of the output of SparseLengthsSum(param, indices, lengths), runs the
+SparseAdagrad update of every row indices[i] with the gradient row of the
+segment of i, and returns (new_param, new_moment). The per-index gradient
+rows are never materialized.
+
+)DOC")
+    .Input(0, "param", "Parameters to be updated")
+    .Input(1, "moment", "Moment history")
+    .Input(2, "indices", "Integer vector containing indices of the first dimension of param for the slices that are being aggregated")
+    .Input(3, "grad", "Gradient of the output of SparseLengthsSum, with one row per segment")
+    .Input(4, "lr", "learning rate")
+    .Input(5, "lengths", "Non negative vector with sum of elements equal to indices length")
+    .Output(0, "output_param", "Updated parameters")
+    .Output(1, "output_moment", "Updated moment")
+    .Arg("epsilon", "Default 1e-5")
+    .Arg(
+        "num_threads",
+        "Default 1. Number of threads of the workspace thread pool that "
+        "update rows in parallel, 0 for all of them.")
+    .Arg(
+        "num_lock_stripes",
+        "Default 0. If positive, parallel row updates are serialized by that "
+        "many mutexes chosen by row. Otherwise they are lock-free "
+        "(Hogwild).");
+
+REGISTER_CPU_OPERATOR(
+    RowWiseSparseAdagradFusedWithSparseLengthsSumGradient,
+    SparseAdagradFusedWithSparseLengthsSumGradientOp<float, CPUContext, true>);
+OPERATOR_SCHEMA(RowWiseSparseAdagradFusedWithSparseLengthsSumGradient)
+    .NumInputs(6)
+    .NumOutputs(2)
+    .EnforceOneToOneInplace()
+    .SetDoc(R"DOC(
+
+Fused operator of SparseLengthsSumGradient followed by RowWiseSparseAdagrad.
+Given inputs (param, moment, indices, grad, lr, lengths), where grad is the
+gradient of the output of SparseLengthsSum(param, indices, lengths) and moment
+has one element per row of param, runs the RowWiseSparseAdagrad update of
+every row indices[i] with the gradient row of the segment of i, and returns
+(new_param, new_moment). The per-index gradient rows are never materialized.
+
+)DOC")
+    .Input(0, "param", "Parameters to be updated")
+    .Input(1, "moment", "Moment history, one element per row of param")
+    .Input(2, "indices", "Integer vector containing indices of the first dimension of param for the slices that are being aggregated")
+    .Input(3, "grad", "Gradient of the output of SparseLengthsSum, with one row per segment")
+    .Input(4, "lr", "learning rate")
+    .Input(5, "lengths", "Non negative vector with sum of elements equal to indices length")
+    .Output(0, "output_param", "Updated parameters")
+    .Output(1, "output_moment", "Updated moment")
+    .Arg("epsilon", "Default 1e-5")
+    .Arg(
+        "num_threads",
+        "Default 1. Number of threads of the workspace thread pool that "
+        "update rows in parallel, 0 for all of them.")
+    .Arg(
+        "num_lock_stripes",
+        "Default 0. If positive, parallel row updates are serialized by that "
+        "many mutexes chosen by row. Otherwise they are lock-free "
+        "(Hogwild).");
+
+SHOULD_NOT_DO_GRADIENT(SparseAdagradFusedWithSparseLengthsSumGradient);
+SHOULD_NOT_DO_GRADIENT(RowWiseSparseAdagradFusedWithSparseLengthsSumGradient);
+
+} // namespace caffe2
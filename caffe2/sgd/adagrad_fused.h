@@ -0,0 +1,148 @@
+#pragma once
+
+#include <algorithm>
+#include <vector>
+
+#include "caffe2/core/operator.h"
+#include "caffe2/sgd/adagrad_op.h"
+#include "caffe2/sgd/sparse_update_parallelizer.h"
+
+namespace caffe2 {
+
+/**
+ * Sparse Adagrad (or row-wise sparse Adagrad) fused with the gradient of
+ * SparseLengthsSum.
+ *
+ * The gradient of SparseLengthsSum with respect to the rows of the table is
+ * the gradient of the output segment of each index, so that running
+ * SparseLengthsSumGradient and SparseAdagrad materializes one gradient row
+ * per index. This operator reads the rows of the segment gradient directly
+ * while updating the table. The row-wise variant also computes the mean
+ * squared gradient once per segment instead of once per index.
+ *
+ * Indices are validated up front, and the updates of an index that occurs
+ * more than once are applied in order when running on a single thread. See
+ * SparseUpdateParallelizer for the semantics of the parallel updates.
+ */
+template <typename T, class Context, bool kRowWise>
+class SparseAdagradFusedWithSparseLengthsSumGradientOp final
+    : public Operator<Context> {
+ public:
+  USE_OPERATOR_CONTEXT_FUNCTIONS;
+  SparseAdagradFusedWithSparseLengthsSumGradientOp(
+      const OperatorDef& operator_def,
+      Workspace* ws)
+      : Operator<Context>(operator_def, ws),
+        epsilon_(this->template GetSingleArgument<float>("epsilon", 1e-5f)),
+        parallelizer_(*this, ws) {}
+
+  bool RunOnDevice() override {
+    // Enforce shapes
+    const auto& param = Input(PARAM);
+    const auto& grad = Input(GRAD);
+    const auto& lengths = Input(LENGTHS);
+    CAFFE_ENFORCE_GE(param.dim(), 1, "PARAM must be at least 1-D");
+    if (kRowWise) {
+      CAFFE_ENFORCE_EQ(param.size(0), Input(MOMENT_1).numel());
+    } else {
+      CAFFE_ENFORCE_EQ(param.numel(), Input(MOMENT_1).numel());
+    }
+    CAFFE_ENFORCE_EQ(Input(LR).numel(), 1);
+    CAFFE_ENFORCE_EQ(Input(INDICES).dim(), 1, "INDICES must be a vector");
+    CAFFE_ENFORCE_EQ(lengths.dim(), 1, "LENGTHS must be a vector");
+    CAFFE_ENFORCE_GE(grad.dim(), 1, "GRAD must be at least 1-D");
+    CAFFE_ENFORCE_EQ(
+        lengths.size(0),
+        grad.size(0),
+        "GRAD must have one row per segment in LENGTHS");
+    CAFFE_ENFORCE_EQ(param.size_from_dim(1), grad.size_from_dim(1));
+
+    return DispatchHelper<TensorTypes<int32_t, int64_t>>::call(
+        this, Input(INDICES));
+  }
+
+  template <typename SIndex>
+  bool DoRunWithType() {
+    const auto* lr = Input(LR).template data<T>();
+    const auto* indices = Input(INDICES).template data<SIndex>();
+    const auto* gradIn = Input(GRAD).template data<T>();
+    const auto* lengths = Input(LENGTHS).template data<int>();
+    const auto* paramIn = Input(PARAM).template data<T>();
+    const auto* momentIn = Input(MOMENT_1).template data<T>();
+    auto* paramOut = Output(OUTPUT_PARAM)->template mutable_data<T>();
+    auto* momentOut = Output(OUTPUT_MOMENT_1)->template mutable_data<T>();
+
+    const int64_t n = Input(INDICES).numel();
+    const int64_t num_segments = Input(LENGTHS).numel();
+    const int64_t block_size = Input(GRAD).size_from_dim(1);
+
+    // offsets[s] is the position of the first index of segment s.
+    std::vector<int64_t> offsets(num_segments + 1);
+    offsets[0] = 0;
+    for (int64_t s = 0; s < num_segments; ++s) {
+      CAFFE_ENFORCE_GE(lengths[s], 0, "Negative length of segment ", s);
+      offsets[s + 1] = offsets[s] + lengths[s];
+    }
+    CAFFE_ENFORCE_EQ(
+        offsets[num_segments], n, "LENGTHS must sum up to the size of INDICES");
+    if (n == 0 || block_size == 0) {
+      return true;
+    }
+    SparseUpdateParallelizer::EnforceIndicesInRange(
+        indices, n, Input(PARAM).size(0), this->debug_def().input(PARAM));
+
+    parallelizer_.Run(n, [&](int64_t begin, int64_t end) {
+      // The segment of the first index of the chunk.
+      int64_t s =
+          std::upper_bound(offsets.begin(), offsets.end(), begin) -
+          offsets.begin() - 1;
+      int64_t mean_square_segment = -1;
+      float mean_square = 0;
+      for (int64_t i = begin; i < end; ++i) {
+        while (i >= offsets[s + 1]) {
+          ++s;
+        }
+        const int64_t idx = indices[i];
+        const float* g = gradIn + s * block_size;
+        if (kRowWise && mean_square_segment != s) {
+          float hs = 0;
+          for (int64_t j = 0; j < block_size; ++j) {
+            hs += g[j] * g[j];
+          }
+          mean_square = hs / block_size;
+          mean_square_segment = s;
+        }
+
+        auto lock = parallelizer_.LockRow(idx);
+        const auto offsetIdx = idx * block_size;
+        if (kRowWise) {
+          float hi = momentOut[idx] = momentIn[idx] + mean_square;
+          float step = lr[0] / (std::sqrt(hi) + epsilon_);
+          for (int64_t j = 0; j < block_size; ++j) {
+            paramOut[offsetIdx + j] = paramIn[offsetIdx + j] + g[j] * step;
+          }
+        } else {
+          adagrad_update(
+              block_size,
+              paramIn + offsetIdx,
+              g,
+              momentIn + offsetIdx,
+              paramOut + offsetIdx,
+              momentOut + offsetIdx,
+              epsilon_,
+              1.0f,
+              lr[0]);
+        }
+      }
+    });
+    return true;
+  }
+
+ protected:
+  T epsilon_;
+  SparseUpdateParallelizer parallelizer_;
+  INPUT_TAGS(PARAM, MOMENT_1, INDICES, GRAD, LR, LENGTHS);
+  OUTPUT_TAGS(OUTPUT_PARAM, OUTPUT_MOMENT_1);
+};
+
+} // namespace caffe2
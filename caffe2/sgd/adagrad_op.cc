@@ -84,6 +84,15 @@ new_moment) as in the dense case.
     .Output(0, "output_param", "Updated parameters")
     .Output(1, "output_moment_1", "Updated moment")
     .Arg("epsilon", "Default 1e-5")
+    .Arg(
+        "num_threads",
+        "Default 1. Number of threads of the workspace thread pool that "
+        "update rows in parallel, 0 for all of them.")
+    .Arg(
+        "num_lock_stripes",
+        "Default 0. If positive, parallel row updates are serialized by that "
+        "many mutexes chosen by row. Otherwise they are lock-free "
+        "(Hogwild).")
     .CostInferenceFunction(
         OpSchema::CostInferenceFunctionType(CostInferenceForSparseAdagrad));
 
@@ -112,7 +121,16 @@ also be a 1D tensor indexing into the rows of param.
     .Input(4, "lr", "learning rate")
     .Output(0, "output_param", "Updated parameters")
     .Output(1, "output_moment_1", "Updated moment")
-    .Arg("epsilon", "Default 1e-5");
+    .Arg("epsilon", "Default 1e-5")
+    .Arg(
+        "num_threads",
+        "Default 1. Number of threads of the workspace thread pool that "
+        "update rows in parallel, 0 for all of them.")
+    .Arg(
+        "num_lock_stripes",
+        "Default 0. If positive, parallel row updates are serialized by that "
+        "many mutexes chosen by row. Otherwise they are lock-free "
+        "(Hogwild).");
 
 SHOULD_NOT_DO_GRADIENT(Adagrad);
 SHOULD_NOT_DO_GRADIENT(SparseAdagrad);
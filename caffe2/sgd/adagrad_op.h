@@ -2,6 +2,7 @@
 
 #include "caffe2/core/operator.h"
 #include "caffe2/perfkernels/adagrad.h"
+#include "caffe2/sgd/sparse_update_parallelizer.h"
 
 namespace caffe2 {
 
@@ -66,6 +67,29 @@ void adagrad_update_output_effective_lr_and_update(
   }
 }
 
+// Row-wise Adagrad update of one row: the moment is a single value per row,
+// to which the mean of the squared gradient of the row is added.
+inline void rowwise_adagrad_update_row(
+    int N,
+    const float* w,
+    const float* g,
+    const float* h,
+    float* nw,
+    float* nh,
+    float epsilon,
+    float lr) {
+  float hs = 0.;
+  for (auto j = 0; j < N; ++j) {
+    float gj = g[j];
+    hs += gj * gj;
+  }
+  float hi = nh[0] = h[0] + hs / N;
+  float step = lr / (std::sqrt(hi) + epsilon);
+  for (auto j = 0; j < N; ++j) {
+    nw[j] = w[j] + g[j] * step;
+  }
+}
+
 template <typename T, class Context>
 class AdagradOp final : public Operator<Context> {
  public:
@@ -155,7 +179,8 @@ class SparseAdagradOp final : public Operator<Context> {
   USE_OPERATOR_CONTEXT_FUNCTIONS;
   SparseAdagradOp(const OperatorDef& operator_def, Workspace* ws)
       : Operator<Context>(operator_def, ws),
-        epsilon_(this->template GetSingleArgument<float>("epsilon", 1e-5f)) {}
+        epsilon_(this->template GetSingleArgument<float>("epsilon", 1e-5f)),
+        parallelizer_(*this, ws) {}
 
   bool RunOnDevice() override {
     // Enforce shapes
@@ -185,54 +210,66 @@ class SparseAdagradOp final : public Operator<Context> {
     }
 
     auto block_size = Input(GRAD).numel() / n;
-    for (auto i = 0; i < n; ++i) {
-      auto idx = indices[i];
-      if (block_size == 1) {
-        float gi = gradIn[i];
-        float hi = momentOut[idx] = momentIn[idx] + gi * gi;
-        paramOut[idx] = paramIn[idx] + lr[0] * gi / (std::sqrt(hi) + epsilon_);
-      } else {
-        auto offsetI = i * block_size;
-        auto offsetIdx = idx * block_size;
+    if (parallelizer_.IsParallel() && block_size > 0) {
+      SparseUpdateParallelizer::EnforceIndicesInRange(
+          indices,
+          n,
+          Input(PARAM).numel() / block_size,
+          this->debug_def().input(PARAM));
+    }
+    parallelizer_.Run(n, [&](int64_t begin, int64_t end) {
+      for (auto i = begin; i < end; ++i) {
+        auto idx = indices[i];
+        auto lock = parallelizer_.LockRow(idx);
+        if (block_size == 1) {
+          float gi = gradIn[i];
+          float hi = momentOut[idx] = momentIn[idx] + gi * gi;
+          paramOut[idx] =
+              paramIn[idx] + lr[0] * gi / (std::sqrt(hi) + epsilon_);
+        } else {
+          auto offsetI = i * block_size;
+          auto offsetIdx = idx * block_size;
 
 #ifndef NDEBUG
-        CAFFE_ENFORCE_GE(
-            Input(PARAM).numel(),
-            block_size + offsetIdx,
-            this->debug_def().input(PARAM),
-            ", out of bound,  idx:",
-            idx,
-            " for input i:",
-            i,
-            " and block size:",
-            block_size);
-        CAFFE_ENFORCE_GE(
-            Input(GRAD).numel(),
-            block_size + offsetI,
-            this->debug_def().input(GRAD),
-            ", out of bound idx, idx:",
-            idx,
-            " for input i:",
-            i);
+          CAFFE_ENFORCE_GE(
+              Input(PARAM).numel(),
+              block_size + offsetIdx,
+              this->debug_def().input(PARAM),
+              ", out of bound,  idx:",
+              idx,
+              " for input i:",
+              i,
+              " and block size:",
+              block_size);
+          CAFFE_ENFORCE_GE(
+              Input(GRAD).numel(),
+              block_size + offsetI,
+              this->debug_def().input(GRAD),
+              ", out of bound idx, idx:",
+              idx,
+              " for input i:",
+              i);
 #endif
-        adagrad_update(
-            block_size,
-            paramIn + offsetIdx,
-            gradIn + offsetI,
-            momentIn + offsetIdx,
-            paramOut + offsetIdx,
-            momentOut + offsetIdx,
-            epsilon_,
-            1.0f,
-            lr,
-            &context_);
+          adagrad_update(
+              block_size,
+              paramIn + offsetIdx,
+              gradIn + offsetI,
+              momentIn + offsetIdx,
+              paramOut + offsetIdx,
+              momentOut + offsetIdx,
+              epsilon_,
+              1.0f,
+              lr,
+              &context_);
+        }
       }
-    }
+    });
     return true;
   }
 
  protected:
   T epsilon_;
+  SparseUpdateParallelizer parallelizer_;
   INPUT_TAGS(PARAM, MOMENT_1, INDICES, GRAD, LR);
   OUTPUT_TAGS(OUTPUT_PARAM, OUTPUT_MOMENT_1);
 };
@@ -243,7 +280,8 @@ class RowWiseSparseAdagradOp final : public Operator<Context> {
   USE_OPERATOR_CONTEXT_FUNCTIONS;
   RowWiseSparseAdagradOp(const OperatorDef& operator_def, Workspace* ws)
       : Operator<Context>(operator_def, ws),
-        epsilon_(this->template GetSingleArgument<float>("epsilon", 1e-5f)) {}
+        epsilon_(this->template GetSingleArgument<float>("epsilon", 1e-5f)),
+        parallelizer_(*this, ws) {}
 
   bool RunOnDevice() override {
     // Enforce shapes
@@ -273,60 +311,65 @@ class RowWiseSparseAdagradOp final : public Operator<Context> {
     }
 
     auto block_size = Input(GRAD).numel() / n;
-
-    for (auto i = 0; i < n; ++i) {
-      auto idx = indices[i];
-      if (block_size == 1) {
-        float gi = gradIn[i];
-        float hi = momentOut[idx] = momentIn[idx] + gi * gi;
-        paramOut[idx] = paramIn[idx] + lr[0] * gi / (std::sqrt(hi) + epsilon_);
-      } else {
-        auto offsetI = i * block_size;
-        auto offsetIdx = idx * block_size;
+    if (parallelizer_.IsParallel()) {
+      SparseUpdateParallelizer::EnforceIndicesInRange(
+          indices,
+          n,
+          Input(MOMENT_1).numel(),
+          this->debug_def().input(PARAM));
+    }
+    parallelizer_.Run(n, [&](int64_t begin, int64_t end) {
+      for (auto i = begin; i < end; ++i) {
+        auto idx = indices[i];
+        auto lock = parallelizer_.LockRow(idx);
+        if (block_size == 1) {
+          float gi = gradIn[i];
+          float hi = momentOut[idx] = momentIn[idx] + gi * gi;
+          paramOut[idx] =
+              paramIn[idx] + lr[0] * gi / (std::sqrt(hi) + epsilon_);
+        } else {
+          auto offsetI = i * block_size;
+          auto offsetIdx = idx * block_size;
 
 #ifndef NDEBUG
-        CAFFE_ENFORCE_GE(
-            Input(PARAM).numel(),
-            block_size + offsetIdx,
-            this->debug_def().input(PARAM),
-            ", out of bound,  idx:",
-            idx,
-            " for input i:",
-            i,
-            " and block size:",
-            block_size);
-        CAFFE_ENFORCE_GE(
-            Input(GRAD).numel(),
-            block_size + offsetI,
-            this->debug_def().input(GRAD),
-            ", out of bound idx, idx:",
-            idx,
-            " for input i:",
-            i);
+          CAFFE_ENFORCE_GE(
+              Input(PARAM).numel(),
+              block_size + offsetIdx,
+              this->debug_def().input(PARAM),
+              ", out of bound,  idx:",
+              idx,
+              " for input i:",
+              i,
+              " and block size:",
+              block_size);
+          CAFFE_ENFORCE_GE(
+              Input(GRAD).numel(),
+              block_size + offsetI,
+              this->debug_def().input(GRAD),
+              ", out of bound idx, idx:",
+              idx,
+              " for input i:",
+              i);
 #endif
 
-        const float* w = paramIn + offsetIdx;
-        const float* g = gradIn + offsetI;
-        const float* h = momentIn + idx;
-        float* nw = paramOut + offsetIdx;
-        float* nh = momentOut + idx;
-        float hs = 0.;
-        for (auto j = 0; j < block_size; ++j) {
-          float gj = g[j];
-          hs += gj * gj;
-        }
-        float hi = nh[0] = h[0] + hs / block_size;
-        float step = lr[0] / (std::sqrt(hi) + epsilon_);
-        for (auto j = 0; j < block_size; ++j) {
-          nw[j] = w[j] + g[j] * step;
+          rowwise_adagrad_update_row(
+              block_size,
+              paramIn + offsetIdx,
+              gradIn + offsetI,
+              momentIn + idx,
+              paramOut + offsetIdx,
+              momentOut + idx,
+              epsilon_,
+              lr[0]);
         }
       }
-    }
+    });
     return true;
   }
 
  protected:
   T epsilon_;
+  SparseUpdateParallelizer parallelizer_;
   INPUT_TAGS(PARAM, MOMENT_1, INDICES, GRAD, LR);
   OUTPUT_TAGS(OUTPUT_PARAM, OUTPUT_MOMENT_1);
 };
@@ -0,0 +1,187 @@
+#include "caffe2/sgd/low_precision_sparse_ops.h"
+
+namespace caffe2 {
+
+namespace {
+
+const char* kStochasticRoundingDoc =
+    "Default 1. If 1, updated rows are rounded to the precision of the table "
+    "stochastically, so that they are unbiased; otherwise they are rounded "
+    "to nearest.";
+const char* kNumThreadsDoc =
+    "Default 1. Number of threads of the workspace thread pool that update "
+    "rows in parallel, 0 for all of them.";
+const char* kNumLockStripesDoc =
+    "Default 0. If positive, parallel row updates are serialized by that many "
+    "mutexes chosen by row. Otherwise they are lock-free (Hogwild).";
+
+} // namespace
+
+REGISTER_CPU_OPERATOR(
+    SparseAdagradFp16,
+    LowPrecisionSparseAdagradOp<HalfTable, CPUContext, false>);
+OPERATOR_SCHEMA(SparseAdagradFp16)
+    .NumInputs(5)
+    .NumOutputs(2)
+    .EnforceInplace({{0, 0}, {1, 1}})
+    .SetDoc(R"DOC(
+
+SparseAdagrad for fp16 embedding tables. Given inputs (param, moment, indices,
+grad, lr), where param is float16 and moment is float or float16, runs the
+SparseAdagrad update of the rows of param and moment in place, rounding them
+back to float16. Gradients and the learning rate are float.
+
+)DOC")
+    .Input(0, "param", "float16 parameters to be updated")
+    .Input(1, "moment", "Moment history, float or float16")
+    .Input(2, "indices", "Sparse indices")
+    .Input(3, "grad", "Gradient computed")
+    .Input(4, "lr", "learning rate")
+    .Output(0, "output_param", "Updated parameters")
+    .Output(1, "output_moment", "Updated moment")
+    .Arg("epsilon", "Default 1e-5")
+    .Arg("stochastic_rounding", kStochasticRoundingDoc)
+    .Arg("num_threads", kNumThreadsDoc)
+    .Arg("num_lock_stripes", kNumLockStripesDoc);
+
+REGISTER_CPU_OPERATOR(
+    RowWiseSparseAdagradFp16,
+    LowPrecisionSparseAdagradOp<HalfTable, CPUContext, true>);
+OPERATOR_SCHEMA(RowWiseSparseAdagradFp16)
+    .NumInputs(5)
+    .NumOutputs(2)
+    .EnforceInplace({{0, 0}, {1, 1}})
+    .SetDoc(R"DOC(
+
+RowWiseSparseAdagrad for fp16 embedding tables. Given inputs (param, moment,
+indices, grad, lr), where param is float16 and moment is a float vector with
+one element per row of param, runs the RowWiseSparseAdagrad update of the rows
+of param and moment in place, rounding param back to float16.
+
+)DOC")
+    .Input(0, "param", "float16 parameters to be updated")
+    .Input(1, "moment", "Moment history, one float per row of param")
+    .Input(2, "indices", "Sparse indices")
+    .Input(3, "grad", "Gradient computed")
+    .Input(4, "lr", "learning rate")
+    .Output(0, "output_param", "Updated parameters")
+    .Output(1, "output_moment", "Updated moment")
+    .Arg("epsilon", "Default 1e-5")
+    .Arg("stochastic_rounding", kStochasticRoundingDoc)
+    .Arg("num_threads", kNumThreadsDoc)
+    .Arg("num_lock_stripes", kNumLockStripesDoc);
+
+REGISTER_CPU_OPERATOR(
+    SparseSGDFp16,
+    LowPrecisionSparseSGDOp<HalfTable, CPUContext>);
+OPERATOR_SCHEMA(SparseSGDFp16)
+    .NumInputs(4)
+    .NumOutputs(1)
+    .EnforceInplace({{0, 0}})
+    .SetDoc(R"DOC(
+
+Sparse SGD for fp16 embedding tables. Given inputs (param, indices, grad, lr),
+where param is float16, computes param[indices[i]] += lr * grad[i] in place,
+rounding the updated rows back to float16.
+
+)DOC")
+    .Input(0, "param", "float16 parameters to be updated")
+    .Input(1, "indices", "Sparse indices")
+    .Input(2, "grad", "Gradient computed")
+    .Input(3, "lr", "learning rate")
+    .Output(0, "output_param", "Updated parameters")
+    .Arg("stochastic_rounding", kStochasticRoundingDoc)
+    .Arg("num_threads", kNumThreadsDoc)
+    .Arg("num_lock_stripes", kNumLockStripesDoc);
+
+REGISTER_CPU_OPERATOR(
+    SparseAdagradFused8BitRowwise,
+    LowPrecisionSparseAdagradOp<Fused8BitRowwiseTable, CPUContext, false>);
+OPERATOR_SCHEMA(SparseAdagradFused8BitRowwise)
+    .NumInputs(5)
+    .NumOutputs(2)
+    .EnforceInplace({{0, 0}, {1, 1}})
+    .SetDoc(R"DOC(
+
+SparseAdagrad for fused 8-bit rowwise quantized embedding tables, as produced
+by FloatToFused8BitRowwiseQuantized. Given inputs (param, moment, indices,
+grad, lr), where moment is float or float16 with one element per value of the
+dequantized table, runs the SparseAdagrad update of the touched rows in place.
+The scale and bias of every touched row are recomputed from its updated
+values before it is quantized again.
+
+)DOC")
+    .Input(0, "param", "Fused 8-bit rowwise quantized parameters to be updated")
+    .Input(1, "moment", "Moment history, float or float16")
+    .Input(2, "indices", "Sparse indices")
+    .Input(3, "grad", "Gradient computed")
+    .Input(4, "lr", "learning rate")
+    .Output(0, "output_param", "Updated parameters")
+    .Output(1, "output_moment", "Updated moment")
+    .Arg("epsilon", "Default 1e-5")
+    .Arg("stochastic_rounding", kStochasticRoundingDoc)
+    .Arg("num_threads", kNumThreadsDoc)
+    .Arg("num_lock_stripes", kNumLockStripesDoc);
+
+REGISTER_CPU_OPERATOR(
+    RowWiseSparseAdagradFused8BitRowwise,
+    LowPrecisionSparseAdagradOp<Fused8BitRowwiseTable, CPUContext, true>);
+OPERATOR_SCHEMA(RowWiseSparseAdagradFused8BitRowwise)
+    .NumInputs(5)
+    .NumOutputs(2)
+    .EnforceInplace({{0, 0}, {1, 1}})
+    .SetDoc(R"DOC(
+
+RowWiseSparseAdagrad for fused 8-bit rowwise quantized embedding tables, as
+produced by FloatToFused8BitRowwiseQuantized. Given inputs (param, moment,
+indices, grad, lr), where moment is a float vector with one element per row of
+param, runs the RowWiseSparseAdagrad update of the touched rows in place. The
+scale and bias of every touched row are recomputed from its updated values
+before it is quantized again.
+
+)DOC")
+    .Input(0, "param", "Fused 8-bit rowwise quantized parameters to be updated")
+    .Input(1, "moment", "Moment history, one float per row of param")
+    .Input(2, "indices", "Sparse indices")
+    .Input(3, "grad", "Gradient computed")
+    .Input(4, "lr", "learning rate")
+    .Output(0, "output_param", "Updated parameters")
+    .Output(1, "output_moment", "Updated moment")
+    .Arg("epsilon", "Default 1e-5")
+    .Arg("stochastic_rounding", kStochasticRoundingDoc)
+    .Arg("num_threads", kNumThreadsDoc)
+    .Arg("num_lock_stripes", kNumLockStripesDoc);
+
+REGISTER_CPU_OPERATOR(
+    SparseSGDFused8BitRowwise,
+    LowPrecisionSparseSGDOp<Fused8BitRowwiseTable, CPUContext>);
+OPERATOR_SCHEMA(SparseSGDFused8BitRowwise)
+    .NumInputs(4)
+    .NumOutputs(1)
+    .EnforceInplace({{0, 0}})
+    .SetDoc(R"DOC(
+
+Sparse SGD for fused 8-bit rowwise quantized embedding tables, as produced by
+FloatToFused8BitRowwiseQuantized. Given inputs (param, indices, grad, lr),
+computes param[indices[i]] += lr * grad[i] on the dequantized rows in place.
+The scale and bias of every touched row are recomputed from its updated values
+before it is quantized again.
+
+)DOC")
+    .Input(0, "param", "Fused 8-bit rowwise quantized parameters to be updated")
+    .Input(1, "indices", "Sparse indices")
+    .Input(2, "grad", "Gradient computed")
+    .Input(3, "lr", "learning rate")
+    .Output(0, "output_param", "Updated parameters")
+    .Arg("stochastic_rounding", kStochasticRoundingDoc)
+    .Arg("num_threads", kNumThreadsDoc)
+    .Arg("num_lock_stripes", kNumLockStripesDoc);
+
+SHOULD_NOT_DO_GRADIENT(SparseAdagradFp16);
+SHOULD_NOT_DO_GRADIENT(RowWiseSparseAdagradFp16);
+SHOULD_NOT_DO_GRADIENT(SparseSGDFp16);
+SHOULD_NOT_DO_GRADIENT(SparseAdagradFused8BitRowwise);
+SHOULD_NOT_DO_GRADIENT(RowWiseSparseAdagradFused8BitRowwise);
+SHOULD_NOT_DO_GRADIENT(SparseSGDFused8BitRowwise);
+
+} // namespace caffe2
@@ -0,0 +1,320 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+#include "caffe2/core/operator.h"
+#include "caffe2/sgd/sparse_update_parallelizer.h"
+#include "caffe2/sgd/stochastic_rounding.h"
+
+namespace caffe2 {
+
+// Row formats of low precision embedding tables. The sparse optimizers below
+// load each touched row into floats, update it, and store it back rounded by
+// a StochasticRounder.
+
+// fp16 tables, with param.size_from_dim(1) values per row.
+struct HalfTable {
+  using DataType = at::Half;
+
+  static int64_t BlockSize(const Tensor& param) {
+    CAFFE_ENFORCE_GE(param.dim(), 1, "PARAM must be at least 1-D");
+    return param.size_from_dim(1);
+  }
+
+  static int64_t RowStride(int64_t block_size) {
+    return block_size;
+  }
+
+  static void Load(const at::Half* row, int64_t block_size, float* out) {
+    for (int64_t j = 0; j < block_size; ++j) {
+      out[j] = row[j];
+    }
+  }
+
+  static void Store(
+      const float* in,
+      int64_t block_size,
+      at::Half* row,
+      StochasticRounder* rounder) {
+    for (int64_t j = 0; j < block_size; ++j) {
+      row[j] = rounder->ToHalf(in[j]);
+    }
+  }
+};
+
+// Fused 8-bit rowwise quantized tables, in the format produced by
+// FloatToFused8BitRowwiseQuantized: every row holds one 8-bit code per value
+// followed by a float scale and a float bias. Storing a row recomputes its
+// scale and bias from the range of the updated values.
+struct Fused8BitRowwiseTable {
+  using DataType = uint8_t;
+
+  static constexpr float kEpsilon = 1e-8f;
+
+  static int64_t BlockSize(const Tensor& param) {
+    CAFFE_ENFORCE_EQ(param.dim(), 2, "Expect PARAM to be a matrix");
+    CAFFE_ENFORCE_GE(
+        param.size(1), 8, "Rows of PARAM must end with a scale and a bias");
+    return param.size(1) - 8;
+  }
+
+  static int64_t RowStride(int64_t block_size) {
+    return block_size + 8;
+  }
+
+  static void Load(const uint8_t* row, int64_t block_size, float* out) {
+    float scale_bias[2];
+    std::memcpy(scale_bias, row + block_size, sizeof(scale_bias));
+    for (int64_t j = 0; j < block_size; ++j) {
+      out[j] = row[j] * scale_bias[0] + scale_bias[1];
+    }
+  }
+
+  static void Store(
+      const float* in,
+      int64_t block_size,
+      uint8_t* row,
+      StochasticRounder* rounder) {
+    const auto minmax = std::minmax_element(in, in + block_size);
+    const float minimum_element = *minmax.first;
+    const float range = *minmax.second - minimum_element;
+    const float scale_bias[2] = {range / 255.0f, minimum_element};
+    std::memcpy(row + block_size, scale_bias, sizeof(scale_bias));
+    const float inverse_scale = 255.0f / (range + kEpsilon);
+    for (int64_t j = 0; j < block_size; ++j) {
+      row[j] = rounder->ToUint8((in[j] - minimum_element) * inverse_scale);
+    }
+  }
+};
+
+inline void StoreMoment(float value, float* dst, StochasticRounder* /*unused*/) {
+  *dst = value;
+}
+
+inline void StoreMoment(float value, at::Half* dst, StochasticRounder* rounder) {
+  *dst = rounder->ToHalf(value);
+}
+
+// Draws the seed of the rounders of one run of an operator.
+template <class Context>
+uint64_t StochasticRoundingSeed(Context* context) {
+  auto& generator = context->RandGenerator();
+  return (static_cast<uint64_t>(generator()) << 32) | generator();
+}
+
+// Seeds the rounder of the chunk of indices starting at `begin`, so that the
+// chunks running on different threads draw different random bits.
+inline StochasticRounder ChunkRounder(
+    bool stochastic,
+    uint64_t seed,
+    int64_t begin) {
+  return StochasticRounder(
+      stochastic, seed ^ (static_cast<uint64_t>(begin) * 0x9E3779B97F4A7C15ULL));
+}
+
+/**
+ * Sparse Adagrad (or row-wise sparse Adagrad) that updates an fp16 or fused
+ * 8-bit rowwise table in place.
+ *
+ * Full Adagrad keeps one moment per value of the table, in float or fp16;
+ * row-wise Adagrad keeps a float moment per row. Gradients and learning
+ * rates are float. Touched rows are updated in float and rounded back
+ * stochastically unless "stochastic_rounding" is 0. Rows are updated in
+ * parallel as described in SparseUpdateParallelizer.
+ */
+template <class Table, class Context, bool kRowWise>
+class LowPrecisionSparseAdagradOp final : public Operator<Context> {
+ public:
+  USE_OPERATOR_CONTEXT_FUNCTIONS;
+  LowPrecisionSparseAdagradOp(const OperatorDef& operator_def, Workspace* ws)
+      : Operator<Context>(operator_def, ws),
+        epsilon_(this->template GetSingleArgument<float>("epsilon", 1e-5f)),
+        stochastic_rounding_(
+            this->template GetSingleArgument<bool>("stochastic_rounding", true)),
+        parallelizer_(*this, ws) {}
+
+  bool RunOnDevice() override {
+    CAFFE_ENFORCE(
+        IsInputOutputAlias(PARAM, OUTPUT_PARAM), "PARAM must be updated in place");
+    CAFFE_ENFORCE(
+        IsInputOutputAlias(MOMENT_1, OUTPUT_MOMENT_1),
+        "MOMENT_1 must be updated in place");
+    const auto& param = Input(PARAM);
+    const auto& moment = Input(MOMENT_1);
+    CAFFE_ENFORCE(
+        param.template IsType<typename Table::DataType>(),
+        "Unexpected type of PARAM: ",
+        param.dtype().name());
+    block_size_ = Table::BlockSize(param);
+    if (kRowWise) {
+      CAFFE_ENFORCE(moment.template IsType<float>(), "MOMENT_1 must be float");
+      CAFFE_ENFORCE_EQ(param.size(0), moment.numel());
+    } else {
+      CAFFE_ENFORCE(
+          moment.template IsType<float>() ||
+              moment.template IsType<at::Half>(),
+          "MOMENT_1 must be float or float16");
+      CAFFE_ENFORCE_EQ(param.size(0) * block_size_, moment.numel());
+    }
+    CAFFE_ENFORCE_EQ(Input(LR).numel(), 1);
+    CAFFE_ENFORCE_EQ(
+        block_size_, Input(GRAD).size_from_dim(Input(INDICES).dim()));
+
+    return DispatchHelper<TensorTypes<int32_t, int64_t>>::call(
+        this, Input(INDICES));
+  }
+
+  template <typename SIndex>
+  bool DoRunWithType() {
+    if (Input(MOMENT_1).template IsType<at::Half>()) {
+      return DoRunWithMoment<SIndex, at::Half>();
+    }
+    return DoRunWithMoment<SIndex, float>();
+  }
+
+  template <typename SIndex, typename TMoment>
+  bool DoRunWithMoment() {
+    using DataType = typename Table::DataType;
+    const auto* lr = Input(LR).template data<float>();
+    const auto* indices = Input(INDICES).template data<SIndex>();
+    const auto* gradIn = Input(GRAD).template data<float>();
+    auto* param = Output(OUTPUT_PARAM)->template mutable_data<DataType>();
+    auto* moment = Output(OUTPUT_MOMENT_1)->template mutable_data<TMoment>();
+
+    const int64_t n = Input(INDICES).numel();
+    if (n == 0 || block_size_ == 0) {
+      return true;
+    }
+    SparseUpdateParallelizer::EnforceIndicesInRange(
+        indices, n, Input(PARAM).size(0), this->debug_def().input(PARAM));
+
+    const int64_t block_size = block_size_;
+    const int64_t row_stride = Table::RowStride(block_size);
+    const uint64_t seed =
+        stochastic_rounding_ ? StochasticRoundingSeed(&context_) : 0;
+    parallelizer_.Run(n, [&](int64_t begin, int64_t end) {
+      auto rounder = ChunkRounder(stochastic_rounding_, seed, begin);
+      std::vector<float> w(block_size);
+      for (int64_t i = begin; i < end; ++i) {
+        const int64_t idx = indices[i];
+        const float* g = gradIn + i * block_size;
+        auto* row = param + idx * row_stride;
+
+        auto lock = parallelizer_.LockRow(idx);
+        Table::Load(row, block_size, w.data());
+        if (kRowWise) {
+          float hs = 0;
+          for (int64_t j = 0; j < block_size; ++j) {
+            hs += g[j] * g[j];
+          }
+          const float hi = static_cast<float>(moment[idx]) + hs / block_size;
+          StoreMoment(hi, moment + idx, &rounder);
+          const float step = lr[0] / (std::sqrt(hi) + epsilon_);
+          for (int64_t j = 0; j < block_size; ++j) {
+            w[j] += g[j] * step;
+          }
+        } else {
+          auto* h = moment + idx * block_size;
+          for (int64_t j = 0; j < block_size; ++j) {
+            const float hj = static_cast<float>(h[j]) + g[j] * g[j];
+            StoreMoment(hj, h + j, &rounder);
+            w[j] += lr[0] * g[j] / (std::sqrt(hj) + epsilon_);
+          }
+        }
+        Table::Store(w.data(), block_size, row, &rounder);
+      }
+    });
+    return true;
+  }
+
+ protected:
+  float epsilon_;
+  bool stochastic_rounding_;
+  int64_t block_size_ = 0;
+  SparseUpdateParallelizer parallelizer_;
+  INPUT_TAGS(PARAM, MOMENT_1, INDICES, GRAD, LR);
+  OUTPUT_TAGS(OUTPUT_PARAM, OUTPUT_MOMENT_1);
+};
+
+/**
+ * Sparse SGD that updates an fp16 or fused 8-bit rowwise table in place:
+ * param[indices[i]] += lr * grad[i]. Touched rows are updated in float and
+ * rounded back stochastically unless "stochastic_rounding" is 0.
+ */
+template <class Table, class Context>
+class LowPrecisionSparseSGDOp final : public Operator<Context> {
+ public:
+  USE_OPERATOR_CONTEXT_FUNCTIONS;
+  LowPrecisionSparseSGDOp(const OperatorDef& operator_def, Workspace* ws)
+      : Operator<Context>(operator_def, ws),
+        stochastic_rounding_(
+            this->template GetSingleArgument<bool>("stochastic_rounding", true)),
+        parallelizer_(*this, ws) {}
+
+  bool RunOnDevice() override {
+    CAFFE_ENFORCE(
+        IsInputOutputAlias(PARAM, OUTPUT_PARAM), "PARAM must be updated in place");
+    const auto& param = Input(PARAM);
+    CAFFE_ENFORCE(
+        param.template IsType<typename Table::DataType>(),
+        "Unexpected type of PARAM: ",
+        param.dtype().name());
+    block_size_ = Table::BlockSize(param);
+    CAFFE_ENFORCE_EQ(Input(LR).numel(), 1);
+    CAFFE_ENFORCE_EQ(
+        block_size_, Input(GRAD).size_from_dim(Input(INDICES).dim()));
+
+    return DispatchHelper<TensorTypes<int32_t, int64_t>>::call(
+        this, Input(INDICES));
+  }
+
+  template <typename SIndex>
+  bool DoRunWithType() {
+    using DataType = typename Table::DataType;
+    const auto* lr = Input(LR).template data<float>();
+    const auto* indices = Input(INDICES).template data<SIndex>();
+    const auto* gradIn = Input(GRAD).template data<float>();
+    auto* param = Output(OUTPUT_PARAM)->template mutable_data<DataType>();
+
+    const int64_t n = Input(INDICES).numel();
+    if (n == 0 || block_size_ == 0) {
+      return true;
+    }
+    SparseUpdateParallelizer::EnforceIndicesInRange(
+        indices, n, Input(PARAM).size(0), this->debug_def().input(PARAM));
+
+    const int64_t block_size = block_size_;
+    const int64_t row_stride = Table::RowStride(block_size);
+    const uint64_t seed =
+        stochastic_rounding_ ? StochasticRoundingSeed(&context_) : 0;
+    parallelizer_.Run(n, [&](int64_t begin, int64_t end) {
+      auto rounder = ChunkRounder(stochastic_rounding_, seed, begin);
+      std::vector<float> w(block_size);
+      for (int64_t i = begin; i < end; ++i) {
+        const int64_t idx = indices[i];
+        const float* g = gradIn + i * block_size;
+        auto* row = param + idx * row_stride;
+
+        auto lock = parallelizer_.LockRow(idx);
+        Table::Load(row, block_size, w.data());
+        for (int64_t j = 0; j < block_size; ++j) {
+          w[j] += lr[0] * g[j];
+        }
+        Table::Store(w.data(), block_size, row, &rounder);
+      }
+    });
+    return true;
+  }
+
+ protected:
+  bool stochastic_rounding_;
+  int64_t block_size_ = 0;
+  SparseUpdateParallelizer parallelizer_;
+  INPUT_TAGS(PARAM, INDICES, GRAD, LR);
+  OUTPUT_TAGS(OUTPUT_PARAM);
+};
+
+} // namespace caffe2
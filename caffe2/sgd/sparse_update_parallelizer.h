@@ -0,0 +1,114 @@
+#pragma once
+
+#include <algorithm>
+#include <memory>
+#include <mutex>
+
+#include "caffe2/core/operator.h"
+#include "caffe2/core/workspace.h"
+#include "caffe2/utils/threadpool/ThreadPool.h"
+
+namespace caffe2 {
+
+/**
+ * Partitions the indices of a sparse optimizer update across the threads of
+ * the workspace thread pool.
+ *
+ * The updates are Hogwild-style by default: threads update rows without
+ * synchronization, so an update of a row that occurs more than once in the
+ * indices may be lost or mixed. Embedding tables are large compared to the
+ * number of rows in a batch, so this rarely happens and hardly affects
+ * convergence. With "num_lock_stripes" > 0, every row update holds one of
+ * that many mutexes (chosen by row), which makes each row update atomic.
+ *
+ * Operators using it accept the arguments
+ *   num_threads: number of threads to use; 1 (the default) runs on the
+ *     calling thread and 0 uses all threads of the workspace thread pool.
+ *   num_lock_stripes: number of mutexes guarding row updates; 0 (the
+ *     default) for lock-free updates.
+ */
+class SparseUpdateParallelizer {
+ public:
+  // Chunks of fewer indices run on the calling thread.
+  static constexpr int64_t kMinIndicesPerChunk = 64;
+
+  SparseUpdateParallelizer(const OperatorBase& op, Workspace* ws)
+      : ws_(ws),
+        num_threads_(op.GetSingleArgument<int>("num_threads", 1)),
+        num_lock_stripes_(op.GetSingleArgument<int>("num_lock_stripes", 0)) {
+    CAFFE_ENFORCE_GE(num_threads_, 0, "num_threads must not be negative");
+    CAFFE_ENFORCE_GE(
+        num_lock_stripes_, 0, "num_lock_stripes must not be negative");
+    if (num_lock_stripes_ > 0) {
+      lock_stripes_.reset(new std::mutex[num_lock_stripes_]);
+    }
+  }
+
+  // Returns true if updates may run on more than one thread.
+  bool IsParallel() const {
+    return num_threads_ != 1;
+  }
+
+  // Calls f(begin, end) for disjoint chunks that cover the indices [0, n),
+  // possibly on different threads, and returns when all chunks are done.
+  // `f` must not throw.
+  template <typename F>
+  void Run(int64_t n, const F& f) {
+    int64_t num_chunks = 1;
+    if (IsParallel() && n >= 2 * kMinIndicesPerChunk) {
+      auto* pool = ws_->GetThreadPool();
+      const int64_t num_threads =
+          num_threads_ > 0 ? num_threads_ : pool->getNumThreads();
+      num_chunks = std::min(num_threads, n / kMinIndicesPerChunk);
+    }
+    if (num_chunks <= 1) {
+      f(0, n);
+      return;
+    }
+    ws_->GetThreadPool()->run(
+        [&](int /* unused */, size_t chunk) {
+          f(chunk * n / num_chunks, (chunk + 1) * n / num_chunks);
+        },
+        num_chunks);
+  }
+
+  // Enforces that all indices are rows of a table with `num_rows` rows.
+  // Parallel updates check the indices up front, since the threads of the
+  // pool cannot report errors.
+  template <typename SIndex>
+  static void EnforceIndicesInRange(
+      const SIndex* indices,
+      int64_t n,
+      int64_t num_rows,
+      const std::string& table) {
+    for (int64_t i = 0; i < n; ++i) {
+      CAFFE_ENFORCE(
+          0 <= indices[i] && indices[i] < num_rows,
+          table,
+          ", out of bound, idx: ",
+          indices[i],
+          " for input i: ",
+          i,
+          " and number of rows: ",
+          num_rows);
+    }
+  }
+
+  // Returns a lock to hold while updating `row`. It holds no mutex in
+  // lock-free mode.
+  std::unique_lock<std::mutex> LockRow(int64_t row) {
+    if (!lock_stripes_) {
+      return std::unique_lock<std::mutex>();
+    }
+    return std::unique_lock<std::mutex>(
+        lock_stripes_[row % num_lock_stripes_]);
+  }
+
+ private:
+  Workspace* ws_;
+  int num_threads_;
+  int num_lock_stripes_;
+  std::unique_ptr<std::mutex[]> lock_stripes_;
+};
+
+} // namespace caffe2
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+#include <c10/util/Half.h>
+
+namespace caffe2 {
+
+/**
+ * Rounds floats to the storage formats of low precision embedding tables.
+ *
+ * When stochastic, a value is rounded up with probability equal to its
+ * distance from the representable value below it, relative to the gap
+ * between the two representable values around it. The rounded value is then
+ * x on average, so that updates smaller than the precision of the table are
+ * kept in expectation instead of being rounded away, which is what keeps
+ * training with fp16 or 8-bit tables close to training with fp32 tables.
+ * Otherwise values are rounded to nearest.
+ *
+ * Random bits come from xorshift64*, which is much cheaper than the
+ * std::mt19937 of CPUContext and good enough for rounding. A rounder is not
+ * thread-safe: every thread updating a table needs its own.
+ */
+class StochasticRounder {
+ public:
+  StochasticRounder(bool stochastic, uint64_t seed)
+      : stochastic_(stochastic),
+        // xorshift never leaves the all-zero state.
+        state_(seed != 0 ? seed : 0x9E3779B97F4A7C15ULL) {}
+
+  bool stochastic() const {
+    return stochastic_;
+  }
+
+  uint32_t NextBits() {
+    state_ ^= state_ >> 12;
+    state_ ^= state_ << 25;
+    state_ ^= state_ >> 27;
+    return static_cast<uint32_t>((state_ * 0x2545F4914F6CDD1DULL) >> 32);
+  }
+
+  // Uniform in [0, 1).
+  float NextUniform() {
+    return (NextBits() >> 8) * (1.0f / (1 << 24));
+  }
+
+  // fp16 has 13 fewer mantissa bits than fp32. Adding 13 random bits to the
+  // magnitude before clearing them rounds it up with the right probability,
+  // and the result converts to fp16 exactly. Values in the subnormal range of
+  // fp16 lose more bits, which are then rounded to nearest.
+  at::Half ToHalf(float x) {
+    if (stochastic_) {
+      uint32_t bits;
+      std::memcpy(&bits, &x, sizeof(bits));
+      if ((bits & 0x7f800000u) != 0x7f800000u) {
+        bits = (bits + (NextBits() & 0x1fffu)) & ~0x1fffu;
+        std::memcpy(&x, &bits, sizeof(bits));
+      }
+    }
+    return at::Half(x);
+  }
+
+  // Rounds a value already scaled to [0, 255] to an 8-bit code.
+  uint8_t ToUint8(float x) {
+    const float rounded =
+        stochastic_ ? std::floor(x + NextUniform()) : std::round(x);
+    return static_cast<uint8_t>(std::min(std::max(rounded, 0.0f), 255.0f));
+  }
+
+ private:
+  bool stochastic_;
+  uint64_t state_;
+};
+
+} // namespace caffe2
@@ -1,9 +1,17 @@
 #include "caffe2/utils/threadpool/ThreadPool.h"
 #include "WorkersPool.h"
 #include "caffe2/core/logging.h"
+#include "c10/core/CPUExecutor.h"
 
 #include <cpuinfo.h>
 
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include <sstream>
+
 C10_DEFINE_bool(
     caffe2_threadpool_force_inline,
     false,
@@ -15,8 +23,78 @@ C10_DEFINE_int(caffe2_threadpool_android_cap, true, "");
 // Whether or not threadpool caps apply to iOS
 C10_DEFINE_int(caffe2_threadpool_ios_cap, true, "");
 
+C10_DEFINE_int(
+    caffe2_threadpool_max_spin_us,
+    5000,
+    "Longest time in microseconds that an idle worker busy-waits for work "
+    "before it parks");
+
+C10_DEFINE_bool(
+    caffe2_threadpool_adaptive_spin,
+    true,
+    "If set, idle workers spin for about twice the time they usually wait for "
+    "work, and park at once when work arrives less often than every "
+    "--caffe2_threadpool_max_spin_us; otherwise they always spin that long");
+
+C10_DEFINE_string(
+    caffe2_threadpool_worker_cpus,
+    "",
+    "CPUs to pin the workers to, such as \"0-3,8\". Worker i runs on the i-th "
+    "CPU of the list, modulo its length");
+
 namespace caffe2 {
 
+std::vector<int> ParseCPUList(const std::string& cpus) {
+  std::vector<int> result;
+  std::stringstream ss(cpus);
+  std::string range;
+  while (std::getline(ss, range, ',')) {
+    if (range.empty()) {
+      continue;
+    }
+    const auto dash = range.find('-');
+    try {
+      size_t end;
+      const int first = std::stoi(range.substr(0, dash), &end);
+      CAFFE_ENFORCE_EQ(end, dash == std::string::npos ? range.size() : dash);
+      int last = first;
+      if (dash != std::string::npos) {
+        const auto last_str = range.substr(dash + 1);
+        last = std::stoi(last_str, &end);
+        CAFFE_ENFORCE_EQ(end, last_str.size());
+      }
+      CAFFE_ENFORCE(0 <= first && first <= last);
+      for (int cpu = first; cpu <= last; ++cpu) {
+        result.push_back(cpu);
+      }
+    } catch (const std::logic_error&) {
+      CAFFE_THROW("Invalid CPU range \"", range, "\" in \"", cpus, "\"");
+    } catch (const EnforceNotMet&) {
+      CAFFE_THROW("Invalid CPU range \"", range, "\" in \"", cpus, "\"");
+    }
+  }
+  return result;
+}
+
+bool SetThreadAffinity(std::thread& thread, int cpu) {
+#if defined(__linux__) && !defined(__ANDROID__)
+  cpu_set_t cpuset;
+  CPU_ZERO(&cpuset);
+  CPU_SET(cpu, &cpuset);
+  const int err =
+      pthread_setaffinity_np(thread.native_handle(), sizeof(cpuset), &cpuset);
+  if (err != 0) {
+    LOG(WARNING) << "Failed to pin thread to CPU " << cpu << ": error " << err;
+    return false;
+  }
+  return true;
+#else
+  (void)thread;
+  (void)cpu;
+  return false;
+#endif
+}
+
 // Default smallest amount of work that will be partitioned between
 // multiple threads; the runtime value is configurable
 constexpr size_t kDefaultMinWorkSize = 1;
@@ -127,6 +205,20 @@ void ThreadPool::run(const std::function<void(int, size_t)>& fn, size_t range) {
 
   CAFFE_ENFORCE_GE(numThreads_, 1);
   const size_t unitsPerTask = (range + numThreads_ - 1) / numThreads_;
+  if (c10::cpu_executor_enabled()) {
+    // Run the same chunks on the threads of the process-wide executor; the
+    // workers of this pool are never started. Slots are less than
+    // numThreads_, so they can be used as thread ids.
+    const size_t numTasks = (range + unitsPerTask - 1) / unitsPerTask;
+    c10::cpu_executor().run(
+        numTasks, numThreads_, [&](size_t slot, size_t task) {
+          const size_t end = std::min(range, (task + 1) * unitsPerTask);
+          for (size_t i = task * unitsPerTask; i < end; ++i) {
+            fn(slot, i);
+          }
+        });
+    return;
+  }
   tasks_.resize(numThreads_);
   for (size_t i = 0; i < numThreads_; ++i) {
     if (!tasks_[i]) {
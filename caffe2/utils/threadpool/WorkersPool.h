@@ -1,8 +1,12 @@
 #pragma once
 
+#include <algorithm>
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
+#include <string>
 #include <thread>
+#include <vector>
 #include "c10/util/thread_name.h"
 #include "caffe2/core/common.h"
 #include "caffe2/core/logging.h"
@@ -11,6 +15,10 @@
 #include <intrin.h>
 #endif
 
+C10_DECLARE_int(caffe2_threadpool_max_spin_us);
+C10_DECLARE_bool(caffe2_threadpool_adaptive_spin);
+C10_DECLARE_string(caffe2_threadpool_worker_cpus);
+
 namespace caffe2 {
 
 // Uses code derived from gemmlowp,
@@ -78,8 +86,6 @@ struct MakeAligned {
   }
 };
 
-const int kMaxBusyWaitNOPs = 32 * 1000 * 1000;
-
 #if defined(_MSC_VER)
 #define GEMMLOWP_NOP __nop();
 #else
@@ -107,6 +113,12 @@ inline int Do256NOPs() {
 #undef GEMMLOWP_NOP4
 #undef GEMMLOWP_NOP
 
+// Time spent in WaitForVariableChange.
+struct WaitTimes {
+  std::chrono::nanoseconds spin{0};
+  std::chrono::nanoseconds sleep{0};
+};
+
 // Waits until *var != initial_value.
 //
 // Returns the new value of *var. The guarantee here is that
@@ -116,7 +128,7 @@ inline int Do256NOPs() {
 // still the value of *var when this function returns, since *var is
 // not assumed to be guarded by any lock.
 //
-// First does some busy-waiting for a fixed number of no-op cycles,
+// First does some busy-waiting for at most max_spin,
 // then falls back to passive waiting for the given condvar, guarded
 // by the given mutex.
 //
@@ -133,10 +145,12 @@ template <typename T>
 T WaitForVariableChange(std::atomic<T>* var,
                         T initial_value,
                         std::condition_variable* cond,
-                        std::mutex* mutex) {
+                        std::mutex* mutex,
+                        std::chrono::nanoseconds max_spin,
+                        WaitTimes* times = nullptr) {
+  using Clock = std::chrono::steady_clock;
   // If we are on a platform that supports it, spin for some time.
   {
-    int nops = 0;
     // First, trivial case where the variable already changed value.
     T new_value = var->load(std::memory_order_relaxed);
     if (new_value != initial_value) {
@@ -144,18 +158,28 @@ T WaitForVariableChange(std::atomic<T>* var,
       return new_value;
     }
     // Then try busy-waiting.
-    while (nops < kMaxBusyWaitNOPs) {
-      nops += Do256NOPs();
+    const auto start = Clock::now();
+    auto now = start;
+    while (now - start < max_spin) {
+      Do256NOPs();
       new_value = var->load(std::memory_order_relaxed);
+      now = Clock::now();
       if (new_value != initial_value) {
         std::atomic_thread_fence(std::memory_order_acquire);
+        if (times) {
+          times->spin += now - start;
+        }
         return new_value;
       }
     }
+    if (times) {
+      times->spin += now - start;
+    }
   }
 
   // Finally, do real passive waiting.
   {
+    const auto start = Clock::now();
     std::unique_lock<std::mutex> g(*mutex);
     T new_value = var->load(std::memory_order_relaxed);
     // Handle spurious wakeups.
@@ -164,10 +188,97 @@ T WaitForVariableChange(std::atomic<T>* var,
       return new_value != initial_value;
     });
     DCHECK_NE(static_cast<size_t>(new_value), static_cast<size_t>(initial_value));
+    if (times) {
+      times->sleep += Clock::now() - start;
+    }
     return new_value;
   }
 }
 
+// Spins for at most --caffe2_threadpool_max_spin_us.
+template <typename T>
+T WaitForVariableChange(std::atomic<T>* var,
+                        T initial_value,
+                        std::condition_variable* cond,
+                        std::mutex* mutex) {
+  return WaitForVariableChange(
+      var,
+      initial_value,
+      cond,
+      mutex,
+      std::chrono::microseconds(FLAGS_caffe2_threadpool_max_spin_us));
+}
+
+// Decides how long a worker busy-waits for its next task before parking.
+//
+// Spinning only pays off when work arrives before the thread would have
+// been rescheduled after parking; otherwise it takes CPU from other
+// processes on the host. The adaptive policy keeps a moving average of the
+// time the worker waited for work, and spins for twice that time, up to
+// max_spin. When work typically arrives later than max_spin, it parks at
+// once. The fixed policy always spins for max_spin.
+class SpinPolicy {
+ public:
+  SpinPolicy(std::chrono::nanoseconds max_spin, bool adaptive)
+      : max_spin_(max_spin),
+        adaptive_(adaptive),
+        // Start out spinning for max_spin.
+        expected_wait_(max_spin / 2) {}
+
+  std::chrono::nanoseconds SpinDuration() const {
+    if (!adaptive_) {
+      return max_spin_;
+    }
+    if (expected_wait_ > max_spin_) {
+      return std::chrono::nanoseconds(0);
+    }
+    return std::min(max_spin_, 2 * expected_wait_ + kMinSpin);
+  }
+
+  // Records how long the last wait for work took.
+  void Observe(std::chrono::nanoseconds wait) {
+    // Moving average with a weight of 1/8 for the last wait.
+    expected_wait_ += (wait - expected_wait_) / 8;
+  }
+
+  std::chrono::nanoseconds ExpectedWait() const {
+    return expected_wait_;
+  }
+
+ private:
+  // Covers the latency of the wake-up itself.
+  const std::chrono::nanoseconds kMinSpin{1000};
+
+  const std::chrono::nanoseconds max_spin_;
+  const bool adaptive_;
+  std::chrono::nanoseconds expected_wait_;
+};
+
+// Time spent by a worker thread since it started, and the number of tasks
+// it ran.
+struct WorkerStats {
+  // Running tasks.
+  std::chrono::nanoseconds busy{0};
+  // Busy-waiting for work.
+  std::chrono::nanoseconds spin{0};
+  // Parked, waiting for work.
+  std::chrono::nanoseconds sleep{0};
+  uint64_t tasks = 0;
+  // Waits that ended while spinning, and after parking.
+  uint64_t spin_wakeups = 0;
+  uint64_t sleep_wakeups = 0;
+  // The CPU the worker is pinned to, or -1.
+  int cpu = -1;
+};
+
+// Parses a list of CPUs such as "0-3,8,10-11". Returns an empty list for an
+// empty string.
+CAFFE2_API std::vector<int> ParseCPUList(const std::string& cpus);
+
+// Pins a thread to a CPU. Returns false if that is not supported on this
+// platform or failed.
+CAFFE2_API bool SetThreadAffinity(std::thread& thread, int cpu);
+
 // A BlockingCounter lets one thread to wait for N events to occur.
 // This is how the master thread waits for all the worker threads
 // to have finished working.
@@ -230,7 +341,10 @@ class alignas(kGEMMLOWPCacheLineSize) Worker {
   explicit Worker(BlockingCounter* counter_to_decrement_when_ready)
       : task_(nullptr),
         state_(State::ThreadStartup),
-        counter_to_decrement_when_ready_(counter_to_decrement_when_ready) {
+        counter_to_decrement_when_ready_(counter_to_decrement_when_ready),
+        spin_policy_(
+            std::chrono::microseconds(FLAGS_caffe2_threadpool_max_spin_us),
+            FLAGS_caffe2_threadpool_adaptive_spin) {
     thread_ = caffe2::make_unique<std::thread>([this]() { this->ThreadFunc(); });
   }
 
@@ -275,18 +389,37 @@ class alignas(kGEMMLOWPCacheLineSize) Worker {
       // Get a state to act on
       // In the 'Ready' state, we have nothing to do but to wait until
       // we switch to another state.
-      State state_to_act_upon =
-          WaitForVariableChange(&state_, State::Ready, &state_cond_, &state_mutex_);
+      WaitTimes wait;
+      State state_to_act_upon = WaitForVariableChange(
+          &state_,
+          State::Ready,
+          &state_cond_,
+          &state_mutex_,
+          spin_policy_.SpinDuration(),
+          &wait);
+      spin_policy_.Observe(wait.spin + wait.sleep);
+      spin_ns_.fetch_add(wait.spin.count(), std::memory_order_relaxed);
+      sleep_ns_.fetch_add(wait.sleep.count(), std::memory_order_relaxed);
+      (wait.sleep.count() > 0 ? sleep_wakeups_ : spin_wakeups_)
+          .fetch_add(1, std::memory_order_relaxed);
 
       // We now have a state to act on, so act.
       switch (state_to_act_upon) {
-      case State::HasWork:
+      case State::HasWork: {
         // Got work to do! So do it, and then revert to 'Ready' state.
         DCHECK(task_.load());
+        const auto start = std::chrono::steady_clock::now();
         (*task_).Run();
+        busy_ns_.fetch_add(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - start)
+                .count(),
+            std::memory_order_relaxed);
+        tasks_.fetch_add(1, std::memory_order_relaxed);
         task_ = nullptr;
         ChangeState(State::Ready);
         break;
+      }
       case State::ExitAsSoonAsPossible:
         return;
       default:
@@ -309,6 +442,25 @@ class alignas(kGEMMLOWPCacheLineSize) Worker {
     ChangeState(State::HasWork);
   }
 
+  // Pins the worker thread to the given CPU.
+  void SetAffinity(int cpu) {
+    if (SetThreadAffinity(*thread_, cpu)) {
+      cpu_ = cpu;
+    }
+  }
+
+  WorkerStats GetStats() const {
+    WorkerStats stats;
+    stats.busy = std::chrono::nanoseconds(busy_ns_.load());
+    stats.spin = std::chrono::nanoseconds(spin_ns_.load());
+    stats.sleep = std::chrono::nanoseconds(sleep_ns_.load());
+    stats.tasks = tasks_.load();
+    stats.spin_wakeups = spin_wakeups_.load();
+    stats.sleep_wakeups = sleep_wakeups_.load();
+    stats.cpu = cpu_;
+    return stats;
+  }
+
  private:
   // The underlying thread.
   std::unique_ptr<std::thread> thread_;
@@ -326,11 +478,23 @@ class alignas(kGEMMLOWPCacheLineSize) Worker {
   // pointer to the master's thread BlockingCounter object, to notify the
   // master thread of when this worker switches to the 'Ready' state.
   BlockingCounter* const counter_to_decrement_when_ready_;
+
+  // Only used by the worker thread.
+  SpinPolicy spin_policy_;
+
+  // Updated by the worker thread, read by GetStats().
+  std::atomic<uint64_t> busy_ns_{0};
+  std::atomic<uint64_t> spin_ns_{0};
+  std::atomic<uint64_t> sleep_ns_{0};
+  std::atomic<uint64_t> tasks_{0};
+  std::atomic<uint64_t> spin_wakeups_{0};
+  std::atomic<uint64_t> sleep_wakeups_{0};
+  int cpu_ = -1;
 };
 
 class WorkersPool {
  public:
-  WorkersPool() {}
+  WorkersPool() : cpus_(ParseCPUList(FLAGS_caffe2_threadpool_worker_cpus)) {}
 
   void Execute(const std::vector<std::shared_ptr<Task>>& tasks) {
     CAFFE_ENFORCE_GE(tasks.size(), 1);
@@ -349,6 +513,29 @@ class WorkersPool {
     counter_to_decrement_when_ready_.Wait();
   }
 
+  // Pins worker i to cpus[i % cpus.size()], including the workers created
+  // later. An empty list leaves the workers created from now on unpinned.
+  // Must not be called concurrently with Execute().
+  void SetWorkerAffinity(const std::vector<int>& cpus) {
+    cpus_ = cpus;
+    if (cpus_.empty()) {
+      return;
+    }
+    for (size_t i = 0; i < workers_.size(); ++i) {
+      workers_[i]->SetAffinity(cpus_[i % cpus_.size()]);
+    }
+  }
+
+  // Returns the stats of every worker created so far.
+  std::vector<WorkerStats> GetWorkerStats() const {
+    std::vector<WorkerStats> stats;
+    stats.reserve(workers_.size());
+    for (const auto& worker : workers_) {
+      stats.push_back(worker->GetStats());
+    }
+    return stats;
+  }
+
  private:
   // Ensures that the pool has at least the given count of workers.
   // If any new worker has to be created, this function waits for it to
@@ -360,13 +547,21 @@ class WorkersPool {
     counter_to_decrement_when_ready_.Reset(workers_count - workers_.size());
     while (workers_.size() < workers_count) {
       workers_.push_back(MakeAligned<Worker>::make(&counter_to_decrement_when_ready_));
+      if (!cpus_.empty()) {
+        workers_.back()->SetAffinity(
+            cpus_[(workers_.size() - 1) % cpus_.size()]);
+      }
     }
     counter_to_decrement_when_ready_.Wait();
   }
 
   C10_DISABLE_COPY_AND_ASSIGN(WorkersPool);
-  std::vector<std::unique_ptr<Worker, AlignedDeleter<Worker>>> workers_;
-  // The BlockingCounter used to wait for the workers.
+  // The BlockingCounter used to wait for the workers. Declared before the
+  // workers so that it outlives them: a worker may still be notifying it
+  // after Execute() returned.
   BlockingCounter counter_to_decrement_when_ready_;
+  std::vector<std::unique_ptr<Worker, AlignedDeleter<Worker>>> workers_;
+  // The CPUs the workers are pinned to, if any.
+  std::vector<int> cpus_;
 };
 } // namespace caffe2
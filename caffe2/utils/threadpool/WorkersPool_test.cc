@@ -0,0 +1,109 @@
+#include <atomic>
+
+#include "caffe2/utils/threadpool/WorkersPool.h"
+#include <gtest/gtest.h>
+
+namespace caffe2 {
+
+namespace {
+
+class CountingTask : public Task {
+ public:
+  explicit CountingTask(std::atomic<int>* count) : count_(count) {}
+  void Run() override {
+    ++*count_;
+  }
+
+ private:
+  std::atomic<int>* count_;
+};
+
+} // namespace
+
+TEST(WorkersPoolTest, ParseCPUList) {
+  EXPECT_EQ(ParseCPUList(""), std::vector<int>());
+  EXPECT_EQ(ParseCPUList("3"), std::vector<int>({3}));
+  EXPECT_EQ(ParseCPUList("0-3,8"), std::vector<int>({0, 1, 2, 3, 8}));
+  EXPECT_EQ(ParseCPUList("10-11,2"), std::vector<int>({10, 11, 2}));
+  EXPECT_THROW(ParseCPUList("a"), EnforceNotMet);
+  EXPECT_THROW(ParseCPUList("3-1"), EnforceNotMet);
+  EXPECT_THROW(ParseCPUList("1-2x"), EnforceNotMet);
+}
+
+TEST(WorkersPoolTest, FixedSpinPolicy) {
+  const std::chrono::microseconds max_spin(100);
+  SpinPolicy policy(max_spin, false);
+  policy.Observe(std::chrono::seconds(1));
+  EXPECT_EQ(policy.SpinDuration(), max_spin);
+}
+
+TEST(WorkersPoolTest, AdaptiveSpinPolicy) {
+  const std::chrono::microseconds max_spin(100);
+  SpinPolicy policy(max_spin, true);
+  EXPECT_EQ(policy.SpinDuration(), max_spin);
+
+  // Work arrives quickly: spin for a bit longer than it takes.
+  for (int i = 0; i < 100; ++i) {
+    policy.Observe(std::chrono::microseconds(10));
+  }
+  EXPECT_GE(policy.SpinDuration(), std::chrono::microseconds(19));
+  EXPECT_LT(policy.SpinDuration(), std::chrono::microseconds(25));
+
+  // Work arrives rarely: park at once.
+  for (int i = 0; i < 100; ++i) {
+    policy.Observe(std::chrono::milliseconds(10));
+  }
+  EXPECT_EQ(policy.SpinDuration().count(), 0);
+
+  // And spin again once it arrives quickly.
+  for (int i = 0; i < 100; ++i) {
+    policy.Observe(std::chrono::microseconds(10));
+  }
+  EXPECT_GT(policy.SpinDuration().count(), 0);
+}
+
+TEST(WorkersPoolTest, WorkerStats) {
+  WorkersPool pool;
+  std::atomic<int> count(0);
+  std::vector<std::shared_ptr<Task>> tasks;
+  for (int i = 0; i < 4; ++i) {
+    tasks.push_back(std::make_shared<CountingTask>(&count));
+  }
+  for (int i = 0; i < 10; ++i) {
+    pool.Execute(tasks);
+  }
+  EXPECT_EQ(count.load(), 40);
+
+  const auto stats = pool.GetWorkerStats();
+  ASSERT_EQ(stats.size(), 3);
+  for (const auto& worker : stats) {
+    EXPECT_EQ(worker.tasks, 10);
+    // Every task was preceded by a wait, and the workers now wait again.
+    EXPECT_GE(worker.spin_wakeups + worker.sleep_wakeups, 10);
+    EXPECT_EQ(worker.cpu, -1);
+  }
+}
+
+TEST(WorkersPoolTest, ParksWithoutSpinning) {
+  const auto max_spin_us = FLAGS_caffe2_threadpool_max_spin_us;
+  FLAGS_caffe2_threadpool_max_spin_us = 0;
+  {
+    WorkersPool pool;
+    std::atomic<int> count(0);
+    std::vector<std::shared_ptr<Task>> tasks;
+    for (int i = 0; i < 3; ++i) {
+      tasks.push_back(std::make_shared<CountingTask>(&count));
+    }
+    for (int i = 0; i < 10; ++i) {
+      pool.Execute(tasks);
+    }
+    EXPECT_EQ(count.load(), 30);
+    for (const auto& worker : pool.GetWorkerStats()) {
+      EXPECT_EQ(worker.spin.count(), 0);
+      EXPECT_GT(worker.sleep.count(), 0);
+    }
+  }
+  FLAGS_caffe2_threadpool_max_spin_us = max_spin_us;
+}
+
+} // namespace caffe2
@@ -0,0 +1,149 @@
+#include <gtest/gtest.h>
+
+#include <torch/nn/checkpoint.h>
+#include <torch/nn/modules/dropout.h>
+#include <torch/nn/modules/functional.h>
+#include <torch/nn/modules/linear.h>
+#include <torch/nn/modules/sequential.h>
+#include <torch/types.h>
+#include <torch/utils.h>
+
+#include <test/cpp/api/support.h>
+
+#include <vector>
+
+using namespace torch::nn;
+using namespace torch::test;
+
+struct CheckpointTest : torch::test::SeedingFixture {};
+
+namespace {
+Sequential make_model() {
+  return Sequential(
+      Linear(10, 20),
+      Functional(torch::relu),
+      Linear(20, 20),
+      Functional(torch::tanh),
+      Linear(20, 20),
+      Functional(torch::relu),
+      Linear(20, 5));
+}
+
+std::vector<torch::Tensor> parameter_grads(Sequential& model) {
+  std::vector<torch::Tensor> grads;
+  for (const auto& parameter : model->parameters()) {
+    grads.push_back(parameter.grad().clone());
+  }
+  return grads;
+}
+} // namespace
+
+TEST_F(CheckpointTest, CheckpointMatchesUncheckpointed) {
+  auto model = make_model();
+  auto input = torch::randn({4, 10}, torch::requires_grad());
+
+  auto expected = model->forward(input);
+  expected.sum().backward();
+  const auto expected_input_grad = input.grad().clone();
+  const auto expected_grads = parameter_grads(model);
+
+  model->zero_grad();
+  input.grad().zero_();
+  auto output = checkpoint_sequential(model, {2, 5, 7}, input);
+  ASSERT_TRUE(output.allclose(expected));
+  output.sum().backward();
+  ASSERT_TRUE(input.grad().allclose(expected_input_grad));
+  const auto grads = parameter_grads(model);
+  ASSERT_EQ(grads.size(), expected_grads.size());
+  for (size_t i = 0; i < grads.size(); ++i) {
+    ASSERT_TRUE(grads[i].allclose(expected_grads[i]));
+  }
+}
+
+TEST_F(CheckpointTest, RecomputesOncePerSegment) {
+  int calls = 0;
+  auto function = [&calls](const torch::Tensor& x) {
+    ++calls;
+    return (x * 2).sin();
+  };
+  auto input = torch::randn({3, 3}, torch::requires_grad());
+  auto output = checkpoint(function, input);
+  ASSERT_EQ(calls, 1);
+  ASSERT_FALSE(output.grad_fn() == nullptr);
+  output.sum().backward();
+  ASSERT_EQ(calls, 2);
+  ASSERT_TRUE(input.grad().allclose((input * 2).cos() * 2));
+}
+
+TEST_F(CheckpointTest, DoesNotRecordWithoutGrad) {
+  int calls = 0;
+  auto function = [&calls](const torch::Tensor& x) {
+    ++calls;
+    return x + 1;
+  };
+  auto output = checkpoint(function, torch::ones(3));
+  ASSERT_EQ(calls, 1);
+  ASSERT_FALSE(output.requires_grad());
+}
+
+TEST_F(CheckpointTest, ReplaysRandomState) {
+  Dropout dropout(0.5);
+  auto input = torch::ones({100}, torch::requires_grad());
+  auto output = checkpoint(
+      [&dropout](const torch::Tensor& x) { return dropout->forward(x); },
+      input);
+  output.sum().backward();
+  // The gradient of dropout is its (scaled) mask, which must match the mask
+  // of the forward pass.
+  ASSERT_TRUE(input.grad().allclose(output));
+}
+
+TEST_F(CheckpointTest, RecordsStats) {
+  reset_checkpoint_stats();
+  auto model = make_model();
+  auto input = torch::randn({4, 10}, torch::requires_grad());
+  checkpoint_sequential(model, {3, 7}, input).sum().backward();
+  const auto stats = checkpoint_stats();
+  ASSERT_EQ(stats.checkpointed_regions, 1);
+  ASSERT_EQ(stats.recomputed_regions, 1);
+  ASSERT_GT(stats.recompute_ns, 0);
+}
+
+TEST(CheckpointPlanTest, KeepsEverythingWithinBudget) {
+  const std::vector<int64_t> activation_bytes(16, 100);
+  const auto plan = plan_checkpoints(activation_bytes, 2000);
+  ASSERT_EQ(plan.segment_ends, std::vector<size_t>({16}));
+  ASSERT_EQ(plan.baseline_bytes, 1600);
+  ASSERT_EQ(plan.peak_bytes, 1600);
+  ASSERT_TRUE(plan.fits_budget);
+}
+
+TEST(CheckpointPlanTest, SplitsToMeetBudget) {
+  const std::vector<int64_t> activation_bytes(16, 100);
+  for (int64_t budget : {900, 800, 700}) {
+    const auto plan = plan_checkpoints(activation_bytes, budget);
+    ASSERT_TRUE(plan.fits_budget);
+    ASSERT_LE(plan.peak_bytes, budget);
+    ASSERT_EQ(plan.segment_ends.back(), 16u);
+  }
+  // Fewer segments are preferred as long as they fit.
+  ASSERT_EQ(plan_checkpoints(activation_bytes, 900).segment_ends.size(), 2u);
+}
+
+TEST(CheckpointPlanTest, ReturnsSmallestPeakIfNothingFits) {
+  const std::vector<int64_t> activation_bytes(16, 100);
+  const auto plan = plan_checkpoints(activation_bytes, 10);
+  ASSERT_FALSE(plan.fits_budget);
+  ASSERT_LT(plan.peak_bytes, plan.baseline_bytes);
+}
+
+TEST_F(CheckpointTest, PlansSequential) {
+  auto model = make_model();
+  const auto input = torch::randn({4, 10});
+  // Outputs of 20 floats per sample dominate the model.
+  const int64_t budget = 4 * 20 * 4 * 4;
+  const auto plan = plan_checkpoints(model, input, budget);
+  ASSERT_EQ(plan.baseline_bytes, 4 * (20 * 6 + 5) * 4);
+  ASSERT_TRUE(plan.fits_budget);
+  ASSERT_EQ(plan.segment_ends.back(), model->size());
+}
@@ -9,42 +9,42 @@ namespace expected_parameters {
 inline std::vector<std::vector<torch::Tensor>> Xavier_Uniform() {
   return {
     {
-      torch::tensor({0.20493895, 0.03128183, -0.25481248, 0.2471149, -0.5009514, -0.30953097, -0.13073051}),
-      torch::tensor({-0.25438663, -0.18269452, -0.42803344, -0.111086845, 0.11163068, -0.34021688, -0.026800662}),
-      torch::tensor({0.37384087, -0.053685665, 0.014514029, -0.04505247, 0.10569024, 0.33205634, 0.4946832}),
-      torch::tensor({0.3316471, 0.49581498, -0.03776875, -0.46913308, -0.24757874, 0.35559112, -0.003385365}),
-      torch::tensor({-0.259574, -0.40019324, -0.48873278, -0.4407689, -0.10592803, 0.28639567, 0.2823406}),
-      torch::tensor({-0.5036581, 0.32575953, -0.40865222, -0.110405415, -0.21175116, -0.10059005, -0.10253662}),
-      torch::tensor({-0.46862572, -0.45091572, -0.08171874, 0.0067536235, -0.2372373, 0.19672471, -0.47004014}),
-      torch::tensor({-0.035244048, 0.45926183, -0.21301463, 0.47157794, 0.18912864, -0.47129482, 0.33041543}),
-      torch::tensor({-0.0602628, -0.23312837, 0.41760528, -0.42201394, 0.05603814, -0.10933924, 0.37293315}),
-      torch::tensor({0.14577848, 0.25093573, 0.18443125, -0.1255838, -0.10982844, -0.43036246, 0.28296888}),
-      torch::tensor({0.4146415, 0.35732478, -0.36837178, 0.023291528, -0.3681398, -0.28748098, -0.304308}),
-      torch::tensor({0.17847049, -0.3112055, -0.011393666, 0.021969378, 0.3366434, -0.39476636, -0.35851932}),
-      torch::tensor({-0.3032406, 0.3655283, -0.18772447, 0.44049758, 0.18884337, 0.066128254, -0.0038875341}),
-      torch::tensor({-0.10323581, 0.06552267, -0.119249105, -0.0036694407, 0.066633284, -0.40849328, -0.2737187}),
-      torch::tensor({0.4216993, -0.4238164, -0.037499547, 0.51661307, 0.1886499, 0.014786005, -0.45257226}),
+      torch::tensor({0.25865477, -0.3477922, -0.37019628, -0.30382484, 0.23911071, 0.0128160715, -0.057321012}),
+      torch::tensor({0.28072459, -0.4272326, -0.42569155, -0.36843795, 0.06016475, 0.066045284, -0.42087418}),
+      torch::tensor({0.15018171, -0.1452668, 0.045314252, -0.14868179, 0.21339798, 0.35198903, -0.35725343}),
+      torch::tensor({-0.014467657, 0.19951457, -0.17468056, 0.35066402, 0.18289334, -0.029405832, -0.45329773}),
+      torch::tensor({-0.33673155, -0.3880824, 0.5041848, -0.119038135, -0.4918108, 0.28557348, -0.4793972}),
+      torch::tensor({0.38966423, -0.25261953, 0.13148302, -0.283106, -0.4123823, -0.33285403, 0.31074536}),
+      torch::tensor({0.16630352, 0.2094239, 0.48296994, -0.20153362, 0.065825164, 0.5084278, 0.16478485}),
+      torch::tensor({-0.23601794, -0.35175282, 0.0692783, 0.22383505, -0.34234303, 0.13456088, -0.089901775}),
+      torch::tensor({0.12462717, 0.104358256, -0.47882128, 0.32513732, 0.3053711, 0.20378578, -0.3776304}),
+      torch::tensor({-0.36184227, -0.080382794, 0.43915653, 0.14172286, 0.2123416, 0.34972447, 0.28824615}),
+      torch::tensor({-0.17313844, -0.33179486, -0.18877488, -0.49462265, -0.029172331, 0.44975984, -0.080314636}),
+      torch::tensor({-0.35949856, -0.48135033, -0.39771232, 0.35356933, 0.3061869, 0.20391822, 0.15302902}),
+      torch::tensor({-0.294531, -0.18243167, -0.19932842, 0.19891745, 0.23257941, 0.25096905, -0.36913288}),
+      torch::tensor({-0.16558447, 0.39446145, 0.48227185, -0.18106768, -0.49993682, -0.45320764, -0.33813813}),
+      torch::tensor({-0.36247283, 0.06822735, -0.039465457, -0.2787848, 0.12732738, -0.096074075, 0.3696475}),
     },
     {
-      torch::tensor({0.2400673, 0.06230098, -0.29922318, -0.3467335, -0.13797283, 0.19630808, 0.44112986, 0.25716078, -0.05036038, 0.15680045, -0.43874466, -0.3819657, 0.20867342, -0.25330856, 0.2151525}),
-      torch::tensor({-0.31570244, -0.22150977, -0.3683649, 0.23337424, -0.045568883, 0.34417605, 0.27676803, 0.24746233, 0.014380664, -0.13826859, -0.09723839, 0.05943495, 0.22168803, -0.3133133, 0.37533647}),
-      torch::tensor({-0.04862556, -0.37474066, -0.24196841, 0.39570248, 0.408989, -0.41424486, 0.31541896, 0.2241252, 0.264714, 0.37857938, -0.24102591, 0.1412192, 0.18301463, -0.13214865, 0.14966142}),
-      torch::tensor({-0.12866935, 0.27649486, -0.12408146, -0.16671932, 0.112585604, 0.15862381, -0.21849588, 0.03953293, 0.25917625, -0.044496298, 0.13610226, -0.107862085, 0.15674818, -0.32395893, -0.26297447}),
-      torch::tensor({-0.22700138, 0.41099417, -0.12033805, -0.0012210608, -0.21667299, 0.44644886, 0.43678015, -0.3372825, -0.3625426, -0.33898476, -0.002156794, -0.113996506, -0.29272172, -0.16040304, 0.084492445}),
-      torch::tensor({-0.23366496, 0.09909475, -0.10255319, -0.21670331, 0.061440647, 0.36772507, -0.30235183, 0.02076611, -0.16491795, 0.4388535, -0.4242998, -0.42872632, 0.44067752, -0.28294754, 0.08574128}),
-      torch::tensor({-0.038597256, -0.09420869, -0.09988415, 0.28417766, 0.021375448, -0.43541366, -0.2640171, -0.15245524, 0.2250452, -0.28940699, 0.42168647, -0.09960759, -0.08030257, 0.3504178, 0.22477299}),
-      torch::tensor({0.37929094, 0.25868815, -0.13566399, -0.2967139, -0.033274055, 0.37013078, -0.15009373, -0.41473246, 0.18332559, 0.43534964, -0.12731421, -0.3703034, -0.40564942, 0.112071455, -0.03386289}),
-      torch::tensor({-0.22583716, 0.090396106, 0.1698333, 0.35567743, 0.34720868, -0.066940606, -0.39433825, -0.40411252, 0.41755867, 0.19769311, 0.19494373, -0.3869386, 0.4141268, 0.4236647, 0.4037714}),
-      torch::tensor({-0.37726268, -0.16874415, -0.3075773, 0.4234959, -0.19215873, -0.2041774, 0.23430097, -0.20687759, -0.22026259, -0.03911844, -0.042985946, -0.34836975, 0.3728277, -0.19727562, 0.15863329}),
-      torch::tensor({0.38897908, 0.22553718, 0.063316464, 0.3805148, 0.060117245, -0.20690633, 0.4230638, 0.10584676, -0.43633774, -0.12731794, -0.30462736, 0.39209586, -0.07385549,-0.40764633, -0.028113335}),
-      torch::tensor({0.2808559, 0.11618626, 0.14141095, 0.041534156, 0.16672957, -0.10896447, -0.17790166, -0.41801435, -0.3369025, 0.19382352, -0.26480114, 0.06416017, 0.14274675, 0.03166446, -0.28995082}),
-      torch::tensor({0.42768306, -0.26005447, 0.36783344, -0.35576212, -0.10757655, 0.24327022, -0.18272284, 0.3756786, -0.30775294, -0.37555724, -0.20165718, 0.07229227, 0.41177452, -0.21350017, 0.15993619}),
-      torch::tensor({-0.112119585, -0.09698379, 0.3288377, -0.34658423, 0.047500044, 0.42056376, -0.061452597, 0.34723365, -0.13772246, 0.35999, -0.43260327, -0.06445408, -0.07855147, 0.14493519, 0.17545414}),
-      torch::tensor({0.34337813, -0.066628546, -0.01773429, 0.3062569, -0.121003985, 0.39204246, -0.29776025, -0.04839292, -0.024020255, 0.1995511, 0.30574924, -0.07088503, -0.37050778, 0.22159088, 0.13377577}),
+      torch::tensor({0.3707438, -0.25371316, -0.44580567, 0.43801153, 0.12664777, -0.3629771, 0.09404194, -0.21405664, -0.43050885, 0.14511073, -0.13906652, -0.17984536, -0.29822713, -0.3972877, -0.30817857}),
+      torch::tensor({0.3583635, -0.330316, -0.02730909, -0.28054264, -0.1545794, 0.4285435, 0.43886644, -0.07989648, -0.22855522, 0.069839776, -0.08073354, -0.2449942, -0.023953617, 0.066661716, -0.107845634}),
+      torch::tensor({-0.3008613, -0.36261642, 0.3120677, 0.2670226, -0.3566005, 0.30890542, 0.27193815, -0.3450424, 0.21890754, 0.09689635, 0.42343038, -0.33265683, 0.04345104, 0.0535264, -0.107170254}),
+      torch::tensor({0.27745265, 0.27924603, -0.24642812, -0.22066338, 0.3717863, 0.33607107, 0.39126265, 0.1654548, 0.22014642, 0.19278592, -0.14442655, 0.099788845, -0.13953051, 0.21399248, 0.06810659}),
+      torch::tensor({0.21491057, 0.041375548, 0.30515522, 0.04965332, -0.3867961, -0.30003852, -0.3988227, -0.032386363, -0.12266523, 0.2550429, 0.27118182, 0.07382733, 0.094605744, -0.11646736, -0.2785363}),
+      torch::tensor({0.33571815, -0.22454786, -0.43615705, 0.2734815, 0.12827086, -0.015211403, 0.36495864, -0.12024233, -0.14584252, 0.12692773, -0.20602754, -0.37224615, -0.10701406, -0.20981982, -0.3060004}),
+      torch::tensor({-0.18345144, -0.16122577, 0.35351777, -0.34410703, -0.37426314, 0.103428364, 0.10609913, 0.4054913, -0.077285826, 0.14208508, 0.28080088, 0.316406, 0.4425581, -0.24982212, 0.42857307}),
+      torch::tensor({-0.26868278, -0.32752508, 0.25556695, 0.009457916, -0.2911362, 0.036949486, -0.4220162, 0.3077132, 0.13258106, 0.13423371, -0.15170628, 0.38011533, -0.052366048, 0.29530174, -0.030022234}),
+      torch::tensor({0.42915058, 0.0636037, -0.113169104, -0.41919494, 0.4017471, -0.06916818, -0.02868101, 0.069898546, 0.37225884, 0.33296317, 0.003037721, 0.30041814, -0.007909268, -0.23182437, -0.1808322}),
+      torch::tensor({0.41103113, -0.14318174, -0.35115388, -0.06971553, 0.28142917, -0.044032514, -0.30338785, 0.010449648, -0.35672113, 0.1878044, -0.22096999, 0.05243787, 0.09253299, 0.39725477, 0.32036048}),
+      torch::tensor({-0.17640254, 0.26222116, -0.24982283, -0.3409425, -0.24538699, 0.036518306, -0.2802453, 0.2630353, -0.3633383, -0.28716293, 0.21694106, -0.36057252, 0.04330519, 0.16956347, -0.35323048}),
+      torch::tensor({-0.1487273, 0.12655729, 0.34097666, 0.18360054, -0.24323954, 0.36103052, -0.3173156, 0.21862805, -0.12000561, -0.06589413, 0.17668015, -0.44383094, 0.0051273406, -0.39880106, -0.26669627}),
+      torch::tensor({0.27598137, -0.22495292, 0.28308916, 0.3015952, 0.042144805, 0.30259365, -0.17065853, -0.20263086, 0.015591949, 0.015060157, -0.039868742, -0.40680745, -0.113977075, -0.06396881, -0.03993076}),
+      torch::tensor({-0.16351259, -0.16100499, -0.11753231, 0.0733726, -0.16138405, 0.33468497, -0.11423522, 0.3323393, -0.0031411946, 0.26978827, 0.14367509, -0.12996146, -0.013881743, 0.4462247, 0.18856835}),
+      torch::tensor({0.31439942, 0.14483261, 0.20351124, -0.31917354, 0.124175966, 0.3602391, 0.40300083, -0.16017482, 0.14110816, 0.32189518, -0.3262098, 0.37654918, 0.22940004, -0.34354562, -0.095136136}),
     },
     {
-      torch::tensor({-0.095182985, -0.35154456, -0.33943355, 0.14092201, 0.5576401, -0.4759267, 0.35954505, -0.30801514, -0.11571318, 0.47157025, -0.1343652, 0.05409521, -0.41528726, 0.5057125, -0.076797724}),
-      torch::tensor({-0.4345107, 0.17395526, -0.42240727, -0.4714136, 0.036191404, 0.47101927, -0.16811755, 0.2796178, 0.51051295, 0.39403576, -0.3116357, -0.065123916, -0.18695068,-0.47772023, 0.00024545193}),
+      torch::tensor({0.07660687, -0.20696416, 0.412943, -0.369688, -0.3796831, -0.39609775, 0.029108346, -0.5600024, -0.5155871, -0.054771245, -0.29510492, -0.14524293, -0.2073327, -0.1777842, -0.3497025}),
+      torch::tensor({-0.2660183, -0.07185483, 0.1935342, 0.5930116, -0.10021502, 0.33673292, -0.19748664, -0.086155534, -0.44361198, -0.38697362, 0.44424367, -0.34835422, -0.49850446, 0.024071932, -0.41774338}),
     },
   };
 }
@@ -52,42 +52,42 @@ inline std::vector<std::vector<torch::Tensor>> Xavier_Uniform() {
 inline std::vector<std::vector<torch::Tensor>> Xavier_Normal() {
   return {
     {
-      torch::tensor({-0.21151732, 0.31257284, -0.18201339, -0.3855622, 0.028025549, -0.20083663, 0.18333313}),
-      torch::tensor({-0.22010927, 0.41458952, 0.19888626, 0.14368738, -0.30642822, 0.05438269, 0.032663286}),
-      torch::tensor({-0.22758777, 0.07366481, 0.34382868, -0.027100464, 0.22004184, -0.5563846, -0.0075437957}),
-      torch::tensor({0.4128839, 0.80112267, 0.29702467, 0.11372463, 0.3320348, -0.34456047, 0.011332423}),
-      torch::tensor({0.81295794, 0.37259677, 0.16366935, 0.15845336, -0.2500635, -0.42430383, 0.49051273}),
-      torch::tensor({0.051942326, -0.48588628, -0.14455895, -0.04322197, -0.09566793, 0.17296337, 0.3008876}),
-      torch::tensor({0.16390441, 0.023760417, 0.26016212, -0.005876346, 0.29881194, -0.23449583, -0.090267815}),
-      torch::tensor({-0.05661722, 0.57766485, 0.20810172, -0.70001936, -0.36073124, 0.059406225, -0.35497883}),
-      torch::tensor({0.034237247, 0.33308733, -0.4206602, 0.14325368, -0.24534757, 0.27866775, -0.07457621}),
-      torch::tensor({-0.42675552, 0.29772332, -0.44859084, 0.17689292, 0.04772785, 0.03324038, -0.24688111}),
-      torch::tensor({0.19078615, -0.57796097, 0.39555034, -0.063268825, 0.23570086, 0.29840353, 0.12504078}),
-      torch::tensor({-0.45496583, 0.61388826, 0.039676014, -0.15409455, -0.5167084, -0.15379032, -0.14318566}),
-      torch::tensor({-0.19097842, -0.44253433, -0.26487318, -0.6266602, -0.33180708, 0.4737542, 0.05777406}),
-      torch::tensor({0.11455678, -0.04364589, 0.19224901, -0.084812194, -0.40097243, -0.197128, -0.161051}),
-      torch::tensor({-0.15780471, 0.25975332, -0.26742947, 0.2529001, 0.34761095, -0.5309911, -0.3337848}),
+      torch::tensor({0.42083937, 0.15239237, 0.10175915, -0.19314803, -0.4492295, 0.2961996, -0.20253585}),
+      torch::tensor({-0.33119184, 0.270632, 0.100009024, 0.13508357, -0.07312794, -0.18850742, 0.20690626}),
+      torch::tensor({-0.2570419, 0.39567494, 0.19367832, -0.12861943, -0.46333218, 0.52562463, 0.07767798}),
+      torch::tensor({0.24065301, 0.45938513, -0.2046058, -0.32406583, -0.25285015, 0.0828276, 0.23139171}),
+      torch::tensor({0.15882328, 0.25128555, -0.050073188, 0.17804503, 0.030664466, 0.15281926, -0.047114085}),
+      torch::tensor({-0.18744843, 0.22653043, -0.14832202, -0.2005973, 0.14165345, 0.066589534, -0.4965688}),
+      torch::tensor({-0.07344544, -0.5832366, -0.05452292, 0.39593306, -0.083863184, -0.011791043, -0.32315508}),
+      torch::tensor({-0.19529273, 0.17389525, 0.14642017, 0.12556455, -0.06267633, 0.27376634, 0.17751385}),
+      torch::tensor({-0.30088058, -0.14173007, 0.04647432, -0.3611988, -0.4604578, -0.17446853, 0.32442594}),
+      torch::tensor({0.25619492, -0.13331234, 0.6690974, -0.42189372, 0.42605105, -0.5067104, 0.29095736}),
+      torch::tensor({0.2637839, 0.14009956, 0.28674796, 0.112167105, 0.074808404, -0.19848602, 0.2658297}),
+      torch::tensor({0.43283147, 0.06621471, 0.1302751, -0.09835881, -0.032653995, 0.28121483, -0.23636158}),
+      torch::tensor({0.15200303, 0.25980115, -0.1201024, 0.45759505, -0.56731343, -0.5342633, 0.37007877}),
+      torch::tensor({0.3649768, -0.14699024, -0.06368603, 0.22982533, 0.061746426, 0.06773164, 0.12537909}),
+      torch::tensor({-0.06686855, -0.058692306, -0.20148152, -0.09481507, 0.39024034, 0.14835536, -0.08856432}),
     },
     {
-      torch::tensor({-0.11110223, -0.08603837, -0.39927804, -0.0037998888, 0.3163225, 0.41147578, -0.4212508, 0.27163807, 0.16257726, 0.07001552, -0.17712006, -0.28190005, 0.43368816, -0.22742769, 0.14976384}),
-      torch::tensor({0.15162551, 0.022756116, -0.337443, -0.1823836, -0.04240044, -0.25083202, -0.26616275, 0.16712677, -0.3765372, 0.18503848, -0.51644665, -0.622171, 0.05665474, -0.4386439, 0.33809182}),
-      torch::tensor({-0.42894447, 0.44781545, -0.16271128, -0.16386595, 0.25165728, 0.054181106, 0.0077175284, 0.44132262, -0.18739006, -0.37522528, 0.15394184, -0.32285675, 0.2957909, 0.19089724, 0.32357433}),
-      torch::tensor({-0.11477537, 0.21132338, 0.0032186622, 0.09303321, -0.41689086, -0.6386192, 0.009335384, -0.088360295, -0.09855254, -0.014685968, -0.22642778, 0.17631726, 0.87642914, -0.4308766, 0.13190313}),
-      torch::tensor({-0.07384103, 0.086509995, 0.30259287, -0.10428588, 0.23001948, -0.12647822, -0.30277884, -0.17739438, -0.60285777, 0.024281243, -0.052177392, 0.807063, 0.5194553, -0.08695924, 0.084167756}),
-      torch::tensor({0.13818856, 0.50950116, -0.053579096, -0.007894313, 0.067052916, 0.0014321166, 0.20509668, 0.105126604, -0.093184546, 0.33830634, -0.24917552, 0.22737288, -0.2688545, -0.17480324, -0.106032155}),
-      torch::tensor({-0.4179092, 0.1311413, 0.5997842, 0.059327736, -0.13675568, 0.47349188, 0.0011002938, -0.32478496, -0.28000802, 0.19441846, 0.08356549, -0.07100728, 0.33710754,0.27447432, 0.070220366}),
-      torch::tensor({-0.23930988, -0.7056576, -0.14566903, -0.0707464, 0.03609119, 0.13131015, 0.085740715, -0.25335756, 0.22949918, 0.40511283, -0.021134255, -0.090214714, 0.052266303, -0.07446028, -0.0024477358}),
-      torch::tensor({0.6245137, 0.34285438, -0.068128414, 0.09410469, 0.6568622, -0.6944174, 0.63067895, 0.10417306, -0.25729227, 0.2526477, -0.1139792, -0.067401096, 0.20603673, -0.28586346, 0.601752}),
-      torch::tensor({-0.26997554, -0.12263605, -0.12787469, -0.05121646, 0.57187945, -0.03529285, -0.26288798, 0.046064075, 0.33631605, -0.1457349, -0.23712163, -0.19353649, -0.024511583, 0.28424242, 0.3383595}),
-      torch::tensor({-0.07561234, 0.10794748, -0.0437702, -0.56154686, 0.18596707, 0.07370188, 0.059135318, 0.33133864, -0.35610923, 0.36255547, -0.24472283, 0.052193344, -0.09056281, 0.14071976, 0.3979389}),
-      torch::tensor({0.15498109, -0.08727514, -0.1047872, 0.23060486, -0.37544468, 0.30660948, -0.07733662, 0.59290683, 0.08534651, 0.56152266, -0.058316797, 0.64462274, -0.1825164,0.29704455, -0.14194927}),
-      torch::tensor({0.21056584, 0.5165385, -0.11343903, -0.2790672, -0.12210965, 0.08408014, -0.25138792, 0.20601495, -0.14802553, 0.053201754, 0.055186458, 0.17179312, 0.18927598,-0.37573355, -0.5282227}),
-      torch::tensor({-0.045720562, 0.16112846, -0.43607467, 0.21109799, -0.008630521, 0.32987764, 0.13289018, 0.0899868, -0.2679775, -0.24753189, 0.23707163, 0.12620693, -0.6093915,0.25720116, 0.33193505}),
-      torch::tensor({-0.4173836, -0.19854523, -0.3151219, 0.14798103, 0.18053184, 0.07821397, 0.051448464, -0.024434408, 0.41581196, -0.031413753, -0.35996363, -0.23361506, -0.08951727, -0.052789558, 0.054483347}),
+      torch::tensor({0.5686917, -0.09445279, -0.008109969, -0.23638095, 0.18513173, 0.10785035, 0.19703159, 0.16283712, 0.06704266, -0.15356655, 0.012011396, 0.74455214, 0.32021716, 0.039456505, 0.29167756}),
+      torch::tensor({-0.11727544, -0.120536864, -0.24520315, 0.024819292, -0.22661427, -0.64093685, -0.57352954, 0.1371297, 0.16018651, -0.06438763, 0.15617928, 0.16395013, 0.03849636, -0.32419354, 0.54249305}),
+      torch::tensor({0.22737336, 0.10824946, 0.49498364, 0.3204376, -0.11382376, -0.46403745, -0.3401805, 0.0469655, 0.16256091, 0.05643296, -0.08347636, 0.3330794, -0.035863854, -0.18320066, 0.31872746}),
+      torch::tensor({-0.118183896, -0.39451256, 0.34899077, -0.15080865, -0.31977287, -0.03558636, -0.5396561, -0.023959527, -0.40960872, 0.22192033, -0.2206079, -0.1272819, 0.47694927, -0.5261017, -0.27987912}),
+      torch::tensor({-0.39171872, -0.12252503, -0.3440547, -0.080229685, -0.076014526, -0.105832845, 0.03241148, 0.20427565, 0.0016206406, 0.45144823, 0.15979332, -0.21185794, -0.059556045, 0.113005266, 0.07978509}),
+      torch::tensor({-0.20339356, 0.24515031, 0.035134725, -0.43726647, -0.26756722, -0.028679186, 0.3085605, -0.06856278, -0.09931894, 0.29273722, 0.15330525, 0.09415757, -0.18881987, 0.2951904, 0.47219887}),
+      torch::tensor({0.2365767, 0.21194734, -0.2263497, 0.13563108, 0.052972805, -0.16781373, 0.35543975, 0.19906428, 0.17790087, 0.084305175, -0.4724828, 0.23126647, -0.8092603, 0.17948656, -0.046811268}),
+      torch::tensor({0.6075029, 0.19878757, -0.36916938, -0.03143812, 0.45038128, -0.21490252, 0.032106392, 0.49374208, -0.33659473, -0.26203027, 0.22677982, 0.55793357, -0.24641389, -0.47635895, -0.25521356}),
+      torch::tensor({-0.062988885, -0.16126911, 0.26710683, 0.045221634, -0.18451777, 0.13013734, 0.09729627, -0.13646396, -0.30782598, 0.40900338, -0.26958758, 0.19394898, -0.28589258, 0.10188064, -0.21653901}),
+      torch::tensor({0.52622664, 0.48560932, 0.32724354, 0.14370431, -0.4509282, 0.09136506, 0.16234079, -0.015924046, 0.38828695, 0.07439342, 0.14474446, 0.05032819, -0.33968955, 0.24030806, 0.13954544}),
+      torch::tensor({0.18231039, 0.19792295, 0.3993777, 0.13390958, 0.32636762, -0.08910536, 0.5717662, -0.49086407, 0.12185809, 0.41345173, -0.11797148, 0.01602378, 0.26770872, 0.24160853, -0.0042542946}),
+      torch::tensor({-0.1547803, -0.3309117, -0.17253256, -0.40866295, 0.115447246, -0.1852874, 0.3124125, -0.12159007, 0.17372964, 0.16514419, -0.5042824, -0.021499014, 0.1614866, -0.031305145, -0.025453987}),
+      torch::tensor({-0.46667746, -0.19407623, -0.45694655, 0.4722757, -0.0065577123, -0.2605364, 0.080246896, 0.17149052, -0.051320944, -0.020609241, 0.13143182, 0.13777348, 0.17538032, -0.18979746, 0.1968781}),
+      torch::tensor({-0.22549178, 0.07228094, -0.13183941, -0.20852013, -0.22549984, -0.17717631, 0.1963955, -0.20556118, 0.0049765697, -0.21493103, -0.20958543, 0.26987603, 0.022059968, 0.9071231, -0.17530003}),
+      torch::tensor({-0.276162, 0.24218534, 0.27478874, 0.12620181, 0.014992369, 0.41604263, -0.29116297, 0.36701506, -0.42193863, -0.29316494, 0.3128194, -0.068356246, -0.36819, 0.37101352, 0.19197387}),
     },
     {
-      torch::tensor({0.41098386, 0.45162097, -0.11947367, 0.4141703, -0.2222035, 0.1805965, 0.3349034, -0.3735036, 0.13126858, -0.14054178, -0.25333884, 0.56775486, 0.17848605, -0.079786636, 0.24059108}),
-      torch::tensor({-0.19057135, -0.13091972, -0.015175606, 0.17821532, 0.26070553, -0.35303566, -0.42888534, -0.038996607, -0.21060736, 0.2925792, 0.053198263, 0.3793282, 0.3753942, 0.19560203, 0.2662913}),
+      torch::tensor({0.40467975, -0.2918865, -0.0068223607, -0.15962237, -0.098847054, -0.12212134, 0.11496088, -0.013517021, 0.17835663, 0.08698669, 0.6652159, 0.15418021, 0.19249022, 0.16726138, 0.40211704}),
+      torch::tensor({0.081645995, 0.16898154, 0.35514954, 0.3441116, 0.31108937, -0.59509027, 0.18418455, -0.11575492, 0.14021583, 0.32813665, -0.36015305, 1.2369571, 0.17215984, -0.07616362, 0.2482759}),
     },
   };
 }
@@ -95,42 +95,42 @@ inline std::vector<std::vector<torch::Tensor>> Xavier_Normal() {
 inline std::vector<std::vector<torch::Tensor>> Kaiming_Normal() {
   return {
     {
-      torch::tensor({-0.37498012, 0.5541324, -0.32267526, -0.6835287, 0.049683988, -0.35604528, 0.3250149}),
-      torch::tensor({-0.39021203, 0.7349887, 0.35258764, 0.2547305, -0.5432392, 0.0964102, 0.057905816}),
-      torch::tensor({-0.40347, 0.13059375, 0.6095431, -0.048043985, 0.3900925, -0.9863645, -0.01337372}),
-      torch::tensor({0.7319649, 1.4202386, 0.5265685, 0.2016122, 0.5886347, -0.61084044, 0.02009024}),
-      torch::tensor({1.4412204, 0.66054344, 0.29015473, 0.28090778, -0.44331524, -0.75221026, 0.8695861}),
-      torch::tensor({0.0920839, -0.8613843, -0.25627562, -0.076624356, -0.16960111, 0.30663127, 0.5334167}),
-      torch::tensor({0.29057145, 0.042122718, 0.46121812, -0.010417648, 0.52973694, -0.41571668, -0.16002773}),
-      torch::tensor({-0.1003716, 1.0240903, 0.36892492, -1.2410016, -0.6395081, 0.105315976, -0.6293102}),
-      torch::tensor({0.06069615, 0.5905007, -0.7457508, 0.25396162, -0.43495473, 0.4940251, -0.13220948}),
-      torch::tensor({-0.75655663, 0.52780706, -0.79526657, 0.31359762, 0.08461243, 0.058928896, -0.43767342}),
-      torch::tensor({0.3382277, -1.0246153, 0.7012358, -0.11216363, 0.41785294, 0.5290129, 0.22167361}),
-      torch::tensor({-0.8065682, 1.0883075, 0.070338055, -0.27318043, -0.91602606, -0.2726411, -0.25384104}),
-      torch::tensor({-0.33856857, -0.78452945, -0.46956995, -1.1109498, -0.5882311, 0.83987635, 0.10242246}),
-      torch::tensor({0.20308746, -0.07737589, 0.34082106, -0.15035595, -0.71084815, -0.3494706, -0.28551292}),
-      torch::tensor({-0.27975786, 0.4604934, -0.47410175, 0.4483439, 0.6162483, -0.9413465, -0.59173715}),
+      torch::tensor({0.7460684, 0.2701628, 0.18039969, -0.34241486, -0.7963988, 0.5251057, -0.35905766}),
+      torch::tensor({-0.5871404, 0.47977924, 0.17729704, 0.23947757, -0.12964198, -0.33418792, 0.36680558}),
+      torch::tensor({-0.45568657, 0.70145667, 0.34335494, -0.22801788, -0.8214001, 0.9318328, 0.13770834}),
+      torch::tensor({0.42663217, 0.81440276, -0.3627273, -0.5745073, -0.44825542, 0.14683764, 0.41021365}),
+      torch::tensor({0.28156358, 0.44548166, -0.08877027, 0.31564012, 0.054362286, 0.2709196, -0.08352435}),
+      torch::tensor({-0.33231056, 0.4015955, -0.26294684, -0.35562098, 0.2511247, 0.11805062, -0.88032234}),
+      torch::tensor({-0.13020484, -1.0339679, -0.0966588, 0.70191425, -0.14867353, -0.020903286, -0.5728927}),
+      torch::tensor({-0.346217, 0.30828333, 0.2595752, 0.22260213, -0.11111325, 0.48533586, 0.31469843}),
+      torch::tensor({-0.53340423, -0.25126055, 0.08239016, -0.64033705, -0.81630445, -0.30929965, 0.5751457}),
+      torch::tensor({0.45418504, -0.23633751, 1.1861829, -0.7479376, 0.7553078, -0.8983015, 0.5158123}),
+      torch::tensor({0.46763888, 0.24836995, 0.50834984, 0.19885102, 0.13262112, -0.35187808, 0.4712657}),
+      torch::tensor({0.7673282, 0.11738613, 0.23095307, -0.17437153, -0.057889342, 0.49854058, -0.4190243}),
+      torch::tensor({0.26947257, 0.4605782, -0.21291879, 0.8112293, -1.0057392, -0.94714755, 0.65607953}),
+      torch::tensor({0.6470347, -0.26058584, -0.11290326, 0.40743676, 0.10946471, 0.12007537, 0.22227335}),
+      torch::tensor({-0.118545264, -0.10405033, -0.35718855, -0.16808915, 0.6918222, 0.26300594, -0.15700775}),
     },
     {
-      torch::tensor({-0.15712228, -0.12167663, -0.5646644, -0.005373854, 0.44734758, 0.58191466, -0.59573853, 0.38415426, 0.22991896, 0.0990169, -0.2504856, -0.3986669, 0.6133277, -0.3216313, 0.21179804}),
-      torch::tensor({0.21443085, 0.032182008, -0.47721645, -0.25792935, -0.059963275, -0.35473004, -0.376411, 0.23635295, -0.532504, 0.26168394, -0.7303659, -0.8798827, 0.0801219, -0.6203361, 0.47813404}),
-      torch::tensor({-0.60661906, 0.6333067, -0.2301085, -0.23174146, 0.35589716, 0.076623656, 0.0109142335, 0.6241244, -0.26500958, -0.53064865, 0.21770664, -0.45658842, 0.4183115,0.26996946, 0.45760322}),
-      torch::tensor({-0.16231689, 0.29885638, 0.004551876, 0.13156882, -0.5895727, -0.9031439, 0.013202227, -0.124960326, -0.13937433, -0.020769095, -0.32021725, 0.24935026, 1.239458, -0.6093515, 0.18653919}),
-      torch::tensor({-0.10442699, 0.12234361, 0.42793095, -0.14748251, 0.32529667, -0.17886722, -0.42819393, -0.25087354, -0.85256964, 0.03433886, -0.07378998, 1.1413594, 0.73462075, -0.12297893, 0.11903118}),
-      torch::tensor({0.19542812, 0.72054344, -0.075772285, -0.011164244, 0.09482714, 0.0020253188, 0.2900505, 0.14867148, -0.13178284, 0.4784374, -0.3523874, 0.32155383, -0.3802177,-0.24720912, -0.14995211}),
-      torch::tensor({-0.5910129, 0.18546182, 0.8482229, 0.08390209, -0.19340174, 0.6696186, 0.0015560504, -0.4593153, -0.39599115, 0.27494922, 0.11817944, -0.10041946, 0.47674203, 0.38816532, 0.0993066}),
-      torch::tensor({-0.33843526, -0.9979506, -0.20600711, -0.10005052, 0.05104065, 0.1857006, 0.12125569, -0.3583017, 0.32456085, 0.57291603, -0.02988835, -0.12758288, 0.07391571, -0.105302736, -0.003461621}),
-      torch::tensor({0.88319576, 0.4848693, -0.09634813, 0.13308413, 0.9289434, -0.98205453, 0.8919147, 0.14732295, -0.3638662, 0.35729778, -0.16119093, -0.09531955, 0.29137993, -0.404272, 0.8510058}),
-      torch::tensor({-0.38180307, -0.17343357, -0.1808421, -0.07243101, 0.8087596, -0.049911626, -0.37177977, 0.06514444, 0.4756227, -0.20610029, -0.33534062, -0.27370194, -0.034664612, 0.4019795, 0.4785126}),
-      torch::tensor({-0.106931984, 0.15266079, -0.06190041, -0.7941472, 0.26299715, 0.1042302, 0.083629966, 0.46858358, -0.5036145, 0.5127309, -0.34609035, 0.07381254, -0.12807515, 0.19900778, 0.5627706}),
-      torch::tensor({0.21917637, -0.123425685, -0.14819148, 0.32612452, -0.53095895, 0.4336113, -0.10937049, 0.83849686, 0.1206982, 0.794113, -0.08247241, 0.91163427, -0.25811717, 0.42008442, -0.20074657}),
-      torch::tensor({0.29778504, 0.73049575, -0.16042702, -0.3946606, -0.17268912, 0.11890727, -0.35551623, 0.2913491, -0.20933971, 0.07523864, 0.078045435, 0.24295215, 0.26767665, -0.5313675, -0.74701965}),
-      torch::tensor({-0.06465864, 0.22787006, -0.61670274, 0.2985376, -0.0122054, 0.46651745, 0.1879351, 0.12726055, -0.37897742, -0.35006294, 0.33526993, 0.17848356, -0.86180973, 0.3637374, 0.46942705}),
-      torch::tensor({-0.59026957, -0.28078535, -0.44564965, 0.2092768, 0.25531057, 0.110611245, 0.072759114, -0.034555472, 0.5880469, -0.044425756, -0.50906545, -0.33038157, -0.12659654, -0.07465571, 0.07705109}),
+      torch::tensor({0.8042515, -0.13357642, -0.011469227, -0.33429316, 0.2618158, 0.15252343, 0.27864474, 0.23028646, 0.09481264, -0.2171759, 0.016986677, 1.0529557, 0.45285544, 0.055799924, 0.4124944}),
+      torch::tensor({-0.16585252, -0.17046486, -0.34676963, 0.035099782, -0.32048097, -0.90642154, -0.8110932, 0.19393069, 0.22653794, -0.09105786, 0.22087085, 0.2318605, 0.054442074, -0.4584789, 0.767201}),
+      torch::tensor({0.32155448, 0.15308785, 0.70001256, 0.4531672, -0.1609711, -0.6562481, -0.48108783, 0.066419244, 0.22989585, 0.07980826, -0.11805339, 0.47104537, -0.05071915, -0.25908485, 0.45074868}),
+      torch::tensor({-0.16713727, -0.55792505, 0.49354747, -0.21327563, -0.45222712, -0.050326712, -0.76318896, -0.03388389, -0.57927424, 0.31384274, -0.31198668, -0.1800038, 0.6745081, -0.74402016, -0.39580885}),
+      torch::tensor({-0.5539739, -0.17327656, -0.4865668, -0.113461904, -0.10750077, -0.14967024, 0.04583675, 0.2888894, 0.002291932, 0.6384442, 0.22598188, -0.29961237, -0.08422497, 0.15981358, 0.11283316}),
+      torch::tensor({-0.2876419, 0.3466949, 0.049688008, -0.6183882, -0.37839717, -0.040558495, 0.43637043, -0.096962415, -0.1404582, 0.41399294, 0.21680637, 0.1331589, -0.26703164, 0.41746226, 0.66779006}),
+      torch::tensor({0.33457, 0.2997388, -0.3201068, 0.19181131, 0.07491486, -0.23732445, 0.5026677, 0.2815194, 0.2515898, 0.119225524, -0.66819155, 0.3270602, -1.1444669, 0.25383234, -0.066201136}),
+      torch::tensor({0.8591388, 0.28112808, -0.52208436, -0.044460215, 0.6369353, -0.30391806, 0.0454053, 0.69825673, -0.47601685, -0.3705668, 0.3207151, 0.7890372, -0.34848186, -0.6736733, -0.36092645}),
+      torch::tensor({-0.08907974, -0.22806896, 0.3777461, 0.06395304, -0.26094753, 0.18404198, 0.1375977, -0.19298917, -0.4353317, 0.57841814, -0.38125437, 0.2742853, -0.40431318, 0.14408098, -0.30623242}),
+      torch::tensor({0.7441969, 0.6867553, 0.46279222, 0.20322858, -0.6377088, 0.12920971, 0.22958454, -0.02252, 0.54912066, 0.10520818, 0.20469958, 0.07117481, -0.48039356, 0.3398469, 0.19734706}),
+      torch::tensor({0.25782582, 0.27990532, 0.5648054, 0.18937676, 0.4615535, -0.12601401, 0.80859953, -0.6941866, 0.17233336, 0.58470905, -0.16683686, 0.022661045, 0.3785973, 0.34168607, -0.0060164807}),
+      torch::tensor({-0.21889238, -0.4679798, -0.24399789, -0.5779367, 0.16326706, -0.26203594, 0.441818, -0.17195433, 0.24569082, 0.23354915, -0.713163, -0.030404195, 0.22837652, -0.04427216, -0.035997372}),
+      torch::tensor({-0.6599816, -0.27446523, -0.64622, 0.6678987, -0.009274006, -0.3684541, 0.113486245, 0.2425242, -0.07257877, -0.029145868, 0.18587266, 0.19484113, 0.24802522, -0.26841414, 0.2784277}),
+      torch::tensor({-0.31889352, 0.10222069, -0.18644908, -0.294892, -0.31890494, -0.25056514, 0.2777452, -0.2907074, 0.007037932, -0.30395836, -0.29639855, 0.38166234, 0.031197505, 1.2828658, -0.24791168}),
+      torch::tensor({-0.390552, 0.3425018, 0.38860998, 0.17847632, 0.021202412, 0.5883731, -0.41176662, 0.51903766, -0.59671134, -0.41459784, 0.44239342, -0.09667033, -0.52069926, 0.52469236, 0.27149206}),
     },
     {
-      torch::tensor({0.43752572, 0.48078725, -0.12718944, 0.44091794, -0.23655368, 0.19225967, 0.35653186, -0.39762494, 0.13974607, -0.14961815, -0.26969978, 0.6044212, 0.19001292, -0.08493936, 0.25612876}),
-      torch::tensor({-0.20287868, -0.13937469, -0.016155666, 0.1897247, 0.27754223, -0.37583515, -0.45658332, -0.041515056, -0.22420865, 0.31147435, 0.056633875, 0.4038257, 0.39963764, 0.20823427, 0.28348872}),
+      torch::tensor({0.4308145, -0.31073692, -0.0072629577, -0.169931, -0.10523073, -0.1300081, 0.1223852, -0.014389968, 0.18987514, 0.0926044, 0.70817643, 0.16413736, 0.20492148, 0.17806335, 0.42808628}),
+      torch::tensor({0.0869188, 0.17989458, 0.37808555, 0.36633474, 0.33117992, -0.633522, 0.19607943, -0.123230524, 0.14927115, 0.34932816, -0.3834122, 1.3168414, 0.18327813, -0.08108237, 0.26430988}),
     },
   };
 }
@@ -138,44 +138,44 @@ inline std::vector<std::vector<torch::Tensor>> Kaiming_Normal() {
 inline std::vector<std::vector<torch::Tensor>> Kaiming_Uniform() {
   return {
     {
-      torch::tensor({0.36331797, 0.055456758, -0.45173424, 0.43808794, -0.8880919, -0.5487398, -0.23176038}),
-      torch::tensor({-0.45097935, -0.32388276, -0.7588222, -0.19693595, 0.19790006, -0.6031401, -0.04751247}),
-      torch::tensor({0.66274905, -0.09517455, 0.02573061, -0.07986951, 0.18736875, 0.588673, 0.8769796}),
-      torch::tensor({0.5879475, 0.8789861, -0.06695682, -0.8316841, -0.43891022, 0.63039577, -0.0060015917}),
-      torch::tensor({-0.4601755, -0.7094668, -0.86643064, -0.7813998, -0.18779033, 0.50772536, 0.5005363}),
-      torch::tensor({-0.89289045, 0.57751, -0.724463, -0.19572788, -0.3753947, -0.17832708, -0.18177801}),
-      torch::tensor({-0.8307846, -0.7993882, -0.14487183, 0.011972845, -0.4205768, 0.34875572, -0.8332921}),
-      torch::tensor({-0.062481046, 0.8141842, -0.37763458, 0.83601844, 0.33528924, -0.83551645, 0.58576393}),
-      torch::tensor({-0.10683453, -0.4132924, 0.7403351, -0.7481508, 0.09934509, -0.19383776, 0.66113985}),
-      torch::tensor({0.25843763, 0.44486153, 0.32696164, -0.22263634, -0.19470501, -0.76295114, 0.5016502}),
-      torch::tensor({0.73508084, 0.6334691, -0.6530534, 0.041291475, -0.6526422, -0.50964934, -0.53948045}),
-      torch::tensor({0.31639445, -0.5517084, -0.020198822, 0.038947523, 0.596805, -0.69984597, -0.63558686}),
-      torch::tensor({-0.5375881, 0.6480124, -0.3327999, 0.78091884, 0.33478355, 0.11723292, -0.0068918467}),
-      torch::tensor({-0.18301755, 0.11615932, -0.21140611, -0.0065051913, 0.11812818, -0.72418123, -0.4852514}),
-      torch::tensor({0.74759305, -0.75134623, -0.06647962, 0.9158571, 0.33444047, 0.026212811, -0.8023249}),
+      torch::tensor({0.45854592, -0.61656976, -0.6562879, -0.5386239, 0.42389798, 0.022720456, -0.10161924}),
+      torch::tensor({0.49767148, -0.7574025, -0.7546705, -0.6531707, 0.10666072, 0.117085814, -0.7461302}),
+      torch::tensor({0.2662437, -0.2575305, 0.08033359, -0.26358467, 0.37831426, 0.62400985, -0.6333426}),
+      torch::tensor({-0.025648355, 0.3537016, -0.3096755, 0.62166095, 0.32423532, -0.052130997, -0.803611}),
+      torch::tensor({-0.59696126, -0.6879966, 0.8938241, -0.2110321, -0.8718874, 0.50626767, -0.84988046}),
+      torch::tensor({0.6908009, -0.4478466, 0.23309457, -0.50189334, -0.7310757, -0.5900872, 0.5508927}),
+      torch::tensor({0.2948246, 0.37126887, 0.85621417, -0.35728097, 0.11669552, 0.9013462, 0.29213238}),
+      torch::tensor({-0.41841507, -0.6235911, 0.1228174, 0.3968172, -0.60690933, 0.2385509, -0.15937883}),
+      torch::tensor({0.22094047, 0.18500745, -0.8488594, 0.57640684, 0.541365, 0.36127353, -0.6694672}),
+      torch::tensor({-0.6414778, -0.1425035, 0.77854145, 0.25124776, 0.37644148, 0.61999524, 0.5110059}),
+      torch::tensor({-0.30694163, -0.5882094, -0.33466214, -0.8768723, -0.051716983, 0.79733896, -0.14238262}),
+      torch::tensor({-0.6373229, -0.85334295, -0.70506865, 0.6268115, 0.5428114, 0.36150837, 0.27129138}),
+      torch::tensor({-0.52214766, -0.32341683, -0.35337156, 0.3526429, 0.41231918, 0.44492054, -0.6544026}),
+      torch::tensor({-0.2935499, 0.6993054, 0.85497665, -0.32099867, -0.8862933, -0.8034513, -0.5994549}),
+      torch::tensor({-0.64259565, 0.120954156, -0.06996477, -0.49423268, 0.22572732, -0.1703211, 0.65531504}),
     },
     {
-      torch::tensor({0.33950645, 0.08810693, -0.42316547, -0.49035522, -0.19512305, 0.2776215, 0.62385184, 0.3636803, -0.07122034, 0.2217493, -0.62047863, -0.5401811, 0.29510874, -0.3582324, 0.30427164}),
-      torch::tensor({-0.44647068, -0.3132621, -0.5209466, 0.33004105, -0.064444125, 0.4867385, 0.3914091, 0.34996456, 0.020337284, -0.19554132, -0.13751587, 0.084053695, 0.31351423,-0.44309196, 0.5308059}),
-      torch::tensor({-0.06876695, -0.5299633, -0.342195, 0.5596078, 0.5783978, -0.5858307, 0.44606978, 0.31696087, 0.37436205, 0.5353921, -0.34086213, 0.19971412, 0.2588218, -0.1868864, 0.21165323}),
-      torch::tensor({-0.18196595, 0.39102274, -0.17547771, -0.2357767, 0.1592201, 0.22432798, -0.30899984, 0.055908024, 0.3665306, -0.062927246, 0.1924777, -0.15254003, 0.22167546, -0.4581471, -0.37190205}),
-      torch::tensor({-0.32102844, 0.58123356, -0.17018372, -0.0017268658, -0.30642188, 0.63137406, 0.6177004, -0.4769895, -0.51271266, -0.47939685, -0.0030501485, -0.1612154, -0.413971, -0.22684419, 0.119490385}),
-      torch::tensor({-0.33045214, 0.14014107, -0.14503211, -0.30646476, 0.08689022, 0.52004176, -0.42759007, 0.029367685, -0.23322919, 0.6206326, -0.60005057, -0.60631055, 0.62321216, -0.40014827, 0.12125647}),
-      torch::tensor({-0.05458474, -0.1332312, -0.14125755, 0.40188795, 0.03022945, -0.6157679, -0.37337655, -0.21560428, 0.31826198, -0.40928328, 0.59635466, -0.1408664, -0.11356497, 0.4955656, 0.317877}),
-      torch::tensor({0.53639835, 0.36584032, -0.19185784, -0.4196168, -0.047056615, 0.523444, -0.2122646, -0.58652025, 0.2592615, 0.6156774, -0.18004948, -0.5236881, -0.5736749, 0.15849298, -0.04788935}),
-      torch::tensor({-0.31938198, 0.12783945, 0.24018055, 0.5030039, 0.49102718, -0.09466827, -0.5576785, -0.57150143, 0.5905171, 0.2795803, 0.27569205, -0.5472138, 0.58566374, 0.5991524, 0.571019}),
-      torch::tensor({-0.53353, -0.23864025, -0.43498003, 0.5989136, -0.2717535, -0.28875044, 0.33135164, -0.2925691, -0.31149834, -0.055321813, -0.060791314, -0.49266922, 0.527258, -0.27898985, 0.22434139}),
-      torch::tensor({0.55009943, 0.31895775, 0.089542985, 0.53812927, 0.085018635, -0.29260972, 0.59830266, 0.14968991, -0.6170747, -0.18005475, -0.43080813, 0.5545073, -0.104447424, -0.576499, -0.039758265}),
-      torch::tensor({0.39719027, 0.16431224, 0.19998527, 0.058738172, 0.23579127, -0.15409905, -0.25159094, -0.59116155, -0.4764521, 0.2741078, -0.37448537, 0.09073615, 0.20187438, 0.044780314, -0.4100524}),
-      torch::tensor({0.6048352, -0.36777255, 0.52019507, -0.5031236, -0.15213624, 0.34403604, -0.25840908, 0.53128976, -0.43522838, -0.53111815, -0.28518632, 0.10223669, 0.5823371, -0.30193484, 0.22618395}),
-      torch::tensor({-0.15856105, -0.13715577, 0.4650467, -0.49014413, 0.06717521, 0.59476703, -0.08690709, 0.49106258, -0.194769, 0.50910276, -0.6117934, -0.09115183, -0.111088574,0.20496935, 0.24812967}),
-      torch::tensor({0.48561007, -0.094227016, -0.025080085, 0.43311268, -0.17112547, 0.55443174, -0.42109656, -0.068437934, -0.03396976, 0.2822079, 0.4323948, -0.10024661, -0.52397716, 0.31337678, 0.18918753}),
+      torch::tensor({0.5243109, -0.35880458, -0.63046443, 0.6194418, 0.17910695, -0.5133271, 0.13299543, -0.3027218, -0.60883147, 0.20521754, -0.19666976, -0.25433975, -0.42175686, -0.56184965, -0.43583032}),
+      torch::tensor({0.5068025, -0.4671374, -0.03862089, -0.3967472, -0.21860829, 0.6060521, 0.6206508, -0.11299068, -0.3232259, 0.09876835, -0.114174426, -0.3464741, -0.033875525, 0.094273925, -0.15251675}),
+      torch::tensor({-0.42548212, -0.5128171, 0.44133037, 0.37762696, -0.50430924, 0.43685824, 0.38457865, -0.48796362, 0.30958205, 0.13703215, 0.598821, -0.47044784, 0.06144905, 0.07569772, -0.15156165}),
+      torch::tensor({0.39237732, 0.3949135, -0.34850198, -0.31206515, 0.52578527, 0.4752763, 0.55332893, 0.2339884, 0.31133407, 0.27264053, -0.20425001, 0.14112276, -0.19732592, 0.30263102, 0.09631723}),
+      torch::tensor({0.30392945, 0.05851388, 0.43155462, 0.07022041, -0.54701227, -0.42431855, -0.56402045, -0.045801222, -0.17347485, 0.36068517, 0.38350898, 0.10440761, 0.1337927, -0.16470969, -0.3939098}),
+      torch::tensor({0.47477716, -0.31755862, -0.6168192, 0.38676125, 0.18140244, -0.02151221, 0.51612943, -0.17004833, -0.20625249, 0.17950296, -0.29136693, -0.5264355, -0.15134072, -0.29673004, -0.43274993}),
+      torch::tensor({-0.25943953, -0.22800767, 0.49994963, -0.48664084, -0.529288, 0.1462698, 0.15004683, 0.57345134, -0.109298706, 0.2009387, 0.39711243, 0.44746572, 0.6258717, -0.35330185, 0.6060938}),
+      torch::tensor({-0.37997484, -0.4631904, 0.3614263, 0.013375521, -0.4117288, 0.052254498, -0.596821, 0.43517226, 0.18749791, 0.18983519, -0.21454507, 0.5375642, -0.074056745, 0.41761976, -0.04245788}),
+      torch::tensor({0.6069105, 0.08994919, -0.16004527, -0.59283113, 0.5681562, -0.09781855, -0.04056108, 0.0988515, 0.52645355, 0.47088104, 0.004296005, 0.4248554, -0.011185408, -0.32784915, -0.25573537}),
+      torch::tensor({0.5812858, -0.20248955, -0.4966066, -0.09859264, 0.3980009, -0.062271416, -0.4290552, 0.014778018, -0.5044799, 0.26559556, -0.31249875, 0.07415831, 0.1308614, 0.56180304, 0.45305818}),
+      torch::tensor({-0.24947083, 0.37083668, -0.3533028, -0.4821655, -0.34702963, 0.051644683, -0.39632672, 0.37198812, -0.51383793, -0.4061097, 0.30680102, -0.50992656, 0.06124276, 0.23979902, -0.49954334}),
+      torch::tensor({-0.21033216, 0.17897904, 0.4822138, 0.2596504, -0.34399265, 0.5105743, -0.44875205, 0.30918676, -0.16971356, -0.093188345, 0.24986345, -0.6276717, 0.0072511435, -0.5639899, -0.3771655}),
+      torch::tensor({0.39029664, -0.31813148, 0.40034848, 0.42652005, 0.059601724, 0.42793208, -0.24134761, -0.2865633, 0.022050321, 0.02129829, -0.056382954, -0.5753126, -0.16118795, -0.090465546, -0.056470633}),
+      torch::tensor({-0.23124173, -0.22769547, -0.16621578, 0.103764474, -0.22823152, 0.473316, -0.161553, 0.46999866, -0.004442334, 0.3815382, 0.20318723, -0.18379328, -0.019631743, 0.6310571, 0.26667595}),
+      torch::tensor({0.44462794, 0.20482421, 0.28780836, -0.45137954, 0.17561132, 0.509455, 0.5699292, -0.2265214, 0.19955707, 0.4552285, -0.46133035, 0.53252095, 0.3244207, -0.48584688, -0.13454282}),
     },
     {
-      torch::tensor({-0.10132998, -0.37424773, -0.3613546, 0.15002292, 0.59365314, -0.5066626, 0.38276488, -0.32790715, -0.12318605, 0.5020248, -0.14304265, 0.057588696, -0.442107, 0.538372, -0.081757426}),
-      torch::tensor({-0.46257195, 0.18518949, -0.44968688, -0.5018581, 0.03852868, 0.5014383, -0.1789748, 0.29767585, 0.5434825, 0.419483, -0.33176154, -0.06932968, -0.19902417, -0.508572, 0.00026130676}),
+      torch::tensor({0.081554234, -0.22033015, 0.43961138, -0.3935629, -0.4042035, -0.42167825, 0.030988216, -0.59616804, -0.54888433, -0.058308423, -0.31416315, -0.15462288, -0.22072253, -0.18926573, -0.3722867}),
+      torch::tensor({-0.2831981, -0.07649535, 0.20603287, 0.631309, -0.10668701, 0.35847956, -0.21024057, -0.09171951, -0.47226098, -0.41196483, 0.47293347, -0.37085137, -0.5306985, 0.02562654, -0.44472176}),
     },
   };
 }
 
-} // namespace expected_parameters
\ No newline at end of file
+} // namespace expected_parameters
@@ -1,10 +1,15 @@
 #include <gtest/gtest.h>
 
 #include <torch/nn/init.h>
+#include <torch/nn/modules/conv.h>
 #include <torch/nn/modules/linear.h>
 #include <torch/types.h>
 #include <torch/utils.h>
 
+#include <torch/csrc/autograd/saved_tensor_codecs.h>
+#include <torch/csrc/autograd/saved_tensor_offload.h>
+#include <torch/csrc/autograd/variable.h>
+
 #include <test/cpp/api/support.h>
 
 TEST(NoGradTest, SetsGradModeCorrectly) {
@@ -19,6 +24,71 @@ TEST(NoGradTest, SetsGradModeCorrectly) {
   ASSERT_FALSE(model->weight.grad().defined());
 }
 
+TEST(InferenceModeTest, CreatesPlainTensors) {
+  torch::InferenceModeGuard guard;
+  ASSERT_FALSE(torch::autograd::GradMode::is_enabled());
+  auto x = torch::ones({2, 3});
+  ASSERT_FALSE(x.is_variable());
+  auto y = torch::tensor({1.0f, 2.0f, 3.0f});
+  ASSERT_FALSE(y.is_variable());
+  auto z = x * y + 1;
+  ASSERT_FALSE(z.is_variable());
+  ASSERT_TRUE(z.allclose(torch::tensor({2.0f, 3.0f, 4.0f}).expand({2, 3})));
+}
+
+TEST(InferenceModeTest, RestoresModes) {
+  {
+    torch::InferenceModeGuard guard;
+    ASSERT_TRUE(at::InferenceMode::is_enabled());
+    {
+      torch::AutoInferenceMode disabled(false);
+      ASSERT_FALSE(at::InferenceMode::is_enabled());
+      ASSERT_TRUE(torch::ones({1}).is_variable());
+    }
+    ASSERT_TRUE(at::InferenceMode::is_enabled());
+  }
+  ASSERT_FALSE(at::InferenceMode::is_enabled());
+  ASSERT_TRUE(torch::autograd::GradMode::is_enabled());
+  ASSERT_TRUE(torch::ones({1}).is_variable());
+}
+
+TEST(InferenceModeTest, MixesWithParameters) {
+  torch::manual_seed(0);
+  torch::nn::Linear linear(5, 2);
+  torch::nn::Conv2d conv(torch::nn::Conv2dOptions(3, 4, 3));
+  auto x = torch::randn({2, 5});
+  auto image = torch::randn({1, 3, 8, 8});
+  torch::Tensor expected_linear, expected_conv;
+  {
+    torch::NoGradGuard guard;
+    expected_linear = linear->forward(x);
+    expected_conv = conv->forward(image);
+  }
+
+  using torch::autograd::as_variable_ref;
+  torch::InferenceModeGuard guard;
+  auto output = linear->forward(as_variable_ref(x).data()).relu_();
+  ASSERT_FALSE(output.is_variable());
+  ASSERT_TRUE(output.allclose(as_variable_ref(expected_linear).data().relu()));
+  output = conv->forward(as_variable_ref(image).data());
+  ASSERT_FALSE(output.is_variable());
+  ASSERT_TRUE(output.allclose(as_variable_ref(expected_conv).data()));
+  // Variables are unwrapped too.
+  ASSERT_FALSE(linear->forward(x).is_variable());
+}
+
+TEST(InferenceModeTest, SkipsVersionCounter) {
+  auto x = torch::ones({3});
+  const auto version = torch::autograd::as_variable_ref(x).current_version();
+  {
+    torch::InferenceModeGuard guard;
+    x.add_(1);
+    x.copy_(torch::ones({3}) * 3);
+  }
+  ASSERT_EQ(torch::autograd::as_variable_ref(x).current_version(), version);
+  ASSERT_TRUE(x.allclose(torch::full({3}, 3)));
+}
+
 struct AutogradTest : torch::test::SeedingFixture {
   AutogradTest() {
     x = torch::randn({3, 3}, torch::requires_grad());
@@ -41,4 +111,131 @@ TEST_F(AutogradTest, CanTakeDerivativesOfZeroDimTensors) {
 TEST_F(AutogradTest, CanPassCustomGradientInputs) {
   z.sum().backward(torch::ones({}) * 2);
   ASSERT_TRUE(x.grad().allclose(y * 2));
-}
\ No newline at end of file
+}
+
+struct SavedTensorCodecTest : torch::test::SeedingFixture {
+  ~SavedTensorCodecTest() {
+    torch::autograd::clear_saved_tensor_codecs();
+  }
+};
+
+TEST_F(SavedTensorCodecTest, BitMaskCodecIsExactForRelu) {
+  torch::autograd::set_saved_tensor_codec(
+      "ReluBackward0", torch::autograd::make_bit_mask_codec(/*sign_only=*/true));
+  auto x = torch::randn({37, 11}, torch::requires_grad());
+  torch::relu(x).sum().backward();
+  ASSERT_TRUE(x.grad().equal(x.gt(0).to(torch::kFloat)));
+}
+
+TEST_F(SavedTensorCodecTest, CodecsApplyPerFunction) {
+  torch::autograd::set_saved_tensor_codec(
+      "MulBackward0", torch::autograd::make_half_codec());
+  auto x = torch::randn({100}, torch::requires_grad());
+  auto y = torch::randn({100}, torch::requires_grad());
+  (x * y).sum().backward();
+  // The saved factors were rounded to half precision.
+  ASSERT_TRUE(x.grad().allclose(y, /*rtol=*/1e-3, /*atol=*/1e-3));
+  ASSERT_FALSE(x.grad().equal(y));
+
+  // Other functions still save their inputs exactly.
+  x.grad().zero_();
+  (x.div(y.reciprocal())).sum().backward();
+  ASSERT_TRUE(x.grad().allclose(y));
+}
+
+TEST_F(SavedTensorCodecTest, LossyCodecsRoundTrip) {
+  const auto x = torch::randn({8, 16, 5, 5});
+  auto bf16 = torch::autograd::make_bfloat16_codec()->pack(x);
+  ASSERT_EQ(bf16->nbytes(), x.nbytes() / 2);
+  ASSERT_TRUE(bf16->unpack().allclose(x, /*rtol=*/1e-2, /*atol=*/1e-2));
+
+  auto int8 = torch::autograd::make_int8_codec(/*dim=*/1)->pack(x);
+  ASSERT_EQ(int8->nbytes(), x.numel() + 16 * 4);
+  const auto scale = std::get<0>(
+      x.abs().transpose(0, 1).reshape({16, -1}).max(1)).div(127);
+  const auto error = (int8->unpack() - x).abs().transpose(0, 1).reshape({16, -1});
+  ASSERT_TRUE(std::get<0>(error.max(1)).le(scale * 0.5 + 1e-6).all().item<uint8_t>());
+
+  auto sign = torch::autograd::make_bit_mask_codec(/*sign_only=*/true)->pack(x);
+  ASSERT_EQ(sign->nbytes(), (x.numel() + 7) / 8);
+  ASSERT_TRUE(sign->unpack().equal(x.gt(0).to(torch::kFloat)));
+}
+
+TEST_F(SavedTensorCodecTest, BitMaskCodecOnlyPacksMasks) {
+  const auto codec = torch::autograd::make_bit_mask_codec();
+  const auto mask = torch::randn({3, 7}).gt(0);
+  auto packed = codec->pack(mask);
+  ASSERT_NE(packed, nullptr);
+  ASSERT_TRUE(packed->unpack().equal(mask));
+
+  ASSERT_EQ(codec->pack(torch::randn({3, 7})), nullptr);
+  ASSERT_EQ(codec->pack(torch::ones({3}, torch::kLong)), nullptr);
+  ASSERT_EQ(codec->pack(mask.mul(2)), nullptr);
+}
+
+TEST_F(SavedTensorCodecTest, IgnoresUnsupportedTensors) {
+  ASSERT_EQ(
+      torch::autograd::make_half_codec()->pack(torch::ones({3}, torch::kLong)),
+      nullptr);
+  ASSERT_EQ(torch::autograd::make_int8_codec()->pack(torch::empty({0})), nullptr);
+}
+
+TEST_F(SavedTensorCodecTest, OffloadsToFilesAndPrefetches) {
+  torch::autograd::reset_offload_stats();
+  torch::autograd::OffloadOptions options;
+  options.min_bytes = 1024;
+  torch::autograd::set_default_saved_tensor_codec(
+      torch::autograd::make_offload_codec(options));
+  auto x = torch::randn({64, 64}, torch::requires_grad());
+  auto w = torch::randn({64, 64}, torch::requires_grad());
+  auto y = torch::relu(x.mm(w)).mul(x).sum();
+  torch::autograd::clear_saved_tensor_codecs();
+
+  auto x2 = x.detach().requires_grad_();
+  auto w2 = w.detach().requires_grad_();
+  torch::relu(x2.mm(w2)).mul(x2).sum().backward();
+  y.backward();
+  ASSERT_TRUE(x.grad().equal(x2.grad()));
+  ASSERT_TRUE(w.grad().equal(w2.grad()));
+
+  const auto stats = torch::autograd::offload_stats();
+  ASSERT_EQ(
+      stats.prefetch_hits + stats.prefetch_misses,
+      /*mm=*/2 + /*relu=*/1 + /*mul=*/2);
+  ASSERT_EQ(stats.bytes_stored, stats.bytes_offloaded);
+}
+
+TEST_F(SavedTensorCodecTest, OffloadsToCompressedMemory) {
+  torch::autograd::reset_offload_stats();
+  torch::autograd::OffloadOptions options;
+  options.tier = torch::autograd::OffloadOptions::Tier::CompressedMemory;
+  options.min_bytes = 1024;
+  torch::autograd::set_saved_tensor_codec(
+      "MulBackward0", torch::autograd::make_offload_codec(options));
+  auto x = torch::randn({1000}, torch::requires_grad());
+  auto y = torch::relu(x);
+  auto z = y.mul(y).sum();
+  torch::autograd::wait_for_offloaded_writes();
+  ASSERT_EQ(torch::autograd::offload_stats().tensors_offloaded, 2);
+  z.backward();
+  ASSERT_TRUE(x.grad().equal(y * 2));
+
+  // About half of the output of ReLU is zero, which the compressed tier
+  // elides.
+  const auto stats = torch::autograd::offload_stats();
+  ASSERT_EQ(stats.tensors_loaded, 2);
+  ASSERT_LT(stats.bytes_stored, stats.bytes_offloaded * 3 / 4);
+}
+
+TEST_F(SavedTensorCodecTest, OffloadErrorsAreRaisedByBackward) {
+  torch::autograd::OffloadOptions options;
+  options.directory = "/nonexistent/torch_offload";
+  options.min_bytes = 1024;
+  torch::autograd::set_saved_tensor_codec(
+      "MulBackward0", torch::autograd::make_offload_codec(options));
+  auto x = torch::randn({1000}, torch::requires_grad());
+  auto y = x.mul(x).sum();
+  // The I/O thread survives the failed writes, and backward reports them.
+  torch::autograd::wait_for_offloaded_writes();
+  ASSERT_THROWS_WITH(y.backward(), "unable to open file");
+}
@@ -135,6 +135,51 @@ void check_exact_values(
   }
 }
 
+template <typename OptimizerClass, typename Options>
+void check_fused_matches_unfused(Options options) {
+  const size_t kIterations = 10;
+
+  torch::manual_seed(0);
+  // The first layer has more elements than a single chunk of the fused
+  // kernels, so that a parameter is split across several tasks.
+  Sequential fused_model(
+      Linear(200, 100),
+      Functional(torch::sigmoid),
+      Linear(100, 3),
+      Functional(torch::sigmoid));
+  Sequential unfused_model(
+      Linear(200, 100),
+      Functional(torch::sigmoid),
+      Linear(100, 3),
+      Functional(torch::sigmoid));
+  {
+    torch::NoGradGuard guard;
+    for (size_t p = 0; p < fused_model->parameters().size(); ++p) {
+      unfused_model->parameters()[p].copy_(fused_model->parameters()[p]);
+    }
+  }
+
+  OptimizerClass fused_optimizer(
+      fused_model->parameters(), Options(options).fused(true));
+  OptimizerClass unfused_optimizer(
+      unfused_model->parameters(), Options(options).fused(false));
+
+  for (size_t i = 0; i < kIterations; ++i) {
+    auto input = torch::randn({8, 200});
+    for (auto* model : {&fused_model, &unfused_model}) {
+      (*model)->zero_grad();
+      (*model)->forward(input).sum().backward();
+    }
+    fused_optimizer.step();
+    unfused_optimizer.step();
+
+    for (size_t p = 0; p < fused_model->parameters().size(); ++p) {
+      ASSERT_TRUE(fused_model->parameters()[p].allclose(
+          unfused_model->parameters()[p], /*rtol=*/1e-4, /*atol=*/1e-5));
+    }
+  }
+}
+
 TEST(OptimTest, BasicInterface) {
   struct MyOptimizer : Optimizer {
     using Optimizer::Optimizer;
@@ -271,6 +316,26 @@ TEST(OptimTest, ProducesPyTorchValues_SGDWithWeightDecayAndNesterovMomentum) {
       expected_parameters::SGD_with_weight_decay_and_nesterov_momentum());
 }
 
+TEST(OptimTest, FusedMatchesUnfused_SGD) {
+  check_fused_matches_unfused<SGD>(
+      SGDOptions(0.1).weight_decay(1e-2).momentum(0.9).nesterov(true));
+}
+
+TEST(OptimTest, FusedMatchesUnfused_Adam) {
+  check_fused_matches_unfused<Adam>(
+      AdamOptions(0.01).weight_decay(1e-2).amsgrad(true));
+}
+
+TEST(OptimTest, FusedMatchesUnfused_Adagrad) {
+  check_fused_matches_unfused<Adagrad>(
+      AdagradOptions(0.1).weight_decay(1e-2).lr_decay(1e-3));
+}
+
+TEST(OptimTest, FusedMatchesUnfused_RMSprop) {
+  check_fused_matches_unfused<RMSprop>(
+      RMSpropOptions(0.01).weight_decay(1e-2).centered(true).momentum(0.9));
+}
+
 TEST(OptimTest, ZeroGrad) {
   torch::manual_seed(0);
 
@@ -14,6 +14,10 @@
 #include <test/cpp/api/support.h>
 
 #include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <limits>
 #include <memory>
 #include <sstream>
 #include <string>
@@ -400,3 +404,159 @@ TEST(SerializeTest, UnserializableSubmoduleIsIgnoredWhenLoadingModule) {
   // serialization.
   ASSERT_EQ(output, 5);  
 }
+
+TEST(SerializeTest, StreamingModule) {
+  torch::manual_seed(0);
+  auto model = xor_model();
+  auto model2 = xor_model();
+
+  auto tempfile = c10::make_tempfile();
+  torch::save_streaming(model, tempfile.name);
+  torch::load(model2, tempfile.name);
+
+  auto params = model->named_parameters();
+  auto params2 = model2->named_parameters();
+  ASSERT_EQ(params.size(), params2.size());
+  for (const auto& p : params) {
+    ASSERT_TRUE(p->equal(params2[p.key()]));
+    ASSERT_TRUE(params2[p.key()].requires_grad());
+  }
+
+  // Loaded parameters are private copies of the file.
+  {
+    torch::NoGradGuard guard;
+    for (auto& p : model2->parameters()) {
+      p.add_(1);
+    }
+  }
+  torch::load(model2, tempfile.name);
+  for (const auto& p : params) {
+    ASSERT_TRUE(p->equal(params2[p.key()]));
+  }
+}
+
+TEST(SerializeTest, StreamingNestedArchives) {
+  auto tempfile = c10::make_tempfile();
+  {
+    auto archive = OutputArchive::streaming(tempfile.name);
+    OutputArchive inner;
+    inner.write("x", torch::ones({2, 3}));
+    OutputArchive outer;
+    outer.write("inner", inner);
+    outer.write("y", torch::arange(4), /*is_buffer=*/true);
+    archive.write("outer", outer);
+    archive.write("z", torch::zeros({5}, torch::kInt));
+    archive.finish();
+  }
+
+  InputArchive archive;
+  archive.load_from(tempfile.name);
+  InputArchive outer, inner, missing;
+  torch::Tensor x, y, z;
+  ASSERT_TRUE(archive.try_read("outer", outer));
+  ASSERT_FALSE(archive.try_read("inner", missing));
+  ASSERT_TRUE(outer.try_read("inner", inner));
+  ASSERT_TRUE(inner.try_read("x", x));
+  ASSERT_FALSE(outer.try_read("x", x));
+  ASSERT_TRUE(outer.try_read("y", y, /*is_buffer=*/true));
+  ASSERT_TRUE(archive.try_read("z", z));
+  ASSERT_TRUE(x.equal(torch::ones({2, 3})));
+  ASSERT_TRUE(y.equal(torch::arange(4)));
+  ASSERT_EQ(z.dtype(), torch::kInt);
+  ASSERT_THROWS_WITH(
+      outer.read("y", y), "Expected deserialized tensor for key 'y' to not be a buffer");
+}
+
+TEST(SerializeTest, StreamingFromStream) {
+  torch::manual_seed(0);
+  std::vector<torch::Tensor> x_vec = {torch::randn({1, 2}), torch::randn({3, 4})};
+  auto tempfile = c10::make_tempfile();
+  torch::save_streaming(x_vec, tempfile.name);
+
+  std::ifstream stream(tempfile.name, std::ios::binary);
+  std::vector<torch::Tensor> y_vec;
+  torch::load(y_vec, stream);
+  ASSERT_EQ(y_vec.size(), x_vec.size());
+  for (size_t i = 0; i < x_vec.size(); i++) {
+    ASSERT_TRUE(x_vec[i].equal(y_vec[i]));
+  }
+}
+
+TEST(SerializeTest, AsyncCheckpointSavesSnapshot) {
+  torch::manual_seed(0);
+  auto model = xor_model();
+  auto expected = xor_model();
+  auto tempfile = c10::make_tempfile();
+  {
+    torch::NoGradGuard guard;
+    for (const auto& p : model->named_parameters()) {
+      expected->named_parameters()[p.key()].copy_(*p);
+    }
+  }
+
+  auto checkpoint = torch::save_async(model, tempfile.name);
+  // Modifying the model does not change the checkpoint.
+  {
+    torch::NoGradGuard guard;
+    for (auto& p : model->parameters()) {
+      p.mul_(2);
+    }
+  }
+  checkpoint.get();
+
+  auto loaded = xor_model();
+  torch::load(loaded, tempfile.name);
+  for (const auto& p : expected->named_parameters()) {
+    ASSERT_TRUE(p->equal(loaded->named_parameters()[p.key()]));
+  }
+}
+
+TEST(SerializeTest, StreamingRejectsMalformedIndex) {
+  auto tempfile = c10::make_tempfile();
+  {
+    auto archive = OutputArchive::streaming(tempfile.name);
+    archive.write("x", torch::ones({2, 3}));
+    archive.finish();
+  }
+  std::ifstream file(tempfile.name, std::ios::binary);
+  const std::string bytes(
+      (std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+  // The footer holds the offset of the index, which starts with the name of
+  // the only record.
+  uint64_t index_offset;
+  std::memcpy(
+      &index_offset,
+      bytes.data() + bytes.size() - 2 * sizeof(uint64_t) - detail::kStreamMagicSize,
+      sizeof(uint64_t));
+  uint32_t name_size;
+  std::memcpy(&name_size, bytes.data() + index_offset, sizeof(uint32_t));
+  const size_t dtype = index_offset + sizeof(uint32_t) + name_size;
+  const size_t device_type = dtype + 1;
+  // dtype, device type and index, is_buffer, requires_grad and the dimension.
+  const size_t sizes = dtype + 10;
+  const size_t offset = sizes + 2 * sizeof(int64_t);
+  const size_t nbytes = offset + sizeof(uint64_t);
+
+  auto load_with = [&](size_t position, const void* value, size_t size) {
+    std::string corrupted = bytes;
+    std::memcpy(&corrupted[position], value, size);
+    std::istringstream stream(corrupted);
+    InputArchive archive;
+    archive.load_from(stream);
+  };
+  const int8_t bad_enum = 100;
+  ASSERT_THROWS_WITH(load_with(dtype, &bad_enum, 1), "invalid dtype");
+  ASSERT_THROWS_WITH(load_with(device_type, &bad_enum, 1), "invalid device");
+  const int64_t negative = -1;
+  ASSERT_THROWS_WITH(load_with(sizes, &negative, 8), "negative size");
+  const int64_t huge = int64_t(1) << 62;
+  ASSERT_THROWS_WITH(load_with(sizes, &huge, 8), "too large");
+  const uint64_t wrong_nbytes = 4 * 6 + 4;
+  ASSERT_THROWS_WITH(
+      load_with(nbytes, &wrong_nbytes, 8), "does not match its shape");
+  // offset + nbytes wraps around to a small value.
+  const uint64_t wrapping_offset = std::numeric_limits<uint64_t>::max() - 8;
+  ASSERT_THROWS_WITH(
+      load_with(offset, &wrapping_offset, 8), "out of bounds");
+}
@@ -183,6 +183,14 @@ class StoreTestBase(object):
     def test_set_get(self):
         self._test_set_get(self._create_store())
 
+    def test_multi_set_get(self):
+        fs = self._create_store()
+        fs.multi_set(["key0", "key1"], ["value0", "value1"])
+        fs.set("key2", "value2")
+        self.assertEqual(
+            [b"value2", b"value0", b"value1"],
+            fs.multi_get(["key2", "key0", "key1"]))
+
 
 class FileStoreTest(TestCase, StoreTestBase):
     def setUp(self):
@@ -207,7 +215,7 @@ class PrefixFileStoreTest(TestCase, StoreTestBase):
         return c10d.PrefixStore(self.prefix, self.filestore)
 
 
-def create_tcp_store(addr):
+def create_tcp_store(addr, num_server_threads=1):
     """
     Creates a TCP store. Retries if the chosen port is already in use.
     """
@@ -216,7 +224,7 @@ def create_tcp_store(addr):
         try:
             port = common.find_free_port()
             ports.append(port)
-            return c10d.TCPStore(addr, port, 1, True)
+            return c10d.TCPStore(addr, port, 1, True, num_server_threads)
         except RuntimeError as error:
             if str(error) == "Address already in use":
                 continue
@@ -241,6 +249,30 @@ class TCPStoreTest(TestCase, StoreTestBase):
             store1 = c10d.TCPStore(addr, port, 1, True)  # noqa: F841
             store2 = c10d.TCPStore(addr, port, 1, True)  # noqa: F841
 
+    def test_compare_set(self):
+        store = self._create_store()
+        self.assertEqual(b"", store.compare_set("key", "old", "new"))
+        self.assertEqual(b"first", store.compare_set("key", "", "first"))
+        self.assertEqual(b"first", store.compare_set("key", "old", "new"))
+        self.assertEqual(b"new", store.compare_set("key", "first", "new"))
+        self.assertEqual(b"new", store.get("key"))
+
+    def test_wait_timeout(self):
+        store = self._create_store()
+        with self.assertRaisesRegex(RuntimeError, "Socket Timeout"):
+            store.wait(["missing"], timedelta(milliseconds=100))
+        # The connection keeps being served after the wait timed out.
+        store.set("key", "value")
+        self.assertEqual(b"value", store.get("key"))
+        self.assertEqual(1, store.add("counter", 1))
+
+
+class ShardedTCPStoreTest(TestCase, StoreTestBase):
+    def _create_store(self):
+        store = create_tcp_store('localhost', num_server_threads=4)
+        store.set_timeout(timedelta(seconds=300))
+        return store
+
 
 class PrefixTCPStoreTest(TestCase, StoreTestBase):
     def setUp(self):
@@ -756,6 +788,42 @@ class ProcessGroupGlooTest(MultiProcessTestCase):
     def test_allreduce_basics_cuda(self):
         self._test_allreduce_basics(lambda t: t.clone().cuda())
 
+    def test_sparse_allreduce_checks(self):
+        store = c10d.FileStore(self.file.name, self.world_size)
+        pg = c10d.ProcessGroupGloo(store, self.rank, self.world_size, self.opts())
+
+        t1 = torch.sparse_coo_tensor([[0]], [1.0], size=(2,))
+
+        with self.assertRaisesRegex(ValueError, "only supports ReduceOp::SUM"):
+            opts = c10d.AllreduceOptions()
+            opts.reduceOp = c10d.ReduceOp.MAX
+            pg.allreduce([t1], opts)
+
+    def test_sparse_allreduce_basics(self):
+        store = c10d.FileStore(self.file.name, self.world_size)
+        pg = c10d.ProcessGroupGloo(store, self.rank, self.world_size, self.opts())
+
+        # Every rank sets its own row and row 0, so that rows overlap across
+        # ranks, and some ranks contribute more nonzeros than others.
+        for num_inputs in [1, 2]:
+            inputs = []
+            for i in range(num_inputs):
+                rows = [0] + list(range(1, self.rank + 2))
+                indices = torch.tensor([rows])
+                values = torch.ones(len(rows), 3) * (i + 1)
+                inputs.append(torch.sparse_coo_tensor(
+                    indices, values, size=(self.world_size + 1, 3)))
+
+            expected = sum(input.to_dense() for input in inputs)
+            work = pg.allreduce([expected])
+            work.wait()
+
+            work = pg.allreduce(inputs)
+            work.wait()
+            for input in inputs:
+                self.assertTrue(input.is_sparse)
+                self.assertEqual(expected, input.to_dense())
+
     def _test_allreduce_stress(self, inputs):
         store = c10d.FileStore(self.file.name, self.world_size)
         pg = c10d.ProcessGroupGloo(store, self.rank, self.world_size, self.opts(threads=8))
@@ -1326,6 +1394,75 @@ class ProcessGroupGlooTest(MultiProcessTestCase):
             self.assertEqual(torch.full(size, float(i * self.world_size)), tensor)
 
 
+class ProcessGroupShmTest(MultiProcessTestCase):
+    def opts(self, buffer_size=1024):
+        # A small buffer so that the tensors below take several chunks
+        opts = c10d.ProcessGroupShm.Options()
+        opts.buffer_size = buffer_size
+        opts.timeout = 5.0
+        return opts
+
+    def test_allreduce_ops(self):
+        store = c10d.FileStore(self.file.name, self.world_size)
+        pg = c10d.ProcessGroupShm(store, self.rank, self.world_size, self.opts())
+
+        for numel in [1, 100, 1000]:
+            x = torch.arange(numel, dtype=torch.float) + self.rank
+            pg.allreduce(x).wait()
+            self.assertEqual(
+                torch.arange(numel, dtype=torch.float) * self.world_size +
+                self.world_size * (self.world_size - 1) / 2, x)
+
+        opts = c10d.AllreduceOptions()
+        opts.reduceOp = c10d.ReduceOp.MAX
+        x = torch.full((1000,), float(self.rank))
+        pg.allreduce([x], opts).wait()
+        self.assertEqual(torch.full((1000,), float(self.world_size - 1)), x)
+
+    def test_broadcast(self):
+        store = c10d.FileStore(self.file.name, self.world_size)
+        pg = c10d.ProcessGroupShm(store, self.rank, self.world_size, self.opts())
+
+        for root in range(self.world_size):
+            x = torch.full((10, 100), float(self.rank))
+            pg.broadcast(x, root=root).wait()
+            self.assertEqual(torch.full((10, 100), float(root)), x)
+
+    def test_allgather(self):
+        store = c10d.FileStore(self.file.name, self.world_size)
+        pg = c10d.ProcessGroupShm(store, self.rank, self.world_size, self.opts())
+
+        output = [torch.zeros(500) for _ in range(self.world_size)]
+        pg.allgather([output], [torch.full((500,), float(self.rank))]).wait()
+        for i, tensor in enumerate(output):
+            self.assertEqual(torch.full((500,), float(i)), tensor)
+
+    def test_barrier_implies_wait(self):
+        store = c10d.FileStore(self.file.name, self.world_size)
+        pg = c10d.ProcessGroupShm(store, self.rank, self.world_size, self.opts())
+
+        tensors = [torch.full((100, 100), float(i)) for i in range(16)]
+        for tensor in tensors:
+            pg.allreduce(tensor)
+        pg.barrier().wait()
+
+        for i, tensor in enumerate(tensors):
+            self.assertEqual(torch.full((100, 100), float(i * self.world_size)), tensor)
+
+    def test_allreduce_checks(self):
+        store = c10d.FileStore(self.file.name, self.world_size)
+        pg = c10d.ProcessGroupShm(store, self.rank, self.world_size, self.opts())
+
+        with self.assertRaisesRegex(ValueError, "requires a single-element tensor list"):
+            pg.allreduce([torch.zeros(1), torch.zeros(1)])
+
+        with self.assertRaisesRegex(ValueError, "only supports contiguous tensors"):
+            pg.allreduce(torch.zeros(4, 4).t())
+
+        with self.assertRaisesRegex(ValueError, "unsupported tensor type"):
+            pg.allreduce(torch.zeros(4, dtype=torch.half))
+
+
 class ProcessGroupNCCLTest(TestCase):
     MAIN_PROCESS_RANK = 0
 
@@ -2415,6 +2552,51 @@ class DistributedDataParallelTest(MultiProcessTestCase):
             loss = criterion(output, target)
             loss.backward()
 
+    def test_sparse_gradient_unused_on_some_ranks(self):
+        store = c10d.FileStore(self.file.name, self.world_size)
+        options = c10d.ProcessGroupGloo.Options()
+        options.devices = [c10d.ProcessGroupGloo.create_tcp_device(interface="lo")]
+        process_group = c10d.ProcessGroupGloo(store, self.rank, self.world_size, options)
+
+        class SparseEmbeddingModule(nn.Module):
+            def __init__(self):
+                super(SparseEmbeddingModule, self).__init__()
+                self.embedding = nn.Embedding(10, 4, sparse=True)
+                self.fc = nn.Linear(4, 4, bias=False)
+
+            def forward(self, x, use_embedding):
+                if use_embedding:
+                    x = self.embedding(x).sum(1)
+                else:
+                    x = torch.zeros(x.size(0), 4)
+                return self.fc(x)
+
+        torch.manual_seed(1337)
+        model = SparseEmbeddingModule()
+        ddp_model = DistributedDataParallel(
+            copy.deepcopy(model),
+            process_group=process_group,
+            find_unused_parameters=True,
+        )
+
+        input = torch.tensor([[1, 2], [3, 3], [5, 9]])
+        target = torch.randn(3, 4)
+        criterion = nn.MSELoss()
+
+        # Only rank 0 looks up the embedding, so the other ranks reduce an
+        # empty gradient for it.
+        loss = criterion(ddp_model(input, use_embedding=(self.rank == 0)), target)
+        loss.backward()
+
+        # The embedding gradient is the gradient of rank 0 averaged over
+        # all ranks.
+        loss = criterion(model(input, use_embedding=True), target)
+        loss.backward()
+        expected = model.embedding.weight.grad.to_dense() / self.world_size
+        grad = ddp_model.module.embedding.weight.grad
+        self.assertTrue(grad.is_sparse)
+        self.assertEqual(expected, grad.to_dense())
+
 
 class ReducerModule(nn.Module):
     def __init__(self):
@@ -2432,6 +2614,15 @@ class ReducerModule(nn.Module):
         return F.softmax(x, dim=1)
 
 
+class SparseGradientModule(nn.Module):
+    def __init__(self):
+        super(SparseGradientModule, self).__init__()
+        self.embedding = nn.EmbeddingBag(10, 4, sparse=True)
+
+    def forward(self, x):
+        return F.softmax(self.embedding(x), dim=1)
+
+
 class ReducerTest(TestCase):
     def setUp(self):
         self.store = c10d.FileStore("/dev/null", 1)
@@ -2548,6 +2739,32 @@ class ReducerTest(TestCase):
             output.backward()
             optimizer.step()
 
+    def test_forward_backward_sparse_gradient(self):
+        batch_size = 10
+        model = SparseGradientModule()
+        parameters = [list(model.parameters())]
+        expect_sparse_gradients = [[True]]
+        buckets = dist._compute_bucket_assignment_by_size(
+            parameters[0], [1024 * 1024], expect_sparse_gradients[0])
+        reducer = dist.Reducer(
+            parameters, buckets, self.process_group, expect_sparse_gradients)
+        loss = nn.CrossEntropyLoss()
+        input = torch.randint(0, 10, [batch_size, 2])
+        target = torch.LongTensor([random.randrange(4) for _ in range(batch_size)])
+        output = loss(model(input), target)
+        reducer.prepare_for_backward(output)
+        output.backward()
+        self.assertTrue(model.embedding.weight.grad.is_sparse)
+
+    def test_sparse_gradient_in_shared_bucket(self):
+        model = ReducerModule()
+        parameters = [list(model.parameters())]
+        expect_sparse_gradients = [[True] + [False] * (len(parameters[0]) - 1)]
+        buckets = [list(range(len(parameters[0])))]
+        with self.assertRaisesRegex(RuntimeError, "expect a sparse gradient"):
+            dist.Reducer(
+                parameters, buckets, self.process_group, expect_sparse_gradients)
+
 
 class ComputeBucketAssignmentTest(TestCase):
     def test_single_limit_single_dtype(self):
@@ -2594,6 +2811,17 @@ class ComputeBucketAssignmentTest(TestCase):
         result = dist._compute_bucket_assignment_by_size(tensors, [200, 400])
         self.assertEqual([[0], [1], [2, 4], [3, 5]], result)
 
+    def test_sparse_gradient(self):
+        tensors = [
+            torch.empty([10], dtype=torch.float),
+            torch.empty([100], dtype=torch.float),
+            torch.empty([10], dtype=torch.float),
+            torch.empty([10], dtype=torch.float),
+        ]
+        result = dist._compute_bucket_assignment_by_size(
+            tensors, [400], [False, True, False, False])
+        self.assertEqual([[0, 2, 3], [1]], result)
+
 
 if __name__ == '__main__':
     assert not torch.cuda._initialized, "test_distributed must not have initialized CUDA context on main process"
@@ -121,5 +121,65 @@ class TestQuantizedOps(unittest.TestCase):
         np.testing.assert_equal(qC, qC_hat.int_repr())
 
 
+@unittest.skipIf(not torch.fbgemm_is_cpu_supported(),
+                 "fbgemm is not supported on this CPU")
+class TestFbgemmLinearDynamic(TestCase):
+    def _inputs(self):
+        torch.manual_seed(0)
+        X = torch.rand(2, 5, 64) * 2 - 1
+        # Output channels of very different magnitudes, which a single scale
+        # for the whole weight would mostly round to zero.
+        W = (torch.rand(32, 64) * 2 - 1) * torch.logspace(-3, 1, 32).view(32, 1)
+        b = torch.rand(32) - 0.5
+        return X, W, b
+
+    def _check_close(self, Y, Y_ref, atol=1e-4):
+        # The error of every output channel is relative to its magnitude.
+        tol = 0.03 * Y_ref.abs().view(-1, Y_ref.size(-1)).max(0)[0] + atol
+        self.assertTrue(((Y - Y_ref).abs() <= tol).all())
+
+    def test_linear_dynamic(self):
+        X, W, b = self._inputs()
+        packed = torch.fbgemm_linear_pack_weight(W)
+        for relu in [False, True]:
+            Y_ref = torch.nn.functional.linear(X, W, b)
+            if relu:
+                Y_ref = torch.relu(Y_ref)
+            Y = torch.fbgemm_linear_dynamic(X, packed, b, relu=relu)
+            self.assertEqual(Y.size(), Y_ref.size())
+            self._check_close(Y, Y_ref)
+        Y = torch.fbgemm_linear_dynamic(X, packed)
+        self._check_close(Y, torch.nn.functional.linear(X, W))
+        self.assertEqual(
+            torch.fbgemm_linear_dynamic(X[:0], packed, b).size(), (0, 5, 32))
+
+    def test_linear_dynamic_groupwise(self):
+        X, W, b = self._inputs()
+        # One scale for every 8 output channels
+        scales = torch.logspace(-1, 1, 4).view(4, 1).expand(4, 8).reshape(32, 1)
+        W = (torch.rand(32, 64) * 2 - 1) * scales
+        Y = torch.fbgemm_linear_dynamic(
+            X, torch.fbgemm_linear_pack_weight(W, group_size=8), b)
+        self._check_close(Y, torch.nn.functional.linear(X, W, b))
+
+    def test_linear_dynamic_requantize(self):
+        X, W, b = self._inputs()
+        packed = torch.fbgemm_linear_pack_weight(W)
+        Y_ref = torch.relu(torch.nn.functional.linear(X, W, b))
+        scale = Y_ref.max().item() / 255
+        qY = torch.fbgemm_linear_dynamic_requantize(
+            X, packed, b, scale, 0, relu=True)
+        self.assertEqual(qY.dtype, torch.uint8)
+        self._check_close(qY.float() * scale, Y_ref, atol=scale)
+
+    def test_linear_dynamic_checks(self):
+        X, W, b = self._inputs()
+        packed = torch.fbgemm_linear_pack_weight(W)
+        with self.assertRaisesRegex(RuntimeError, "Expected an input with 64"):
+            torch.fbgemm_linear_dynamic(X[..., :32], packed, b)
+        with self.assertRaisesRegex(RuntimeError, "Expected a bias of size 32"):
+            torch.fbgemm_linear_dynamic(X, packed, b[:16])
+
+
 if __name__ == '__main__':
     run_tests()
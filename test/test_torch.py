@@ -1312,6 +1312,21 @@ class _TestTorchMixin(object):
         torch.logsumexp(a, 1, out=c)
         self.assertTrue(np.allclose(expected, b[:, 0].numpy()))
 
+        # large inputs, infinities and NaNs, reduced over contiguous and
+        # strided dimensions
+        a = torch.randn(4, 3000, dtype=torch.double) * 100
+        a[1, 7] = inf
+        a[2, :] = -inf
+        a[2, 1234] = 5
+        a[3, 2999] = nan
+        for t, dim in [(a, 1), (a.t(), 0), (a.t().contiguous(), 0), (a[:, ::3], 1)]:
+            expected = logsumexp(t.numpy(), dim)
+            for dtype in [torch.float, torch.double]:
+                actual = t.to(dtype).logsumexp(dim)
+                self.assertTrue(np.allclose(expected, actual.double().numpy(), rtol=1e-5, equal_nan=True))
+        self.assertTrue(np.allclose(logsumexp(a.numpy()), a.logsumexp([0, 1]).numpy(), equal_nan=True))
+        self.assertEqual(a[:3].logsumexp([0, 1]).item(), inf)
+
     @unittest.skipIf(not TEST_NUMPY, "Numpy not found")
     def test_cpu_parallel(self):
         # To use parallel branches we'll need to compare on tensors
@@ -1568,6 +1583,54 @@ class _TestTorchMixin(object):
             res_reciprocal.reciprocal_()
             self.assertEqual(res_reciprocal, res_div)
 
+    def test_elementwise_contiguous_and_scalar_operands(self):
+        # Contiguous operands of the same shape and dtype, and scalars, take a
+        # shortcut when setting up the TensorIterator: compare with
+        # non-contiguous operands.
+        def non_contiguous(t):
+            return torch.stack([t, t], -1).select(-1, 0)
+
+        for dtype in [torch.float, torch.double, torch.long]:
+            for shape in [(1,), (7,), (3, 64), (4096,), (0, 3)]:
+                a = (torch.randn(shape) * 10).to(dtype)
+                b = (torch.randn(shape) * 10).to(dtype)
+                a_nc, b_nc = non_contiguous(a), non_contiguous(b)
+                self.assertFalse(a_nc.is_contiguous() and a.numel() > 1)
+                for res, expected in [(a + b, a_nc + b_nc),
+                                      (a * b, a_nc * b_nc),
+                                      (torch.relu(a), torch.relu(a_nc)),
+                                      (a + 2, a_nc + 2),
+                                      (3 * a, 3 * a_nc),
+                                      (a * torch.tensor(2.5), a_nc * torch.tensor(2.5))]:
+                    self.assertEqual(res.dtype, dtype)
+                    self.assertEqual(res.shape, torch.Size(shape))
+                    self.assertTrue(res.is_contiguous())
+                    self.assertEqual(res, expected, 0)
+
+                res = a.clone()
+                res.mul_(b)
+                self.assertEqual(res, a_nc * b_nc, 0)
+                # out= tensors are resized
+                out = torch.empty(0, dtype=dtype)
+                torch.add(a, b, out=out)
+                self.assertEqual(out.shape, torch.Size(shape))
+                self.assertEqual(out, a_nc + b_nc, 0)
+
+        # the shape of write-only outputs comes from the inputs
+        out = torch.empty(3)
+        torch.add(torch.tensor(1.), torch.tensor(2.), out=out)
+        self.assertEqual(out.shape, torch.Size([]))
+        self.assertEqual(out, torch.tensor(3.), 0)
+        out = torch.empty(2, 3)
+        torch.mul(torch.ones(3), torch.full((3,), 2.), out=out)
+        self.assertEqual(out.shape, torch.Size([3]))
+        self.assertEqual(out, torch.full((3,), 2.), 0)
+
+        # broadcasting and mismatched outputs are not affected
+        self.assertEqual(torch.ones(3, 1) + torch.ones(3), torch.full((3, 3), 2))
+        with self.assertRaisesRegex(RuntimeError, "doesn't match the broadcast shape"):
+            torch.ones(3).add_(torch.ones(2, 3))
+
     def test_mul(self):
         m1 = torch.randn(10, 10)
         res1 = m1.clone()
@@ -2287,6 +2350,31 @@ class _TestTorchMixin(object):
         torch.sum(x, (2, 1), out=res2)
         self.assertEqual(res1, res2)
 
+    def test_sum_precision(self):
+        # float sums are accumulated in float, and should still stay close to
+        # the double ones on long rows
+        def rel_err(actual, expected):
+            return ((actual.double() - expected).abs() / expected.abs()).max().item()
+
+        x = torch.rand(10 ** 7)
+        ref = x.double()
+        self.assertLess(rel_err(x.sum(), ref.sum()), 1e-6)
+        self.assertLess(rel_err(x.mean(), ref.mean()), 1e-6)
+        self.assertLess(rel_err(x.norm(), ref.norm()), 1e-6)
+        self.assertLess(rel_err(x.norm(1), ref.norm(1)), 1e-6)
+        self.assertLess(rel_err(x.norm(3), ref.norm(3)), 1e-5)
+
+        x = x.view(10 ** 5, 100)
+        ref = ref.view(10 ** 5, 100)
+        for dim, prec in [(0, 1e-6), (1, 1e-5)]:
+            self.assertLess(rel_err(x.sum(dim), ref.sum(dim)), prec)
+            self.assertLess(rel_err(x.t().sum(1 - dim), ref.sum(dim)), prec)
+        self.assertLess(rel_err(x.t().sum(), ref.sum()), 1e-6)
+        self.assertLess(rel_err(x.norm(dim=1), ref.norm(dim=1)), 1e-5)
+        for p in [1, 2, 3]:
+            self.assertLess(rel_err(x.t().norm(p, 0), ref.norm(p, 1)), 1e-5)
+        self.assertLess(rel_err(x[:, ::3].sum(), ref[:, ::3].sum()), 1e-6)
+
     # TODO: these tests only check if it's possible to pass a return value
     # it'd be good to expand them
     def test_prod(self):
@@ -7736,6 +7824,78 @@ class _TestTorchMixin(object):
         self.assertEqual(tensor.var(dim=0), 0.03125)
         self.assertEqual(tensor.var(), 0.03125)
 
+    def test_var_mean(self):
+        for dtype in [torch.float, torch.double]:
+            # large enough to be split across threads, with a mean far from 0
+            x = torch.randn(3, 1000, 33, dtype=dtype) + 1000
+            for t in [x, x.transpose(0, 2), x[:, ::3]]:
+                ref = t.double()
+                for unbiased in [False, True]:
+                    var, mean = torch.var_mean(t, unbiased=unbiased)
+                    self.assertEqual(var, ref.var(unbiased=unbiased), 1e-3)
+                    self.assertEqual(mean, ref.mean(), 1e-3)
+                    std, mean = torch.std_mean(t, unbiased=unbiased)
+                    self.assertEqual(std, ref.std(unbiased=unbiased), 1e-3)
+                    self.assertEqual(mean, ref.mean(), 1e-3)
+                    for dim in [0, 1, 2, [0, 2], [1, 2]]:
+                        for keepdim in [False, True]:
+                            var, mean = torch.var_mean(t, dim, unbiased, keepdim)
+                            self.assertEqual(var, ref.var(dim, unbiased, keepdim), 1e-3)
+                            self.assertEqual(mean, ref.mean(dim, keepdim), 1e-3)
+                            std, mean = torch.std_mean(t, dim, unbiased, keepdim)
+                            self.assertEqual(std, ref.std(dim, unbiased, keepdim), 1e-3)
+                            self.assertEqual(mean, ref.mean(dim, keepdim), 1e-3)
+
+        var, mean = torch.var_mean(torch.empty(0, 3), 0)
+        self.assertTrue(torch.isnan(var).all())
+        self.assertTrue(torch.isnan(mean).all())
+
+        x = torch.randn(4, 5, dtype=torch.double, requires_grad=True)
+        self.assertTrue(torch.autograd.gradcheck(lambda t: torch.var_mean(t, 1), (x,)))
+        self.assertTrue(torch.autograd.gradcheck(lambda t: torch.std_mean(t), (x,)))
+        self.assertTrue(torch.autograd.gradcheck(lambda t: torch.std_mean(t, [0, 1], keepdim=True)[1], (x,)))
+
+    def test_aminmax(self):
+        for dtype in [torch.float, torch.double, torch.int32, torch.int64, torch.uint8]:
+            x = (torch.rand(10, 2000) * 100).to(dtype)
+            for t in [x, x.t(), x[:, ::7]]:
+                min, max = torch._aminmax(t)
+                self.assertEqual(min, t.min())
+                self.assertEqual(max, t.max())
+                for dim in [0, 1, -1]:
+                    for keepdim in [False, True]:
+                        min, max = torch._aminmax(t, dim, keepdim)
+                        self.assertEqual(min, t.min(dim, keepdim)[0])
+                        self.assertEqual(max, t.max(dim, keepdim)[0])
+
+        x = torch.tensor([1., nan, -inf, 3.])
+        self.assertTrue(all(math.isnan(r) for r in torch._aminmax(x)))
+        self.assertRaises(RuntimeError, lambda: torch._aminmax(torch.empty(0)))
+
+    def test_max_min_dim_noncontiguous(self):
+        # few outputs, or an input that is not contiguous, go through the
+        # parallel TensorIterator reduction
+        x = torch.randn(3, 10000)
+        for t in [x, x.t(), x[:, ::2], x.t()[::3]]:
+            for dim in [0, 1]:
+                for op in [torch.max, torch.min]:
+                    value, index = op(t, dim)
+                    expected = op(t.contiguous(), dim)
+                    self.assertEqual(value, expected[0], 0)
+                    self.assertEqual(index, expected[1], 0)
+                    self.assertEqual(t.gather(dim, index.unsqueeze(dim)).squeeze(dim), value, 0)
+
+        # the first NaN wins, and ties go to the first index
+        x = torch.zeros(2, 5000)
+        x[0, 100] = nan
+        x[0, 4000] = nan
+        x[1, 1000] = 1
+        x[1, 2000] = 1
+        for t in [x, x.t().contiguous().t()]:
+            self.assertEqual(torch.max(t, 1)[1], torch.tensor([100, 1000]), 0)
+            self.assertEqual(torch.min(-t, 1)[1], torch.tensor([100, 1000]), 0)
+            self.assertEqual(t.argmax(1), torch.tensor([100, 1000]), 0)
+
     @staticmethod
     def _test_view(self, cast):
         tensor = cast(torch.rand(15))
@@ -8555,6 +8715,40 @@ class _TestTorchMixin(object):
         self.assertEqual(perm, new)
         self.assertEqual(x.size(), orig)
 
+    def test_contiguous_permuted(self):
+        # Gathers the elements of t one at a time through their offsets.
+        def reference(t):
+            index = torch.tensor(t.storage_offset())
+            for size, stride in zip(t.size(), t.stride()):
+                index = index.unsqueeze(-1) + torch.arange(size) * stride
+            base = torch.tensor([], dtype=t.dtype).set_(t.storage())
+            return base.take(index)
+
+        cases = [
+            ((70, 90), (1, 0)),
+            ((512, 257), (1, 0)),
+            ((3, 16, 33, 35), (0, 2, 3, 1)),  # NCHW -> NHWC
+            ((3, 33, 35, 16), (0, 3, 1, 2)),  # NHWC -> NCHW
+            ((2, 37, 9, 24), (0, 2, 1, 3)),
+            ((2, 37, 9, 24), (0, 2, 3, 1)),
+            ((5, 1, 31, 67), (3, 1, 2, 0)),
+            ((4, 5, 6, 7, 8), (4, 2, 0, 3, 1)),
+        ]
+        views = [lambda x, perm: x.permute(*perm),
+                 lambda x, perm: x.permute(*perm)[..., 1:-1]]
+        for shape, perm in cases:
+            x = torch.arange(reduce(lambda a, b: a * b, shape)).view(shape)
+            for view in views:
+                expected = reference(view(x, perm))
+                for dtype in [torch.uint8, torch.bool, torch.int16, torch.half,
+                              torch.int32, torch.float, torch.int64, torch.double]:
+                    convert = (lambda t: t % 3 == 0) if dtype == torch.bool else (lambda t: t.to(dtype))
+                    src = view(convert(x), perm)
+                    y = src.contiguous()
+                    self.assertTrue(y.is_contiguous())
+                    self.assertEqual(y.double(), convert(expected).double(), 0)
+                    self.assertEqual(torch.empty_like(y).copy_(src).double(), y.double(), 0)
+
     @staticmethod
     def _test_flip(self, use_cuda=False):
         device = torch.device('cuda') if use_cuda else torch.device('cpu')
@@ -8987,6 +9181,11 @@ class _TestTorchMixin(object):
         self.assertEqual(q.mean(), 2, 0.3)
         self.assertEqual(q.std(), 3, 0.3)
 
+        with self.assertRaisesRegex(RuntimeError, "std > 0.0"):
+            q.normal_(0, 0)
+        with self.assertRaisesRegex(RuntimeError, "std > 0.0"):
+            q.normal_(0, -1)
+
         q = torch.Tensor(100, 100)
         q_row1 = q[0:1].clone()
         q[99:100].normal_()
@@ -10508,6 +10707,53 @@ tensor([[[1., 1., 1.,  ..., 1., 1., 1.],
             torch.Tensor(bad_mock_seq)
         self.assertEqual(torch.Tensor([1.0, 2.0, 3.0]), torch.Tensor(good_mock_seq))
 
+    def test_tensor_from_buffer(self):
+        import array
+
+        # buffers infer their dtype the same way as the list of their items
+        for typecode in 'bBhHiIlfd':
+            values = [1, 2, 0, 5, 3] if typecode not in 'fd' else [1.5, -2.25, 0., 3.]
+            if typecode in 'bhil':
+                values[0] = -values[0]
+            buf = array.array(typecode, values)
+            self.assertEqual(torch.tensor(buf), torch.tensor(values), 0)
+            self.assertIs(torch.tensor(buf).dtype, torch.tensor(values).dtype)
+            for dtype in [torch.uint8, torch.int32, torch.float32, torch.float64]:
+                self.assertEqual(torch.tensor(buf, dtype=dtype), torch.tensor(values, dtype=dtype), 0)
+
+        # empty buffers have no items to infer from, like empty lists
+        for buf in [array.array('i'), array.array('d'), bytearray()]:
+            self.assertIs(torch.tensor(buf).dtype, torch.tensor([]).dtype)
+            self.assertEqual(torch.tensor(buf).shape, (0,))
+        self.assertIs(torch.tensor(array.array('i'), dtype=torch.int32).dtype, torch.int32)
+
+        # the result never aliases the buffer
+        buf = array.array('d', [1., 2., 3.])
+        t = torch.tensor(buf)
+        buf[0] = 7.
+        self.assertEqual(t, torch.tensor([1., 2., 3.]), 0)
+
+        if PY3:
+            self.assertEqual(torch.tensor(b'\x01\x02\xff'), torch.tensor([1, 2, 255]), 0)
+            data = bytearray(range(12))
+            view = memoryview(data)[1::3]
+            self.assertEqual(torch.tensor(view), torch.tensor(list(data)[1::3]), 0)
+            view = memoryview(data).cast('B', (3, 4))
+            self.assertEqual(torch.tensor(view), torch.arange(12).view(3, 4), 0)
+        self.assertRaises(TypeError, lambda: torch.tensor('abc'))
+
+        # nested tensors are copied as blocks
+        rows = [torch.randn(4, 5) for _ in range(3)]
+        expected = torch.stack(rows)
+        self.assertEqual(torch.tensor(rows), expected, 0)
+        self.assertEqual(torch.tensor([rows[0].t()]), expected[:1].transpose(1, 2), 0)
+        self.assertEqual(torch.tensor(rows, dtype=torch.float64), expected.double(), 0)
+        if TEST_NUMPY:
+            import numpy as np
+            arrays = [r.numpy() for r in rows]
+            self.assertEqual(torch.tensor(arrays), expected, 0)
+            self.assertEqual(torch.tensor([arrays[0][:, ::2]]), expected[:1, :, ::2], 0)
+
     def test_comparison_ops(self):
         x = torch.randn(5, 5)
         y = torch.randn(5, 5)
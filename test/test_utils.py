@@ -11,7 +11,8 @@ import torch
 import torch.nn as nn
 import torch.utils.data
 import torch.cuda
-from torch.utils.checkpoint import checkpoint, checkpoint_sequential
+from torch.utils.checkpoint import checkpoint, checkpoint_sequential, \
+    checkpoint_stats, plan_checkpoint_segments, reset_checkpoint_stats
 import torch.hub as hub
 from torch.autograd._functions.utils import prepare_onnx_paddings
 from torch.autograd._functions.utils import check_onnx_broadcast
@@ -264,6 +265,32 @@ class TestCheckpoint(TestCase):
         out = checkpoint(run_fn, input_var, None)
         out.sum().backward()
 
+    def test_checkpoint_memory_budget(self):
+        model = nn.Sequential(*[nn.Linear(64, 64) for _ in range(8)])
+        input_var = torch.randn(16, 64, requires_grad=True)
+        layer_bytes = 16 * 64 * 4
+
+        segment_ends, baseline, peak, fits = plan_checkpoint_segments(model, 10 ** 9, input_var)
+        self.assertEqual(segment_ends, [8])
+        self.assertEqual(baseline, 8 * layer_bytes)
+        self.assertEqual(peak, baseline)
+        self.assertTrue(fits)
+
+        budget = 5 * layer_bytes
+        segment_ends, baseline, peak, fits = plan_checkpoint_segments(model, budget, input_var)
+        self.assertTrue(fits)
+        self.assertLessEqual(peak, budget)
+        self.assertEqual(segment_ends[-1], 8)
+        self.assertGreater(len(segment_ends), 1)
+
+        reset_checkpoint_stats()
+        out = checkpoint_sequential(model, None, input_var, memory_budget=budget)
+        out.sum().backward()
+        stats = checkpoint_stats()
+        self.assertEqual(stats['checkpointed_regions'], len(segment_ends) - 1)
+        self.assertEqual(stats['recomputed_regions'], len(segment_ends) - 1)
+        self.assertGreater(stats['recompute_time'], 0)
+
 
 class TestDataLoader(TestCase):
     def setUp(self):
@@ -8,8 +8,12 @@ from .utils import CodeTemplate, write
 from .gen_variable_type import format_trace
 
 
+# In inference mode, factories return plain tensors; see NOTE [ Inference mode ].
 FUNCTION_TEMPLATE = CodeTemplate("""\
 inline at::Tensor ${name}(${formals}) {
+  if (at::InferenceMode::is_enabled()) {
+    return at::${name}(${actuals});
+  }
   ${pre_record_trace}
   at::Tensor tensor = at::${name}(${actuals});
   at::Tensor result =
@@ -195,6 +195,19 @@ DISPATCH_TO_NON_VAR_TYPE_WITHOUT_RETURN_VALUES = CodeTemplate("""\
 }
 """)
 
+# In inference mode, we skip all autograd bookkeeping and call the `baseType`
+# operation on the unwrapped arguments. The results are returned as they are,
+# i.e., as non-Variables. See NOTE [ Inference mode ] for details.
+INFERENCE_MODE_FAST_PATH = CodeTemplate("""\
+if (at::InferenceMode::is_enabled()) {
+  at::AutoNonVariableTypeMode non_var_type_mode(true);
+  ${statements}
+}
+""")
+
+CALL_INFERENCE = CodeTemplate("""\
+baseType->${method_prefix_derived}${api_name}(${inference_args})""")
+
 SET_HISTORY = CodeTemplate("""\
 if (grad_fn) {
     ${fn}_history(${differentiable_outputs}, grad_fn);
@@ -652,7 +665,9 @@ def emit_body(declaration):
                     assert not is_output
                 if inplace and is_output:
                     var = 'self'
-                expr = 'SavedVariable({}, {})'.format(var, str(is_output).lower())
+                # Passing grad_fn lets SavedVariable pick the codec registered for
+                # this function, see torch/csrc/autograd/saved_tensor_codecs.h
+                expr = 'SavedVariable({}, {}, grad_fn.get())'.format(var, str(is_output).lower())
             elif arg['type'] == 'TensorList':
                 name += '_'
                 expr = 'make_saved_variable_list({})'.format(arg['name'])
@@ -821,6 +836,24 @@ def emit_body(declaration):
         moved = ['std::move({})'.format(r['name']) for r in returns]
         return 'std::make_tuple({})'.format(', '.join(moved))
 
+    def emit_inference_fast_path():
+        inference_args = []
+        for arg in arguments:
+            if 'TensorOptions' in arg['dynamic_type']:
+                inference_args.append('TensorOptions({}).is_variable(false)'.format(arg['name']))
+            elif 'Tensor' in arg['dynamic_type']:
+                inference_args.append('unpack_inference({})'.format(arg['name']))
+            else:
+                inference_args.append(arg['name'])
+        call = CALL_INFERENCE.substitute(declaration, inference_args=inference_args)
+        if returns_void:
+            statements = [call + ';', 'return;']
+        elif modifies_arguments:
+            statements = [call + ';', 'return {};'.format(get_return_value())]
+        else:
+            statements = ['return {};'.format(call)]
+        return INFERENCE_MODE_FAST_PATH.substitute(statements=statements)
+
     def emit_history():
         fn = 'rebase' if modifies_arguments and view_info is None else 'set'
         output_names = [r['name'] for r in differentiable_outputs]
@@ -861,7 +894,7 @@ def emit_body(declaration):
     env = {}
     combined = nested_dict(env, declaration)
 
-    body = []
+    body = [emit_inference_fast_path()]
     if base_name not in DONT_PROFILE:
         input_names = record_function_input_names()
         body.append(
@@ -676,6 +676,38 @@ Tensor var_backward(Tensor grad, const Tensor & self, IntArrayRef dim, bool unbi
   return (2.0 / (_safe_size(self.sizes(), dim) - unbiased)) * grad * (self - self.mean(dim, true));
 }
 
+Tensor var_mean_backward(const Tensor & gvar, const Tensor & gmean, const Tensor & self, bool unbiased) {
+  Tensor gself;
+  if (gvar.defined()) {
+    gself = var_backward(gvar, self, unbiased);
+  }
+  if (gmean.defined()) {
+    auto aux = gmean.expand(self.sizes()) / self.numel();
+    gself = gself.defined() ? gself + aux : aux;
+  }
+  return gself;
+}
+
+Tensor var_mean_backward(const Tensor & gvar, const Tensor & gmean, const Tensor & self, IntArrayRef dim, bool unbiased, bool keepdim) {
+  Tensor gself;
+  if (gvar.defined()) {
+    gself = var_backward(gvar, self, dim, unbiased, keepdim);
+  }
+  if (gmean.defined()) {
+    auto aux = sum_backward(gmean, self.sizes(), dim, keepdim) / _safe_size(self.sizes(), dim);
+    gself = gself.defined() ? gself + aux : aux;
+  }
+  return gself;
+}
+
+Tensor std_mean_backward(const Tensor & gstd, const Tensor & gmean, const Tensor & self, const Tensor & std, bool unbiased) {
+  return var_mean_backward(gstd.defined() ? gstd / (std * 2) : gstd, gmean, self, unbiased);
+}
+
+Tensor std_mean_backward(const Tensor & gstd, const Tensor & gmean, const Tensor & self, const Tensor & std, IntArrayRef dim, bool unbiased, bool keepdim) {
+  return var_mean_backward(gstd.defined() ? gstd / (std * 2) : gstd, gmean, self, dim, unbiased, keepdim);
+}
+
 Tensor masked_scatter_backward(const Tensor & grad, const Tensor & mask, IntArrayRef sizes) {
   int64_t numel = 1;
   for (auto size : sizes) {
@@ -67,6 +67,11 @@ private:
   static at::SparseTensorRef unpack(SparseTensorRef t, const char * name, int pos);
   static at::Tensor unpack_opt(const Tensor & t, const char * name, int pos);
   static std::vector<at::Tensor> unpack(at::TensorList tl, const char *name, int pos);
+  // unwraps t if it is a Variable, for inference mode
+  static at::Tensor & unpack_inference(Tensor & t);
+  static const at::Tensor & unpack_inference(const Tensor & t);
+  static at::SparseTensorRef unpack_inference(SparseTensorRef t);
+  static std::vector<at::Tensor> unpack_inference(at::TensorList tl);
 
   at::TypeExtendedInterface* baseType;
   std::string str;
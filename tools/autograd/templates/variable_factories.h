@@ -19,6 +19,9 @@ namespace torch {
       at::ArrayRef<T> values, const at::TensorOptions& options) {          \
     at::Tensor result =                                                    \
         at::tensor(values, at::TensorOptions(options).is_variable(false)); \
+    if (at::InferenceMode::is_enabled()) {                                 \
+      return result;                                                       \
+    }                                                                      \
     return autograd::make_variable(result, options.requires_grad());       \
   }                                                                        \
   inline at::Tensor tensor(                                                \
@@ -58,6 +61,9 @@ inline at::Tensor from_blob(
     const at::TensorOptions& options = at::TensorOptions()) {
   at::Tensor tensor =
       at::from_blob(data, sizes, strides, deleter, options.is_variable(false));
+  if (at::InferenceMode::is_enabled()) {
+    return tensor;
+  }
   return autograd::make_variable(tensor, options.requires_grad());
 }
 
@@ -92,6 +98,9 @@ inline at::Tensor from_blob(
     const at::TensorOptions& options = at::TensorOptions()) {
   at::Tensor tensor =
       at::from_blob(data, sizes, deleter, options.is_variable(false));
+  if (at::InferenceMode::is_enabled()) {
+    return tensor;
+  }
   return autograd::make_variable(tensor, options.requires_grad());
 }
 
@@ -41,12 +41,15 @@ libtorch_sources = [
     "torch/csrc/autograd/function_hook.cpp",
     "torch/csrc/autograd/functions/accumulate_grad.cpp",
     "torch/csrc/autograd/functions/basic_ops.cpp",
+    "torch/csrc/autograd/functions/checkpoint.cpp",
     "torch/csrc/autograd/functions/tensor.cpp",
     "torch/csrc/autograd/functions/utils.cpp",
     "torch/csrc/autograd/grad_mode.cpp",
     "torch/csrc/autograd/input_buffer.cpp",
     "torch/csrc/autograd/profiler.cpp",
     "torch/csrc/autograd/record_function.cpp",
+    "torch/csrc/autograd/saved_tensor_codecs.cpp",
+    "torch/csrc/autograd/saved_tensor_offload.cpp",
     "torch/csrc/autograd/saved_variable.cpp",
     "torch/csrc/autograd/variable.cpp",
     "torch/csrc/Exceptions.cpp",
@@ -166,6 +169,7 @@ def add_torch_libs():
         "torch/csrc/api/src/data/samplers/random.cpp",
         "torch/csrc/api/src/data/samplers/sequential.cpp",
         "torch/csrc/api/src/data/samplers/stream.cpp",
+        "torch/csrc/api/src/nn/checkpoint.cpp",
         "torch/csrc/api/src/nn/init.cpp",
         "torch/csrc/api/src/nn/module.cpp",
         "torch/csrc/api/src/nn/modules/batchnorm.cpp",
@@ -186,6 +190,7 @@ def add_torch_libs():
         "torch/csrc/api/src/python/init.cpp",
         "torch/csrc/api/src/serialize/input-archive.cpp",
         "torch/csrc/api/src/serialize/output-archive.cpp",
+        "torch/csrc/api/src/serialize/stream.cpp",
         "torch/csrc/autograd/functions/init.cpp",
         "torch/csrc/autograd/init.cpp",
         "torch/csrc/autograd/python_anomaly_mode.cpp",
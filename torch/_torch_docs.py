@@ -4659,6 +4659,44 @@ Example::
     tensor([ 1.0311,  0.7477,  1.2204,  0.9087])
 """.format(**multi_dim_common))
 
+add_docstr(torch.std_mean,
+           r"""
+.. function:: std_mean(input, unbiased=True) -> (Tensor, Tensor)
+
+Returns the standard-deviation and the mean of all elements in the :attr:`input` tensor,
+computed together in a single pass over :attr:`input`.
+
+If :attr:`unbiased` is ``False``, then the standard-deviation will be calculated via the
+biased estimator. Otherwise, Bessel's correction will be used.
+
+Args:
+    input (Tensor): the input tensor
+    unbiased (bool): whether to use the unbiased estimation or not
+
+.. function:: std_mean(input, dim, keepdim=False, unbiased=True) -> (Tensor, Tensor)
+
+Returns the standard-deviation and the mean of each row of the :attr:`input` tensor in the
+given dimension :attr:`dim`. If :attr:`dim` is a list of dimensions, reduce
+over all of them.
+
+{keepdim_details}
+
+If :attr:`unbiased` is ``False``, then the standard-deviation will be calculated via the
+biased estimator. Otherwise, Bessel's correction will be used.
+
+Args:
+    input (Tensor): the input tensor
+    {dim}
+    {keepdim}
+    unbiased (bool): whether to use the unbiased estimation or not
+
+Example::
+
+    >>> a = torch.tensor([[1., 2., 3.], [4., 6., 8.]])
+    >>> torch.std_mean(a, 1)
+    (tensor([1., 2.]), tensor([2., 6.]))
+""".format(**multi_dim_common))
+
 add_docstr(torch.sum,
            r"""
 .. function:: sum(input, dtype=None) -> Tensor
@@ -5512,6 +5550,44 @@ Example::
     tensor([ 1.7444,  1.1363,  0.7356,  0.5112])
 """.format(**multi_dim_common))
 
+add_docstr(torch.var_mean,
+           r"""
+.. function:: var_mean(input, unbiased=True) -> (Tensor, Tensor)
+
+Returns the variance and the mean of all elements in the :attr:`input` tensor,
+computed together in a single pass over :attr:`input`.
+
+If :attr:`unbiased` is ``False``, then the variance will be calculated via the
+biased estimator. Otherwise, Bessel's correction will be used.
+
+Args:
+    input (Tensor): the input tensor
+    unbiased (bool): whether to use the unbiased estimation or not
+
+.. function:: var_mean(input, dim, keepdim=False, unbiased=True) -> (Tensor, Tensor)
+
+Returns the variance and the mean of each row of the :attr:`input` tensor in the
+given dimension :attr:`dim`. If :attr:`dim` is a list of dimensions, reduce
+over all of them.
+
+{keepdim_details}
+
+If :attr:`unbiased` is ``False``, then the variance will be calculated via the
+biased estimator. Otherwise, Bessel's correction will be used.
+
+Args:
+    input (Tensor): the input tensor
+    {dim}
+    {keepdim}
+    unbiased (bool): whether to use the unbiased estimation or not
+
+Example::
+
+    >>> a = torch.tensor([[1., 2., 3.], [4., 6., 8.]])
+    >>> torch.var_mean(a, 1)
+    (tensor([1., 4.]), tensor([2., 6.]))
+""".format(**multi_dim_common))
+
 add_docstr(torch.zeros,
            r"""
 zeros(*sizes, out=None, dtype=None, layout=torch.strided, device=None, requires_grad=False) -> Tensor
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <torch/nn/modules/sequential.h>
+#include <torch/types.h>
+
+#include <torch/csrc/WindowsTorchApiMacro.h>
+#include <torch/csrc/autograd/functions/checkpoint.h>
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+namespace torch {
+namespace nn {
+
+using autograd::CheckpointPlan;
+using autograd::CheckpointStats;
+using autograd::checkpoint_stats;
+using autograd::plan_checkpoints;
+using autograd::reset_checkpoint_stats;
+
+/// Applies `function` to `input` without keeping the intermediate activations
+/// of `function` alive for the backward pass. They are recomputed when the
+/// gradient of the result is needed, trading compute for memory. Random ops
+/// inside `function` see the same CPU random numbers during recomputation if
+/// `preserve_rng_state` is true.
+///
+/// Gradients flow to `input` and to every tensor that `function` uses
+/// internally (e.g. module parameters), just like without checkpointing.
+/// Checkpointing only works with `backward()`, not with `torch::autograd::grad`.
+TORCH_API Tensor checkpoint(
+    std::function<Tensor(const Tensor&)> function,
+    const Tensor& input,
+    bool preserve_rng_state = true);
+
+/// Runs `sequential` on `input`, checkpointing every segment but the last one.
+/// `segment_ends` holds the (exclusive) end index of each segment in
+/// increasing order; the last entry must be `sequential->size()`.
+TORCH_API Tensor checkpoint_sequential(
+    Sequential sequential,
+    const std::vector<size_t>& segment_ends,
+    const Tensor& input,
+    bool preserve_rng_state = true);
+
+/// Like `plan_checkpoints(activation_bytes, memory_budget)`, measuring the
+/// activation sizes by running `sequential` on `sample_input` once without
+/// recording gradients.
+TORCH_API CheckpointPlan plan_checkpoints(
+    Sequential sequential,
+    const Tensor& sample_input,
+    int64_t memory_budget);
+
+} // namespace nn
+} // namespace torch
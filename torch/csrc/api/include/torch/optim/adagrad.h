@@ -23,6 +23,9 @@ struct TORCH_API AdagradOptions {
   TORCH_ARG(double, learning_rate);
   TORCH_ARG(double, lr_decay) = 0;
   TORCH_ARG(double, weight_decay) = 0;
+  /// Update all dense CPU parameters with a single fused, vectorized kernel
+  /// instead of a sequence of ATen ops per parameter.
+  TORCH_ARG(bool, fused) = true;
 };
 
 class TORCH_API Adagrad : public Optimizer {
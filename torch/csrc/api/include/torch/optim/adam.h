@@ -26,6 +26,9 @@ struct TORCH_API AdamOptions {
   TORCH_ARG(double, weight_decay) = 0;
   TORCH_ARG(double, eps) = 1e-8;
   TORCH_ARG(bool, amsgrad) = false;
+  /// Update all dense CPU parameters with a single fused, vectorized kernel
+  /// instead of a sequence of ATen ops per parameter.
+  TORCH_ARG(bool, fused) = true;
 };
 
 class TORCH_API Adam : public Optimizer {
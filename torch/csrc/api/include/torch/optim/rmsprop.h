@@ -29,6 +29,9 @@ struct TORCH_API RMSpropOptions {
   TORCH_ARG(double, weight_decay) = 0;
   TORCH_ARG(double, momentum) = 0;
   TORCH_ARG(bool, centered) = false;
+  /// Update all dense CPU parameters with a single fused, vectorized kernel
+  /// instead of a sequence of ATen ops per parameter.
+  TORCH_ARG(bool, fused) = true;
 };
 
 class TORCH_API RMSprop : public Optimizer {
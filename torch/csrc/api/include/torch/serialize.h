@@ -3,7 +3,10 @@
 #include <torch/serialize/archive.h>
 #include <torch/serialize/tensor.h>
 
+#include <future>
+#include <string>
 #include <utility>
+#include <vector>
 
 namespace torch {
 
@@ -70,6 +73,69 @@ void save(const std::vector<torch::Tensor>& tensor_vec, SaveToArgs&&... args) {
   archive.save_to(std::forward<SaveToArgs>(args)...);
 }
 
+/// Serializes the given `value` like `torch::save`, but in the streaming format
+/// (see `serialize::OutputArchive::streaming`): every tensor is written to the
+/// file at `filename` as soon as it is visited, without building the whole
+/// archive in memory first. `torch::load` reads both formats, and maps files
+/// in the streaming format into memory instead of reading them eagerly.
+///
+/// \rst
+/// .. code-block:: cpp
+///
+///   torch::nn::Linear model(3, 4);
+///   torch::save_streaming(model, "model.pts");
+///   torch::load(model, "model.pts");
+/// \endrst
+template <typename Value>
+void save_streaming(const Value& value, const std::string& filename) {
+  auto archive = serialize::OutputArchive::streaming(filename);
+  archive << value;
+  archive.finish();
+}
+
+/// Serializes the given `tensor_vec` of type `std::vector<torch::Tensor>` in
+/// the streaming format.
+inline void save_streaming(
+    const std::vector<torch::Tensor>& tensor_vec,
+    const std::string& filename) {
+  auto archive = serialize::OutputArchive::streaming(filename);
+  for (size_t i = 0; i < tensor_vec.size(); i++) {
+    archive.write(std::to_string(i), tensor_vec[i]);
+  }
+  archive.finish();
+}
+
+/// Starts a checkpoint of the given `value` in the streaming format and
+/// returns a future that becomes ready when the file at `filename` is
+/// complete. A snapshot of all tensors is taken before this returns, so
+/// training can modify them while the file is written in the background.
+///
+/// \rst
+/// .. code-block:: cpp
+///
+///   auto checkpoint = torch::save_async(model, "model.pts");
+///   optimizer.step();
+///   checkpoint.get();
+/// \endrst
+template <typename Value>
+std::future<void> save_async(const Value& value, const std::string& filename) {
+  auto archive = serialize::OutputArchive::streaming(filename, /*async=*/true);
+  archive << value;
+  return archive.finish_async();
+}
+
+/// Starts a checkpoint of the given `tensor_vec` of type
+/// `std::vector<torch::Tensor>` in the streaming format.
+inline std::future<void> save_async(
+    const std::vector<torch::Tensor>& tensor_vec,
+    const std::string& filename) {
+  auto archive = serialize::OutputArchive::streaming(filename, /*async=*/true);
+  for (size_t i = 0; i < tensor_vec.size(); i++) {
+    archive.write(std::to_string(i), tensor_vec[i]);
+  }
+  return archive.finish_async();
+}
+
 /// Deserializes the given `value`.
 /// There must be an overload of `operator>>` between `serialize::InputArchive`
 /// and `Value` for this method to be well-formed. Currently, such an overload
@@ -25,6 +25,9 @@ struct Module;
 
 namespace torch {
 namespace serialize {
+namespace detail {
+class StreamReader;
+} // namespace detail
 
 /// A recursive representation of tensors that can be deserialized from a file
 /// or stream. In most cases, users should not have to interact with this class,
@@ -68,6 +71,11 @@ class TORCH_API InputArchive final {
   /// Loads the `InputArchive` from a serialized representation stored in the
   /// file at `filename`. Storage are remapped using device option. If device
   /// is not specified, the module is loaded to the original device.
+  ///
+  /// Files in the streaming format (see `OutputArchive::streaming`) are
+  /// mapped into memory and only their index is read here; each tensor is
+  /// created when it is first read, and CPU tensors use the mapped memory
+  /// without a copy.
   void load_from(const std::string& filename,
       c10::optional<torch::Device> device = c10::nullopt);
 
@@ -87,6 +95,10 @@ class TORCH_API InputArchive final {
 
  private:
   std::shared_ptr<jit::script::Module> module_;
+  // Set for archives in the streaming format.
+  std::shared_ptr<detail::StreamReader> reader_;
+  std::string prefix_;
+  c10::optional<torch::Device> device_;
 };
 } // namespace serialize
 } // namespace torch
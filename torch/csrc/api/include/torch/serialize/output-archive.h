@@ -2,6 +2,7 @@
 
 #include <torch/csrc/WindowsTorchApiMacro.h>
 
+#include <future>
 #include <iosfwd>
 #include <memory>
 #include <string>
@@ -22,6 +23,10 @@ struct Module;
 
 namespace torch {
 namespace serialize {
+namespace detail {
+class StreamWriter;
+} // namespace detail
+
 class TORCH_API OutputArchive final {
  public:
   /// Default-constructs the `OutputArchive`.
@@ -35,6 +40,25 @@ class TORCH_API OutputArchive final {
   OutputArchive(OutputArchive&) = delete;
   OutputArchive& operator=(OutputArchive&) = delete;
 
+  /// Creates an `OutputArchive` in the streaming format (see
+  /// `torch/serialize/stream.h`), which writes every tensor to the file at
+  /// `filename` when it is written to the archive, instead of collecting
+  /// them until `save_to()`. Nested archives are written when they are
+  /// written to this archive. Call `finish()` or `finish_async()` after the
+  /// last write.
+  ///
+  /// If `async` is true, writes only take a snapshot of the tensor and the
+  /// file is written on a background thread, so the tensors can be modified
+  /// as soon as they have been written to the archive.
+  static OutputArchive streaming(const std::string& filename, bool async = false);
+
+  /// Completes the file of a streaming `OutputArchive`.
+  void finish();
+
+  /// Completes the file of a streaming `OutputArchive` in the background. The
+  /// returned future becomes ready when the file is complete.
+  std::future<void> finish_async();
+
   /// Writes a `(key, tensor)` pair to the `OutputArchive`, and marks it as
   /// being or not being a buffer (non-differentiable tensor).
   void write(
@@ -64,6 +88,8 @@ class TORCH_API OutputArchive final {
 
  private:
   std::shared_ptr<jit::script::Module> module_;
+  // Set for streaming archives.
+  std::shared_ptr<detail::StreamWriter> writer_;
 };
 } // namespace serialize
 } // namespace torch
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <torch/csrc/WindowsTorchApiMacro.h>
+#include <torch/types.h>
+
+#include <c10/core/Device.h>
+#include <c10/util/Optional.h>
+
+#include <cstdint>
+#include <future>
+#include <iosfwd>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace torch {
+namespace serialize {
+namespace detail {
+
+/// The streaming archive format. Unlike the default format (a zip file written
+/// by `jit::ExportModule`), tensors are appended to the file one by one as
+/// they are written to the archive, and an index of all tensors is written at
+/// the end:
+///
+///   magic | data of tensor 0 | ... | data of tensor N-1 | index | footer
+///
+/// The data of every tensor is stored contiguously and uncompressed at an
+/// offset that is a multiple of `kStreamAlignment`, so that the tensors of an
+/// archive mapped into memory can be used in place. The index holds one entry
+/// per tensor (see `StreamRecord`) and the footer the offset of the index, the
+/// number of entries and the magic again. Integers are stored in host byte
+/// order. Keys of nested archives are joined with '\0'.
+constexpr char kStreamMagic[] = "PTSTRM01";
+constexpr size_t kStreamMagicSize = 8;
+constexpr size_t kStreamAlignment = 64;
+
+struct StreamRecord {
+  at::ScalarType dtype;
+  Device device{kCPU};
+  std::vector<int64_t> sizes;
+  bool is_buffer = false;
+  bool requires_grad = false;
+  uint64_t offset = 0;
+  uint64_t nbytes = 0;
+};
+
+/// Returns true if the file at `filename` is in the streaming format.
+TORCH_API bool is_stream_archive(const std::string& filename);
+/// Returns true if `stream` is in the streaming format. Leaves the read position
+/// unchanged.
+TORCH_API bool is_stream_archive(std::istream& stream);
+
+/// Appends tensors to a file in the streaming format.
+///
+/// In synchronous mode, `write()` returns after the data of the tensor has been
+/// handed to the file. In asynchronous mode, `write()` takes a snapshot (a
+/// copy in CPU memory) of the tensor and returns; a background thread writes
+/// the snapshots in order. The snapshot may cost a memory copy per tensor, but
+/// it lets the caller modify the tensors right away.
+class TORCH_API StreamWriter {
+ public:
+  StreamWriter(const std::string& filename, bool async);
+  ~StreamWriter();
+
+  StreamWriter(const StreamWriter&) = delete;
+  StreamWriter& operator=(const StreamWriter&) = delete;
+
+  void write(const std::string& name, const Tensor& tensor, bool is_buffer);
+
+  /// Writes the index and closes the file, after all pending writes.
+  void finish();
+
+  /// Like `finish()`, but returns right away. The future becomes ready once the
+  /// file is complete, or holds the exception that stopped the writer.
+  std::future<void> finish_async();
+
+  /// Number of tensor bytes written (or queued) so far.
+  int64_t bytes_written() const;
+
+ private:
+  struct State;
+  std::shared_ptr<State> state_;
+};
+
+/// Reads the index of a file in the streaming format and creates the tensors
+/// on demand. Files are mapped into memory, and CPU tensors point into the
+/// mapping (copy-on-write); streams are read into memory once.
+class TORCH_API StreamReader : public std::enable_shared_from_this<StreamReader> {
+ public:
+  explicit StreamReader(const std::string& filename);
+  explicit StreamReader(std::istream& stream);
+
+  /// Returns the record with the given name, or nullptr.
+  const StreamRecord* find(const std::string& name) const;
+
+  /// Returns true if any record name starts with `prefix`.
+  bool has_prefix(const std::string& prefix) const;
+
+  /// Creates the tensor of `record`, on `device` if given and on the device it
+  /// was saved from otherwise.
+  Tensor tensor(
+      const StreamRecord& record,
+      c10::optional<Device> device) const;
+
+ private:
+  void parse_index();
+
+  at::DataPtr data_;
+  size_t size_ = 0;
+  std::map<std::string, StreamRecord> records_;
+};
+
+} // namespace detail
+} // namespace serialize
+} // namespace torch
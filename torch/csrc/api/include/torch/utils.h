@@ -6,6 +6,7 @@
 
 namespace torch {
 using autograd::AutoGradMode;
+using autograd::AutoInferenceMode;
 
 // A RAII, thread local (!) guard that stops future operations from building
 // gradients.
@@ -13,6 +14,13 @@ struct TORCH_API NoGradGuard : public AutoGradMode {
   NoGradGuard() : AutoGradMode(/*enabled=*/false) {}
 };
 
+// A RAII, thread local (!) guard that makes future operations skip autograd
+// entirely. Tensors created in inference mode are plain tensors and cannot be
+// used with autograd later; see NOTE [ Inference mode ] for details.
+struct TORCH_API InferenceModeGuard : public AutoInferenceMode {
+  InferenceModeGuard() : AutoInferenceMode(/*enabled=*/true) {}
+};
+
 /// Sets the global random seed for all newly created CPU and CUDA tensors.
 using at::manual_seed;
 } // namespace torch
@@ -0,0 +1,93 @@
+#include <torch/nn/checkpoint.h>
+
+#include <torch/types.h>
+#include <torch/utils.h>
+
+#include <torch/csrc/autograd/functions/checkpoint.h>
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace torch {
+namespace nn {
+namespace {
+// Runs the modules [begin, end) of `sequential` on `input`.
+Tensor run_segment(
+    Sequential& sequential,
+    size_t begin,
+    size_t end,
+    Tensor input) {
+  for (auto module = sequential->begin() + begin;
+       module != sequential->begin() + end;
+       ++module) {
+    input = module->forward(std::move(input));
+  }
+  return input;
+}
+} // namespace
+
+Tensor checkpoint(
+    std::function<Tensor(const Tensor&)> function,
+    const Tensor& input,
+    bool preserve_rng_state) {
+  auto outputs = autograd::checkpoint(
+      [function](const autograd::variable_list& inputs) {
+        return autograd::variable_list{function(inputs[0])};
+      },
+      {input},
+      preserve_rng_state);
+  return outputs[0];
+}
+
+Tensor checkpoint_sequential(
+    Sequential sequential,
+    const std::vector<size_t>& segment_ends,
+    const Tensor& input,
+    bool preserve_rng_state) {
+  AT_CHECK(
+      !segment_ends.empty() && segment_ends.back() == sequential->size(),
+      "The last segment must end at the end of the Sequential (",
+      sequential->size(),
+      ")");
+  Tensor output = input;
+  size_t begin = 0;
+  for (size_t s = 0; s < segment_ends.size(); ++s) {
+    const size_t end = segment_ends[s];
+    AT_CHECK(
+        begin < end, "Checkpoint segments must be non-empty and increasing");
+    if (s + 1 == segment_ends.size()) {
+      // The last segment is differentiated right away, recomputing it would
+      // not save anything.
+      output = run_segment(sequential, begin, end, std::move(output));
+    } else {
+      output = checkpoint(
+          [sequential, begin, end](const Tensor& segment_input) mutable {
+            return run_segment(sequential, begin, end, segment_input);
+          },
+          output,
+          preserve_rng_state);
+    }
+    begin = end;
+  }
+  return output;
+}
+
+CheckpointPlan plan_checkpoints(
+    Sequential sequential,
+    const Tensor& sample_input,
+    int64_t memory_budget) {
+  std::vector<int64_t> activation_bytes;
+  activation_bytes.reserve(sequential->size());
+  {
+    NoGradGuard guard;
+    Tensor output = sample_input;
+    for (auto& module : *sequential) {
+      output = module.forward(std::move(output));
+      activation_bytes.push_back(output.nbytes());
+    }
+  }
+  return plan_checkpoints(activation_bytes, memory_budget);
+}
+} // namespace nn
+} // namespace torch
@@ -5,8 +5,10 @@
 #include <torch/utils.h>
 
 #include <ATen/ATen.h>
+#include <ATen/native/FusedOptimizers.h>
 
 #include <functional>
+#include <vector>
 
 namespace torch {
 namespace optim {
@@ -17,27 +19,47 @@ AdagradOptions::AdagradOptions(double learning_rate)
 /// Adapted from
 /// https://github.com/pytorch/pytorch/blob/master/torch/optim/adagrad.py
 void Adagrad::step() {
+  std::vector<Tensor> params, grads, sums;
+  std::vector<double> learning_rates;
   for (size_t i = 0; i < parameters_.size(); ++i) {
     Tensor p = parameters_.at(i);
     if (!p.grad().defined()) {
       continue;
     }
 
-    if (options.weight_decay_ > 0) {
-      p.grad() = p.grad() + options.weight_decay_ * p;
-    }
-
     buffer_at(step_buffers, i) += 1.0;
     const auto clr = options.learning_rate_ /
         (1.0 + (buffer_at(step_buffers, i) - 1.0) * options.lr_decay_);
 
     auto& sum = buffer_at(sum_buffers, i);
+    if (options.fused_ &&
+        at::native::fused_optimizer_supported(p, {p.grad(), sum})) {
+      params.push_back(autograd::as_variable_ref(p).data());
+      grads.push_back(autograd::as_variable_ref(p.grad()).data());
+      sums.push_back(autograd::as_variable_ref(sum).data());
+      learning_rates.push_back(clr);
+      autograd::as_variable_ref(p).bump_version();
+      continue;
+    }
+
+    if (options.weight_decay_ > 0) {
+      p.grad() = p.grad() + options.weight_decay_ * p;
+    }
+
     sum.addcmul_(p.grad(), p.grad(), 1.0);
     const auto std = buffer_at(sum_buffers, i).sqrt().add_(1e-10);
 
     NoGradGuard guard;
     p.addcdiv_(p.grad(), std, -clr);
   }
+
+  if (!params.empty()) {
+    at::native::FusedAdagradOptions fused_options;
+    fused_options.weight_decay = options.weight_decay_;
+    fused_options.eps = 1e-10;
+    at::native::fused_adagrad_step_(
+        params, grads, sums, learning_rates, fused_options);
+  }
 }
 
 void Adagrad::save(serialize::OutputArchive& archive) const {
@@ -6,9 +6,11 @@
 #include <torch/utils.h>
 
 #include <ATen/ATen.h>
+#include <ATen/native/FusedOptimizers.h>
 
 #include <cmath>
 #include <functional>
+#include <vector>
 
 namespace torch {
 namespace optim {
@@ -16,20 +18,52 @@ AdamOptions::AdamOptions(double learning_rate)
     : learning_rate_(learning_rate) {}
 
 void Adam::step() {
+  std::vector<Tensor> params, grads, exp_averages, exp_average_sqs,
+      max_exp_average_sqs;
+  std::vector<double> step_sizes;
   for (size_t i = 0; i < parameters_.size(); ++i) {
     Tensor p = parameters_.at(i);
     if (!p.grad().defined()) {
       continue;
     }
 
-    if (options.weight_decay_ > 0) {
-      p.grad() = p.grad() + options.weight_decay_ * p;
-    }
-
     auto& exp_average = buffer_at(exp_average_buffers, i);
     auto& exp_average_sq = buffer_at(exp_average_sq_buffers, i);
 
     buffer_at(step_buffers, i) += 1;
+    const auto bias_correction1 =
+        1 - std::pow(options.beta1_, buffer_at(step_buffers, i));
+    const auto bias_correction2 =
+        1 - std::pow(options.beta2_, buffer_at(step_buffers, i));
+    const auto step_size =
+        options.learning_rate_ * std::sqrt(bias_correction2) / bias_correction1;
+
+    if (options.fused_) {
+      Tensor max_exp_average_sq;
+      if (options.amsgrad_) {
+        max_exp_average_sq = buffer_at(max_exp_average_sq_buffers, i);
+      }
+      if (at::native::fused_optimizer_supported(
+              p,
+              {p.grad(), exp_average, exp_average_sq, max_exp_average_sq})) {
+        params.push_back(autograd::as_variable_ref(p).data());
+        grads.push_back(autograd::as_variable_ref(p.grad()).data());
+        exp_averages.push_back(autograd::as_variable_ref(exp_average).data());
+        exp_average_sqs.push_back(
+            autograd::as_variable_ref(exp_average_sq).data());
+        if (options.amsgrad_) {
+          max_exp_average_sqs.push_back(
+              autograd::as_variable_ref(max_exp_average_sq).data());
+        }
+        step_sizes.push_back(step_size);
+        autograd::as_variable_ref(p).bump_version();
+        continue;
+      }
+    }
+
+    if (options.weight_decay_ > 0) {
+      p.grad() = p.grad() + options.weight_decay_ * p;
+    }
 
     exp_average.mul_(options.beta1_).add_(p.grad(), 1 - options.beta1_);
     exp_average_sq.mul_(options.beta2_)
@@ -42,16 +76,26 @@ void Adam::step() {
       denom = max_exp_average_sq;
     }
 
-    const auto bias_correction1 =
-        1 - std::pow(options.beta1_, buffer_at(step_buffers, i));
-    const auto bias_correction2 =
-        1 - std::pow(options.beta2_, buffer_at(step_buffers, i));
-    const auto step_size =
-        options.learning_rate_ * std::sqrt(bias_correction2) / bias_correction1;
-
     NoGradGuard guard;
     p.addcdiv_(exp_average, denom.sqrt() + options.eps_, -step_size);
   }
+
+  if (!params.empty()) {
+    at::native::FusedAdamOptions fused_options;
+    fused_options.beta1 = options.beta1_;
+    fused_options.beta2 = options.beta2_;
+    fused_options.eps = options.eps_;
+    fused_options.weight_decay = options.weight_decay_;
+    fused_options.amsgrad = options.amsgrad_;
+    at::native::fused_adam_step_(
+        params,
+        grads,
+        exp_averages,
+        exp_average_sqs,
+        max_exp_average_sqs,
+        step_sizes,
+        fused_options);
+  }
 }
 
 void Adam::save(serialize::OutputArchive& archive) const {
@@ -5,8 +5,10 @@
 #include <torch/utils.h>
 
 #include <ATen/ATen.h>
+#include <ATen/native/FusedOptimizers.h>
 
 #include <functional>
+#include <vector>
 
 namespace torch {
 namespace optim {
@@ -17,17 +19,46 @@ RMSpropOptions::RMSpropOptions(double learning_rate)
 /// Adapted from
 /// https://github.com/pytorch/pytorch/blob/master/torch/optim/rmsprop.py
 void RMSprop::step() {
+  std::vector<Tensor> params, grads, square_averages, momentums,
+      grad_averages;
   for (size_t i = 0; i < parameters_.size(); ++i) {
     Tensor p = parameters_.at(i);
     if (!p.grad().defined()) {
       continue;
     }
 
+    auto square_average = buffer_at(square_average_buffers, i);
+
+    if (options.fused_) {
+      Tensor momentum, grad_average;
+      if (options.momentum_ > 0) {
+        momentum = buffer_at(momentum_buffers, i);
+      }
+      if (options.centered_ > 0) {
+        grad_average = buffer_at(grad_average_buffers, i);
+      }
+      if (at::native::fused_optimizer_supported(
+              p, {p.grad(), square_average, momentum, grad_average})) {
+        params.push_back(autograd::as_variable_ref(p).data());
+        grads.push_back(autograd::as_variable_ref(p.grad()).data());
+        square_averages.push_back(
+            autograd::as_variable_ref(square_average).data());
+        if (momentum.defined()) {
+          momentums.push_back(autograd::as_variable_ref(momentum).data());
+        }
+        if (grad_average.defined()) {
+          grad_averages.push_back(
+              autograd::as_variable_ref(grad_average).data());
+        }
+        autograd::as_variable_ref(p).bump_version();
+        continue;
+      }
+    }
+
     if (options.weight_decay_ > 0) {
       p.grad() = p.grad() + options.weight_decay_ * p;
     }
 
-    auto square_average = buffer_at(square_average_buffers, i);
     square_average.mul_(options.alpha_)
         .addcmul_(p.grad(), p.grad(), 1.0 - options.alpha_);
 
@@ -51,6 +82,23 @@ void RMSprop::step() {
       p.addcdiv_(p.grad(), average, -options.learning_rate_);
     }
   }
+
+  if (!params.empty()) {
+    at::native::FusedRMSpropOptions fused_options;
+    fused_options.learning_rate = options.learning_rate_;
+    fused_options.alpha = options.alpha_;
+    fused_options.eps = options.eps_;
+    fused_options.weight_decay = options.weight_decay_;
+    fused_options.momentum = options.momentum_;
+    fused_options.centered = options.centered_;
+    at::native::fused_rmsprop_step_(
+        params,
+        grads,
+        square_averages,
+        momentums,
+        grad_averages,
+        fused_options);
+  }
 }
 
 void RMSprop::save(serialize::OutputArchive& archive) const {
@@ -8,14 +8,18 @@
 #include <torch/utils.h>
 
 #include <ATen/ATen.h>
+#include <ATen/native/FusedOptimizers.h>
 
 #include <functional>
+#include <vector>
 
 namespace torch {
 namespace optim {
 SGDOptions::SGDOptions(double learning_rate) : learning_rate_(learning_rate) {}
 
 void SGD::step() {
+  const auto dampening = iteration_ == 0 ? 1 : 1 - options.dampening_;
+  std::vector<Tensor> params, grads, momentums;
   for (size_t i = 0; i < parameters_.size(); ++i) {
     Tensor p = parameters_.at(i);
 
@@ -23,6 +27,22 @@ void SGD::step() {
       continue;
     }
 
+    if (options.fused_) {
+      Tensor momentum;
+      if (options.momentum_ != 0) {
+        momentum = buffer_at(momentum_buffers, i);
+      }
+      if (at::native::fused_optimizer_supported(p, {p.grad(), momentum})) {
+        params.push_back(autograd::as_variable_ref(p).data());
+        grads.push_back(autograd::as_variable_ref(p.grad()).data());
+        if (options.momentum_ != 0) {
+          momentums.push_back(autograd::as_variable_ref(momentum).data());
+        }
+        autograd::as_variable_ref(p).bump_version();
+        continue;
+      }
+    }
+
     auto update = p.grad();
 
     if (options.weight_decay_ > 0) {
@@ -30,7 +50,6 @@ void SGD::step() {
     }
 
     if (options.momentum_ != 0) {
-      const auto dampening = iteration_ == 0 ? 1 : 1 - options.dampening_;
       auto& momentum = buffer_at(momentum_buffers, i);
       momentum = (options.momentum_ * momentum) + (dampening * update);
       if (options.nesterov_) {
@@ -45,6 +64,16 @@ void SGD::step() {
     NoGradGuard guard;
     p.add_(-options.learning_rate_ * update);
   }
+
+  if (!params.empty()) {
+    at::native::FusedSGDOptions fused_options;
+    fused_options.learning_rate = options.learning_rate_;
+    fused_options.momentum = options.momentum_;
+    fused_options.dampening = dampening;
+    fused_options.weight_decay = options.weight_decay_;
+    fused_options.nesterov = options.nesterov_;
+    at::native::fused_sgd_step_(params, grads, momentums, fused_options);
+  }
   iteration_ += 1;
 }
 
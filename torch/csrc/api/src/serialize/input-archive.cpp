@@ -1,5 +1,6 @@
 #include <torch/serialize/input-archive.h>
 
+#include <torch/serialize/stream.h>
 #include <torch/types.h>
 #include <torch/utils.h>
 
@@ -23,18 +24,32 @@ bool InputArchive::try_read(
     const std::string& key,
     Tensor& tensor,
     bool is_buffer) {
-  auto param = module_->find_parameter(key);
-  auto buffer = module_->find_buffer(key);
-  if (param == nullptr && buffer == nullptr) return false;
+  Tensor read_tensor;
+  if (reader_) {
+    auto record = reader_->find(prefix_ + key);
+    if (record == nullptr) return false;
 
-  // clang-format off
-  auto read_param = is_buffer ? buffer : param;
-  auto read_tensor = read_param->value().toTensor();
-  AT_CHECK(
-      bool(buffer) == is_buffer,
-      "Expected deserialized tensor for key '", key,
-      "' to ", is_buffer ? "not " : "", "be a buffer, but it was not");
-  // clang-format on
+    // clang-format off
+    AT_CHECK(
+        record->is_buffer == is_buffer,
+        "Expected deserialized tensor for key '", key,
+        "' to ", is_buffer ? "not " : "", "be a buffer, but it was not");
+    // clang-format on
+    read_tensor = reader_->tensor(*record, device_);
+  } else {
+    auto param = module_->find_parameter(key);
+    auto buffer = module_->find_buffer(key);
+    if (param == nullptr && buffer == nullptr) return false;
+
+    // clang-format off
+    auto read_param = is_buffer ? buffer : param;
+    read_tensor = read_param->value().toTensor();
+    AT_CHECK(
+        bool(buffer) == is_buffer,
+        "Expected deserialized tensor for key '", key,
+        "' to ", is_buffer ? "not " : "", "be a buffer, but it was not");
+    // clang-format on
+  }
   if (tensor.defined()) {
     torch::NoGradGuard guard;
     if (tensor.device() != read_tensor.device()) {
@@ -60,6 +75,16 @@ void InputArchive::read(
 }
 
 bool InputArchive::try_read(const std::string& key, InputArchive& archive) {
+  if (reader_) {
+    auto prefix = prefix_ + key + '\0';
+    if (!reader_->has_prefix(prefix)) {
+      return false;
+    }
+    archive.reader_ = reader_;
+    archive.prefix_ = std::move(prefix);
+    archive.device_ = device_;
+    return true;
+  }
   if (auto named_module = module_->find_module(key)) {
     archive.module_ = std::move(named_module);
     return true;
@@ -76,11 +101,21 @@ void InputArchive::read(const std::string& key, InputArchive& archive) {
 
 void InputArchive::load_from(const std::string& filename,
     c10::optional<torch::Device> device /*= c10::nullopt*/) {
+  if (detail::is_stream_archive(filename)) {
+    reader_ = std::make_shared<detail::StreamReader>(filename);
+    device_ = std::move(device);
+    return;
+  }
   module_ = torch::jit::load(filename, std::move(device));
 }
 
 void InputArchive::load_from(std::istream& stream,
     c10::optional<torch::Device> device /*= c10::nullopt*/) {
+  if (detail::is_stream_archive(stream)) {
+    reader_ = std::make_shared<detail::StreamReader>(stream);
+    device_ = std::move(device);
+    return;
+  }
   module_ = torch::jit::load(stream, std::move(device));
 }
 } // namespace serialize
@@ -1,5 +1,6 @@
 #include <torch/serialize/output-archive.h>
 
+#include <torch/serialize/stream.h>
 #include <torch/types.h>
 #include <torch/utils.h>
 
@@ -14,29 +15,85 @@
 
 namespace torch {
 namespace serialize {
+namespace {
+// Keys of nested archives are joined with '\0' in the streaming format.
+void stream_module(
+    detail::StreamWriter& writer,
+    const std::string& prefix,
+    const jit::script::Module& module) {
+  for (const auto& slot : module.get_parameters()) {
+    writer.write(prefix + slot.name(), slot.value().toTensor(), false);
+  }
+  for (const auto& slot : module.get_attributes()) {
+    if (slot.type()->isSubtypeOf(c10::TensorType::get())) {
+      writer.write(prefix + slot.name(), slot.value().toTensor(), true);
+    }
+  }
+  for (const auto& child : module.get_modules()) {
+    stream_module(writer, prefix + child->name() + '\0', *child);
+  }
+}
+} // namespace
+
 OutputArchive::OutputArchive()
     : module_(std::make_shared<jit::script::Module>()) {}
 
+OutputArchive OutputArchive::streaming(
+    const std::string& filename,
+    bool async) {
+  OutputArchive archive;
+  archive.writer_ = std::make_shared<detail::StreamWriter>(filename, async);
+  return archive;
+}
+
+void OutputArchive::finish() {
+  AT_CHECK(writer_ != nullptr, "finish() requires a streaming OutputArchive");
+  writer_->finish();
+}
+
+std::future<void> OutputArchive::finish_async() {
+  AT_CHECK(
+      writer_ != nullptr, "finish_async() requires a streaming OutputArchive");
+  return writer_->finish_async();
+}
+
 void OutputArchive::write(
     const std::string& key,
     const Tensor& tensor,
     bool is_buffer) {
-  module_->register_parameter(key, tensor, is_buffer);
+  if (writer_) {
+    writer_->write(key, tensor, is_buffer);
+  } else {
+    module_->register_parameter(key, tensor, is_buffer);
+  }
 }
 
 void OutputArchive::write(
     const std::string& key,
     OutputArchive& nested_archive) {
-  module_->register_module(key, nested_archive.module_);
+  AT_CHECK(
+      nested_archive.writer_ == nullptr,
+      "Cannot nest a streaming OutputArchive");
+  if (writer_) {
+    stream_module(*writer_, key + '\0', *nested_archive.module_);
+  } else {
+    module_->register_module(key, nested_archive.module_);
+  }
 }
 
 void OutputArchive::save_to(const std::string& filename) {
   AT_ASSERT(module_ != nullptr);
+  AT_CHECK(
+      writer_ == nullptr,
+      "A streaming OutputArchive is saved with finish(), not save_to()");
   jit::ExportModule(*module_, filename);
 }
 
 void OutputArchive::save_to(std::ostream& stream) {
   AT_ASSERT(module_ != nullptr);
+  AT_CHECK(
+      writer_ == nullptr,
+      "A streaming OutputArchive is saved with finish(), not save_to()");
   jit::ExportModule(*module_, stream);
 }
 } // namespace serialize
@@ -0,0 +1,355 @@
+#include <torch/serialize/stream.h>
+
+#include <torch/types.h>
+#include <torch/utils.h>
+
+#include <torch/csrc/autograd/variable.h>
+
+#include <TH/THAllocator.h>
+#include <c10/core/CPUAllocator.h>
+#include <c10/util/Exception.h>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <fstream>
+#include <istream>
+#include <limits>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace torch {
+namespace serialize {
+namespace detail {
+
+namespace {
+constexpr size_t kFooterSize = 2 * sizeof(uint64_t) + kStreamMagicSize;
+
+template <typename T>
+void write_value(std::ostream& stream, T value) {
+  stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+T read_value(const char* data, size_t size, size_t& position) {
+  AT_CHECK(
+      position <= size && sizeof(T) <= size - position,
+      "Malformed streaming archive: index is truncated");
+  T value;
+  std::memcpy(&value, data + position, sizeof(T));
+  position += sizeof(T);
+  return value;
+}
+} // namespace
+
+bool is_stream_archive(const std::string& filename) {
+  std::ifstream file(filename, std::ios::binary);
+  return file && is_stream_archive(file);
+}
+
+bool is_stream_archive(std::istream& stream) {
+  const auto position = stream.tellg();
+  char magic[kStreamMagicSize] = {};
+  stream.read(magic, kStreamMagicSize);
+  const bool matches =
+      stream.gcount() == static_cast<std::streamsize>(kStreamMagicSize) &&
+      std::memcmp(magic, kStreamMagic, kStreamMagicSize) == 0;
+  stream.clear();
+  stream.seekg(position);
+  return matches;
+}
+
+struct StreamWriter::State {
+  struct PendingWrite {
+    std::string name;
+    Tensor data;
+    StreamRecord record;
+  };
+
+  std::ofstream file;
+  std::string filename;
+  uint64_t offset = 0;
+  std::vector<std::pair<std::string, StreamRecord>> index;
+  std::atomic<int64_t> bytes_written{0};
+  bool async = false;
+  bool finished = false;
+
+  // Only used in asynchronous mode.
+  std::mutex mutex;
+  std::condition_variable cv;
+  std::deque<PendingWrite> queue;
+  bool closing = false;
+  std::promise<void> done;
+
+  void append(const std::string& name, const Tensor& data, StreamRecord record) {
+    const uint64_t padding =
+        (kStreamAlignment - offset % kStreamAlignment) % kStreamAlignment;
+    if (padding > 0) {
+      const char zeros[kStreamAlignment] = {};
+      file.write(zeros, padding);
+      offset += padding;
+    }
+    record.offset = offset;
+    file.write(static_cast<const char*>(data.data_ptr()), record.nbytes);
+    offset += record.nbytes;
+    AT_CHECK(file, "Failed to write tensor '", name, "' to ", filename);
+    index.emplace_back(name, std::move(record));
+  }
+
+  void write_index() {
+    const uint64_t index_offset = offset;
+    for (const auto& entry : index) {
+      const auto& name = entry.first;
+      const auto& record = entry.second;
+      write_value<uint32_t>(file, name.size());
+      file.write(name.data(), name.size());
+      write_value<int8_t>(file, static_cast<int8_t>(record.dtype));
+      write_value<int8_t>(file, static_cast<int8_t>(record.device.type()));
+      write_value<int16_t>(file, record.device.index());
+      write_value<uint8_t>(file, record.is_buffer);
+      write_value<uint8_t>(file, record.requires_grad);
+      write_value<uint32_t>(file, record.sizes.size());
+      for (auto size : record.sizes) {
+        write_value<int64_t>(file, size);
+      }
+      write_value<uint64_t>(file, record.offset);
+      write_value<uint64_t>(file, record.nbytes);
+    }
+    write_value<uint64_t>(file, index_offset);
+    write_value<uint64_t>(file, index.size());
+    file.write(kStreamMagic, kStreamMagicSize);
+    file.close();
+    AT_CHECK(file, "Failed to write the index of ", filename);
+  }
+
+  static void run(std::shared_ptr<State> state) {
+    try {
+      while (true) {
+        PendingWrite write;
+        {
+          std::unique_lock<std::mutex> lock(state->mutex);
+          state->cv.wait(
+              lock, [&] { return !state->queue.empty() || state->closing; });
+          if (state->queue.empty()) {
+            break;
+          }
+          write = std::move(state->queue.front());
+          state->queue.pop_front();
+        }
+        state->append(write.name, write.data, std::move(write.record));
+      }
+      state->write_index();
+      state->done.set_value();
+    } catch (...) {
+      state->done.set_exception(std::current_exception());
+    }
+  }
+};
+
+StreamWriter::StreamWriter(const std::string& filename, bool async)
+    : state_(std::make_shared<State>()) {
+  state_->filename = filename;
+  state_->async = async;
+  state_->file.open(filename, std::ios::binary | std::ios::trunc);
+  AT_CHECK(state_->file, "Could not open ", filename, " for writing");
+  state_->file.write(kStreamMagic, kStreamMagicSize);
+  state_->offset = kStreamMagicSize;
+  if (async) {
+    // The thread keeps the state alive, so that the archive need not outlive
+    // the checkpoint it started.
+    std::thread(&State::run, state_).detach();
+  }
+}
+
+StreamWriter::~StreamWriter() {
+  if (!state_->finished) {
+    try {
+      finish();
+    } catch (const std::exception& e) {
+      AT_WARN("Failed to finish streaming archive: ", e.what());
+    }
+  }
+}
+
+void StreamWriter::write(
+    const std::string& name,
+    const Tensor& tensor,
+    bool is_buffer) {
+  AT_CHECK(!state_->finished, "Cannot write to a finished streaming archive");
+  AT_CHECK(tensor.defined(), "Cannot serialize undefined tensor '", name, "'");
+  StreamRecord record;
+  record.dtype = tensor.scalar_type();
+  record.device = tensor.device();
+  record.sizes = tensor.sizes().vec();
+  record.is_buffer = is_buffer;
+  record.requires_grad = tensor.requires_grad();
+  record.nbytes = tensor.numel() * tensor.element_size();
+
+  torch::NoGradGuard guard;
+  auto data = tensor.device().is_cpu() ? tensor : tensor.to(kCPU);
+  data = data.contiguous();
+  state_->bytes_written += record.nbytes;
+  if (!state_->async) {
+    state_->append(name, data, std::move(record));
+    return;
+  }
+  if (data.data_ptr() == tensor.data_ptr()) {
+    // The snapshot must not change when the caller modifies the tensor.
+    data = data.clone();
+  }
+  std::lock_guard<std::mutex> lock(state_->mutex);
+  state_->queue.push_back({name, std::move(data), std::move(record)});
+  state_->cv.notify_one();
+}
+
+void StreamWriter::finish() {
+  finish_async().get();
+}
+
+std::future<void> StreamWriter::finish_async() {
+  AT_CHECK(!state_->finished, "Streaming archive was finished already");
+  state_->finished = true;
+  if (!state_->async) {
+    state_->write_index();
+    state_->done.set_value();
+  } else {
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    state_->closing = true;
+    state_->cv.notify_one();
+  }
+  return state_->done.get_future();
+}
+
+int64_t StreamWriter::bytes_written() const {
+  return state_->bytes_written;
+}
+
+StreamReader::StreamReader(const std::string& filename) {
+  // A private mapping: pages are read when they are first touched, and
+  // tensors that are modified get copies of their pages.
+  data_ = THMapAllocator::makeDataPtr(filename.c_str(), 0, 0, &size_);
+  parse_index();
+}
+
+StreamReader::StreamReader(std::istream& stream) {
+  const auto begin = stream.tellg();
+  stream.seekg(0, std::ios::end);
+  size_ = stream.tellg() - begin;
+  stream.seekg(begin);
+  // Allocated with the CPU allocator for the alignment of the tensor data.
+  data_ = c10::GetCPUAllocator()->allocate(size_);
+  stream.read(static_cast<char*>(data_.get()), size_);
+  AT_CHECK(stream, "Failed to read streaming archive");
+  parse_index();
+}
+
+void StreamReader::parse_index() {
+  const char* data = static_cast<const char*>(data_.get());
+  AT_CHECK(
+      size_ >= kStreamMagicSize + kFooterSize &&
+          std::memcmp(data, kStreamMagic, kStreamMagicSize) == 0 &&
+          std::memcmp(
+              data + size_ - kStreamMagicSize,
+              kStreamMagic,
+              kStreamMagicSize) == 0,
+      "Not a complete streaming archive");
+
+  size_t position = size_ - kFooterSize;
+  const auto index_offset = read_value<uint64_t>(data, size_, position);
+  const auto num_records = read_value<uint64_t>(data, size_, position);
+  const size_t index_end = size_ - kFooterSize;
+  AT_CHECK(index_offset <= index_end, "Malformed streaming archive");
+
+  position = index_offset;
+  for (uint64_t i = 0; i < num_records; ++i) {
+    const auto name_size = read_value<uint32_t>(data, index_end, position);
+    AT_CHECK(
+        name_size <= index_end - position,
+        "Malformed streaming archive: index is truncated");
+    std::string name(data + position, name_size);
+    position += name_size;
+
+    StreamRecord record;
+    const auto dtype = read_value<int8_t>(data, index_end, position);
+    AT_CHECK(
+        dtype >= 0 &&
+            dtype < static_cast<int8_t>(at::ScalarType::Undefined),
+        "Malformed streaming archive: '", name, "' has an invalid dtype");
+    record.dtype = static_cast<at::ScalarType>(dtype);
+    const auto device_type =
+        static_cast<DeviceType>(read_value<int8_t>(data, index_end, position));
+    AT_CHECK(
+        isValidDeviceType(device_type),
+        "Malformed streaming archive: '", name, "' has an invalid device");
+    const auto device_index = read_value<int16_t>(data, index_end, position);
+    record.device = Device(device_type, device_index);
+    record.is_buffer = read_value<uint8_t>(data, index_end, position);
+    record.requires_grad = read_value<uint8_t>(data, index_end, position);
+    const auto dim = read_value<uint32_t>(data, index_end, position);
+    // The size of the data must follow from the sizes and the dtype, without
+    // overflowing on the way.
+    uint64_t expected_nbytes = c10::elementSize(record.dtype);
+    for (uint32_t d = 0; d < dim; ++d) {
+      const auto size = read_value<int64_t>(data, index_end, position);
+      AT_CHECK(
+          size >= 0,
+          "Malformed streaming archive: '", name, "' has a negative size");
+      AT_CHECK(
+          size == 0 ||
+              expected_nbytes <= std::numeric_limits<uint64_t>::max() /
+                      static_cast<uint64_t>(size),
+          "Malformed streaming archive: '", name, "' is too large");
+      expected_nbytes *= static_cast<uint64_t>(size);
+      record.sizes.push_back(size);
+    }
+    record.offset = read_value<uint64_t>(data, index_end, position);
+    record.nbytes = read_value<uint64_t>(data, index_end, position);
+    AT_CHECK(
+        record.nbytes == expected_nbytes,
+        "Malformed streaming archive: size of '", name,
+        "' does not match its shape");
+    AT_CHECK(
+        record.nbytes <= index_offset &&
+            record.offset <= index_offset - record.nbytes,
+        "Malformed streaming archive: data of '", name, "' is out of bounds");
+    records_.emplace(std::move(name), std::move(record));
+  }
+}
+
+const StreamRecord* StreamReader::find(const std::string& name) const {
+  auto it = records_.find(name);
+  return it == records_.end() ? nullptr : &it->second;
+}
+
+bool StreamReader::has_prefix(const std::string& prefix) const {
+  auto it = records_.lower_bound(prefix);
+  return it != records_.end() &&
+      it->first.compare(0, prefix.size(), prefix) == 0;
+}
+
+Tensor StreamReader::tensor(
+    const StreamRecord& record,
+    c10::optional<Device> device) const {
+  auto self = shared_from_this();
+  // The tensor keeps the mapping alive.
+  auto tensor = at::from_blob(
+      static_cast<char*>(data_.get()) + record.offset,
+      record.sizes,
+      [self](void*) {},
+      at::device(kCPU).dtype(record.dtype));
+  const auto target = device ? *device : record.device;
+  if (target != tensor.device()) {
+    tensor = tensor.to(target);
+  }
+  return autograd::make_variable(tensor, record.requires_grad);
+}
+
+} // namespace detail
+} // namespace serialize
+} // namespace torch
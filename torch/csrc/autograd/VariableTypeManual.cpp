@@ -210,6 +210,26 @@ std::vector<at::Tensor> VariableType::unpack(at::TensorList tl, const char *name
   return ret;
 }
 
+Tensor & VariableType::unpack_inference(Tensor & t) {
+  return t.is_variable() ? static_cast<Variable&>(t).data() : t;
+}
+
+const Tensor & VariableType::unpack_inference(const Tensor & t) {
+  return t.is_variable() ? static_cast<const Variable&>(t).data() : t;
+}
+
+SparseTensorRef VariableType::unpack_inference(SparseTensorRef t) {
+  return SparseTensorRef(unpack_inference(t.tref));
+}
+
+std::vector<at::Tensor> VariableType::unpack_inference(at::TensorList tl) {
+  std::vector<at::Tensor> ret(tl.size());
+  for (size_t i = 0; i < tl.size(); ++i) {
+    ret[i] = unpack_inference(tl[i]);
+  }
+  return ret;
+}
+
 void VariableType::backward(
     Tensor& self,
     c10::optional<Tensor> gradient,
@@ -224,6 +244,11 @@ void VariableType::set_data(Tensor & self, Tensor new_data) const {
 
 // We don't have an outplace copy, so this can't be generated automatically
 Tensor & VariableType::copy_(Tensor & self, const Tensor & src, bool non_blocking) const {
+  if (at::InferenceMode::is_enabled()) {
+    at::AutoNonVariableTypeMode non_var_type_mode(true);
+    baseType->copy_(unpack_inference(self), unpack_inference(src), non_blocking);
+    return self;
+  }
   jit::Value* output = nullptr;
   if(torch::jit::tracer::isTracing()) {
     const jit::tracer::TracingState& state = *jit::tracer::getTracingState();
@@ -270,6 +295,11 @@ Tensor & VariableType::copy_(Tensor & self, const Tensor & src, bool non_blockin
 }
 
 Tensor & VariableType::resize_(Tensor & self, IntArrayRef size) const {
+  if (at::InferenceMode::is_enabled()) {
+    at::AutoNonVariableTypeMode non_var_type_mode(true);
+    baseType->resize_(unpack_inference(self), size);
+    return self;
+  }
   auto& self_ = unpack(self, "self", 0);
   if (as_variable_ref(self).requires_grad()) {
     AT_ERROR("cannot resize variables that require grad");
@@ -287,6 +317,11 @@ Tensor & VariableType::resize_(Tensor & self, IntArrayRef size) const {
 }
 
 Tensor & VariableType::resize_as_(Tensor & self, const Tensor & the_template) const {
+  if (at::InferenceMode::is_enabled()) {
+    at::AutoNonVariableTypeMode non_var_type_mode(true);
+    baseType->resize_as_(unpack_inference(self), unpack_inference(the_template));
+    return self;
+  }
   auto& self_ = unpack(self, "self", 0);
   auto& the_template_ = unpack(the_template, "the_template", 1);
   if (as_variable_ref(self).requires_grad()) {
@@ -304,6 +339,10 @@ Tensor & VariableType::resize_as_(Tensor & self, const Tensor & the_template) co
 }
 
 Tensor VariableType::detach(const Tensor & self) const {
+  if (at::InferenceMode::is_enabled() && !self.is_variable()) {
+    // Plain tensors have no history to detach from.
+    return Tensor(self.getIntrusivePtr()->shallow_copy_and_detach());
+  }
   RECORD_FUNCTION("detach", std::vector<c10::IValue>({self}));
 
   torch::jit::Node* node = nullptr;
@@ -325,6 +364,9 @@ Tensor VariableType::detach(const Tensor & self) const {
 }
 
 Tensor & VariableType::detach_(Tensor & self) const {
+  if (at::InferenceMode::is_enabled() && !self.is_variable()) {
+    return self;
+  }
   RECORD_FUNCTION("detach_", std::vector<c10::IValue>({self}));
 
   torch::jit::Node* node = nullptr;
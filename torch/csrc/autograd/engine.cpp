@@ -3,6 +3,7 @@
 #include <torch/csrc/autograd/function.h>
 #include <torch/csrc/autograd/functions/basic_ops.h>
 #include <torch/csrc/autograd/grad_mode.h>
+#include <torch/csrc/autograd/saved_tensor_offload.h>
 #include <torch/csrc/autograd/anomaly_mode.h>
 #include <torch/csrc/autograd/variable.h>
 #include <torch/csrc/utils/memory.h>
@@ -448,6 +449,10 @@ auto Engine::evaluate_function(FunctionTask& task) -> void {
     if (!fn_info.needed) return;
   }
 
+  // Start reading back the offloaded tensors of the functions that run after
+  // this one, so that their I/O overlaps with the computation.
+  prefetch_offloaded_tensors(task.fn->sequence_nr());
+
   auto outputs = call_function(task);
 
   auto& fn = *task.fn;
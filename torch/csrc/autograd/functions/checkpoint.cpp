@@ -0,0 +1,310 @@
+#include <torch/csrc/autograd/functions/checkpoint.h>
+
+#include <torch/csrc/autograd/engine.h>
+#include <torch/csrc/autograd/function.h>
+#include <torch/csrc/autograd/functions/utils.h>
+#include <torch/csrc/autograd/grad_mode.h>
+#include <torch/csrc/autograd/variable.h>
+
+#include <ATen/ATen.h>
+#include <ATen/CPUGenerator.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <limits>
+#include <memory>
+#include <vector>
+
+namespace torch { namespace autograd {
+
+namespace {
+
+std::atomic<int64_t> checkpointed_regions{0};
+std::atomic<int64_t> recomputed_regions{0};
+std::atomic<int64_t> recompute_ns{0};
+
+std::unique_ptr<at::Generator> copy_cpu_generator(const at::Generator& from) {
+  std::unique_ptr<at::Generator> generator(
+      new at::CPUGenerator(&at::globalContext()));
+  generator->copy(from);
+  return generator;
+}
+
+// Sets the default CPU generator to `state` for the lifetime of the guard and
+// restores the state it had before afterwards.
+struct CPUGeneratorStateGuard {
+  explicit CPUGeneratorStateGuard(const at::Generator* state) {
+    if (state) {
+      auto& generator = at::globalContext().defaultGenerator(at::kCPU);
+      saved_ = copy_cpu_generator(generator);
+      generator.copy(*state);
+    }
+  }
+  ~CPUGeneratorStateGuard() {
+    if (saved_) {
+      at::globalContext().defaultGenerator(at::kCPU).copy(*saved_);
+    }
+  }
+
+  std::unique_ptr<at::Generator> saved_;
+};
+
+// Estimated peak activation memory of the partition given by `segment_ends`,
+// see `plan_checkpoints`.
+int64_t peak_bytes(
+    const std::vector<int64_t>& activation_bytes,
+    const std::vector<int64_t>& prefix,
+    const std::vector<size_t>& segment_ends) {
+  int64_t boundaries = 0;
+  int64_t largest_segment = 0;
+  size_t begin = 0;
+  for (size_t s = 0; s < segment_ends.size(); ++s) {
+    const size_t end = segment_ends[s];
+    int64_t segment = prefix[end] - prefix[begin];
+    if (s + 1 < segment_ends.size()) {
+      // The output of a checkpointed segment is kept for its whole lifetime.
+      boundaries += activation_bytes[end - 1];
+      segment -= activation_bytes[end - 1];
+    }
+    largest_segment = std::max(largest_segment, segment);
+    begin = end;
+  }
+  return boundaries + largest_segment;
+}
+
+} // namespace
+
+CheckpointBackward::CheckpointBackward(
+    CheckpointRegion region,
+    const variable_list& inputs,
+    bool preserve_rng_state)
+    : region_(std::move(region)) {
+  inputs_.reserve(inputs.size());
+  for (const auto& input : inputs) {
+    inputs_.emplace_back(input, /*is_output=*/false);
+  }
+  if (preserve_rng_state) {
+    rng_state_ =
+        copy_cpu_generator(at::globalContext().defaultGenerator(at::kCPU));
+  }
+}
+
+variable_list CheckpointBackward::apply(variable_list&& grads) {
+  // The recomputed graph is differentiated with a nested backward() call,
+  // whose accumulated gradients an outer .grad() call would never see.
+  AT_CHECK(
+      Engine::get_default_engine().is_checkpoint_valid(),
+      "Checkpointing is not compatible with .grad(), please use .backward() "
+      "if possible");
+  AT_CHECK(
+      region_,
+      "Trying to backward through a checkpointed region a second time, but "
+      "its inputs have already been freed. Specify retain_graph=True when "
+      "calling backward the first time.");
+
+  const auto start = std::chrono::steady_clock::now();
+
+  // Recompute the region on detached copies of the inputs, so that the
+  // recomputed graph ends at these copies instead of reaching into the graph
+  // that is being differentiated right now.
+  variable_list inputs;
+  inputs.reserve(inputs_.size());
+  for (auto& saved : inputs_) {
+    auto input = saved.unpack();
+    if (input.defined()) {
+      const bool requires_grad = input.requires_grad();
+      input = input.detach();
+      input.set_requires_grad(requires_grad);
+    }
+    inputs.push_back(std::move(input));
+  }
+
+  variable_list outputs;
+  {
+    CPUGeneratorStateGuard rng_guard(rng_state_.get());
+    AutoGradMode grad_mode(true);
+    outputs = region_(inputs);
+  }
+  AT_CHECK(
+      outputs.size() == grads.size(),
+      "checkpointed region returned ", outputs.size(), " outputs during "
+      "recomputation, but ", grads.size(), " during the forward pass");
+
+  edge_list roots;
+  variable_list root_grads;
+  for (size_t i = 0; i < outputs.size(); ++i) {
+    if (outputs[i].defined() && outputs[i].requires_grad() &&
+        grads[i].defined()) {
+      roots.push_back(outputs[i].gradient_edge());
+      root_grads.push_back(std::move(grads[i]));
+    }
+  }
+
+  // Like backward(), this accumulates gradients into every leaf of the
+  // recomputed graph: the parameters used by the region as well as the
+  // detached inputs, whose gradients are then passed on.
+  if (!roots.empty()) {
+    Engine::get_default_engine().execute(
+        roots,
+        root_grads,
+        /*keep_graph=*/false,
+        /*create_graph=*/GradMode::is_enabled());
+  }
+  variable_list grad_inputs;
+  grad_inputs.reserve(inputs.size());
+  for (auto& input : inputs) {
+    grad_inputs.push_back(input.defined() ? input.grad() : Variable());
+  }
+
+  record_recomputed_region(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now() - start)
+          .count());
+  return grad_inputs;
+}
+
+void CheckpointBackward::release_variables() {
+  inputs_.clear();
+  region_ = nullptr;
+  rng_state_.reset();
+}
+
+variable_list checkpoint(
+    CheckpointRegion region,
+    const variable_list& inputs,
+    bool preserve_rng_state) {
+  if (!compute_requires_grad(inputs)) {
+    return region(inputs);
+  }
+
+  auto grad_fn = std::shared_ptr<CheckpointBackward>(
+      new CheckpointBackward(region, inputs, preserve_rng_state),
+      deleteFunction);
+  grad_fn->set_next_edges(collect_next_edges(inputs));
+
+  variable_list outputs;
+  {
+    AutoGradMode grad_mode(false);
+    outputs = region(inputs);
+  }
+  // Outputs may alias inputs (or each other); give every output its own
+  // Variable so that attaching the history below does not rewrite the
+  // history of an input.
+  for (auto& output : outputs) {
+    if (output.defined()) {
+      output = output.detach();
+    }
+  }
+  set_history(outputs, grad_fn);
+
+  record_checkpointed_region();
+  return outputs;
+}
+
+CheckpointPlan plan_checkpoints(
+    const std::vector<int64_t>& activation_bytes,
+    int64_t memory_budget) {
+  const size_t n = activation_bytes.size();
+  std::vector<int64_t> prefix(n + 1, 0);
+  for (size_t i = 0; i < n; ++i) {
+    prefix[i + 1] = prefix[i] + activation_bytes[i];
+  }
+
+  CheckpointPlan best;
+  best.baseline_bytes = prefix[n];
+  best.peak_bytes = prefix[n];
+  best.fits_budget = best.peak_bytes <= memory_budget;
+  if (n == 0) {
+    return best;
+  }
+  best.segment_ends = {n};
+  if (best.fits_budget) {
+    return best;
+  }
+
+  // largest[k][j]: smallest possible size of the largest segment when the
+  // first j modules are split into k checkpointed segments, where the size of
+  // a segment does not include its output (that is counted as a boundary).
+  // split[k][j] is the start of the last of these segments.
+  constexpr int64_t kInfinity = std::numeric_limits<int64_t>::max();
+  std::vector<std::vector<int64_t>> largest(
+      n, std::vector<int64_t>(n + 1, kInfinity));
+  std::vector<std::vector<size_t>> split(n, std::vector<size_t>(n + 1, 0));
+  largest[0][0] = 0;
+  for (size_t k = 1; k < n; ++k) {
+    for (size_t j = k; j < n; ++j) {
+      for (size_t i = k - 1; i < j; ++i) {
+        if (largest[k - 1][i] == kInfinity) {
+          continue;
+        }
+        const int64_t internal =
+            prefix[j] - prefix[i] - activation_bytes[j - 1];
+        const int64_t candidate = std::max(largest[k - 1][i], internal);
+        if (candidate < largest[k][j]) {
+          largest[k][j] = candidate;
+          split[k][j] = i;
+        }
+      }
+    }
+  }
+
+  // Try k checkpointed segments followed by the unrecorded last segment.
+  for (size_t k = 1; k < n; ++k) {
+    size_t last_begin = 0;
+    int64_t smallest = kInfinity;
+    for (size_t i = k; i < n; ++i) {
+      if (largest[k][i] == kInfinity) {
+        continue;
+      }
+      const int64_t candidate =
+          std::max(largest[k][i], prefix[n] - prefix[i]);
+      if (candidate < smallest) {
+        smallest = candidate;
+        last_begin = i;
+      }
+    }
+
+    std::vector<size_t> segment_ends(k + 1);
+    segment_ends[k] = n;
+    for (size_t s = k, end = last_begin; s > 0; --s) {
+      segment_ends[s - 1] = end;
+      end = split[s][end];
+    }
+    const int64_t peak = peak_bytes(activation_bytes, prefix, segment_ends);
+    if (peak < best.peak_bytes) {
+      best.segment_ends = std::move(segment_ends);
+      best.peak_bytes = peak;
+      best.fits_budget = peak <= memory_budget;
+      if (best.fits_budget) {
+        break;
+      }
+    }
+  }
+  return best;
+}
+
+CheckpointStats checkpoint_stats() {
+  CheckpointStats stats;
+  stats.checkpointed_regions = checkpointed_regions.load();
+  stats.recomputed_regions = recomputed_regions.load();
+  stats.recompute_ns = recompute_ns.load();
+  return stats;
+}
+
+void record_checkpointed_region() {
+  checkpointed_regions++;
+}
+
+void record_recomputed_region(int64_t nanoseconds) {
+  recomputed_regions++;
+  recompute_ns += nanoseconds;
+}
+
+void reset_checkpoint_stats() {
+  checkpointed_regions = 0;
+  recomputed_regions = 0;
+  recompute_ns = 0;
+}
+
+}} // namespace torch::autograd
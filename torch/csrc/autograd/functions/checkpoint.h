@@ -0,0 +1,97 @@
+#pragma once
+
+#include <torch/csrc/WindowsTorchApiMacro.h>
+#include <torch/csrc/autograd/function.h>
+#include <torch/csrc/autograd/saved_variable.h>
+#include <torch/csrc/autograd/variable.h>
+
+#include <ATen/ATen.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace torch { namespace autograd {
+
+/// A differentiable region of a graph that is recomputed during backward.
+using CheckpointRegion = std::function<variable_list(const variable_list&)>;
+
+/// Backward of a checkpointed region. Only the region's inputs are saved; the
+/// region is run again with grad mode enabled when its gradient is needed, and
+/// the gradients of the recomputed graph are then propagated to the inputs.
+/// If requested, the CPU RNG state at the time of the forward pass is replayed
+/// so that random ops (e.g. dropout) produce the same values again.
+struct TORCH_API CheckpointBackward : public Function {
+  CheckpointBackward(
+      CheckpointRegion region,
+      const variable_list& inputs,
+      bool preserve_rng_state);
+
+  variable_list apply(variable_list&& grads) override;
+
+  void release_variables() override;
+
+  CheckpointRegion region_;
+  std::vector<SavedVariable> inputs_;
+  // Snapshot of the CPU generator taken right before the forward pass.
+  std::unique_ptr<at::Generator> rng_state_;
+};
+
+/// Runs `region` on `inputs` without recording its internals for backward.
+/// The returned outputs are differentiable with respect to `inputs`; their
+/// gradient recomputes `region` (see `CheckpointBackward`). If no input
+/// requires grad, this is the same as calling `region(inputs)`.
+TORCH_API variable_list checkpoint(
+    CheckpointRegion region,
+    const variable_list& inputs,
+    bool preserve_rng_state = true);
+
+/// Process wide counters describing the cost of checkpointing.
+struct CheckpointStats {
+  /// Number of regions whose forward pass ran without saving activations.
+  int64_t checkpointed_regions = 0;
+  /// Number of regions that were recomputed during backward.
+  int64_t recomputed_regions = 0;
+  /// Total wall time spent recomputing regions, in nanoseconds.
+  int64_t recompute_ns = 0;
+};
+
+TORCH_API CheckpointStats checkpoint_stats();
+TORCH_API void reset_checkpoint_stats();
+
+/// Updates the counters in `CheckpointStats`. Called by `checkpoint` and
+/// `CheckpointBackward`, and by the Python implementation of checkpointing.
+TORCH_API void record_checkpointed_region();
+TORCH_API void record_recomputed_region(int64_t nanoseconds);
+
+/// A partition of a chain of modules into checkpointed segments, together with
+/// the memory it is estimated to need for activations.
+struct TORCH_API CheckpointPlan {
+  /// End index (exclusive) of every segment. All segments but the last one
+  /// are checkpointed.
+  std::vector<size_t> segment_ends;
+  /// Estimated peak activation memory without any checkpointing.
+  int64_t baseline_bytes = 0;
+  /// Estimated peak activation memory with this plan.
+  int64_t peak_bytes = 0;
+  /// Whether `peak_bytes` is within the budget the plan was made for.
+  bool fits_budget = false;
+};
+
+/// Picks checkpoint boundaries for a chain of modules whose outputs take up
+/// `activation_bytes[i]` bytes each, such that the activation memory stays
+/// within `memory_budget` bytes.
+///
+/// With checkpointing, the outputs of all segment boundaries stay alive during
+/// the forward pass, and the activations of one segment at a time are alive
+/// in addition (the unrecorded last segment, or a segment being recomputed).
+/// The planner returns the plan with the fewest segments that fits the budget,
+/// which also keeps the recomputation overhead low. If no plan fits, the one
+/// with the smallest peak is returned and `fits_budget` is false.
+TORCH_API CheckpointPlan plan_checkpoints(
+    const std::vector<int64_t>& activation_bytes,
+    int64_t memory_budget);
+
+}} // namespace torch::autograd
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <ATen/core/LegacyTypeDispatch.h>
 #include <torch/csrc/WindowsTorchApiMacro.h>
 
 namespace torch { namespace autograd {
@@ -21,4 +22,21 @@ struct TORCH_API AutoGradMode {
   bool prev_mode;
 };
 
+// A RAII, thread local (!) guard that enables or disables inference mode upon
+// construction, and sets it (and grad mode) back to the original value upon
+// destruction. Enabling inference mode also disables grad mode.
+// See NOTE [ Inference mode ] for details.
+struct TORCH_API AutoInferenceMode {
+  AutoInferenceMode(bool enabled)
+      : prev_mode(at::InferenceMode::is_enabled()),
+        grad_mode(enabled ? false : GradMode::is_enabled()) {
+    at::InferenceMode::set_enabled(enabled);
+  }
+  ~AutoInferenceMode() {
+    at::InferenceMode::set_enabled(prev_mode);
+  }
+  bool prev_mode;
+  AutoGradMode grad_mode;
+};
+
 }}
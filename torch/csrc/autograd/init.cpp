@@ -6,6 +6,9 @@
 #include <torch/csrc/autograd/profiler.h>
 #include <torch/csrc/autograd/python_function.h>
 #include <torch/csrc/autograd/function.h>
+#include <torch/csrc/autograd/functions/checkpoint.h>
+#include <torch/csrc/autograd/saved_tensor_codecs.h>
+#include <torch/csrc/autograd/saved_tensor_offload.h>
 
 PyObject * THPAutograd_initExtension(PyObject *_unused)
 {
@@ -50,6 +53,81 @@ PyObject * THPAutograd_initExtension(PyObject *_unused)
   });
   m.def("_pop_range", []() { torch::autograd::profiler::popRange(); });
 
+  m.def("_checkpoint_stats", []() {
+    auto stats = torch::autograd::checkpoint_stats();
+    return std::make_tuple(
+        stats.checkpointed_regions,
+        stats.recomputed_regions,
+        stats.recompute_ns);
+  });
+  m.def("_reset_checkpoint_stats", torch::autograd::reset_checkpoint_stats);
+  m.def(
+      "_record_checkpointed_region",
+      torch::autograd::record_checkpointed_region);
+  m.def(
+      "_record_recomputed_region", torch::autograd::record_recomputed_region);
+  m.def(
+      "_plan_checkpoints",
+      [](const std::vector<int64_t>& activation_bytes, int64_t memory_budget) {
+        auto plan = torch::autograd::plan_checkpoints(
+            activation_bytes, memory_budget);
+        return std::make_tuple(
+            plan.segment_ends,
+            plan.baseline_bytes,
+            plan.peak_bytes,
+            plan.fits_budget);
+      });
+
+
+  // Codecs are selected by name from Python, None removes the entry.
+  m.def(
+      "_set_saved_tensor_codec",
+      [](const std::string& function_name, c10::optional<std::string> codec) {
+        torch::autograd::set_saved_tensor_codec(
+            function_name,
+            codec ? torch::autograd::make_saved_tensor_codec(*codec) : nullptr);
+      });
+  m.def(
+      "_set_default_saved_tensor_codec",
+      [](c10::optional<std::string> codec) {
+        torch::autograd::set_default_saved_tensor_codec(
+            codec ? torch::autograd::make_saved_tensor_codec(*codec) : nullptr);
+      });
+  m.def(
+      "_clear_saved_tensor_codecs",
+      torch::autograd::clear_saved_tensor_codecs);
+  // Offloads the saved tensors of all functions without a codec of their
+  // own; an empty directory selects the compressed in-memory tier.
+  m.def(
+      "_set_default_saved_tensor_offload",
+      [](const std::string& directory, int64_t min_bytes, int64_t prefetch_bytes) {
+        torch::autograd::OffloadOptions options;
+        if (directory.empty()) {
+          options.tier = torch::autograd::OffloadOptions::Tier::CompressedMemory;
+        } else {
+          options.directory = directory;
+        }
+        options.min_bytes = min_bytes;
+        options.prefetch_bytes = prefetch_bytes;
+        torch::autograd::set_default_saved_tensor_codec(
+            torch::autograd::make_offload_codec(std::move(options)));
+      });
+  m.def("_offload_stats", []() {
+    auto stats = torch::autograd::offload_stats();
+    return std::make_tuple(
+        stats.tensors_offloaded,
+        stats.bytes_offloaded,
+        stats.bytes_stored,
+        stats.tensors_loaded,
+        stats.bytes_loaded,
+        stats.prefetch_hits,
+        stats.prefetch_misses,
+        stats.write_ns,
+        stats.read_ns,
+        stats.stall_ns);
+  });
+  m.def("_reset_offload_stats", torch::autograd::reset_offload_stats);
+
   Py_RETURN_TRUE;
 }
 
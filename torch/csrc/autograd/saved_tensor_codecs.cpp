@@ -0,0 +1,351 @@
+#include <torch/csrc/autograd/saved_tensor_codecs.h>
+
+#include <torch/csrc/autograd/function.h>
+
+#include <ATen/ATen.h>
+#include <ATen/Parallel.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace torch { namespace autograd {
+
+namespace {
+
+bool is_packable(const at::Tensor& tensor) {
+  return tensor.defined() && !tensor.is_sparse() && tensor.numel() > 0;
+}
+
+// Eight elements per byte, least significant bit first.
+struct BitMaskPackedTensor : public PackedTensor {
+  BitMaskPackedTensor(at::Tensor bits, at::IntArrayRef sizes, at::ScalarType dtype)
+      : bits_(std::move(bits)), sizes_(sizes.vec()), dtype_(dtype) {}
+
+  at::Tensor unpack() const override {
+    int64_t numel = 1;
+    for (auto size : sizes_) {
+      numel *= size;
+    }
+    auto mask = at::empty({numel}, bits_.options());
+    const uint8_t* bits = bits_.data<uint8_t>();
+    uint8_t* out = mask.data<uint8_t>();
+    at::parallel_for(
+        0, bits_.numel(), at::internal::GRAIN_SIZE / 8,
+        [&](int64_t begin, int64_t end) {
+          for (int64_t i = begin; i < end; ++i) {
+            const int64_t n = std::min<int64_t>(8, numel - i * 8);
+            for (int64_t b = 0; b < n; ++b) {
+              out[i * 8 + b] = (bits[i] >> b) & 1;
+            }
+          }
+        });
+    return mask.to(dtype_).view(sizes_);
+  }
+
+  int64_t nbytes() const override {
+    return bits_.nbytes();
+  }
+
+  at::Tensor bits_;
+  std::vector<int64_t> sizes_;
+  at::ScalarType dtype_;
+};
+
+struct BitMaskCodec : public SavedTensorCodec {
+  explicit BitMaskCodec(bool sign_only) : sign_only_(sign_only) {}
+
+  using SavedTensorCodec::pack;
+
+  std::shared_ptr<PackedTensor> pack(const at::Tensor& tensor) const override {
+    if (!is_packable(tensor) || !tensor.device().is_cpu()) {
+      return nullptr;
+    }
+    const auto dtype = tensor.scalar_type();
+    at::Tensor mask;
+    if (dtype == at::kBool || dtype == at::kByte) {
+      mask = tensor.contiguous();
+    } else if (sign_only_ && at::isFloatingType(dtype)) {
+      mask = tensor.gt(0).contiguous();
+    } else {
+      return nullptr;
+    }
+    const int64_t numel = mask.numel();
+    auto bits = at::empty({(numel + 7) / 8}, mask.options().dtype(at::kByte));
+    const uint8_t* in = static_cast<const uint8_t*>(mask.data_ptr());
+    uint8_t* out = bits.data<uint8_t>();
+    // Set if a byte tensor holds values other than zero and one.
+    std::atomic<bool> lossy{false};
+    at::parallel_for(
+        0, bits.numel(), at::internal::GRAIN_SIZE / 8,
+        [&](int64_t begin, int64_t end) {
+          uint8_t seen = 0;
+          for (int64_t i = begin; i < end; ++i) {
+            const int64_t n = std::min<int64_t>(8, numel - i * 8);
+            uint8_t byte = 0;
+            for (int64_t b = 0; b < n; ++b) {
+              seen |= in[i * 8 + b];
+              byte |= (in[i * 8 + b] != 0) << b;
+            }
+            out[i] = byte;
+          }
+          if (seen > 1) {
+            lossy = true;
+          }
+        });
+    if (lossy) {
+      return nullptr;
+    }
+    return std::make_shared<BitMaskPackedTensor>(
+        std::move(bits), tensor.sizes(), dtype);
+  }
+
+  bool sign_only_;
+};
+
+// A tensor stored in another dtype and cast back when unpacked.
+struct CastPackedTensor : public PackedTensor {
+  CastPackedTensor(at::Tensor data, at::ScalarType dtype)
+      : data_(std::move(data)), dtype_(dtype) {}
+
+  at::Tensor unpack() const override {
+    return data_.to(dtype_);
+  }
+
+  int64_t nbytes() const override {
+    return data_.nbytes();
+  }
+
+  at::Tensor data_;
+  at::ScalarType dtype_;
+};
+
+struct HalfCodec : public SavedTensorCodec {
+  using SavedTensorCodec::pack;
+
+  std::shared_ptr<PackedTensor> pack(const at::Tensor& tensor) const override {
+    const auto dtype = tensor.scalar_type();
+    if (!is_packable(tensor) || (dtype != at::kFloat && dtype != at::kDouble)) {
+      return nullptr;
+    }
+    return std::make_shared<CastPackedTensor>(tensor.to(at::kHalf), dtype);
+  }
+};
+
+// bfloat16 values are kept as the upper 16 bits of the corresponding float in
+// an int16 tensor.
+struct BFloat16PackedTensor : public PackedTensor {
+  BFloat16PackedTensor(at::Tensor data, at::IntArrayRef sizes, at::ScalarType dtype)
+      : data_(std::move(data)), sizes_(sizes.vec()), dtype_(dtype) {}
+
+  at::Tensor unpack() const override {
+    auto output = at::empty(sizes_, data_.options().dtype(at::kFloat));
+    const uint16_t* in = reinterpret_cast<const uint16_t*>(data_.data<int16_t>());
+    float* out = output.data<float>();
+    at::parallel_for(
+        0, output.numel(), at::internal::GRAIN_SIZE,
+        [&](int64_t begin, int64_t end) {
+          for (int64_t i = begin; i < end; ++i) {
+            const uint32_t bits = static_cast<uint32_t>(in[i]) << 16;
+            std::memcpy(out + i, &bits, sizeof(bits));
+          }
+        });
+    return output.to(dtype_);
+  }
+
+  int64_t nbytes() const override {
+    return data_.nbytes();
+  }
+
+  at::Tensor data_;
+  std::vector<int64_t> sizes_;
+  at::ScalarType dtype_;
+};
+
+struct BFloat16Codec : public SavedTensorCodec {
+  using SavedTensorCodec::pack;
+
+  std::shared_ptr<PackedTensor> pack(const at::Tensor& tensor) const override {
+    const auto dtype = tensor.scalar_type();
+    if (!is_packable(tensor) || !tensor.device().is_cpu() ||
+        (dtype != at::kFloat && dtype != at::kDouble)) {
+      return nullptr;
+    }
+    const auto input = tensor.to(at::kFloat).contiguous();
+    auto data = at::empty({input.numel()}, input.options().dtype(at::kShort));
+    const float* in = input.data<float>();
+    uint16_t* out = reinterpret_cast<uint16_t*>(data.data<int16_t>());
+    at::parallel_for(
+        0, input.numel(), at::internal::GRAIN_SIZE,
+        [&](int64_t begin, int64_t end) {
+          for (int64_t i = begin; i < end; ++i) {
+            uint32_t bits;
+            std::memcpy(&bits, in + i, sizeof(bits));
+            if ((bits & 0x7fffffff) > 0x7f800000) {
+              // Keep NaNs quiet instead of rounding them to infinity.
+              out[i] = static_cast<uint16_t>((bits >> 16) | 0x40);
+            } else {
+              // Round to nearest even.
+              bits += 0x7fff + ((bits >> 16) & 1);
+              out[i] = static_cast<uint16_t>(bits >> 16);
+            }
+          }
+        });
+    return std::make_shared<BFloat16PackedTensor>(
+        std::move(data), tensor.sizes(), dtype);
+  }
+};
+
+struct Int8PackedTensor : public PackedTensor {
+  Int8PackedTensor(at::Tensor data, at::Tensor scales, at::ScalarType dtype)
+      : data_(std::move(data)), scales_(std::move(scales)), dtype_(dtype) {}
+
+  at::Tensor unpack() const override {
+    return data_.to(dtype_).mul_(scales_);
+  }
+
+  int64_t nbytes() const override {
+    return data_.nbytes() + scales_.nbytes();
+  }
+
+  at::Tensor data_;
+  // Broadcastable against data_, with the size of the channel dimension.
+  at::Tensor scales_;
+  at::ScalarType dtype_;
+};
+
+struct Int8Codec : public SavedTensorCodec {
+  explicit Int8Codec(int64_t dim) : dim_(dim) {}
+
+  using SavedTensorCodec::pack;
+
+  std::shared_ptr<PackedTensor> pack(const at::Tensor& tensor) const override {
+    const auto dtype = tensor.scalar_type();
+    if (!is_packable(tensor) || (dtype != at::kFloat && dtype != at::kDouble)) {
+      return nullptr;
+    }
+    at::Tensor scales;
+    if (tensor.dim() > dim_) {
+      const int64_t channels = tensor.size(dim_);
+      scales = std::get<0>(tensor.abs()
+                               .transpose(0, dim_)
+                               .reshape({channels, -1})
+                               .max(/*dim=*/1));
+      std::vector<int64_t> shape(tensor.dim(), 1);
+      shape[dim_] = channels;
+      scales = scales.view(shape);
+    } else {
+      scales = tensor.abs().max();
+    }
+    // Channels that are all zero would otherwise divide by zero.
+    scales = scales.div(127).clamp_min_(1e-30);
+    auto data = tensor.div(scales).round_().clamp_(-127, 127).to(at::kChar);
+    return std::make_shared<Int8PackedTensor>(
+        std::move(data), std::move(scales), dtype);
+  }
+
+  int64_t dim_;
+};
+
+struct CodecRegistry {
+  std::mutex mutex;
+  std::unordered_map<std::string, std::shared_ptr<SavedTensorCodec>> codecs;
+  std::shared_ptr<SavedTensorCodec> default_codec;
+  // Lets saved_tensor_codec_for skip the lookup while no codec is set.
+  std::atomic<bool> active{false};
+
+  void update_active() {
+    active = default_codec != nullptr || !codecs.empty();
+  }
+};
+
+CodecRegistry& registry() {
+  static CodecRegistry registry;
+  return registry;
+}
+
+} // namespace
+
+std::shared_ptr<SavedTensorCodec> make_bit_mask_codec(bool sign_only) {
+  return std::make_shared<BitMaskCodec>(sign_only);
+}
+
+std::shared_ptr<SavedTensorCodec> make_half_codec() {
+  return std::make_shared<HalfCodec>();
+}
+
+std::shared_ptr<SavedTensorCodec> make_bfloat16_codec() {
+  return std::make_shared<BFloat16Codec>();
+}
+
+std::shared_ptr<SavedTensorCodec> make_int8_codec(int64_t dim) {
+  AT_CHECK(dim >= 0, "int8 codec: dim must be non-negative, got ", dim);
+  return std::make_shared<Int8Codec>(dim);
+}
+
+std::shared_ptr<SavedTensorCodec> make_saved_tensor_codec(
+    const std::string& name) {
+  if (name == "mask") {
+    return make_bit_mask_codec();
+  } else if (name == "sign") {
+    return make_bit_mask_codec(/*sign_only=*/true);
+  } else if (name == "fp16") {
+    return make_half_codec();
+  } else if (name == "bf16") {
+    return make_bfloat16_codec();
+  } else if (name == "int8") {
+    return make_int8_codec();
+  }
+  AT_ERROR(
+      "Unknown saved tensor codec '", name,
+      "', expected one of 'mask', 'sign', 'fp16', 'bf16' or 'int8'");
+}
+
+void set_saved_tensor_codec(
+    const std::string& function_name,
+    std::shared_ptr<SavedTensorCodec> codec) {
+  auto& r = registry();
+  std::lock_guard<std::mutex> lock(r.mutex);
+  if (codec) {
+    r.codecs[function_name] = std::move(codec);
+  } else {
+    r.codecs.erase(function_name);
+  }
+  r.update_active();
+}
+
+void set_default_saved_tensor_codec(std::shared_ptr<SavedTensorCodec> codec) {
+  auto& r = registry();
+  std::lock_guard<std::mutex> lock(r.mutex);
+  r.default_codec = std::move(codec);
+  r.update_active();
+}
+
+void clear_saved_tensor_codecs() {
+  auto& r = registry();
+  std::lock_guard<std::mutex> lock(r.mutex);
+  r.codecs.clear();
+  r.default_codec = nullptr;
+  r.update_active();
+}
+
+std::shared_ptr<SavedTensorCodec> saved_tensor_codec_for(
+    const Function& function) {
+  auto& r = registry();
+  if (!r.active) {
+    return nullptr;
+  }
+  const auto name = function.name();
+  std::lock_guard<std::mutex> lock(r.mutex);
+  auto it = r.codecs.find(name);
+  return it != r.codecs.end() ? it->second : r.default_codec;
+}
+
+}} // namespace torch::autograd
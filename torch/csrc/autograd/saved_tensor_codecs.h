@@ -0,0 +1,90 @@
+#pragma once
+
+#include <torch/csrc/WindowsTorchApiMacro.h>
+
+#include <ATen/ATen.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace torch { namespace autograd {
+
+struct Function;
+
+/// A compressed representation of a tensor saved for backward.
+struct TORCH_API PackedTensor {
+  virtual ~PackedTensor() = default;
+
+  /// Reconstructs (an approximation of) the tensor that was packed.
+  virtual at::Tensor unpack() const = 0;
+
+  /// Number of bytes held by the packed representation.
+  virtual int64_t nbytes() const = 0;
+};
+
+/// A pack/unpack hook for tensors saved in a `SavedVariable`. Codecs may be
+/// lossy; they are only applied to the saved tensors of the functions they are
+/// registered for (see `set_saved_tensor_codec`), so that the loss can be
+/// limited to the places where the gradient formula tolerates it.
+struct TORCH_API SavedTensorCodec {
+  virtual ~SavedTensorCodec() = default;
+
+  /// Packs `tensor`, or returns nullptr if this codec cannot handle it (e.g.
+  /// because of its dtype or layout), in which case it is saved as is.
+  virtual std::shared_ptr<PackedTensor> pack(const at::Tensor& tensor) const = 0;
+
+  /// Packs `tensor`, which is saved by `saved_by`. Codecs that depend on the
+  /// position of the function in the graph override this.
+  virtual std::shared_ptr<PackedTensor> pack(
+      const at::Tensor& tensor,
+      const Function& /*saved_by*/) const {
+    return pack(tensor);
+  }
+};
+
+/// Packs bool and byte masks into one bit per element. Byte tensors holding
+/// values other than zero and one are saved as is, so that packing is always
+/// lossless. With `sign_only`, floating point tensors are packed too, keeping
+/// only whether an element is greater than zero, and unpack to zeros and ones
+/// of their dtype. That is only correct for tensors whose gradient formula
+/// compares them against zero, like the saved output of ReLU.
+TORCH_API std::shared_ptr<SavedTensorCodec> make_bit_mask_codec(
+    bool sign_only = false);
+
+/// Saves floating point tensors as IEEE half precision.
+TORCH_API std::shared_ptr<SavedTensorCodec> make_half_codec();
+
+/// Saves float and double tensors as bfloat16, which keeps the exponent range
+/// of float and rounds the mantissa to 8 bits.
+TORCH_API std::shared_ptr<SavedTensorCodec> make_bfloat16_codec();
+
+/// Saves floating point tensors as int8 with one symmetric scale per slice
+/// along `dim` (the channel dimension of NCHW activations by default). Tensors
+/// with fewer dimensions are quantized with one scale per tensor.
+TORCH_API std::shared_ptr<SavedTensorCodec> make_int8_codec(int64_t dim = 1);
+
+/// Returns the built-in codec called `name`: "mask", "sign" (the bit mask
+/// codec with `sign_only`), "fp16", "bf16" or "int8".
+TORCH_API std::shared_ptr<SavedTensorCodec> make_saved_tensor_codec(
+    const std::string& name);
+
+/// Packs the tensors saved by every backward function named `function_name`
+/// (e.g. "ReluBackward0", see `Function::name()`) with `codec`. Passing a null
+/// codec removes the entry.
+TORCH_API void set_saved_tensor_codec(
+    const std::string& function_name,
+    std::shared_ptr<SavedTensorCodec> codec);
+
+/// Sets the codec used for the functions without an entry of their own.
+TORCH_API void set_default_saved_tensor_codec(
+    std::shared_ptr<SavedTensorCodec> codec);
+
+/// Removes all codecs; saved tensors are stored as is again.
+TORCH_API void clear_saved_tensor_codecs();
+
+/// Returns the codec for the tensors saved by `function`, or nullptr.
+TORCH_API std::shared_ptr<SavedTensorCodec> saved_tensor_codec_for(
+    const Function& function);
+
+}} // namespace torch::autograd
@@ -0,0 +1,534 @@
+#include <torch/csrc/autograd/saved_tensor_offload.h>
+
+#include <torch/csrc/autograd/function.h>
+
+#include <ATen/ATen.h>
+#include <TH/THAllocator.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#ifdef _WIN32
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace torch { namespace autograd {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+int64_t elapsed_ns(Clock::time_point start) {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             Clock::now() - start)
+      .count();
+}
+
+int process_id() {
+#ifdef _WIN32
+  return _getpid();
+#else
+  return getpid();
+#endif
+}
+
+struct AtomicOffloadStats {
+  std::atomic<int64_t> tensors_offloaded{0};
+  std::atomic<int64_t> bytes_offloaded{0};
+  std::atomic<int64_t> bytes_stored{0};
+  std::atomic<int64_t> tensors_loaded{0};
+  std::atomic<int64_t> bytes_loaded{0};
+  std::atomic<int64_t> prefetch_hits{0};
+  std::atomic<int64_t> prefetch_misses{0};
+  std::atomic<int64_t> write_ns{0};
+  std::atomic<int64_t> read_ns{0};
+  std::atomic<int64_t> stall_ns{0};
+};
+
+AtomicOffloadStats& stats() {
+  static AtomicOffloadStats stats;
+  return stats;
+}
+
+// Lossless compression that stores one bit per element, telling whether the
+// element is non-zero, followed by the non-zero elements. Elements are
+// compared bitwise, so that negative zeros and NaNs survive.
+template <typename word_t>
+std::vector<uint8_t> compress_zeros(const void* data, int64_t numel) {
+  const word_t* in = static_cast<const word_t*>(data);
+  const int64_t mask_bytes = (numel + 7) / 8;
+  std::vector<uint8_t> out(mask_bytes);
+  std::vector<word_t> values;
+  for (int64_t i = 0; i < numel; ++i) {
+    if (in[i] != 0) {
+      out[i / 8] |= 1 << (i % 8);
+      values.push_back(in[i]);
+    }
+  }
+  out.resize(mask_bytes + values.size() * sizeof(word_t));
+  if (!values.empty()) {
+    std::memcpy(out.data() + mask_bytes, values.data(), values.size() * sizeof(word_t));
+  }
+  return out;
+}
+
+template <typename word_t>
+void decompress_zeros(const std::vector<uint8_t>& in, void* data, int64_t numel) {
+  word_t* out = static_cast<word_t*>(data);
+  const int64_t mask_bytes = (numel + 7) / 8;
+  const uint8_t* values = in.data() + mask_bytes;
+  for (int64_t i = 0; i < numel; ++i) {
+    if (in[i / 8] & (1 << (i % 8))) {
+      std::memcpy(out + i, values, sizeof(word_t));
+      values += sizeof(word_t);
+    } else {
+      out[i] = 0;
+    }
+  }
+}
+
+class OffloadedTensor;
+
+// Owns the I/O thread and the offloaded tensors that wait to be prefetched,
+// ordered by the sequence number of the function that saved them.
+class OffloadManager {
+ public:
+  static OffloadManager& get() {
+    static OffloadManager manager;
+    return manager;
+  }
+
+  void enqueue_write(std::shared_ptr<OffloadedTensor> tensor, int64_t nbytes, int64_t max_pending);
+  void prefetch(uint64_t sequence_nr);
+  void wait_for_writes();
+  void wait_until_loaded(const OffloadedTensor& tensor, std::unique_lock<std::mutex>& lock);
+  void load(OffloadedTensor& tensor, std::unique_lock<std::mutex>& lock);
+
+  std::mutex mutex;
+
+ private:
+  friend class OffloadedTensor;
+
+  void start_thread();
+  void thread_main();
+
+  std::condition_variable work_available_;
+  // Signalled whenever a write or a load completes.
+  std::condition_variable io_done_;
+  std::deque<std::shared_ptr<OffloadedTensor>> writes_;
+  std::deque<std::shared_ptr<OffloadedTensor>> loads_;
+  std::map<uint64_t, std::vector<std::weak_ptr<OffloadedTensor>>> stored_;
+  // Lets prefetch() return right away while nothing is offloaded.
+  std::atomic<int64_t> num_stored_{0};
+  int64_t pending_write_bytes_ = 0;
+  // Atomic, as tensors that are freed before they are unpacked give back
+  // their share without taking the lock.
+  std::atomic<int64_t> prefetched_bytes_{0};
+  bool thread_started_ = false;
+};
+
+// A saved tensor that lives in the secondary tier between the end of its
+// write and the start of its load. All state is protected by the mutex of the
+// OffloadManager; the I/O itself happens outside of it.
+class OffloadedTensor : public PackedTensor,
+                        public std::enable_shared_from_this<OffloadedTensor> {
+ public:
+  enum class State { Writing, Stored, Loading, Loaded, Failed };
+
+  OffloadedTensor(
+      at::Tensor tensor,
+      uint64_t sequence_nr,
+      const OffloadOptions& options)
+      : tensor_(std::move(tensor)),
+        sizes_(tensor_.sizes().vec()),
+        options_(tensor_.options()),
+        nbytes_(tensor_.nbytes()),
+        sequence_nr_(sequence_nr),
+        tier_(options.tier),
+        prefetch_bytes_(options.prefetch_bytes) {
+    if (tier_ == OffloadOptions::Tier::File) {
+      static std::atomic<uint64_t> next_file{0};
+      path_ = options.directory + "/torch_offload_" +
+          std::to_string(process_id()) + "_" + std::to_string(next_file++);
+    }
+  }
+
+  ~OffloadedTensor() override {
+    if (prefetched_) {
+      OffloadManager::get().prefetched_bytes_ -= nbytes_;
+    }
+    if (has_file_) {
+      std::remove(path_.c_str());
+    }
+  }
+
+  at::Tensor unpack() const override;
+
+  int64_t nbytes() const override {
+    return nbytes_;
+  }
+
+  // Runs on the I/O thread.
+  void write();
+  at::Tensor read() const;
+
+  // Called with the lock held once an I/O operation on this tensor threw.
+  void fail(std::exception_ptr error);
+
+  State state_ = State::Writing;
+  // The data while it is being written, and again once it has been read.
+  at::Tensor tensor_;
+  // The error of a failed write or read, which unpack() rethrows.
+  std::exception_ptr error_;
+  // Whether the loaded tensor was prefetched and has not been unpacked yet.
+  bool prefetched_ = false;
+
+  const std::vector<int64_t> sizes_;
+  const at::TensorOptions options_;
+  const int64_t nbytes_;
+  const uint64_t sequence_nr_;
+  const OffloadOptions::Tier tier_;
+  const int64_t prefetch_bytes_;
+
+ private:
+  std::string path_;
+  std::vector<uint8_t> compressed_;
+  // Whether the file of the `File` tier may exist.
+  bool has_file_ = false;
+};
+
+void OffloadedTensor::write() {
+  const auto start = Clock::now();
+  const void* data = tensor_.data_ptr();
+  if (tier_ == OffloadOptions::Tier::File) {
+    // Set before the file is created, so that a partially written file is
+    // removed as well.
+    has_file_ = true;
+    auto mapping = THMapAllocator::makeDataPtr(
+        path_.c_str(),
+        TH_ALLOCATOR_MAPPED_SHARED | TH_ALLOCATOR_MAPPED_EXCLUSIVE,
+        nbytes_,
+        nullptr);
+    std::memcpy(mapping.get(), data, nbytes_);
+    stats().bytes_stored += nbytes_;
+  } else {
+    const int64_t numel = tensor_.numel();
+    switch (tensor_.element_size()) {
+      case 1: compressed_ = compress_zeros<uint8_t>(data, numel); break;
+      case 2: compressed_ = compress_zeros<uint16_t>(data, numel); break;
+      case 4: compressed_ = compress_zeros<uint32_t>(data, numel); break;
+      default: compressed_ = compress_zeros<uint64_t>(data, numel); break;
+    }
+    stats().bytes_stored += compressed_.size();
+  }
+  stats().tensors_offloaded++;
+  stats().bytes_offloaded += nbytes_;
+  stats().write_ns += elapsed_ns(start);
+}
+
+at::Tensor OffloadedTensor::read() const {
+  const auto start = Clock::now();
+  auto tensor = at::empty(sizes_, options_);
+  void* data = tensor.data_ptr();
+  if (tier_ == OffloadOptions::Tier::File) {
+    size_t size = 0;
+    auto mapping = THMapAllocator::makeDataPtr(path_.c_str(), 0, 0, &size);
+    AT_CHECK(
+        static_cast<int64_t>(size) == nbytes_,
+        "offload: ", path_, " holds ", size, " bytes, expected ", nbytes_);
+    std::memcpy(data, mapping.get(), nbytes_);
+  } else {
+    const int64_t numel = tensor.numel();
+    switch (tensor.element_size()) {
+      case 1: decompress_zeros<uint8_t>(compressed_, data, numel); break;
+      case 2: decompress_zeros<uint16_t>(compressed_, data, numel); break;
+      case 4: decompress_zeros<uint32_t>(compressed_, data, numel); break;
+      default: decompress_zeros<uint64_t>(compressed_, data, numel); break;
+    }
+  }
+  stats().tensors_loaded++;
+  stats().bytes_loaded += nbytes_;
+  stats().read_ns += elapsed_ns(start);
+  return tensor;
+}
+
+void OffloadedTensor::fail(std::exception_ptr error) {
+  state_ = State::Failed;
+  error_ = std::move(error);
+  tensor_.reset();
+}
+
+at::Tensor OffloadedTensor::unpack() const {
+  auto& manager = OffloadManager::get();
+  auto self = const_cast<OffloadedTensor*>(this);
+  std::unique_lock<std::mutex> lock(manager.mutex);
+  if (state_ == State::Loading) {
+    manager.wait_until_loaded(*this, lock);
+  }
+  if (state_ == State::Failed) {
+    std::rethrow_exception(error_);
+  }
+  if (state_ == State::Writing || state_ == State::Loaded) {
+    stats().prefetch_hits++;
+    if (prefetched_) {
+      self->prefetched_ = false;
+      manager.prefetched_bytes_ -= nbytes_;
+    }
+    return tensor_;
+  }
+  // Not prefetched; read it on this thread. The Loading state keeps the I/O
+  // thread from starting a second read, and makes other unpacks wait for
+  // this one.
+  stats().prefetch_misses++;
+  self->state_ = State::Loading;
+  const auto start = Clock::now();
+  manager.load(*self, lock);
+  stats().stall_ns += elapsed_ns(start);
+  if (state_ == State::Failed) {
+    std::rethrow_exception(error_);
+  }
+  return tensor_;
+}
+
+void OffloadManager::start_thread() {
+  if (!thread_started_) {
+    // Like the engine's worker threads, the I/O thread lives as long as the
+    // process.
+    std::thread thread(&OffloadManager::thread_main, this);
+    thread.detach();
+    thread_started_ = true;
+  }
+}
+
+void OffloadManager::enqueue_write(
+    std::shared_ptr<OffloadedTensor> tensor,
+    int64_t nbytes,
+    int64_t max_pending) {
+  std::unique_lock<std::mutex> lock(mutex);
+  start_thread();
+  if (pending_write_bytes_ > 0 && pending_write_bytes_ + nbytes > max_pending) {
+    const auto start = Clock::now();
+    io_done_.wait(lock, [&] {
+      return pending_write_bytes_ == 0 ||
+          pending_write_bytes_ + nbytes <= max_pending;
+    });
+    stats().stall_ns += elapsed_ns(start);
+  }
+  pending_write_bytes_ += nbytes;
+  writes_.push_back(std::move(tensor));
+  work_available_.notify_one();
+}
+
+void OffloadManager::wait_until_loaded(
+    const OffloadedTensor& tensor,
+    std::unique_lock<std::mutex>& lock) {
+  const auto start = Clock::now();
+  io_done_.wait(lock, [&] {
+    return tensor.state_ != OffloadedTensor::State::Loading;
+  });
+  stats().stall_ns += elapsed_ns(start);
+}
+
+void OffloadManager::wait_for_writes() {
+  std::unique_lock<std::mutex> lock(mutex);
+  io_done_.wait(lock, [&] { return pending_write_bytes_ == 0; });
+}
+
+// Reads a tensor in the Loading state without holding the lock, and
+// publishes the result.
+void OffloadManager::load(
+    OffloadedTensor& tensor,
+    std::unique_lock<std::mutex>& lock) {
+  lock.unlock();
+  at::Tensor data;
+  std::exception_ptr error;
+  try {
+    data = tensor.read();
+  } catch (...) {
+    error = std::current_exception();
+  }
+  lock.lock();
+  if (error) {
+    tensor.fail(std::move(error));
+  } else {
+    tensor.tensor_ = std::move(data);
+    tensor.state_ = OffloadedTensor::State::Loaded;
+  }
+  io_done_.notify_all();
+}
+
+void OffloadManager::prefetch(uint64_t sequence_nr) {
+  if (num_stored_ == 0) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(mutex);
+  // The engine runs functions in decreasing order of sequence_nr, so the
+  // tensors needed next are the ones saved by the function about to run and
+  // by those created right before it.
+  auto it = stored_.upper_bound(sequence_nr);
+  while (it != stored_.begin()) {
+    --it;
+    auto& tensors = it->second;
+    for (auto t = tensors.begin(); t != tensors.end();) {
+      auto tensor = t->lock();
+      if (!tensor) {
+        t = tensors.erase(t);
+        num_stored_--;
+        continue;
+      }
+      if (tensor->state_ != OffloadedTensor::State::Stored) {
+        // Being read or already read back synchronously.
+        t = tensors.erase(t);
+        num_stored_--;
+        continue;
+      }
+      if (prefetched_bytes_ > 0 &&
+          prefetched_bytes_ + tensor->nbytes_ > tensor->prefetch_bytes_) {
+        return;
+      }
+      tensor->state_ = OffloadedTensor::State::Loading;
+      tensor->prefetched_ = true;
+      prefetched_bytes_ += tensor->nbytes_;
+      loads_.push_back(std::move(tensor));
+      work_available_.notify_one();
+      t = tensors.erase(t);
+      num_stored_--;
+    }
+    if (tensors.empty()) {
+      it = stored_.erase(it);
+    }
+  }
+}
+
+void OffloadManager::thread_main() {
+  std::unique_lock<std::mutex> lock(mutex);
+  while (true) {
+    work_available_.wait(lock, [&] { return !writes_.empty() || !loads_.empty(); });
+    // Loads are on the critical path of the backward pass, writes are not.
+    if (!loads_.empty()) {
+      auto tensor = std::move(loads_.front());
+      loads_.pop_front();
+      load(*tensor, lock);
+    } else {
+      auto tensor = std::move(writes_.front());
+      writes_.pop_front();
+      if (tensor.use_count() == 1) {
+        // The saved variable is gone already (e.g. the graph was freed
+        // without running backward), there is nothing to write.
+        pending_write_bytes_ -= tensor->nbytes_;
+        io_done_.notify_all();
+        continue;
+      }
+      lock.unlock();
+      std::exception_ptr error;
+      try {
+        tensor->write();
+      } catch (...) {
+        error = std::current_exception();
+      }
+      lock.lock();
+      pending_write_bytes_ -= tensor->nbytes_;
+      if (error) {
+        tensor->fail(std::move(error));
+      } else if (tensor->state_ == OffloadedTensor::State::Writing) {
+        tensor->state_ = OffloadedTensor::State::Stored;
+        tensor->tensor_.reset();
+        stored_[tensor->sequence_nr_].push_back(tensor);
+        num_stored_++;
+      }
+    }
+    io_done_.notify_all();
+  }
+}
+
+class OffloadCodec : public SavedTensorCodec {
+ public:
+  explicit OffloadCodec(OffloadOptions options) : options_(std::move(options)) {}
+
+  std::shared_ptr<PackedTensor> pack(const at::Tensor&) const override {
+    // Without the function that saves the tensor, there is no way to tell
+    // when to prefetch it.
+    return nullptr;
+  }
+
+  std::shared_ptr<PackedTensor> pack(
+      const at::Tensor& tensor,
+      const Function& saved_by) const override {
+    if (!tensor.defined() || tensor.is_sparse() ||
+        !tensor.device().is_cpu() ||
+        static_cast<int64_t>(tensor.nbytes()) < options_.min_bytes) {
+      return nullptr;
+    }
+    const int64_t nbytes = tensor.nbytes();
+    auto offloaded = std::make_shared<OffloadedTensor>(
+        tensor.contiguous(), saved_by.sequence_nr(), options_);
+    OffloadManager::get().enqueue_write(
+        offloaded, nbytes, options_.max_pending_write_bytes);
+    return offloaded;
+  }
+
+ private:
+  OffloadOptions options_;
+};
+
+} // namespace
+
+std::shared_ptr<SavedTensorCodec> make_offload_codec(OffloadOptions options) {
+  AT_CHECK(options.min_bytes > 0, "offload: min_bytes must be positive");
+  return std::make_shared<OffloadCodec>(std::move(options));
+}
+
+OffloadStats offload_stats() {
+  auto& s = stats();
+  OffloadStats result;
+  result.tensors_offloaded = s.tensors_offloaded;
+  result.bytes_offloaded = s.bytes_offloaded;
+  result.bytes_stored = s.bytes_stored;
+  result.tensors_loaded = s.tensors_loaded;
+  result.bytes_loaded = s.bytes_loaded;
+  result.prefetch_hits = s.prefetch_hits;
+  result.prefetch_misses = s.prefetch_misses;
+  result.write_ns = s.write_ns;
+  result.read_ns = s.read_ns;
+  result.stall_ns = s.stall_ns;
+  return result;
+}
+
+void reset_offload_stats() {
+  auto& s = stats();
+  s.tensors_offloaded = 0;
+  s.bytes_offloaded = 0;
+  s.bytes_stored = 0;
+  s.tensors_loaded = 0;
+  s.bytes_loaded = 0;
+  s.prefetch_hits = 0;
+  s.prefetch_misses = 0;
+  s.write_ns = 0;
+  s.read_ns = 0;
+  s.stall_ns = 0;
+}
+
+void prefetch_offloaded_tensors(uint64_t sequence_nr) {
+  OffloadManager::get().prefetch(sequence_nr);
+}
+
+void wait_for_offloaded_writes() {
+  OffloadManager::get().wait_for_writes();
+}
+
+}} // namespace torch::autograd
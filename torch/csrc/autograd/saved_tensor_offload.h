@@ -0,0 +1,84 @@
+#pragma once
+
+#include <torch/csrc/WindowsTorchApiMacro.h>
+#include <torch/csrc/autograd/saved_tensor_codecs.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace torch { namespace autograd {
+
+/// Offloading moves tensors saved for backward out of the working memory of
+/// the process while the forward pass continues, and brings them back before
+/// the backward pass needs them.
+///
+/// Saved tensors are handed to a background I/O thread, which writes them to
+/// the secondary tier and then drops the in-memory copy. During backward, the
+/// engine announces every function it is about to run; the tensors saved by
+/// the functions that run after it (the engine runs functions in decreasing
+/// order of `sequence_nr`) are then read back ahead of time, up to a budget.
+/// A tensor that has not been prefetched when it is needed is read
+/// synchronously.
+struct OffloadOptions {
+  enum class Tier {
+    /// One memory mapped file per tensor (see THMapAllocator) in `directory`.
+    File,
+    /// A lossless compressed copy in memory, which elides zero elements. This
+    /// suits activations after ReLU or dropout.
+    CompressedMemory,
+  };
+
+  Tier tier = Tier::File;
+  /// Directory for the files of the `File` tier. Should be on a fast local
+  /// disk.
+  std::string directory = "/tmp";
+  /// Smaller tensors are kept in memory.
+  int64_t min_bytes = 1 << 20;
+  /// The forward pass blocks while more than this many bytes are waiting to
+  /// be written, which bounds the memory held by the queue.
+  int64_t max_pending_write_bytes = int64_t(256) << 20;
+  /// At most this many bytes are prefetched ahead of their use.
+  int64_t prefetch_bytes = int64_t(256) << 20;
+};
+
+/// I/O counters of offloading, accumulated over all offload codecs.
+struct OffloadStats {
+  /// Number and size of the tensors written to the secondary tier.
+  int64_t tensors_offloaded = 0;
+  int64_t bytes_offloaded = 0;
+  /// Size of the offloaded tensors in the secondary tier (differs from
+  /// `bytes_offloaded` for the compressed tier).
+  int64_t bytes_stored = 0;
+  /// Number and size of the tensors read back.
+  int64_t tensors_loaded = 0;
+  int64_t bytes_loaded = 0;
+  /// Tensors that had been read back (or were still in memory) when needed,
+  /// and tensors that had to be read synchronously.
+  int64_t prefetch_hits = 0;
+  int64_t prefetch_misses = 0;
+  /// Time spent writing and reading on the I/O thread and in synchronous
+  /// reads, and time the forward and backward passes spent waiting for I/O.
+  int64_t write_ns = 0;
+  int64_t read_ns = 0;
+  int64_t stall_ns = 0;
+};
+
+/// Returns a codec that offloads the saved tensors it packs according to
+/// `options`. Like any codec, it can be set for some functions only, or as the
+/// default codec (see saved_tensor_codecs.h).
+TORCH_API std::shared_ptr<SavedTensorCodec> make_offload_codec(
+    OffloadOptions options);
+
+TORCH_API OffloadStats offload_stats();
+TORCH_API void reset_offload_stats();
+
+/// Blocks until every tensor handed to an offload codec so far has been
+/// written to the secondary tier, or has failed to.
+TORCH_API void wait_for_offloaded_writes();
+
+/// Called by the engine before it runs the function with `sequence_nr`;
+/// starts reading back the offloaded tensors that are needed next.
+TORCH_API void prefetch_offloaded_tensors(uint64_t sequence_nr);
+
+}} // namespace torch::autograd
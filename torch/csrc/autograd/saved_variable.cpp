@@ -4,6 +4,7 @@
 #include <torch/csrc/autograd/function.h>
 #include <torch/csrc/autograd/variable.h>
 #include <torch/csrc/autograd/anomaly_mode.h>
+#include <torch/csrc/autograd/saved_tensor_codecs.h>
 
 #include <ATen/Tensor.h>
 
@@ -33,8 +34,23 @@ SavedVariable::SavedVariable(const Variable& variable, bool is_output) {
   }
 }
 
+SavedVariable::SavedVariable(
+    const Variable& variable,
+    bool is_output,
+    const Function* saved_by)
+    : SavedVariable(variable, is_output) {
+  if (data_.defined() && saved_by) {
+    if (auto codec = saved_tensor_codec_for(*saved_by)) {
+      packed_ = codec->pack(data_, *saved_by);
+      if (packed_) {
+        data_.reset();
+      }
+    }
+  }
+}
+
 Variable SavedVariable::unpack(std::shared_ptr<Function> saved_for) const {
-  if (!data_.defined()) {
+  if (!data_.defined() && !packed_) {
     if (!was_default_constructed_) {
       throw std::runtime_error(ERR_BACKWARD_TWICE);
     }
@@ -51,11 +67,13 @@ Variable SavedVariable::unpack(std::shared_ptr<Function> saved_for) const {
     grad_fn = std::move(saved_for);
   }
 
+  const auto data = packed_ ? packed_->unpack() : data_;
+
   if (saved_version_ != version_counter_.current_version()) {
     std::stringstream message;
     message << "one of the variables needed for gradient computation has been "
-        "modified by an inplace operation: [" << data_.type().toString() << " "
-        << data_.sizes() << "]";
+        "modified by an inplace operation: [" << data.type().toString() << " "
+        << data.sizes() << "]";
     if (grad_fn) {
         message << ", which is output " << output_nr_
             << " of " << grad_fn->name() << ",";
@@ -80,9 +98,9 @@ Variable SavedVariable::unpack(std::shared_ptr<Function> saved_for) const {
   // in-place functions on unpacked variables.
   Variable var;
   if (grad_fn) {
-    var = make_variable(data_, Edge(std::move(grad_fn), output_nr_));
+    var = make_variable(data, Edge(std::move(grad_fn), output_nr_));
   } else {
-    var = make_variable(data_, requires_grad_);
+    var = make_variable(data, requires_grad_);
   }
   var.set_version_counter(saved_version_);
 
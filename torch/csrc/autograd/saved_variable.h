@@ -12,6 +12,7 @@ namespace torch { namespace autograd {
 
 struct Variable;
 struct Function;
+struct PackedTensor;
 
 TORCH_API extern const char* ERR_BACKWARD_TWICE;
 
@@ -21,6 +22,10 @@ class TORCH_API SavedVariable {
  public:
   SavedVariable() = default;
   SavedVariable(const Variable& variable, bool is_output);
+  /// Like the above, but packs the saved data with the codec registered for
+  /// `saved_by`, the function saving the variable, if there is one (see
+  /// saved_tensor_codecs.h).
+  SavedVariable(const Variable& variable, bool is_output, const Function* saved_by);
   SavedVariable(SavedVariable&&) = default;
   SavedVariable& operator=(SavedVariable&&) = default;
 
@@ -30,6 +35,7 @@ class TORCH_API SavedVariable {
   Variable unpack(std::shared_ptr<Function> saved_for = nullptr) const;
 
   void reset_data() {
+    packed_.reset();
     return data_.reset();
   }
 
@@ -39,6 +45,8 @@ class TORCH_API SavedVariable {
 
  private:
   at::Tensor data_;
+  // If set, data_ is undefined and the data is reconstructed from packed_.
+  std::shared_ptr<PackedTensor> packed_;
 
   // The gradient function associated with this node. If has_grad_fn
   // is false, then this is a leaf node. Note that the grad_fn is not saved if
@@ -9,6 +9,7 @@
 #include <torch/csrc/autograd/generated/VariableType.h>
 
 #include <ATen/ATen.h>
+#include <c10/core/impl/LocalBlockPool.h>
 #include <c10/util/Exception.h>
 
 #include <list>
@@ -20,6 +21,14 @@
 
 namespace torch {
 namespace autograd {
+void* Variable::AutogradMeta::operator new(size_t size) {
+  return c10::impl::local_pool_allocate(size);
+}
+
+void Variable::AutogradMeta::operator delete(void* ptr, size_t size) {
+  c10::impl::local_pool_free(ptr, size);
+}
+
 Variable::Impl::Impl(at::Tensor data, std::unique_ptr<Variable::AutogradMeta> autograd_meta, bool requires_grad, Edge gradient_edge)
     : TensorImpl(data.type_id(), data.dtype(), data.device()),
       data_(std::move(data)) {
@@ -374,6 +374,12 @@ struct TORCH_API Variable::AutogradMeta : public c10::AutogradMetaInterface {
   const Variable& grad() const override {
     return grad_;
   }
+
+  /// Every `Variable` allocates an `AutogradMeta` (or a
+  /// `DifferentiableViewMeta`), and most of them are short-lived temporaries.
+  /// Like TensorImpls, they are allocated from `c10::impl::local_pool_allocate`.
+  static void* operator new(size_t size);
+  static void operator delete(void* ptr, size_t size);
 };
 
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
@@ -41,9 +41,11 @@ inline int64_t current_time_in_nanos() {
 Reducer::Reducer(
     std::vector<std::vector<torch::autograd::Variable>> replicas,
     std::vector<std::vector<size_t>> bucket_indices,
-    std::shared_ptr<c10d::ProcessGroup> process_group)
+    std::shared_ptr<c10d::ProcessGroup> process_group,
+    std::vector<std::vector<bool>> expect_sparse_gradients)
     : replicas_(std::move(replicas)),
       process_group_(std::move(process_group)),
+      expect_sparse_gradients_(std::move(expect_sparse_gradients)),
       expect_autograd_hooks_(false),
       require_finalize_(false),
       has_marked_unused_parameters_(false),
@@ -79,6 +81,22 @@ Reducer::Reducer(
     }
   }
 
+  // If no sparse gradients are expected, mark all variables as dense.
+  if (expect_sparse_gradients_.empty()) {
+    expect_sparse_gradients_ = std::vector<std::vector<bool>>(
+        replicas_.size(), std::vector<bool>(replicas_[0].size(), false));
+  }
+  AT_ASSERTM(
+      expect_sparse_gradients_.size() == replicas_.size(),
+      "Expected one list of sparse gradient flags per model replica.");
+  for (size_t replica_index = 0; replica_index < replicas_.size();
+       replica_index++) {
+    AT_ASSERTM(
+        expect_sparse_gradients_[replica_index].size() ==
+            replicas_[replica_index].size(),
+        "Expected one sparse gradient flag per parameter.");
+  }
+
   // Initialize variable bucketing.
   // This can be reinitialized later after capturing runtime information.
   initialize_buckets(std::move(bucket_indices));
@@ -203,20 +221,48 @@ void Reducer::mark_variable_ready(
   // If the gradient is not set, we assume it wasn't computed
   // as part of the current backwards pass, and zero the part
   // of the bucket it would otherwise hold.
-  auto bucket_view = replica.contents.narrow(0, offset, length);
+  //
+  // Sparse gradients are not flattened, since that would densify them.
+  // The bucket holds the gradient itself instead, or an empty sparse
+  // tensor if it wasn't computed. The gradient is overwritten with the
+  // reduced result in `finalize_backward` anyway, so it can be reduced
+  // in place. The empty tensor has the layout of an embedding gradient,
+  // with a single sparse dimension, since the sparse allreduce requires
+  // the same number of sparse dimensions on all ranks.
   auto& grad = variable.grad();
-  if (grad.defined()) {
-    // Assert that the grad tensor and the bucket don't share storage.
-    // If they did, we could avoid the copy altogether.
-    // The reason for not doing this is that existing code calls
-    // `detach_` from `zero_grad`, which is incompatible with views.
-    AT_ASSERT(!grad.is_alias_of(bucket_view));
-    AT_ASSERT(grad.type() == variable.type());
-    AT_ASSERT(grad.device() == variable.device());
-    AT_ASSERT(grad.numel() == length);
-    bucket_view.copy_(grad.view({-1}), /* non_blocking */ true);
+  if (bucket.expect_sparse_gradient) {
+    if (grad.defined()) {
+      AT_ASSERTM(
+          grad.is_sparse(),
+          "Expected a sparse gradient for a parameter marked with "
+          "`expect_sparse_gradient`.");
+      replica.contents = grad;
+    } else {
+      replica.contents = torch::autograd::make_variable_consuming(
+          at::_sparse_coo_tensor_with_dims(
+              1,
+              variable.dim() - 1,
+              variable.sizes(),
+              at::TensorOptions()
+                  .device(variable.device())
+                  .dtype(variable.dtype())
+                  .layout(at::kSparse)));
+    }
   } else {
-    bucket_view.zero_();
+    auto bucket_view = replica.contents.narrow(0, offset, length);
+    if (grad.defined()) {
+      // Assert that the grad tensor and the bucket don't share storage.
+      // If they did, we could avoid the copy altogether.
+      // The reason for not doing this is that existing code calls
+      // `detach_` from `zero_grad`, which is incompatible with views.
+      AT_ASSERT(!grad.is_alias_of(bucket_view));
+      AT_ASSERT(grad.type() == variable.type());
+      AT_ASSERT(grad.device() == variable.device());
+      AT_ASSERT(grad.numel() == length);
+      bucket_view.copy_(grad.view({-1}), /* non_blocking */ true);
+    } else {
+      bucket_view.zero_();
+    }
   }
 
   // TODO(@pietern): Make this work for both CPU/CUDA tensors.
@@ -310,6 +356,26 @@ void Reducer::initialize_buckets(
     AT_ASSERTM(
         bucket_indices[bucket_index].size() > 0, "Empty bucket specified.");
 
+    // Variables that expect sparse gradients must be alone in a bucket.
+    if (bucket_indices[bucket_index].size() == 1) {
+      const auto variable_index = bucket_indices[bucket_index].front();
+      AT_ASSERTM(
+          variable_index < replicas_[0].size(),
+          "Out of range variable index specified.");
+      bucket.expect_sparse_gradient =
+          expect_sparse_gradients_[0][variable_index];
+    } else {
+      for (const auto variable_index : bucket_indices[bucket_index]) {
+        AT_ASSERTM(
+            variable_index < replicas_[0].size(),
+            "Out of range variable index specified.");
+        AT_ASSERTM(
+            !expect_sparse_gradients_[0][variable_index],
+            "Buckets with more than one variable cannot include variables ",
+            "that expect a sparse gradient.");
+      }
+    }
+
     // Iterate over model replicas.
     for (size_t replica_index = 0; replica_index < replica_count;
          replica_index++) {
@@ -348,8 +414,12 @@ void Reducer::initialize_buckets(
       // This must be a Variable because as of Apr 2019 there is still
       // a distinction between the Tensor and Variable types, and it
       // is not recommended (or sometimes even possible) to mix and match.
-      replica.contents = torch::autograd::make_variable_consuming(
-          at::empty({static_cast<long>(offset)}, options));
+      // Buckets with a sparse gradient take the gradient as their contents
+      // when it is ready.
+      if (!bucket.expect_sparse_gradient) {
+        replica.contents = torch::autograd::make_variable_consuming(
+            at::empty({static_cast<long>(offset)}, options));
+      }
 
       // Add bucket replica to enclosing bucket.
       bucket.replicas.push_back(std::move(replica));
@@ -482,6 +552,11 @@ void Reducer::finalize_backward() {
     AT_ASSERT(bucket.work);
     bucket.work->wait();
     for (auto& replica : bucket.replicas) {
+      // The contents of a sparse bucket is the reduced gradient.
+      if (bucket.expect_sparse_gradient) {
+        replica.variables.front().grad() = replica.contents;
+        continue;
+      }
       for (size_t intra_bucket_index = 0;
            intra_bucket_index < replica.variables.size();
            intra_bucket_index++) {
@@ -529,7 +604,14 @@ inline bool operator==(const BucketKey& lhs, const BucketKey& rhs) {
 // of device placement and will not allow buckets to span devices.
 std::vector<std::vector<size_t>> compute_bucket_assignment_by_size(
     const std::vector<at::Tensor>& tensors,
-    std::vector<size_t> bucket_size_limits) {
+    std::vector<size_t> bucket_size_limits,
+    const std::vector<bool>& expect_sparse_gradient) {
+  // Either expect_sparse_gradient is not specified or it has as many elements
+  // as the vector with tensors.
+  AT_ASSERT(
+      expect_sparse_gradient.empty() ||
+      (tensors.size() == expect_sparse_gradient.size()));
+
   std::vector<std::vector<size_t>> result;
   result.reserve(tensors.size());
 
@@ -554,6 +636,14 @@ std::vector<std::vector<size_t>> compute_bucket_assignment_by_size(
   for (size_t i = 0; i < tensors.size(); i++) {
     const auto& tensor = tensors[i];
     AT_ASSERTM(!tensor.is_sparse(), "No support for sparse tensors.");
+
+    // If we expect a sparse gradient to be produced for this tensor, it cannot
+    // be grouped together with other gradients and gets its own bucket.
+    if (!expect_sparse_gradient.empty() && expect_sparse_gradient[i]) {
+      result.push_back({i});
+      continue;
+    }
+
     auto key = BucketKey(tensor.scalar_type(), tensor.device());
     auto& bucket = buckets[key];
     bucket.indices.push_back(i);
@@ -19,10 +19,15 @@ class Reducer {
   // The bucket assignment for this reducer is specified as a list of
   // buckets, each of which is specified as a list of indices into the
   // variables list for **a single replica** (i.e. `variables[0]`).
+  // Variables that are expected to receive sparse gradients are marked in
+  // `expect_sparse_gradients` (one list per replica, empty for none). Their
+  // gradients are reduced as sparse tensors, so they must not share a
+  // bucket with other variables.
   explicit Reducer(
       std::vector<std::vector<torch::autograd::Variable>> replicas,
       std::vector<std::vector<size_t>> bucket_indices,
-      std::shared_ptr<c10d::ProcessGroup> process_group);
+      std::shared_ptr<c10d::ProcessGroup> process_group,
+      std::vector<std::vector<bool>> expect_sparse_gradients = {});
 
   // To (re-)initialize bucket assignment, pass a list of buckets, each
   // of which is specified by a list of indices in the variables list.
@@ -48,6 +53,7 @@ class Reducer {
   std::mutex mutex_;
   std::vector<std::vector<torch::autograd::Variable>> replicas_;
   std::shared_ptr<c10d::ProcessGroup> process_group_;
+  std::vector<std::vector<bool>> expect_sparse_gradients_;
 
   std::vector<std::vector<std::shared_ptr<torch::autograd::Function>>>
       grad_accumulators_;
@@ -80,6 +86,7 @@ class Reducer {
   //
   struct BucketReplica {
     // Flattened (1 dimensional) contents of bucket.
+    // For a bucket holding a sparse gradient, this is the gradient itself.
     at::Tensor contents;
 
     // Variables that contribute to this bucket replica. Use refcounted value
@@ -115,6 +122,10 @@ class Reducer {
 
     // Keep work handle around when this set of buckets is being reduced.
     std::shared_ptr<c10d::ProcessGroup::Work> work;
+
+    // If this bucket holds a single variable with a sparse gradient.
+    // Sparse gradients are reduced as is instead of being flattened.
+    bool expect_sparse_gradient = false;
   };
 
   std::vector<Bucket> buckets_;
@@ -140,8 +151,11 @@ class Reducer {
   std::vector<std::vector<int64_t>> backward_stats_;
 };
 
+// Tensors marked in `expect_sparse_gradient` are assigned a bucket of their
+// own, regardless of their size.
 std::vector<std::vector<size_t>> compute_bucket_assignment_by_size(
     const std::vector<at::Tensor>& tensors,
-    std::vector<size_t> bucket_size);
+    std::vector<size_t> bucket_size,
+    const std::vector<bool>& expect_sparse_gradient = {});
 
 } // namespace c10d
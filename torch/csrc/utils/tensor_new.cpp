@@ -2,6 +2,7 @@
 #include <torch/csrc/utils/tensor_new.h>
 
 #include <torch/csrc/DynamicTypes.h>
+#include <torch/csrc/byte_order.h>
 #include <torch/csrc/Exceptions.h>
 #include <torch/csrc/Size.h>
 #include <torch/csrc/autograd/variable.h>
@@ -20,7 +21,9 @@
 #include <c10/util/Exception.h>
 #include <c10/util/Optional.h>
 
+#include <memory>
 #include <stdexcept>
+#include <type_traits>
 #include <vector>
 
 using at::Backend;
@@ -144,16 +147,24 @@ ScalarType infer_scalar_type(PyObject *obj) {
   }
   if (PySequence_Check(obj)) {
     c10::optional<ScalarType> scalarType;
-    auto length = PySequence_Length(obj);
-    if (length < 0) throw python_error();
+    auto seq = THPObjectPtr(PySequence_Fast(obj, "not a sequence"));
+    if (!seq) throw python_error();
+    auto length = PySequence_Fast_GET_SIZE(seq.get());
     // match NumPy semantics, except use default tensor type instead of double.
     if (length == 0) return torch::tensors::get_default_scalar_type();
-    for (int i = 0; i < length; ++i) {
-      THPObjectPtr handle(PySequence_GetItem(obj, i));
-      if (!handle) throw python_error();
-      auto cur_item = handle.get();
+    PyObject** items = PySequence_Fast_ITEMS(seq.get());
+    for (int64_t i = 0; i < length; ++i) {
+      auto cur_item = items[i];
       if (cur_item == obj) throw TypeError("new(): self-referential lists are incompatible");
-      ScalarType item_scalarType = infer_scalar_type(cur_item);
+      // floats and ints, by far the most common items, are checked inline
+      ScalarType item_scalarType;
+      if (PyFloat_CheckExact(cur_item)) {
+        item_scalarType = torch::tensors::get_default_scalar_type();
+      } else if (PyLong_CheckExact(cur_item)) {
+        item_scalarType = ScalarType::Long;
+      } else {
+        item_scalarType = infer_scalar_type(cur_item);
+      }
       scalarType = (scalarType) ?
           at::promoteTypes(*scalarType, item_scalarType) : item_scalarType;
       if (scalarType == ScalarType::Double) {
@@ -166,6 +177,84 @@ ScalarType infer_scalar_type(PyObject *obj) {
   AT_ERROR("Could not infer dtype of ", Py_TYPE(obj)->tp_name);
 }
 
+// Stores the n Python numbers of `items`. Floats into floating point types
+// and ints into integral types are unpacked inline, without going through
+// store_scalar for every item.
+template <typename scalar_t>
+void store_numbers(char* data, int64_t stride, ScalarType scalarType, PyObject** items, int64_t n) {
+  for (int64_t i = 0; i < n; i++) {
+    PyObject* item = items[i];
+    if (std::is_floating_point<scalar_t>::value && PyFloat_CheckExact(item)) {
+      *(scalar_t*)data = static_cast<scalar_t>(PyFloat_AS_DOUBLE(item));
+    } else if (std::is_integral<scalar_t>::value && PyLong_CheckExact(item)) {
+      *(scalar_t*)data = static_cast<scalar_t>(THPUtils_unpackLong(item));
+    } else {
+      torch::utils::store_scalar(data, scalarType, item);
+    }
+    data += stride;
+  }
+}
+
+void store_numbers(char* data, int64_t stride, ScalarType scalarType, PyObject** items, int64_t n) {
+  switch (scalarType) {
+    case ScalarType::Byte: return store_numbers<uint8_t>(data, stride, scalarType, items, n);
+    case ScalarType::Char: return store_numbers<int8_t>(data, stride, scalarType, items, n);
+    case ScalarType::Short: return store_numbers<int16_t>(data, stride, scalarType, items, n);
+    case ScalarType::Int: return store_numbers<int32_t>(data, stride, scalarType, items, n);
+    case ScalarType::Long: return store_numbers<int64_t>(data, stride, scalarType, items, n);
+    case ScalarType::Float: return store_numbers<float>(data, stride, scalarType, items, n);
+    case ScalarType::Double: return store_numbers<double>(data, stride, scalarType, items, n);
+    default:
+      for (int64_t i = 0; i < n; i++) {
+        torch::utils::store_scalar(data, scalarType, items[i]);
+        data += stride;
+      }
+  }
+}
+
+#ifdef USE_NUMPY
+// Whether tensor_from_numpy can share the memory of the array.
+bool is_shareable_numpy_array(PyObject* obj) {
+  if (!PyArray_Check(obj)) {
+    return false;
+  }
+  auto array = (PyArrayObject*)obj;
+  if (!PyArray_IS_C_CONTIGUOUS(array) || !PyArray_ISNOTSWAPPED(array)) {
+    return false;
+  }
+  switch (PyArray_TYPE(array)) {
+    case NPY_DOUBLE: case NPY_FLOAT: case NPY_HALF: case NPY_INT32:
+    case NPY_INT16: case NPY_INT8: case NPY_UINT8: case NPY_BOOL:
+      return true;
+    default:
+      return PyArray_TYPE(array) == NPY_LONGLONG || PyArray_TYPE(array) == NPY_INT64;
+  }
+}
+#endif
+
+// Copies a tensor or an array whose shape is sizes[dim:] at once, with the
+// GIL released, instead of element by element. Returns false for anything
+// else.
+bool store_block(char* data, IntArrayRef sizes, IntArrayRef strides, int64_t dim,
+                 ScalarType scalarType, PyObject* obj) {
+  Tensor src;
+  if (THPVariable_Check(obj)) {
+    src = reinterpret_cast<THPVariable*>(obj)->cdata.data();
+#ifdef USE_NUMPY
+  } else if (is_shareable_numpy_array(obj)) {
+    src = tensor_from_numpy(obj);
+#endif
+  }
+  if (!src.defined() || src.sizes() != sizes.slice(dim)) {
+    return false;
+  }
+  auto dst = at::from_blob(
+      data, sizes.slice(dim), strides.slice(dim), at::device(kCPU).dtype(scalarType));
+  AutoNoGIL no_gil;
+  dst.copy_(src);
+  return true;
+}
+
 void recursive_store(char* data, IntArrayRef sizes, IntArrayRef strides, int64_t dim,
                             ScalarType scalarType, int elementSize, PyObject* obj) {
   int64_t ndim = sizes.size();
@@ -173,6 +262,9 @@ void recursive_store(char* data, IntArrayRef sizes, IntArrayRef strides, int64_t
     torch::utils::store_scalar(data, scalarType, obj);
     return;
   }
+  if (store_block(data, sizes, strides, dim, scalarType, obj)) {
+    return;
+  }
 
   auto n = sizes[dim];
   auto seq = THPObjectPtr(PySequence_Fast(obj, "not a sequence"));
@@ -184,12 +276,115 @@ void recursive_store(char* data, IntArrayRef sizes, IntArrayRef strides, int64_t
   }
 
   PyObject** items = PySequence_Fast_ITEMS(seq.get());
+  if (dim + 1 == ndim) {
+    store_numbers(data, strides[dim] * elementSize, scalarType, items, n);
+    return;
+  }
   for (int64_t i = 0; i < n; i++) {
     recursive_store(data, sizes, strides, dim + 1, scalarType, elementSize, items[i]);
     data += strides[dim] * elementSize;
   }
 }
 
+// Whether to read `obj` through the buffer protocol, e.g. an array.array, a
+// memoryview or a bytearray. Text never is, and neither is str on Python 2.
+bool is_buffer(PyObject* obj) {
+#if PY_MAJOR_VERSION == 2
+  if (PyBytes_Check(obj)) {
+    return false;
+  }
+#endif
+  return !PyUnicode_Check(obj) && PyObject_CheckBuffer(obj);
+}
+
+// The scalar type of the items of a buffer, from their struct module format,
+// or nullopt if tensors don't support them.
+c10::optional<ScalarType> buffer_scalar_type(const Py_buffer& view) {
+  const char* format = view.format ? view.format : "B";
+  switch (*format) {
+    case '@': case '=':
+      format++;
+      break;
+    case '<':
+      if (THP_nativeByteOrder() != THP_LITTLE_ENDIAN) return c10::nullopt;
+      format++;
+      break;
+    case '>': case '!':
+      if (THP_nativeByteOrder() != THP_BIG_ENDIAN) return c10::nullopt;
+      format++;
+      break;
+  }
+  if (format[0] == '\0' || format[1] != '\0') {
+    return c10::nullopt;
+  }
+  switch (format[0]) {
+    case 'e': if (view.itemsize == 2) return ScalarType::Half; break;
+    case 'f': if (view.itemsize == 4) return ScalarType::Float; break;
+    case 'd': if (view.itemsize == 8) return ScalarType::Double; break;
+    case 'B': if (view.itemsize == 1) return ScalarType::Byte; break;
+    case '?': if (view.itemsize == 1) return ScalarType::Bool; break;
+    case 'b': case 'h': case 'i': case 'l': case 'q': case 'n':
+      switch (view.itemsize) {
+        case 1: return ScalarType::Char;
+        case 2: return ScalarType::Short;
+        case 4: return ScalarType::Int;
+        case 8: return ScalarType::Long;
+      }
+      break;
+  }
+  return c10::nullopt;
+}
+
+// Copies the items of a buffer straight from its memory, with the GIL
+// released. The type inferred is the one of the sequence of the items, so
+// that e.g. an array.array gives the same tensor as the list of its items.
+// Returns an undefined tensor for buffers that are read as sequences instead.
+Tensor new_from_buffer(
+    const Type& type,
+    ScalarType scalar_type,
+    c10::optional<Device> device_opt,
+    PyObject* data,
+    bool type_inference) {
+  Py_buffer view;
+  if (PyObject_GetBuffer(data, &view, PyBUF_STRIDES | PyBUF_FORMAT) != 0) {
+    PyErr_Clear();
+    return Tensor();
+  }
+  std::unique_ptr<Py_buffer, decltype(&PyBuffer_Release)> view_guard(&view, &PyBuffer_Release);
+  auto item_scalar_type = buffer_scalar_type(view);
+  // scalars, e.g. NumPy ones, which export 0-d buffers, infer their own type
+  if (!item_scalar_type || view.ndim == 0) {
+    return Tensor();
+  }
+  std::vector<int64_t> sizes(view.shape, view.shape + view.ndim);
+  std::vector<int64_t> strides(view.ndim);
+  for (int i = 0; i < view.ndim; i++) {
+    if (view.strides[i] < 0 || view.strides[i] % view.itemsize != 0) {
+      return Tensor();
+    }
+    strides[i] = view.strides[i] / view.itemsize;
+  }
+  auto tensor = autograd::make_variable(
+      at::from_blob(view.buf, sizes, strides, at::device(kCPU).dtype(*item_scalar_type)),
+      /*requires_grad=*/false);
+  ScalarType inferred_scalar_type = scalar_type;
+  if (type_inference) {
+    // Like an empty list, an empty buffer has no items to infer a type from.
+    if (view.len == 0 || at::isFloatingType(*item_scalar_type)) {
+      inferred_scalar_type = torch::tensors::get_default_scalar_type();
+    } else if (*item_scalar_type == ScalarType::Bool) {
+      // TODO: infer Bool when we have Bool ScalarType
+      inferred_scalar_type = ScalarType::Byte;
+    } else {
+      inferred_scalar_type = ScalarType::Long;
+    }
+  }
+  auto device = device_opt.has_value() ? *device_opt : at::Device(type.device_type());
+  AutoNoGIL no_gil;
+  maybe_initialize_cuda(device);
+  return tensor.to(device, inferred_scalar_type, /*non_blocking=*/false, /*copy=*/true);
+}
+
 Tensor internal_new_from_data(
     const Type& type,
     ScalarType scalar_type,
@@ -200,7 +395,7 @@ Tensor internal_new_from_data(
     bool type_inference,
     bool pin_memory = false) {
 
-  if (THPUtils_checkString(data)) {
+  if (THPUtils_checkString(data) && !is_buffer(data)) {
     throw TypeError("new(): invalid data type '%s'", Py_TYPE(data)->tp_name);
   }
 
@@ -231,6 +426,13 @@ Tensor internal_new_from_data(
   }
 #endif
 
+  if (!pin_memory && is_buffer(data)) {
+    auto tensor = new_from_buffer(type, scalar_type, device_opt, data, type_inference);
+    if (tensor.defined()) {
+      return tensor;
+    }
+  }
+
   auto sizes = compute_sizes(data);
   ScalarType inferred_scalar_type = type_inference ? infer_scalar_type(data) : scalar_type;
   auto tensor = autograd::make_variable(at::empty(sizes, at::initialTensorOptions().dtype(inferred_scalar_type).pinned_memory(pin_memory)), /*requires_grad=*/false);
@@ -22,6 +22,7 @@ from . import PrefixStore
 _MPI_AVAILABLE = True
 _NCCL_AVAILABLE = True
 _GLOO_AVAILABLE = True
+_SHM_AVAILABLE = True
 
 
 try:
@@ -39,10 +40,15 @@ try:
 except ImportError:
     _GLOO_AVAILABLE = False
 
+try:
+    from. import ProcessGroupShm
+except ImportError:
+    _SHM_AVAILABLE = False
+
 
 class Backend(object):
     """
-    An enum-like class of available backends: GLOO, NCCL, and MPI.
+    An enum-like class of available backends: GLOO, NCCL, MPI, and SHM.
 
     The values of this class are lowercase strings, e.g., ``"gloo"``. They can
     be accessed as attributes, e.g., ``Backend.NCCL``.
@@ -60,6 +66,7 @@ class Backend(object):
     GLOO = "gloo"
     NCCL = "nccl"
     MPI = "mpi"
+    SHM = "shm"
     TCP = "tcp"
 
     def __new__(cls, name):
@@ -256,6 +263,14 @@ def is_gloo_available():
     return _GLOO_AVAILABLE
 
 
+def is_shm_available():
+    """
+    Checks if the shared memory backend is available.
+
+    """
+    return _SHM_AVAILABLE
+
+
 def is_initialized():
     """
     Checking if the default process group has been initialized
@@ -333,12 +348,14 @@ def init_process_group(backend,
     Arguments:
         backend (str or Backend): The backend to use. Depending on
             build-time configurations, valid values include ``mpi``, ``gloo``,
-            and ``nccl``. This field should be given as a lowercase string
+            ``nccl`` and ``shm``. This field should be given as a lowercase string
             (e.g., ``"gloo"``), which can also be accessed via
             :class:`Backend` attributes (e.g., ``Backend.GLOO``). If using
             multiple processes per machine with ``nccl`` backend, each process
             must have exclusive access to every GPU it uses, as sharing GPUs
-            between processes can result in deadlocks.
+            between processes can result in deadlocks. The ``shm`` backend
+            runs collectives on CPU tensors through shared memory, and
+            requires all processes to run on the same machine.
         init_method (str, optional): URL specifying how to initialize the
                                      process group. Default is "env://" if no
                                      ``init_method`` or ``store`` is specified.
@@ -352,7 +369,7 @@ def init_process_group(backend,
                                 Mutually exclusive with ``init_method``.
         timeout (timedelta, optional): Timeout for operations executed against
             the process group. Default value equals 30 minutes.
-            This is only applicable for the ``gloo`` backend.
+            This is only applicable for the ``gloo`` and ``shm`` backends.
         group_name (str, optional, deprecated): Group name.
 
     To enable ``backend == Backend.MPI``, PyTorch needs to built from source
@@ -484,6 +501,17 @@ def _new_process_group_helper(world_size,
                 timeout=timeout)
             _pg_map[pg] = (Backend.GLOO, store)
             _pg_names[pg] = group_name
+        elif backend == Backend.SHM:
+            if not is_shm_available():
+                raise RuntimeError("Distributed package doesn't have the "
+                                   "shared memory backend built in")
+            pg = ProcessGroupShm(
+                prefix_store,
+                rank,
+                world_size,
+                timeout=timeout)
+            _pg_map[pg] = (Backend.SHM, store)
+            _pg_names[pg] = group_name
         elif backend == Backend.NCCL:
             if not is_nccl_available():
                 raise RuntimeError("Distributed package doesn't have NCCL "
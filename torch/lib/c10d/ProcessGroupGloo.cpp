@@ -608,6 +608,119 @@ class AsyncAllreduceCUDAWork : public AsyncAllreduceWork {
 
 #endif
 
+// Sparse tensors with up to this many dimensions can be reduced.
+constexpr int64_t kSparseMaxDims = 16;
+
+// Number of nonzeros, number of sparse and dense dimensions, and sizes.
+constexpr int64_t kSparseMetadataSize = 3 + kSparseMaxDims;
+
+// Reduces sparse COO tensors by gathering the indices and values of all
+// ranks and summing duplicate indices locally, so that the bytes exchanged
+// scale with the number of nonzeros instead of the dense size.
+class AsyncSparseAllreduceWork : public ProcessGroupGloo::AsyncWork {
+ public:
+  AsyncSparseAllreduceWork(
+      const std::shared_ptr<gloo::Context>& context,
+      std::vector<at::Tensor>& inputs,
+      uint32_t tag)
+      : context(context), inputs(inputs), tag(tag) {}
+
+  std::shared_ptr<gloo::Context> context;
+  std::vector<at::Tensor> inputs;
+  const uint32_t tag;
+
+  // Returns the metadata of the tensor on every rank, one row per rank.
+  at::Tensor allgatherMetadata(const at::Tensor& tensor) {
+    auto metadata = at::full({kSparseMetadataSize}, -1, at::kLong);
+    auto data = metadata.data<int64_t>();
+    data[0] = tensor._nnz();
+    data[1] = tensor.sparse_dim();
+    data[2] = tensor.dense_dim();
+    for (int64_t i = 0; i < tensor.dim(); i++) {
+      data[3 + i] = tensor.size(i);
+    }
+
+    auto output = at::empty({context->size, kSparseMetadataSize}, at::kLong);
+    gloo::AllgatherOptions opts(context);
+    opts.setTag(tag);
+    setInput<int64_t>(opts, metadata);
+    setOutput<int64_t>(opts, output);
+    gloo::allgather(opts);
+    return output;
+  }
+
+  // Gathers the tensor from every rank, padded with zeros to `rows` rows so
+  // that every rank contributes the same number of elements.
+  at::Tensor allgatherPadded(const at::Tensor& tensor, int64_t rows) {
+    auto sizes = tensor.sizes().vec();
+    sizes[0] = rows;
+    auto input = at::zeros(sizes, tensor.options());
+    input.narrow(0, 0, tensor.size(0)).copy_(tensor);
+    sizes.insert(sizes.begin(), context->size);
+    auto output = at::empty(sizes, tensor.options());
+
+    const auto& scalarType = tensor.scalar_type();
+    gloo::AllgatherOptions opts(context);
+    opts.setTag(tag);
+    GENERATE_ALL_TYPES(scalarType, setInput, opts, input);
+    GENERATE_ALL_TYPES(scalarType, setOutput, opts, output);
+    gloo::allgather(opts);
+    return output;
+  }
+
+  at::Tensor allreduce(std::vector<at::Tensor>& tensors) {
+    // Sum the local tensors and remove duplicate indices first, so that
+    // every rank sends an index at most once.
+    auto input = tensors[0];
+    for (size_t i = 1; i < tensors.size(); i++) {
+      input = input + tensors[i];
+    }
+    input = input.coalesce();
+
+    const auto metadata = allgatherMetadata(input);
+    const auto data = metadata.data<int64_t>();
+    int64_t maxNnz = 0;
+    for (int i = 0; i < context->size; i++) {
+      const auto row = data + i * kSparseMetadataSize;
+      if (!std::equal(row + 1, row + kSparseMetadataSize, data + 1)) {
+        throw std::runtime_error(
+            "ProcessGroupGloo::allreduce: sparse tensors must have the same "
+            "sizes and number of sparse dimensions on all ranks");
+      }
+      maxNnz = std::max(maxNnz, row[0]);
+    }
+    if (maxNnz == 0) {
+      return input;
+    }
+
+    // Indices are gathered as [nnz, sparse dims], so that both the indices
+    // and the values can be padded along their first dimension.
+    auto indices = allgatherPadded(input.indices().t(), maxNnz);
+    auto values = allgatherPadded(input.values(), maxNnz);
+    std::vector<at::Tensor> allIndices;
+    std::vector<at::Tensor> allValues;
+    for (int i = 0; i < context->size; i++) {
+      const auto nnz = data[i * kSparseMetadataSize];
+      allIndices.push_back(indices[i].narrow(0, 0, nnz));
+      allValues.push_back(values[i].narrow(0, 0, nnz));
+    }
+
+    // Coalescing sums the values of indices present on several ranks.
+    return at::sparse_coo_tensor(
+               at::cat(allIndices).t().contiguous(),
+               at::cat(allValues),
+               input.sizes())
+        .coalesce();
+  }
+
+  void run() override {
+    auto output = allreduce(inputs);
+    for (auto& input : inputs) {
+      input.copy_(output);
+    }
+  }
+};
+
 } // namespace
 
 std::shared_ptr<ProcessGroup::Work> ProcessGroupGloo::allreduce(
@@ -618,7 +731,6 @@ std::shared_ptr<ProcessGroup::Work> ProcessGroupGloo::allreduce(
   };
 
   assertNonEmpty(invalidArgument, inputs);
-  assertDense(invalidArgument, inputs);
   assertTypeAndSizesMatch(invalidArgument, inputs);
 
   const auto& device = inputs[0].device();
@@ -632,8 +744,28 @@ std::shared_ptr<ProcessGroup::Work> ProcessGroupGloo::allreduce(
       invalidArgument("unsupported device type");
   }
 
-  std::shared_ptr<AsyncAllreduceWork> work;
   auto& context = contexts_[0];
+  if (inputs[0].is_sparse()) {
+    if (device.type() != at::kCPU) {
+      invalidArgument("only supports sparse CPU tensors");
+    }
+    if (opts.reduceOp != ReduceOp::SUM) {
+      invalidArgument("only supports ReduceOp::SUM for sparse tensors");
+    }
+    if (inputs[0].dim() > kSparseMaxDims) {
+      invalidArgument(
+          "only supports sparse tensors with up to " +
+          std::to_string(kSparseMaxDims) + " dimensions");
+    }
+    auto work =
+        std::make_shared<AsyncSparseAllreduceWork>(context, inputs, nextTag());
+    enqueue(work);
+    return work;
+  }
+
+  assertDense(invalidArgument, inputs);
+
+  std::shared_ptr<AsyncAllreduceWork> work;
   if (device.type() == at::kCPU) {
     work = std::make_shared<AsyncAllreduceWork>(
         context, inputs, opts.reduceOp, nextTag());
@@ -0,0 +1,640 @@
+#include <c10d/ProcessGroupShm.hpp>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <cstring>
+#include <random>
+#include <system_error>
+
+#include <ATen/Dispatch.h>
+
+namespace c10d {
+
+namespace {
+
+constexpr size_t kCacheLineSize = 64;
+constexpr size_t kPageSize = 4096;
+
+// Waiters spin this long on the barrier before they sleep.
+constexpr auto kSpinTime = std::chrono::microseconds(50);
+// Sleeping waiters wake up at least this often to check for the timeout.
+constexpr auto kSleepTime = std::chrono::milliseconds(100);
+
+const std::string kSegmentKey = "shm_segment";
+
+static_assert(
+    ATOMIC_INT_LOCK_FREE == 2,
+    "ProcessGroupShm requires lock-free atomics in shared memory");
+
+size_t roundUp(size_t n, size_t multiple) {
+  return (n + multiple - 1) / multiple * multiple;
+}
+
+#ifdef __linux__
+// The futex is not FUTEX_PRIVATE_FLAG, since the other ranks map the segment
+// at other addresses or in other processes.
+void futexWait(
+    std::atomic<uint32_t>* word,
+    uint32_t expected,
+    std::chrono::nanoseconds timeout) {
+  struct timespec ts;
+  ts.tv_sec = timeout.count() / 1000000000;
+  ts.tv_nsec = timeout.count() % 1000000000;
+  // EAGAIN, EINTR and ETIMEDOUT are all handled by checking the word again.
+  syscall(SYS_futex, word, FUTEX_WAIT, expected, &ts, nullptr, 0);
+}
+
+void futexWakeAll(std::atomic<uint32_t>* word) {
+  syscall(SYS_futex, word, FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+}
+#endif
+
+// Combines n elements of src into dst. The loops are simple enough for the
+// compiler to vectorize them.
+template <typename T>
+void reduceInto(T* dst, const T* src, size_t n, ReduceOp op) {
+  switch (op) {
+    case ReduceOp::SUM:
+      for (size_t i = 0; i < n; i++) {
+        dst[i] = dst[i] + src[i];
+      }
+      break;
+    case ReduceOp::PRODUCT:
+      for (size_t i = 0; i < n; i++) {
+        dst[i] = dst[i] * src[i];
+      }
+      break;
+    case ReduceOp::MIN:
+      for (size_t i = 0; i < n; i++) {
+        dst[i] = src[i] < dst[i] ? src[i] : dst[i];
+      }
+      break;
+    case ReduceOp::MAX:
+      for (size_t i = 0; i < n; i++) {
+        dst[i] = src[i] > dst[i] ? src[i] : dst[i];
+      }
+      break;
+    case ReduceOp::UNUSED:
+      throw std::invalid_argument("ProcessGroupShm: invalid reduce operation");
+  }
+}
+
+void reduceInto(
+    at::ScalarType type,
+    void* dst,
+    const void* src,
+    size_t n,
+    ReduceOp op) {
+  AT_DISPATCH_ALL_TYPES(type, "ProcessGroupShm::reduce", [&] {
+    reduceInto<scalar_t>(
+        static_cast<scalar_t*>(dst), static_cast<const scalar_t*>(src), n, op);
+  });
+}
+
+void assertContiguous(
+    std::function<void(const std::string&)> fn,
+    const at::ArrayRef<at::Tensor>& tensors) {
+  for (const auto& tensor : tensors) {
+    if (!tensor.is_contiguous()) {
+      fn("only supports contiguous tensors");
+    }
+  }
+}
+
+// Reductions fail on the worker thread after the other ranks have entered
+// the collective, which would leave them waiting, so check the type upfront.
+void assertReducible(
+    std::function<void(const std::string&)> fn,
+    const at::Tensor& tensor,
+    ReduceOp op) {
+  switch (tensor.scalar_type()) {
+    case at::kByte:
+    case at::kChar:
+    case at::kShort:
+    case at::kInt:
+    case at::kLong:
+    case at::kFloat:
+    case at::kDouble:
+      break;
+    default:
+      fn("unsupported tensor type " + tensor.type().toString());
+  }
+  if (op == ReduceOp::UNUSED) {
+    fn("invalid reduce operation");
+  }
+}
+
+void assertSingleTensor(
+    std::function<void(const std::string&)> fn,
+    const std::vector<at::Tensor>& tensors) {
+  assertSingleElement(fn, tensors);
+  assertDense(fn, tensors);
+  assertCPU(fn, tensors);
+  assertContiguous(fn, tensors);
+}
+
+uint8_t* bytes(const at::Tensor& tensor) {
+  return static_cast<uint8_t*>(tensor.data_ptr());
+}
+
+} // namespace
+
+// The control block at the start of the segment. Every field has a cache
+// line of its own, so that spinning on the generation does not slow down
+// the ranks arriving at the barrier.
+struct ProcessGroupShm::Control {
+  // Number of ranks that entered the current barrier.
+  alignas(kCacheLineSize) std::atomic<uint32_t> arrived;
+  // Incremented by the last rank to enter a barrier, which releases the
+  // others. This is the futex word.
+  alignas(kCacheLineSize) std::atomic<uint32_t> generation;
+  // Number of ranks sleeping on the futex.
+  alignas(kCacheLineSize) std::atomic<uint32_t> sleepers;
+};
+
+ProcessGroupShm::Options::Options()
+    : bufferSize(4 * 1024 * 1024),
+      timeout(std::chrono::milliseconds(10 * 1000)) {}
+
+ProcessGroupShm::ProcessGroupShm(
+    const std::shared_ptr<Store>& store,
+    int rank,
+    int size,
+    Options options)
+    : ProcessGroup(rank, size),
+      options_(options),
+      segment_(nullptr),
+      segmentSize_(0),
+      control_(nullptr),
+      slots_(nullptr),
+      step_(0),
+      stop_(false) {
+  // Both halves of a slot must hold whole cache lines, and reduce_scatter
+  // needs room for an element from every rank.
+  options_.bufferSize = roundUp(
+      std::max(options_.bufferSize, 2 * sizeof(double) * size),
+      2 * kCacheLineSize);
+  mapSegment(*store);
+
+  // Start the worker thread running the collectives
+  workerThread_ = std::thread(&ProcessGroupShm::runLoop, this);
+}
+
+ProcessGroupShm::~ProcessGroupShm() {
+  std::unique_lock<std::mutex> lock(pgMutex_);
+  queueConsumeCV_.wait(lock, [&] { return queue_.empty(); });
+
+  // Queue is empty, signal stop
+  stop_ = true;
+
+  // Release lock to allow threads to terminate
+  lock.unlock();
+  queueProduceCV_.notify_all();
+
+  // Join the single worker thread
+  workerThread_.join();
+
+  munmap(segment_, segmentSize_);
+}
+
+void ProcessGroupShm::mapSegment(Store& store) {
+  const auto controlSize = roundUp(sizeof(Control), kPageSize);
+  segmentSize_ = controlSize + options_.bufferSize * size_;
+
+  std::string name;
+  int fd = -1;
+  if (rank_ == 0) {
+    std::random_device rd;
+    do {
+      name = "/c10d_shm_" + std::to_string(getpid()) + "_" +
+          std::to_string(rd());
+      fd = shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+    } while (fd == -1 && errno == EEXIST);
+    if (fd == -1) {
+      throw std::system_error(errno, std::system_category(), "shm_open");
+    }
+  } else {
+    const auto value = store.get(kSegmentKey);
+    name = std::string(value.begin(), value.end());
+    fd = shm_open(name.c_str(), O_RDWR, 0);
+    if (fd == -1) {
+      throw std::runtime_error(
+          "ProcessGroupShm: cannot open shared memory segment " + name + " (" +
+          std::strerror(errno) + "), are all ranks on the same host?");
+    }
+  }
+
+  // Remove the name as soon as all ranks have mapped the segment, or if
+  // anything fails before that.
+  ResourceGuard unlinkName([&] {
+    if (rank_ == 0) {
+      shm_unlink(name.c_str());
+    }
+  });
+  {
+    ResourceGuard closeFd([fd] { ::close(fd); });
+    if (rank_ == 0) {
+      // The new segment is zero filled, which initializes the control block.
+      SYSCHECK_ERR_RETURN_NEG1(ftruncate(fd, segmentSize_));
+    }
+    SYSCHECK(
+        segment_ = mmap(
+            nullptr,
+            segmentSize_,
+            PROT_READ | PROT_WRITE,
+            MAP_SHARED,
+            fd,
+            0),
+        __output != MAP_FAILED);
+  }
+  control_ = static_cast<Control*>(segment_);
+  slots_ = static_cast<uint8_t*>(segment_) + controlSize;
+
+  if (rank_ == 0) {
+    store.set(kSegmentKey, std::vector<uint8_t>(name.begin(), name.end()));
+  }
+  try {
+    barrierWait();
+  } catch (...) {
+    munmap(segment_, segmentSize_);
+    throw;
+  }
+}
+
+void ProcessGroupShm::barrierWait() {
+  auto& control = *control_;
+  const auto generation = control.generation.load();
+  if (control.arrived.fetch_add(1) == uint32_t(size_ - 1)) {
+    // No rank can enter the next barrier before the generation changes.
+    control.arrived.store(0);
+    control.generation.fetch_add(1);
+#ifdef __linux__
+    if (control.sleepers.load() > 0) {
+      futexWakeAll(&control.generation);
+    }
+#endif
+    return;
+  }
+
+  const auto start = std::chrono::steady_clock::now();
+  auto now = start;
+  while (now - start < kSpinTime) {
+    if (control.generation.load() != generation) {
+      return;
+    }
+    now = std::chrono::steady_clock::now();
+  }
+
+  const auto deadline = start + options_.timeout;
+  while (control.generation.load() == generation) {
+    now = std::chrono::steady_clock::now();
+    if (now >= deadline) {
+      throw std::runtime_error(
+          "ProcessGroupShm: timed out waiting for the other ranks");
+    }
+#ifdef __linux__
+    // The waker reads the sleepers after changing the generation, so either
+    // it sees this rank sleeping or the futex sees the new generation.
+    control.sleepers.fetch_add(1);
+    futexWait(
+        &control.generation,
+        generation,
+        std::min<std::chrono::nanoseconds>(deadline - now, kSleepTime));
+    control.sleepers.fetch_sub(1);
+#else
+    std::this_thread::sleep_for(std::chrono::microseconds(10));
+#endif
+  }
+}
+
+uint8_t* ProcessGroupShm::slot(int rank) const {
+  return slots_ + options_.bufferSize * rank +
+      options_.bufferSize / 2 * step_;
+}
+
+void ProcessGroupShm::runLoop() {
+  std::unique_lock<std::mutex> lock(pgMutex_);
+
+  while (!stop_) {
+    if (queue_.empty()) {
+      queueProduceCV_.wait(lock);
+      continue;
+    }
+
+    auto workTuple = std::move(queue_.front());
+
+    queue_.pop_front();
+
+    auto& fn = std::get<0>(workTuple);
+    auto& work = std::get<1>(workTuple);
+
+    lock.unlock();
+    queueConsumeCV_.notify_one();
+
+    try {
+      fn();
+      work->finish();
+    } catch (...) {
+      work->finish(std::current_exception());
+    }
+
+    lock.lock();
+  }
+}
+
+std::shared_ptr<ProcessGroup::Work> ProcessGroupShm::enqueue(WorkFunc fn) {
+  auto work = std::make_shared<WorkShm>();
+  std::unique_lock<std::mutex> lock(pgMutex_);
+  queue_.push_back(std::make_tuple(std::move(fn), work));
+  lock.unlock();
+  queueProduceCV_.notify_one();
+  return work;
+}
+
+// Every chunk below is written to the current half of the slots, read after
+// a barrier, and the next chunk moves to the other half. A half is written
+// again only after the barrier of the next chunk, which all ranks enter once
+// they are done reading it.
+
+void ProcessGroupShm::runBroadcast(at::Tensor& tensor, int rootRank) {
+  const size_t elementSize = tensor.element_size();
+  const size_t numel = tensor.numel();
+  const size_t chunk = chunkElements(elementSize);
+  auto data = bytes(tensor);
+  for (size_t offset = 0; offset < numel; offset += chunk) {
+    const auto length = std::min(chunk, numel - offset) * elementSize;
+    auto ptr = data + offset * elementSize;
+    if (rank_ == rootRank) {
+      std::memcpy(slot(rank_), ptr, length);
+    }
+    barrierWait();
+    if (rank_ != rootRank) {
+      std::memcpy(ptr, slot(rootRank), length);
+    }
+    nextStep();
+  }
+}
+
+// Reduces the tensor into all ranks, or into rootRank only if it is not -1.
+void ProcessGroupShm::runAllreduce(
+    at::Tensor& tensor,
+    ReduceOp op,
+    int rootRank) {
+  const auto type = tensor.scalar_type();
+  const size_t elementSize = tensor.element_size();
+  const size_t numel = tensor.numel();
+  const size_t chunk = chunkElements(elementSize);
+  const size_t lineElements = kCacheLineSize / elementSize;
+  auto data = bytes(tensor);
+  for (size_t offset = 0; offset < numel; offset += chunk) {
+    const auto length = std::min(chunk, numel - offset);
+    std::memcpy(
+        slot(rank_), data + offset * elementSize, length * elementSize);
+    barrierWait();
+
+    // Every rank reduces a segment of whole cache lines into its own slot,
+    // so that no two ranks write to the same line.
+    const auto segment = roundUp((length + size_ - 1) / size_, lineElements);
+    const auto begin = std::min(length, segment * rank_);
+    const auto end = std::min(length, begin + segment);
+    if (begin < end) {
+      auto dst = slot(rank_) + begin * elementSize;
+      for (int i = 0; i < size_; i++) {
+        if (i != rank_) {
+          reduceInto(
+              type, dst, slot(i) + begin * elementSize, end - begin, op);
+        }
+      }
+    }
+    barrierWait();
+
+    if (rootRank == -1 || rootRank == rank_) {
+      for (int i = 0; i < size_; i++) {
+        const auto segmentBegin = std::min(length, segment * i);
+        const auto segmentEnd = std::min(length, segmentBegin + segment);
+        std::memcpy(
+            data + (offset + segmentBegin) * elementSize,
+            slot(i) + segmentBegin * elementSize,
+            (segmentEnd - segmentBegin) * elementSize);
+      }
+    }
+    nextStep();
+  }
+}
+
+void ProcessGroupShm::runAllgather(
+    std::vector<at::Tensor>& outputs,
+    at::Tensor& input) {
+  const size_t elementSize = input.element_size();
+  const size_t numel = input.numel();
+  const size_t chunk = chunkElements(elementSize);
+  for (size_t offset = 0; offset < numel; offset += chunk) {
+    const auto length = std::min(chunk, numel - offset) * elementSize;
+    std::memcpy(slot(rank_), bytes(input) + offset * elementSize, length);
+    barrierWait();
+    for (int i = 0; i < size_; i++) {
+      std::memcpy(bytes(outputs[i]) + offset * elementSize, slot(i), length);
+    }
+    nextStep();
+  }
+}
+
+void ProcessGroupShm::runReduceScatter(
+    at::Tensor& output,
+    std::vector<at::Tensor>& inputs,
+    ReduceOp op) {
+  const auto type = output.scalar_type();
+  const size_t elementSize = output.element_size();
+  const size_t numel = output.numel();
+  const size_t lineElements = kCacheLineSize / elementSize;
+  // Every slot holds a chunk of the input for every rank, starting on a
+  // cache line if the chunks are large enough.
+  auto stride = chunkElements(elementSize) / size_;
+  if (stride > lineElements) {
+    stride = stride / lineElements * lineElements;
+  }
+  auto data = bytes(output);
+  for (size_t offset = 0; offset < numel; offset += stride) {
+    const auto length = std::min(stride, numel - offset) * elementSize;
+    for (int i = 0; i < size_; i++) {
+      std::memcpy(
+          slot(rank_) + i * stride * elementSize,
+          bytes(inputs[i]) + offset * elementSize,
+          length);
+    }
+    barrierWait();
+
+    // The output is private, so reduce into it directly.
+    auto dst = data + offset * elementSize;
+    const auto chunkOffset = rank_ * stride * elementSize;
+    std::memcpy(dst, slot(rank_) + chunkOffset, length);
+    for (int i = 0; i < size_; i++) {
+      if (i != rank_) {
+        reduceInto(
+            type, dst, slot(i) + chunkOffset, length / elementSize, op);
+      }
+    }
+    nextStep();
+  }
+}
+
+std::shared_ptr<ProcessGroup::Work> ProcessGroupShm::broadcast(
+    std::vector<at::Tensor>& tensors,
+    const BroadcastOptions& opts) {
+  static auto invalidArgument = [](const std::string& msg) {
+    throw std::invalid_argument("ProcessGroupShm::broadcast: " + msg);
+  };
+
+  assertRootRank(invalidArgument, opts.rootRank, size_);
+  assertRootTensor(invalidArgument, opts.rootTensor, tensors.size());
+  assertSingleTensor(invalidArgument, tensors);
+
+  auto tensor = tensors[0];
+  const auto rootRank = opts.rootRank;
+  return enqueue(
+      [this, tensor, rootRank]() mutable { runBroadcast(tensor, rootRank); });
+}
+
+std::shared_ptr<ProcessGroup::Work> ProcessGroupShm::allreduce(
+    std::vector<at::Tensor>& tensors,
+    const AllreduceOptions& opts) {
+  static auto invalidArgument = [](const std::string& msg) {
+    throw std::invalid_argument("ProcessGroupShm::allreduce: " + msg);
+  };
+
+  assertSingleTensor(invalidArgument, tensors);
+  assertReducible(invalidArgument, tensors[0], opts.reduceOp);
+
+  auto tensor = tensors[0];
+  const auto op = opts.reduceOp;
+  return enqueue(
+      [this, tensor, op]() mutable { runAllreduce(tensor, op, -1); });
+}
+
+std::shared_ptr<ProcessGroup::Work> ProcessGroupShm::reduce(
+    std::vector<at::Tensor>& tensors,
+    const ReduceOptions& opts) {
+  static auto invalidArgument = [](const std::string& msg) {
+    throw std::invalid_argument("ProcessGroupShm::reduce: " + msg);
+  };
+
+  assertRootRank(invalidArgument, opts.rootRank, size_);
+  assertRootTensor(invalidArgument, opts.rootTensor, tensors.size());
+  assertSingleTensor(invalidArgument, tensors);
+  assertReducible(invalidArgument, tensors[0], opts.reduceOp);
+
+  auto tensor = tensors[0];
+  const auto op = opts.reduceOp;
+  const auto rootRank = opts.rootRank;
+  return enqueue([this, tensor, op, rootRank]() mutable {
+    runAllreduce(tensor, op, rootRank);
+  });
+}
+
+std::shared_ptr<ProcessGroup::Work> ProcessGroupShm::allgather(
+    std::vector<std::vector<at::Tensor>>& outputs,
+    std::vector<at::Tensor>& inputs,
+    const AllgatherOptions& opts) {
+  static auto invalidArgument = [](const std::string& msg) {
+    throw std::invalid_argument("ProcessGroupShm::allgather: " + msg);
+  };
+
+  assertSingleTensor(invalidArgument, inputs);
+  if (outputs.size() != 1) {
+    invalidArgument("requires a single-element output list");
+  }
+  if (outputs[0].size() != static_cast<size_t>(size_)) {
+    invalidArgument(
+        "requires an output list of " + std::to_string(size_) + " tensors");
+  }
+  assertTypeAndSizesMatch(
+      invalidArgument, outputs[0], inputs[0].type(), inputs[0].sizes());
+  assertContiguous(invalidArgument, outputs[0]);
+
+  auto input = inputs[0];
+  auto outputTensors = outputs[0];
+  return enqueue([this, outputTensors, input]() mutable {
+    runAllgather(outputTensors, input);
+  });
+}
+
+std::shared_ptr<ProcessGroup::Work> ProcessGroupShm::reduce_scatter(
+    std::vector<at::Tensor>& outputs,
+    std::vector<std::vector<at::Tensor>>& inputs,
+    const ReduceScatterOptions& opts) {
+  static auto invalidArgument = [](const std::string& msg) {
+    throw std::invalid_argument("ProcessGroupShm::reduce_scatter: " + msg);
+  };
+
+  assertSingleTensor(invalidArgument, outputs);
+  assertReducible(invalidArgument, outputs[0], opts.reduceOp);
+  if (inputs.size() != 1) {
+    invalidArgument("requires a single-element input list");
+  }
+  if (inputs[0].size() != static_cast<size_t>(size_)) {
+    invalidArgument(
+        "requires an input list of " + std::to_string(size_) + " tensors");
+  }
+  assertTypeAndSizesMatch(
+      invalidArgument, inputs[0], outputs[0].type(), outputs[0].sizes());
+  assertContiguous(invalidArgument, inputs[0]);
+
+  auto output = outputs[0];
+  auto inputTensors = inputs[0];
+  const auto op = opts.reduceOp;
+  return enqueue([this, output, inputTensors, op]() mutable {
+    runReduceScatter(output, inputTensors, op);
+  });
+}
+
+std::shared_ptr<ProcessGroup::Work> ProcessGroupShm::barrier(
+    const BarrierOptions& opts) {
+  return enqueue([this]() { barrierWait(); });
+}
+
+std::shared_ptr<ProcessGroup::Work> ProcessGroupShm::gather(
+    std::vector<std::vector<at::Tensor>>& /* unused */,
+    std::vector<at::Tensor>& /* unused */,
+    const GatherOptions& /* unused */) {
+  throw std::runtime_error("ProcessGroupShm does not support gather");
+}
+
+std::shared_ptr<ProcessGroup::Work> ProcessGroupShm::scatter(
+    std::vector<at::Tensor>& /* unused */,
+    std::vector<std::vector<at::Tensor>>& /* unused */,
+    const ScatterOptions& /* unused */) {
+  throw std::runtime_error("ProcessGroupShm does not support scatter");
+}
+
+std::shared_ptr<ProcessGroup::Work> ProcessGroupShm::send(
+    std::vector<at::Tensor>& /* unused */,
+    int /* unused */,
+    int /* unused */) {
+  throw std::runtime_error("ProcessGroupShm does not support send");
+}
+
+std::shared_ptr<ProcessGroup::Work> ProcessGroupShm::recv(
+    std::vector<at::Tensor>& /* unused */,
+    int /* unused */,
+    int /* unused */) {
+  throw std::runtime_error("ProcessGroupShm does not support recv");
+}
+
+std::shared_ptr<ProcessGroup::Work> ProcessGroupShm::recvAnysource(
+    std::vector<at::Tensor>& /* unused */,
+    int /* unused */) {
+  throw std::runtime_error("ProcessGroupShm does not support recv");
+}
+
+} // namespace c10d
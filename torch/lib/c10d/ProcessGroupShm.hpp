@@ -0,0 +1,179 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#include <c10d/ProcessGroup.hpp>
+#include <c10d/Store.hpp>
+#include <c10d/Types.hpp>
+#include <c10d/Utils.hpp>
+
+namespace c10d {
+
+// ProcessGroupShm implements collectives on CPU tensors for processes that
+// run on the same host, through a shared memory segment that every process
+// maps. It avoids the copies through the loopback interface and the socket
+// system calls that ProcessGroupGloo makes in this setting.
+//
+// Rank 0 creates the segment with shm_open and publishes its name through the
+// store; the segment is unlinked as soon as every rank has mapped it, so that
+// it does not outlive the processes. The segment holds a small control block
+// followed by one slot of Options::bufferSize bytes per rank. Every slot is
+// split in two halves that collectives use in turn, which lets consecutive
+// collectives overlap by a phase without corrupting each other. Tensors
+// larger than half a slot are processed in chunks.
+//
+// The ranks synchronize with a barrier in the control block: waiters spin
+// for a while and then sleep on a futex, which also works between mappings
+// of the segment in different processes. A rank that waits longer than
+// Options::timeout throws, and the process group must not be used
+// afterwards.
+//
+// An allreduce is a reduce-scatter followed by an allgather within the
+// segment. Every rank copies its chunk to its slot, reduces one cache line
+// aligned segment of the chunk across all slots, and then copies the reduced
+// segments of all ranks back to its tensor.
+//
+// Like ProcessGroupMPI, all collectives run on a single worker thread, in
+// the order they were issued, and only single tensor collectives are
+// supported. The functions of this class must be called in the same order
+// by all processes in the group.
+class ProcessGroupShm : public ProcessGroup {
+ public:
+  class WorkShm : public ProcessGroup::Work {
+   protected:
+    friend class ProcessGroupShm;
+  };
+
+  struct Options {
+    explicit Options();
+
+    // Size of the slot of every rank in the segment.
+    size_t bufferSize;
+    std::chrono::milliseconds timeout;
+  };
+
+  explicit ProcessGroupShm(
+      const std::shared_ptr<Store>& store,
+      int rank,
+      int size,
+      Options options = Options());
+
+  virtual ~ProcessGroupShm();
+
+  std::shared_ptr<ProcessGroup::Work> broadcast(
+      std::vector<at::Tensor>& tensors,
+      const BroadcastOptions& opts = BroadcastOptions()) override;
+
+  std::shared_ptr<ProcessGroup::Work> allreduce(
+      std::vector<at::Tensor>& tensors,
+      const AllreduceOptions& opts = AllreduceOptions()) override;
+
+  std::shared_ptr<ProcessGroup::Work> reduce(
+      std::vector<at::Tensor>& tensors,
+      const ReduceOptions& opts = ReduceOptions()) override;
+
+  std::shared_ptr<ProcessGroup::Work> allgather(
+      std::vector<std::vector<at::Tensor>>& outputs,
+      std::vector<at::Tensor>& inputs,
+      const AllgatherOptions& opts = AllgatherOptions()) override;
+
+  std::shared_ptr<ProcessGroup::Work> gather(
+      std::vector<std::vector<at::Tensor>>& outputs,
+      std::vector<at::Tensor>& inputs,
+      const GatherOptions& opts = GatherOptions()) override;
+
+  std::shared_ptr<ProcessGroup::Work> scatter(
+      std::vector<at::Tensor>& outputs,
+      std::vector<std::vector<at::Tensor>>& inputs,
+      const ScatterOptions& opts = ScatterOptions()) override;
+
+  std::shared_ptr<ProcessGroup::Work> reduce_scatter(
+      std::vector<at::Tensor>& outputs,
+      std::vector<std::vector<at::Tensor>>& inputs,
+      const ReduceScatterOptions& opts = ReduceScatterOptions()) override;
+
+  std::shared_ptr<ProcessGroup::Work> send(
+      std::vector<at::Tensor>& tensors,
+      int dstRank,
+      int tag) override;
+
+  std::shared_ptr<ProcessGroup::Work> recv(
+      std::vector<at::Tensor>& tensors,
+      int srcRank,
+      int tag) override;
+
+  std::shared_ptr<ProcessGroup::Work> recvAnysource(
+      std::vector<at::Tensor>& tensors,
+      int tag) override;
+
+  std::shared_ptr<ProcessGroup::Work> barrier(
+      const BarrierOptions& opts = BarrierOptions()) override;
+
+ protected:
+  struct Control;
+
+  using WorkFunc = std::function<void()>;
+  using WorkType = std::tuple<WorkFunc, std::shared_ptr<WorkShm>>;
+
+  // Worker thread loop
+  void runLoop();
+
+  std::shared_ptr<ProcessGroup::Work> enqueue(WorkFunc fn);
+
+  // Maps the segment, creating it on rank 0.
+  void mapSegment(Store& store);
+
+  // Waits until all ranks have called it.
+  void barrierWait();
+
+  // Returns the half of the slot of `rank` used by the current collective.
+  uint8_t* slot(int rank) const;
+
+  // Moves to the other half of the slots, for the next collective or chunk.
+  void nextStep() {
+    step_ ^= 1;
+  }
+
+  // Number of elements of the given size that fit in half a slot.
+  size_t chunkElements(size_t elementSize) const {
+    return options_.bufferSize / 2 / elementSize;
+  }
+
+  // Runs on the worker thread.
+  void runBroadcast(at::Tensor& tensor, int rootRank);
+  void runAllreduce(at::Tensor& tensor, ReduceOp op, int rootRank);
+  void runAllgather(std::vector<at::Tensor>& outputs, at::Tensor& input);
+  void runReduceScatter(
+      at::Tensor& output,
+      std::vector<at::Tensor>& inputs,
+      ReduceOp op);
+
+  Options options_;
+
+  void* segment_;
+  size_t segmentSize_;
+  Control* control_;
+  uint8_t* slots_;
+  int step_;
+
+  bool stop_;
+  std::mutex pgMutex_;
+  std::thread workerThread_;
+
+  std::deque<WorkType> queue_;
+  std::condition_variable queueProduceCV_;
+  std::condition_variable queueConsumeCV_;
+};
+
+} // namespace c10d
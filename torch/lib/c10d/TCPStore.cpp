@@ -1,156 +1,633 @@
 #include <c10d/TCPStore.hpp>
 
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
 #include <poll.h>
+#ifdef __linux__
+#include <sys/epoll.h>
+#endif
 
 #include <unistd.h>
 #include <algorithm>
+#include <cstring>
 #include <system_error>
+#include <unordered_set>
 
 namespace c10d {
 
 namespace {
 
-enum class QueryType : uint8_t { SET, GET, ADD, CHECK, WAIT };
+enum class QueryType : uint8_t {
+  SET,
+  GET,
+  ADD,
+  CHECK,
+  WAIT,
+  MULTI_GET,
+  MULTI_SET,
+  COMPARE_SET,
+  CANCEL_WAIT
+};
 
 enum class CheckResponseType : uint8_t { READY, NOT_READY };
 
-enum class WaitResponseType : uint8_t { STOP_WAITING };
+enum class WaitResponseType : uint8_t { STOP_WAITING, WAIT_CANCELED };
 
-} // anonymous namespace
+#ifdef MSG_NOSIGNAL
+constexpr int kSendFlags = MSG_NOSIGNAL;
+#else
+constexpr int kSendFlags = 0;
+#endif
 
-// TCPStoreDaemon class methods
-// Simply start the daemon thread
-TCPStoreDaemon::TCPStoreDaemon(int storeListenSocket)
-    : storeListenSocket_(storeListenSocket) {
-  // Use control pipe to signal instance destruction to the daemon thread.
-  if (pipe(controlPipeFd_.data()) == -1) {
-    throw std::runtime_error(
-        "Failed to create the control pipe to start the "
-        "TCPStoreDaemon run");
+// Queries and replies are serialized in the format of tcputil's send and
+// recv functions, so that the client can read the replies with them.
+template <typename T>
+void appendValue(std::vector<uint8_t>& buffer, const T& value) {
+  auto bytes = reinterpret_cast<const uint8_t*>(&value);
+  buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+}
+
+void appendString(std::vector<uint8_t>& buffer, const std::string& str) {
+  appendValue<SizeType>(buffer, str.size());
+  buffer.insert(buffer.end(), str.begin(), str.end());
+}
+
+void appendVector(std::vector<uint8_t>& buffer, const std::vector<uint8_t>& vec) {
+  appendValue<SizeType>(buffer, vec.size());
+  buffer.insert(buffer.end(), vec.begin(), vec.end());
+}
+
+void appendKeys(
+    std::vector<uint8_t>& buffer,
+    const std::vector<std::string>& keys) {
+  appendValue<SizeType>(buffer, keys.size());
+  for (const auto& key : keys) {
+    appendString(buffer, key);
   }
-  daemonThread_ = std::thread(&TCPStoreDaemon::run, this);
 }
 
-TCPStoreDaemon::~TCPStoreDaemon() {
-  // Stop the run
-  stop();
-  // Join the thread
-  join();
-  // Close unclosed sockets
-  for (auto socket : sockets_) {
-    if (socket != -1) {
-      ::close(socket);
+// Appends a wait for `keys`, followed by the queries to handle once the wait
+// is over. The daemon drops these queries if the wait is canceled.
+void appendWait(
+    std::vector<uint8_t>& buffer,
+    const std::vector<std::string>& keys,
+    const std::vector<uint8_t>& dependentQueries = {}) {
+  appendValue(buffer, QueryType::WAIT);
+  appendKeys(buffer, keys);
+  appendValue<SizeType>(buffer, dependentQueries.size());
+  buffer.insert(buffer.end(), dependentQueries.begin(), dependentQueries.end());
+}
+
+// Reads a query from a buffer that may not hold all of it yet. The read
+// functions return false when the buffer ends before the field.
+class QueryReader {
+ public:
+  QueryReader(const uint8_t* data, size_t size) : data_(data), size_(size) {}
+
+  template <typename T>
+  bool read(T* value) {
+    if (size_ - pos_ < sizeof(T)) {
+      return false;
     }
+    std::memcpy(value, data_ + pos_, sizeof(T));
+    pos_ += sizeof(T);
+    return true;
   }
-  // Now close the rest control pipe
-  for (auto fd : controlPipeFd_) {
-    if (fd != -1) {
-      ::close(fd);
+
+  bool readString(std::string* str) {
+    SizeType size;
+    if (!read(&size) || size_ - pos_ < size) {
+      return false;
+    }
+    str->assign(reinterpret_cast<const char*>(data_ + pos_), size);
+    pos_ += size;
+    return true;
+  }
+
+  bool readVector(std::vector<uint8_t>* vec) {
+    SizeType size;
+    if (!read(&size) || size_ - pos_ < size) {
+      return false;
+    }
+    vec->assign(data_ + pos_, data_ + pos_ + size);
+    pos_ += size;
+    return true;
+  }
+
+  bool readKeys(std::vector<std::string>* keys) {
+    SizeType nargs;
+    if (!read(&nargs)) {
+      return false;
+    }
+    keys->resize(nargs);
+    for (auto& key : *keys) {
+      if (!readString(&key)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  size_t consumed() const {
+    return pos_;
+  }
+
+ private:
+  const uint8_t* const data_;
+  const size_t size_;
+  size_t pos_ = 0;
+};
+
+struct PollEvent {
+  int fd;
+  bool readable;
+  bool writable;
+  bool hangup;
+};
+
+// Waits for the sockets of an event loop to be readable, or writable when
+// asked. Every socket is polled for reads.
+#ifdef __linux__
+class Poller {
+ public:
+  Poller() {
+    SYSCHECK_ERR_RETURN_NEG1(fd_ = ::epoll_create1(EPOLL_CLOEXEC));
+  }
+
+  ~Poller() {
+    ::close(fd_);
+  }
+
+  void add(int fd) {
+    control(EPOLL_CTL_ADD, fd, false);
+  }
+
+  void pollWrites(int fd, bool writes) {
+    control(EPOLL_CTL_MOD, fd, writes);
+  }
+
+  void remove(int fd) {
+    ::epoll_ctl(fd_, EPOLL_CTL_DEL, fd, nullptr);
+  }
+
+  void wait(std::vector<PollEvent>* events) {
+    constexpr int kMaxEvents = 256;
+    struct ::epoll_event buffer[kMaxEvents];
+    int count;
+    SYSCHECK_ERR_RETURN_NEG1(
+        count = ::epoll_wait(fd_, buffer, kMaxEvents, -1));
+    events->clear();
+    for (int i = 0; i < count; i++) {
+      events->push_back({buffer[i].data.fd,
+                         (buffer[i].events & EPOLLIN) != 0,
+                         (buffer[i].events & EPOLLOUT) != 0,
+                         (buffer[i].events & (EPOLLHUP | EPOLLERR)) != 0});
+    }
+  }
+
+ private:
+  void control(int op, int fd, bool writes) {
+    struct ::epoll_event event;
+    std::memset(&event, 0, sizeof(event));
+    event.events = EPOLLIN | (writes ? uint32_t(EPOLLOUT) : 0);
+    event.data.fd = fd;
+    SYSCHECK_ERR_RETURN_NEG1(::epoll_ctl(fd_, op, fd, &event));
+  }
+
+  int fd_;
+};
+#else
+class Poller {
+ public:
+  void add(int fd) {
+    fds_.push_back({.fd = fd, .events = POLLIN});
+  }
+
+  void pollWrites(int fd, bool writes) {
+    find(fd)->events = POLLIN | (writes ? POLLOUT : 0);
+  }
+
+  void remove(int fd) {
+    fds_.erase(find(fd));
+  }
+
+  void wait(std::vector<PollEvent>* events) {
+    SYSCHECK_ERR_RETURN_NEG1(::poll(fds_.data(), fds_.size(), -1));
+    events->clear();
+    for (const auto& fd : fds_) {
+      if (fd.revents != 0) {
+        events->push_back({fd.fd,
+                           (fd.revents & POLLIN) != 0,
+                           (fd.revents & POLLOUT) != 0,
+                           (fd.revents & (POLLHUP | POLLERR)) != 0});
+      }
     }
   }
+
+ private:
+  std::vector<struct ::pollfd>::iterator find(int fd) {
+    return std::find_if(
+        fds_.begin(), fds_.end(), [fd](const struct ::pollfd& pfd) {
+          return pfd.fd == fd;
+        });
+  }
+
+  std::vector<struct ::pollfd> fds_;
+};
+#endif
+
+void setNonBlocking(int socket) {
+  int flags;
+  SYSCHECK_ERR_RETURN_NEG1(flags = ::fcntl(socket, F_GETFL));
+  SYSCHECK_ERR_RETURN_NEG1(::fcntl(socket, F_SETFL, flags | O_NONBLOCK));
 }
 
-void TCPStoreDaemon::join() {
-  daemonThread_.join();
+void sendQuery(int socket, const std::vector<uint8_t>& query) {
+  tcputil::sendBytes<uint8_t>(socket, query.data(), query.size());
 }
 
-void TCPStoreDaemon::run() {
-  std::vector<struct pollfd> fds;
-  fds.push_back({.fd = storeListenSocket_, .events = POLLIN});
-  // Push the read end of the pipe to signal the stopping of the daemon run
-  fds.push_back({.fd = controlPipeFd_[0], .events = POLLHUP});
+} // anonymous namespace
+
+struct TCPStoreDaemon::Connection {
+  Connection(int socket, EventLoop* loop) : socket(socket), loop(loop) {}
+
+  const int socket;
+  EventLoop* const loop;
+
+  // Only used by the thread of the loop.
+  // Received bytes that are not handled yet.
+  std::vector<uint8_t> input;
+  // Replies, of which the first outputSent bytes were sent.
+  std::vector<uint8_t> output;
+  size_t outputSent = 0;
+  bool pollingWrites = false;
+  // Set while the client waits for keys; its next queries are not handled
+  // until then, except for a CANCEL_WAIT that follows the dependentBytes
+  // bytes of queries sent along with the wait.
+  bool waiting = false;
+  size_t dependentBytes = 0;
+  std::vector<std::string> awaitedKeys;
+  bool closed = false;
 
-  // receive the queries
-  bool finished = false;
-  while (!finished) {
-    for (size_t i = 0; i < sockets_.size(); i++) {
-      fds[i].revents = 0;
+  // Guarded by storeMutex_.
+  size_t keysAwaited = 0;
+};
+
+class TCPStoreDaemon::EventLoop {
+ public:
+  // Only the first loop accepts connections, and spreads them over all the
+  // loops.
+  EventLoop(TCPStoreDaemon* daemon, int listenSocket, int controlFd)
+      : daemon_(daemon), listenSocket_(listenSocket), controlFd_(controlFd) {
+    if (pipe(wakeupPipeFd_) == -1) {
+      throw std::runtime_error(
+          "Failed to create the wakeup pipe of a TCPStoreDaemon thread");
+    }
+    setNonBlocking(wakeupPipeFd_[0]);
+    setNonBlocking(wakeupPipeFd_[1]);
+    if (listenSocket_ != -1) {
+      poller_.add(listenSocket_);
     }
+    poller_.add(controlFd_);
+    poller_.add(wakeupPipeFd_[0]);
+  }
 
-    SYSCHECK_ERR_RETURN_NEG1(::poll(fds.data(), fds.size(), -1));
+  ~EventLoop() {
+    for (auto& entry : connections_) {
+      ::close(entry.first);
+    }
+    for (auto socket : newSockets_) {
+      ::close(socket);
+    }
+    ::close(wakeupPipeFd_[0]);
+    ::close(wakeupPipeFd_[1]);
+  }
 
-    // TCPStore's listening socket has an event and it should now be able to
-    // accept new connections.
-    if (fds[0].revents != 0) {
-      if (fds[0].revents ^ POLLIN) {
-        throw std::system_error(
-            ECONNABORTED,
-            std::system_category(),
-            "Unexpected poll revent on the master's listening socket: " +
-                std::to_string(fds[0].revents));
+  void run() {
+    current_ = this;
+    std::vector<PollEvent> events;
+    while (true) {
+      poller_.wait(&events);
+      for (const auto& event : events) {
+        if (event.fd == controlFd_) {
+          // The control pipe was closed, which tells us to shutdown.
+          return;
+        } else if (event.fd == listenSocket_) {
+          acceptConnections();
+        } else if (event.fd == wakeupPipeFd_[0]) {
+          char buffer[64];
+          while (::read(wakeupPipeFd_[0], buffer, sizeof(buffer)) > 0) {
+          }
+        } else {
+          auto it = connections_.find(event.fd);
+          if (it == connections_.end()) {
+            continue;
+          }
+          auto conn = it->second;
+          try {
+            if (event.readable || event.hangup) {
+              const bool closed = receive(*conn);
+              handleQueries(conn);
+              if (closed) {
+                // The queries sent before the client closed the connection
+                // are handled; reply to them in case it still reads.
+                flush(*conn);
+                close(conn);
+                continue;
+              }
+            }
+            flush(*conn);
+          } catch (...) {
+            // There was an error when processing the queries, probably
+            // because the socket on the other side has been closed. If the
+            // closing was due to normal exit, then the store should continue
+            // executing. Otherwise, if it was different exception, other
+            // connections will get an exception once they try to use the
+            // store. We will go ahead and close this connection whenever we
+            // hit an exception here.
+            close(conn);
+          }
+        }
       }
-      int sockFd = std::get<0>(tcputil::accept(storeListenSocket_));
-      sockets_.push_back(sockFd);
-      fds.push_back({.fd = sockFd, .events = POLLIN});
-    }
-    // The pipe receives an event which tells us to shutdown the daemon
-    if (fds[1].revents != 0) {
-      // Will be POLLUP when the pipe is closed
-      if (fds[1].revents ^ POLLHUP) {
-        throw std::system_error(
-            ECONNABORTED,
-            std::system_category(),
-            "Unexpected poll revent on the control pipe's reading fd: " +
-                std::to_string(fds[1].revents));
+      handleMailbox();
+    }
+  }
+
+  // Hands over an accepted socket. Called by the first loop.
+  void addSocket(int socket) {
+    {
+      std::lock_guard<std::mutex> lock(mailboxMutex_);
+      newSockets_.push_back(socket);
+    }
+    signal();
+  }
+
+  // Tells the loop that a connection stopped waiting. Called by any loop.
+  void wake(std::shared_ptr<Connection> conn) {
+    {
+      std::lock_guard<std::mutex> lock(mailboxMutex_);
+      wokenConnections_.push_back(std::move(conn));
+    }
+    // The loop checks its mailbox before polling again.
+    if (current_ != this) {
+      signal();
+    }
+  }
+
+ private:
+  void signal() {
+    const char byte = 0;
+    // If the pipe is full, the loop is already signaled.
+    if (::write(wakeupPipeFd_[1], &byte, 1) == -1 && errno != EAGAIN &&
+        errno != EWOULDBLOCK) {
+      throw std::system_error(errno, std::system_category());
+    }
+  }
+
+  void acceptConnections() {
+    while (true) {
+      int socket = ::accept(listenSocket_, nullptr, nullptr);
+      if (socket == -1) {
+        if (errno == EINTR) {
+          continue;
+        } else if (errno == EAGAIN || errno == EWOULDBLOCK) {
+          return;
+        } else if (errno == ECONNABORTED) {
+          // The client gave up before we accepted the connection.
+          continue;
+        }
+        throw std::system_error(errno, std::system_category());
       }
-      finished = true;
-      break;
-    }
-    // Skipping the fds[0] and fds[1],
-    // fds[0] is master's listening socket
-    // fds[1] is control pipe's reading fd
-    for (size_t fdIdx = 2; fdIdx < fds.size(); ++fdIdx) {
-      if (fds[fdIdx].revents == 0) {
-        continue;
+      int flag = 1;
+      SYSCHECK_ERR_RETURN_NEG1(::setsockopt(
+          socket, IPPROTO_TCP, TCP_NODELAY, (char*)&flag, sizeof(flag)));
+      setNonBlocking(socket);
+
+      auto& loop = daemon_->loops_[nextLoop_++ % daemon_->loops_.size()];
+      if (loop.get() == this) {
+        addConnection(socket);
+      } else {
+        loop->addSocket(socket);
       }
+    }
+  }
+
+  void addConnection(int socket) {
+    connections_.emplace(socket, std::make_shared<Connection>(socket, this));
+    poller_.add(socket);
+  }
+
+  void close(const std::shared_ptr<Connection>& conn) {
+    {
+      std::lock_guard<std::mutex> lock(daemon_->storeMutex_);
+      daemon_->forgetConnection(*conn);
+    }
+    conn->closed = true;
+    poller_.remove(conn->socket);
+    ::close(conn->socket);
+    connections_.erase(conn->socket);
+  }
 
-      if (fds[fdIdx].revents ^ POLLIN) {
-        throw std::system_error(
-            ECONNABORTED,
-            std::system_category(),
-            "Unexpected poll revent: " + std::to_string(fds[fdIdx].revents) +
-                " on socket: " + std::to_string(fds[fdIdx].fd));
+  // Reads everything the client sent so far. Returns whether the client
+  // closed the connection.
+  bool receive(Connection& conn) {
+    constexpr size_t kReadSize = 64 * 1024;
+    while (true) {
+      const size_t size = conn.input.size();
+      conn.input.resize(size + kReadSize);
+      ssize_t bytesReceived =
+          ::recv(conn.socket, conn.input.data() + size, kReadSize, 0);
+      conn.input.resize(size + std::max<ssize_t>(bytesReceived, 0));
+      if (bytesReceived == 0) {
+        return true;
+      } else if (bytesReceived == -1) {
+        if (errno == EINTR) {
+          continue;
+        } else if (errno == EAGAIN || errno == EWOULDBLOCK) {
+          return false;
+        }
+        throw std::system_error(errno, std::system_category());
+      } else if (static_cast<size_t>(bytesReceived) < kReadSize) {
+        return false;
       }
-      // Now query the socket that has the event
-      try {
-        query(fds[fdIdx].fd);
-      } catch (...) {
-        // There was an error when processing query. Probably an exception
-        // occurred in recv/send what would indicate that socket on the other
-        // side has been closed. If the closing was due to normal exit, then
-        // the store should continue executing. Otherwise, if it was different
-        // exception, other connections will get an exception once they try to
-        // use the store. We will go ahead and close this connection whenever
-        // we hit an exception here.
-        ::close(fds[fdIdx].fd);
-
-        // Remove all the tracking state of the close FD
-        for (auto it = waitingSockets_.begin(); it != waitingSockets_.end();) {
-          for (auto vecIt = it->second.begin(); vecIt != it->second.end();) {
-            if (*vecIt == fds[fdIdx].fd) {
-              vecIt = it->second.erase(vecIt);
-            } else {
-              ++vecIt;
-            }
-          }
-          if (it->second.size() == 0) {
-            it = waitingSockets_.erase(it);
-          } else {
-            ++it;
-          }
+    }
+  }
+
+  // Handles the complete queries received from the client, until it waits.
+  void handleQueries(const std::shared_ptr<Connection>& conn) {
+    size_t handled = 0;
+    while (handled < conn->input.size()) {
+      if (conn->waiting) {
+        // A client that gives up waiting sends a CANCEL_WAIT right after the
+        // queries that depend on the wait, which are dropped.
+        const size_t cancelPos = handled + conn->dependentBytes;
+        if (cancelPos >= conn->input.size()) {
+          break;
         }
-        for (auto it = keysAwaited_.begin(); it != keysAwaited_.end();) {
-          if (it->first == fds[fdIdx].fd) {
-            it = keysAwaited_.erase(it);
-          } else {
-            ++it;
-          }
+        if (static_cast<QueryType>(conn->input[cancelPos]) !=
+            QueryType::CANCEL_WAIT) {
+          throw std::runtime_error("Unexpected query while waiting");
         }
-        fds.erase(fds.begin() + fdIdx);
-        sockets_.erase(sockets_.begin() + fdIdx - 2);
-        --fdIdx;
+        if (!cancelWait(*conn)) {
+          // The keys were just set, and the connection is in the mailbox of
+          // its loop, which handles the queries as if the wait was over.
+          break;
+        }
+        handled = cancelPos + 1;
         continue;
       }
+      const size_t size = daemon_->query(
+          conn, conn->input.data() + handled, conn->input.size() - handled);
+      if (size == 0) {
+        break;
+      }
+      handled += size;
+    }
+    conn->input.erase(conn->input.begin(), conn->input.begin() + handled);
+  }
+
+  // Stops waiting for the keys that are not set yet, unless the connection was
+  // already woken up.
+  bool cancelWait(Connection& conn) {
+    {
+      std::lock_guard<std::mutex> lock(daemon_->storeMutex_);
+      if (conn.keysAwaited == 0) {
+        return false;
+      }
+      daemon_->forgetConnection(conn);
+      conn.keysAwaited = 0;
+    }
+    conn.waiting = false;
+    conn.dependentBytes = 0;
+    appendValue(conn.output, WaitResponseType::WAIT_CANCELED);
+    return true;
+  }
+
+  // Sends the pending replies, and polls for writes if the socket is full.
+  void flush(Connection& conn) {
+    while (conn.outputSent < conn.output.size()) {
+      ssize_t bytesSent = ::send(
+          conn.socket,
+          conn.output.data() + conn.outputSent,
+          conn.output.size() - conn.outputSent,
+          kSendFlags);
+      if (bytesSent == -1) {
+        if (errno == EINTR) {
+          continue;
+        } else if (errno == EAGAIN || errno == EWOULDBLOCK) {
+          break;
+        }
+        throw std::system_error(errno, std::system_category());
+      }
+      conn.outputSent += bytesSent;
+    }
+    const bool pending = conn.outputSent < conn.output.size();
+    if (!pending) {
+      conn.output.clear();
+      conn.outputSent = 0;
+    }
+    if (pending != conn.pollingWrites) {
+      poller_.pollWrites(conn.socket, pending);
+      conn.pollingWrites = pending;
+    }
+  }
+
+  void handleMailbox() {
+    while (true) {
+      std::vector<int> sockets;
+      std::vector<std::shared_ptr<Connection>> woken;
+      {
+        std::lock_guard<std::mutex> lock(mailboxMutex_);
+        sockets.swap(newSockets_);
+        woken.swap(wokenConnections_);
+      }
+      if (sockets.empty() && woken.empty()) {
+        return;
+      }
+      for (auto socket : sockets) {
+        addConnection(socket);
+      }
+      // Resuming a connection can wake up others of this loop, which are
+      // handled in the next round.
+      for (auto& conn : woken) {
+        if (conn->closed) {
+          continue;
+        }
+        try {
+          conn->waiting = false;
+          conn->dependentBytes = 0;
+          conn->awaitedKeys.clear();
+          appendValue(conn->output, WaitResponseType::STOP_WAITING);
+          handleQueries(conn);
+          flush(*conn);
+        } catch (...) {
+          close(conn);
+        }
+      }
+    }
+  }
+
+  // The loop of the current thread, if any.
+  static thread_local EventLoop* current_;
+
+  TCPStoreDaemon* const daemon_;
+  const int listenSocket_;
+  const int controlFd_;
+  int wakeupPipeFd_[2];
+  Poller poller_;
+  std::unordered_map<int, std::shared_ptr<Connection>> connections_;
+  size_t nextLoop_ = 0;
+
+  std::mutex mailboxMutex_;
+  std::vector<int> newSockets_;
+  std::vector<std::shared_ptr<Connection>> wokenConnections_;
+};
+
+thread_local TCPStoreDaemon::EventLoop* TCPStoreDaemon::EventLoop::current_ =
+    nullptr;
+
+// TCPStoreDaemon class methods
+// Simply start the daemon threads
+TCPStoreDaemon::TCPStoreDaemon(int storeListenSocket, size_t numThreads)
+    : storeListenSocket_(storeListenSocket) {
+  // Use control pipe to signal instance destruction to the daemon threads.
+  if (pipe(controlPipeFd_.data()) == -1) {
+    throw std::runtime_error(
+        "Failed to create the control pipe to start the "
+        "TCPStoreDaemon run");
+  }
+  // The first loop accepts all pending connections at once.
+  setNonBlocking(storeListenSocket_);
+  numThreads = std::max<size_t>(numThreads, 1);
+  for (size_t i = 0; i < numThreads; i++) {
+    loops_.emplace_back(new EventLoop(
+        this, i == 0 ? storeListenSocket_ : -1, controlPipeFd_[0]));
+  }
+  for (auto& loop : loops_) {
+    daemonThreads_.emplace_back(&EventLoop::run, loop.get());
+  }
+}
+
+TCPStoreDaemon::~TCPStoreDaemon() {
+  // Stop the run
+  stop();
+  // Join the threads
+  join();
+  // Close unclosed sockets
+  loops_.clear();
+  // Now close the rest control pipe
+  for (auto fd : controlPipeFd_) {
+    if (fd != -1) {
+      ::close(fd);
+    }
+  }
+}
+
+void TCPStoreDaemon::join() {
+  for (auto& thread : daemonThreads_) {
+    if (thread.joinable()) {
+      thread.join();
     }
   }
 }
@@ -163,109 +640,203 @@ void TCPStoreDaemon::stop() {
   }
 }
 
-// query communicates with the worker. The format
+// query handles a query of the worker. The format
 // of the query is as follows:
 // type of query | size of arg1 | arg1 | size of arg2 | arg2 | ...
-// or, in the case of wait
+// or, in the case of check and multi get
 // type of query | number of args | size of arg1 | arg1 | ...
-void TCPStoreDaemon::query(int socket) {
+// or, in the case of wait, followed by the queries to handle after it
+// type of query | number of args | size of arg1 | arg1 | ... | size of queries
+// or, in the case of multi set
+// type of query | number of keys | size of key1 | key1 | size of value1 | ...
+size_t TCPStoreDaemon::query(
+    const std::shared_ptr<Connection>& conn,
+    const uint8_t* data,
+    size_t size) {
+  QueryReader reader(data, size);
   QueryType qt;
-  tcputil::recvBytes<QueryType>(socket, &qt, 1);
+  if (!reader.read(&qt)) {
+    return 0;
+  }
+  std::vector<uint8_t>& output = conn->output;
+  std::vector<std::shared_ptr<Connection>> woken;
 
   if (qt == QueryType::SET) {
-    setHandler(socket);
+    std::string key;
+    std::vector<uint8_t> value;
+    if (!reader.readString(&key) || !reader.readVector(&value)) {
+      return 0;
+    }
+    std::lock_guard<std::mutex> lock(storeMutex_);
+    setKey(key, std::move(value), &woken);
 
   } else if (qt == QueryType::ADD) {
-    addHandler(socket);
+    std::string key;
+    int64_t addVal;
+    if (!reader.readString(&key) || !reader.read(&addVal)) {
+      return 0;
+    }
+    {
+      std::lock_guard<std::mutex> lock(storeMutex_);
+      auto it = tcpStore_.find(key);
+      if (it != tcpStore_.end()) {
+        auto buf = reinterpret_cast<const char*>(it->second.data());
+        auto len = it->second.size();
+        addVal += std::stoll(std::string(buf, len));
+      }
+      auto addValStr = std::to_string(addVal);
+      setKey(
+          key,
+          std::vector<uint8_t>(addValStr.begin(), addValStr.end()),
+          &woken);
+    }
+    // Now send the new value
+    appendValue<int64_t>(output, addVal);
 
   } else if (qt == QueryType::GET) {
-    getHandler(socket);
+    std::string key;
+    if (!reader.readString(&key)) {
+      return 0;
+    }
+    std::lock_guard<std::mutex> lock(storeMutex_);
+    appendVector(output, tcpStore_.at(key));
 
   } else if (qt == QueryType::CHECK) {
-    checkHandler(socket);
+    std::vector<std::string> keys;
+    if (!reader.readKeys(&keys)) {
+      return 0;
+    }
+    std::lock_guard<std::mutex> lock(storeMutex_);
+    appendValue(
+        output,
+        checkKeys(keys) ? CheckResponseType::READY
+                        : CheckResponseType::NOT_READY);
 
   } else if (qt == QueryType::WAIT) {
-    waitHandler(socket);
+    std::vector<std::string> keys;
+    SizeType dependentBytes;
+    if (!reader.readKeys(&keys) || !reader.read(&dependentBytes)) {
+      return 0;
+    }
+    std::lock_guard<std::mutex> lock(storeMutex_);
+    std::unordered_set<std::string> missingKeys;
+    for (const auto& key : keys) {
+      if (tcpStore_.count(key) == 0) {
+        missingKeys.insert(key);
+      }
+    }
+    if (missingKeys.empty()) {
+      appendValue(output, WaitResponseType::STOP_WAITING);
+    } else {
+      // The reply is sent by the loop once the last key is set.
+      for (const auto& key : missingKeys) {
+        waitingConnections_[key].push_back(conn);
+        conn->awaitedKeys.push_back(key);
+      }
+      conn->keysAwaited = missingKeys.size();
+      conn->waiting = true;
+      conn->dependentBytes = dependentBytes;
+    }
 
-  } else {
-    throw std::runtime_error("Unexpected query type");
-  }
-}
+  } else if (qt == QueryType::CANCEL_WAIT) {
+    // The wait was over before the client gave up on it, and the client
+    // expects no reply.
 
-void TCPStoreDaemon::wakeupWaitingClients(const std::string& key) {
-  auto socketsToWait = waitingSockets_.find(key);
-  if (socketsToWait != waitingSockets_.end()) {
-    for (int socket : socketsToWait->second) {
-      if (--keysAwaited_[socket] == 0) {
-        tcputil::sendValue<WaitResponseType>(
-            socket, WaitResponseType::STOP_WAITING);
-      }
+  } else if (qt == QueryType::MULTI_GET) {
+    std::vector<std::string> keys;
+    if (!reader.readKeys(&keys)) {
+      return 0;
+    }
+    std::lock_guard<std::mutex> lock(storeMutex_);
+    for (const auto& key : keys) {
+      appendVector(output, tcpStore_.at(key));
     }
-    waitingSockets_.erase(socketsToWait);
-  }
-}
 
-void TCPStoreDaemon::setHandler(int socket) {
-  std::string key = tcputil::recvString(socket);
-  tcpStore_[key] = tcputil::recvVector<uint8_t>(socket);
-  // On "set", wake up all clients that have been waiting
-  wakeupWaitingClients(key);
-}
+  } else if (qt == QueryType::MULTI_SET) {
+    SizeType nargs;
+    if (!reader.read(&nargs)) {
+      return 0;
+    }
+    std::vector<std::pair<std::string, std::vector<uint8_t>>> entries(nargs);
+    for (auto& entry : entries) {
+      if (!reader.readString(&entry.first) ||
+          !reader.readVector(&entry.second)) {
+        return 0;
+      }
+    }
+    std::lock_guard<std::mutex> lock(storeMutex_);
+    for (auto& entry : entries) {
+      setKey(entry.first, std::move(entry.second), &woken);
+    }
 
-void TCPStoreDaemon::addHandler(int socket) {
-  std::string key = tcputil::recvString(socket);
-  int64_t addVal = tcputil::recvValue<int64_t>(socket);
+  } else if (qt == QueryType::COMPARE_SET) {
+    std::string key;
+    std::vector<uint8_t> expectedValue;
+    std::vector<uint8_t> desiredValue;
+    if (!reader.readString(&key) || !reader.readVector(&expectedValue) ||
+        !reader.readVector(&desiredValue)) {
+      return 0;
+    }
+    std::lock_guard<std::mutex> lock(storeMutex_);
+    auto it = tcpStore_.find(key);
+    const bool matches = it == tcpStore_.end() ? expectedValue.empty()
+                                               : it->second == expectedValue;
+    if (matches) {
+      appendVector(output, desiredValue);
+      setKey(key, std::move(desiredValue), &woken);
+    } else {
+      appendVector(
+          output,
+          it == tcpStore_.end() ? std::vector<uint8_t>() : it->second);
+    }
 
-  if (tcpStore_.find(key) != tcpStore_.end()) {
-    auto buf = reinterpret_cast<const char*>(tcpStore_[key].data());
-    auto len = tcpStore_[key].size();
-    addVal += std::stoll(std::string(buf, len));
+  } else {
+    throw std::runtime_error("Unexpected query type");
   }
-  auto addValStr = std::to_string(addVal);
-  tcpStore_[key] = std::vector<uint8_t>(addValStr.begin(), addValStr.end());
-  // Now send the new value
-  tcputil::sendValue<int64_t>(socket, addVal);
-  // On "add", wake up all clients that have been waiting
-  wakeupWaitingClients(key);
-}
 
-void TCPStoreDaemon::getHandler(int socket) const {
-  std::string key = tcputil::recvString(socket);
-  auto data = tcpStore_.at(key);
-  tcputil::sendVector<uint8_t>(socket, data);
+  for (auto& wokenConn : woken) {
+    wokenConn->loop->wake(std::move(wokenConn));
+  }
+  return reader.consumed();
 }
 
-void TCPStoreDaemon::checkHandler(int socket) const {
-  SizeType nargs;
-  tcputil::recvBytes<SizeType>(socket, &nargs, 1);
-  std::vector<std::string> keys(nargs);
-  for (size_t i = 0; i < nargs; i++) {
-    keys[i] = tcputil::recvString(socket);
-  }
-  // Now we have received all the keys
-  if (checkKeys(keys)) {
-    tcputil::sendValue<CheckResponseType>(socket, CheckResponseType::READY);
-  } else {
-    tcputil::sendValue<CheckResponseType>(socket, CheckResponseType::NOT_READY);
+void TCPStoreDaemon::setKey(
+    const std::string& key,
+    std::vector<uint8_t> value,
+    std::vector<std::shared_ptr<Connection>>* woken) {
+  tcpStore_[key] = std::move(value);
+  // On "set", wake up all clients that have been waiting
+  auto it = waitingConnections_.find(key);
+  if (it != waitingConnections_.end()) {
+    for (auto& conn : it->second) {
+      if (--conn->keysAwaited == 0) {
+        woken->push_back(std::move(conn));
+      }
+    }
+    waitingConnections_.erase(it);
   }
 }
 
-void TCPStoreDaemon::waitHandler(int socket) {
-  SizeType nargs;
-  tcputil::recvBytes<SizeType>(socket, &nargs, 1);
-  std::vector<std::string> keys(nargs);
-  for (size_t i = 0; i < nargs; i++) {
-    keys[i] = tcputil::recvString(socket);
-  }
-  if (checkKeys(keys)) {
-    tcputil::sendValue<WaitResponseType>(
-        socket, WaitResponseType::STOP_WAITING);
-  } else {
-    for (auto& key : keys) {
-      waitingSockets_[key].push_back(socket);
+void TCPStoreDaemon::forgetConnection(Connection& conn) {
+  for (const auto& key : conn.awaitedKeys) {
+    auto it = waitingConnections_.find(key);
+    if (it == waitingConnections_.end()) {
+      continue;
+    }
+    auto& conns = it->second;
+    conns.erase(
+        std::remove_if(
+            conns.begin(),
+            conns.end(),
+            [&conn](const std::shared_ptr<Connection>& c) {
+              return c.get() == &conn;
+            }),
+        conns.end());
+    if (conns.empty()) {
+      waitingConnections_.erase(it);
     }
-    keysAwaited_[socket] = keys.size();
   }
+  conn.awaitedKeys.clear();
 }
 
 bool TCPStoreDaemon::checkKeys(const std::vector<std::string>& keys) const {
@@ -279,7 +850,8 @@ TCPStore::TCPStore(
     const std::string& masterAddr,
     PortType masterPort,
     int numWorkers,
-    bool isServer)
+    bool isServer,
+    int numServerThreads)
     : isServer_(isServer),
       tcpStoreAddr_(masterAddr),
       tcpStorePort_(masterPort),
@@ -291,7 +863,7 @@ TCPStore::TCPStore(
     std::tie(masterListenSocket_, std::ignore) = tcputil::listen(masterPort);
     // Now start the daemon
     tcpStoreDaemon_ = std::unique_ptr<TCPStoreDaemon>(
-        new TCPStoreDaemon(masterListenSocket_));
+        new TCPStoreDaemon(masterListenSocket_, numServerThreads));
   }
   // Connect to the daemon
   storeSocket_ = tcputil::connect(tcpStoreAddr_, tcpStorePort_);
@@ -334,11 +906,22 @@ void TCPStore::waitForWorkers_() {
   }
 }
 
+std::vector<std::string> TCPStore::regularKeys_(
+    const std::vector<std::string>& keys) {
+  std::vector<std::string> regKeys;
+  regKeys.reserve(keys.size());
+  for (const auto& key : keys) {
+    regKeys.push_back(regularPrefix_ + key);
+  }
+  return regKeys;
+}
+
 void TCPStore::set(const std::string& key, const std::vector<uint8_t>& data) {
-  std::string regKey = regularPrefix_ + key;
-  tcputil::sendValue<QueryType>(storeSocket_, QueryType::SET);
-  tcputil::sendString(storeSocket_, regKey, true);
-  tcputil::sendVector<uint8_t>(storeSocket_, data);
+  std::vector<uint8_t> query;
+  appendValue(query, QueryType::SET);
+  appendString(query, regularPrefix_ + key);
+  appendVector(query, data);
+  sendQuery(storeSocket_, query);
 }
 
 std::vector<uint8_t> TCPStore::get(const std::string& key) {
@@ -347,9 +930,16 @@ std::vector<uint8_t> TCPStore::get(const std::string& key) {
 }
 
 std::vector<uint8_t> TCPStore::getHelper_(const std::string& key) {
-  waitHelper_({key}, timeout_);
-  tcputil::sendValue<QueryType>(storeSocket_, QueryType::GET);
-  tcputil::sendString(storeSocket_, key);
+  setRecvTimeout_(timeout_);
+  // The daemon handles the get once the wait is over, so both are sent in
+  // one go.
+  std::vector<uint8_t> getQuery;
+  appendValue(getQuery, QueryType::GET);
+  appendString(getQuery, key);
+  std::vector<uint8_t> query;
+  appendWait(query, {key}, getQuery);
+  sendQuery(storeSocket_, query);
+  recvStopWaiting_();
   return tcputil::recvVector<uint8_t>(storeSocket_);
 }
 
@@ -359,20 +949,19 @@ int64_t TCPStore::add(const std::string& key, int64_t value) {
 }
 
 int64_t TCPStore::addHelper_(const std::string& key, int64_t value) {
-  tcputil::sendValue<QueryType>(storeSocket_, QueryType::ADD);
-  tcputil::sendString(storeSocket_, key, true);
-  tcputil::sendValue<int64_t>(storeSocket_, value);
+  std::vector<uint8_t> query;
+  appendValue(query, QueryType::ADD);
+  appendString(query, key);
+  appendValue<int64_t>(query, value);
+  sendQuery(storeSocket_, query);
   return tcputil::recvValue<int64_t>(storeSocket_);
 }
 
 bool TCPStore::check(const std::vector<std::string>& keys) {
-  tcputil::sendValue<QueryType>(storeSocket_, QueryType::CHECK);
-  SizeType nkeys = keys.size();
-  tcputil::sendBytes<SizeType>(storeSocket_, &nkeys, 1, (nkeys > 0));
-  for (size_t i = 0; i < nkeys; i++) {
-    std::string regKey = regularPrefix_ + keys[i];
-    tcputil::sendString(storeSocket_, regKey, (i != (nkeys - 1)));
-  }
+  std::vector<uint8_t> query;
+  appendValue(query, QueryType::CHECK);
+  appendKeys(query, regularKeys_(keys));
+  sendQuery(storeSocket_, query);
   auto checkResponse = tcputil::recvValue<CheckResponseType>(storeSocket_);
   if (checkResponse == CheckResponseType::READY) {
     return true;
@@ -390,38 +979,107 @@ void TCPStore::wait(const std::vector<std::string>& keys) {
 void TCPStore::wait(
     const std::vector<std::string>& keys,
     const std::chrono::milliseconds& timeout) {
-  std::vector<std::string> regKeys;
-  regKeys.resize(keys.size());
-  for (size_t i = 0; i < keys.size(); ++i) {
-    regKeys[i] = regularPrefix_ + keys[i];
-  }
-  waitHelper_(regKeys, timeout);
+  waitHelper_(regularKeys_(keys), timeout);
 }
 
 void TCPStore::waitHelper_(
     const std::vector<std::string>& keys,
     const std::chrono::milliseconds& timeout) {
-  // Set the socket timeout if there is a wait timeout
-  if (timeout != kNoTimeout) {
-    struct timeval timeoutTV = {.tv_sec = timeout.count() / 1000,
-                                .tv_usec = (timeout.count() % 1000) * 1000};
-    SYSCHECK_ERR_RETURN_NEG1(::setsockopt(
-        storeSocket_,
-        SOL_SOCKET,
-        SO_RCVTIMEO,
-        reinterpret_cast<char*>(&timeoutTV),
-        sizeof(timeoutTV)));
-  }
-  tcputil::sendValue<QueryType>(storeSocket_, QueryType::WAIT);
-  SizeType nkeys = keys.size();
-  tcputil::sendBytes<SizeType>(storeSocket_, &nkeys, 1, (nkeys > 0));
-  for (size_t i = 0; i < nkeys; i++) {
-    tcputil::sendString(storeSocket_, keys[i], (i != (nkeys - 1)));
-  }
-  auto waitResponse = tcputil::recvValue<WaitResponseType>(storeSocket_);
+  setRecvTimeout_(timeout);
+  std::vector<uint8_t> query;
+  appendWait(query, keys);
+  sendQuery(storeSocket_, query);
+  recvStopWaiting_();
+}
+
+void TCPStore::recvStopWaiting_() {
+  WaitResponseType waitResponse;
+  try {
+    waitResponse = tcputil::recvValue<WaitResponseType>(storeSocket_);
+  } catch (const std::runtime_error& e) {
+    if (std::string(e.what()) != "Socket Timeout") {
+      throw;
+    }
+    // Cancel the wait, so that the daemon serves the next queries of this
+    // connection. If the keys were set in the meantime, the daemon replies
+    // to the wait instead, and the wait succeeded after all.
+    std::vector<uint8_t> query;
+    appendValue(query, QueryType::CANCEL_WAIT);
+    sendQuery(storeSocket_, query);
+    setRecvTimeout_(kNoTimeout);
+    waitResponse = tcputil::recvValue<WaitResponseType>(storeSocket_);
+    if (waitResponse == WaitResponseType::WAIT_CANCELED) {
+      throw;
+    }
+  }
   if (waitResponse != WaitResponseType::STOP_WAITING) {
     throw std::runtime_error("Stop_waiting response is expected");
   }
 }
 
+std::vector<std::vector<uint8_t>> TCPStore::multiGet(
+    const std::vector<std::string>& keys) {
+  const auto regKeys = regularKeys_(keys);
+  setRecvTimeout_(timeout_);
+  std::vector<uint8_t> getQuery;
+  appendValue(getQuery, QueryType::MULTI_GET);
+  appendKeys(getQuery, regKeys);
+  std::vector<uint8_t> query;
+  appendWait(query, regKeys, getQuery);
+  sendQuery(storeSocket_, query);
+  recvStopWaiting_();
+  std::vector<std::vector<uint8_t>> values;
+  values.reserve(keys.size());
+  for (size_t i = 0; i < keys.size(); i++) {
+    values.push_back(tcputil::recvVector<uint8_t>(storeSocket_));
+  }
+  return values;
+}
+
+void TCPStore::multiSet(
+    const std::vector<std::string>& keys,
+    const std::vector<std::vector<uint8_t>>& values) {
+  if (keys.size() != values.size()) {
+    throw std::invalid_argument(
+        "multiSet: got a different number of keys and values");
+  }
+  std::vector<uint8_t> query;
+  appendValue(query, QueryType::MULTI_SET);
+  appendValue<SizeType>(query, keys.size());
+  for (size_t i = 0; i < keys.size(); i++) {
+    appendString(query, regularPrefix_ + keys[i]);
+    appendVector(query, values[i]);
+  }
+  sendQuery(storeSocket_, query);
+}
+
+std::vector<uint8_t> TCPStore::compareSet(
+    const std::string& key,
+    const std::vector<uint8_t>& expectedValue,
+    const std::vector<uint8_t>& desiredValue) {
+  std::vector<uint8_t> query;
+  appendValue(query, QueryType::COMPARE_SET);
+  appendString(query, regularPrefix_ + key);
+  appendVector(query, expectedValue);
+  appendVector(query, desiredValue);
+  sendQuery(storeSocket_, query);
+  return tcputil::recvVector<uint8_t>(storeSocket_);
+}
+
+void TCPStore::setRecvTimeout_(const std::chrono::milliseconds& timeout) {
+  if (timeout == recvTimeout_) {
+    return;
+  }
+  // A zero timeout (kNoTimeout) blocks forever.
+  struct timeval timeoutTV = {.tv_sec = timeout.count() / 1000,
+                              .tv_usec = (timeout.count() % 1000) * 1000};
+  SYSCHECK_ERR_RETURN_NEG1(::setsockopt(
+      storeSocket_,
+      SOL_SOCKET,
+      SO_RCVTIMEO,
+      reinterpret_cast<char*>(&timeoutTV),
+      sizeof(timeoutTV)));
+  recvTimeout_ = timeout;
+}
+
 } // namespace c10d
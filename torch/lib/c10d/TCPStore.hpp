@@ -1,6 +1,7 @@
 #pragma once
 
 #include <memory>
+#include <mutex>
 #include <thread>
 #include <unordered_map>
 
@@ -9,36 +10,57 @@
 
 namespace c10d {
 
+// Serves a TCPStore. Connections are spread over `numThreads` threads, each
+// running an event loop (epoll on Linux, poll elsewhere) over non-blocking
+// sockets, so that a slow client cannot stall the others. Every loop parses
+// all the queries that a client pipelined in a single read, and sends the
+// replies in a single write.
+//
+// A client waiting for keys is parked on the server until the last key is
+// set, and the queries it sent after the wait are only handled then, so a
+// client can pipeline a wait with the get that follows it. A client whose
+// wait times out cancels it, which drops these queries.
 class TCPStoreDaemon {
  public:
-  explicit TCPStoreDaemon(int storeListenSocket);
+  explicit TCPStoreDaemon(int storeListenSocket, size_t numThreads = 1);
   ~TCPStoreDaemon();
 
   void join();
 
  protected:
-  void run();
-  void stop();
+  struct Connection;
+  class EventLoop;
 
-  void query(int socket);
+  void stop();
 
-  void setHandler(int socket);
-  void addHandler(int socket);
-  void getHandler(int socket) const;
-  void checkHandler(int socket) const;
-  void waitHandler(int socket);
+  // Handles the first query buffered in `data`, and returns the number of
+  // bytes it took, or 0 if the query is not complete yet.
+  size_t query(
+      const std::shared_ptr<Connection>& conn,
+      const uint8_t* data,
+      size_t size);
 
+  // The following are called with storeMutex_ held.
   bool checkKeys(const std::vector<std::string>& keys) const;
-  void wakeupWaitingClients(const std::string& key);
-
-  std::thread daemonThread_;
+  // Sets the key, and appends the connections that no longer wait for any
+  // key to `woken`, which must be woken up once storeMutex_ is released.
+  void setKey(
+      const std::string& key,
+      std::vector<uint8_t> value,
+      std::vector<std::shared_ptr<Connection>>* woken);
+  // Removes a closed connection from the waiting lists.
+  void forgetConnection(Connection& conn);
+
+  std::vector<std::unique_ptr<EventLoop>> loops_;
+  std::vector<std::thread> daemonThreads_;
+
+  // Guards the store and the waiting lists, which are shared by the loops.
+  std::mutex storeMutex_;
   std::unordered_map<std::string, std::vector<uint8_t>> tcpStore_;
-  // From key -> the list of sockets waiting on it
-  std::unordered_map<std::string, std::vector<int>> waitingSockets_;
-  // From socket -> number of keys awaited
-  std::unordered_map<int, size_t> keysAwaited_;
+  // From key -> the connections waiting on it
+  std::unordered_map<std::string, std::vector<std::shared_ptr<Connection>>>
+      waitingConnections_;
 
-  std::vector<int> sockets_;
   int storeListenSocket_;
   std::vector<int> controlPipeFd_{-1, -1};
 };
@@ -49,7 +71,8 @@ class TCPStore : public Store {
       const std::string& masterAddr,
       PortType masterPort,
       int numWorkers,
-      bool isServer = false);
+      bool isServer = false,
+      int numServerThreads = 1);
 
   virtual ~TCPStore();
 
@@ -67,17 +90,36 @@ class TCPStore : public Store {
       const std::vector<std::string>& keys,
       const std::chrono::milliseconds& timeout) override;
 
+  std::vector<std::vector<uint8_t>> multiGet(
+      const std::vector<std::string>& keys) override;
+
+  void multiSet(
+      const std::vector<std::string>& keys,
+      const std::vector<std::vector<uint8_t>>& values) override;
+
+  std::vector<uint8_t> compareSet(
+      const std::string& key,
+      const std::vector<uint8_t>& expectedValue,
+      const std::vector<uint8_t>& desiredValue) override;
+
  protected:
   int64_t addHelper_(const std::string& key, int64_t value);
   std::vector<uint8_t> getHelper_(const std::string& key);
   void waitHelper_(
       const std::vector<std::string>& keys,
       const std::chrono::milliseconds& timeout);
+  // Receives the reply to a wait, and cancels the wait if it times out.
+  void recvStopWaiting_();
   void waitForWorkers_();
+  // Sets the receive timeout of the socket, if it changed.
+  void setRecvTimeout_(const std::chrono::milliseconds& timeout);
+  std::vector<std::string> regularKeys_(const std::vector<std::string>& keys);
 
   bool isServer_;
   int storeSocket_ = -1;
   int masterListenSocket_ = -1;
+  // The current receive timeout of storeSocket_.
+  std::chrono::milliseconds recvTimeout_ = kNoTimeout;
 
   std::string tcpStoreAddr_;
   PortType tcpStorePort_;
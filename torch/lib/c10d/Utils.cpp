@@ -21,7 +21,9 @@ namespace tcputil {
 
 namespace {
 
-constexpr int LISTEN_QUEUE_SIZE = 64;
+// Large enough for all the ranks of a job to connect to the store at once;
+// the kernel caps it to net.core.somaxconn.
+constexpr int LISTEN_QUEUE_SIZE = 2048;
 
 void setSocketNoDelay(int socket) {
   int flag = 1;
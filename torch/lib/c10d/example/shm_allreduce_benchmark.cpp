@@ -0,0 +1,110 @@
+// Compares the allreduce latency of ProcessGroupShm and ProcessGroupGloo for
+// processes on a single host, for a sweep of message sizes.
+//
+// Usage: shm_allreduce_benchmark [processes] [max bytes]
+//
+// Rank 0 prints the average time of an allreduce of float tensors for every
+// size, from 4 bytes to the maximum size, in powers of 4.
+
+#include <c10d/FileStore.hpp>
+#include <c10d/PrefixStore.hpp>
+#include <c10d/ProcessGroupGloo.hpp>
+#include <c10d/ProcessGroupShm.hpp>
+
+#include <gloo/transport/tcp/device.h>
+
+#include <stdlib.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+
+using namespace ::c10d;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// Returns the average time of an allreduce of `bytes` bytes, in microseconds.
+double timeAllreduce(ProcessGroup& pg, size_t bytes) {
+  std::vector<at::Tensor> tensors = {
+      at::ones({static_cast<int64_t>(bytes / sizeof(float))})};
+  // Move about 256 MB through every size, within reason.
+  const auto iterations =
+      std::max<size_t>(10, std::min<size_t>(10000, (256 << 20) / bytes));
+  for (auto i = 0; i < 5; i++) {
+    pg.allreduce(tensors)->wait();
+  }
+  pg.barrier()->wait();
+  const auto start = Clock::now();
+  for (size_t i = 0; i < iterations; i++) {
+    pg.allreduce(tensors)->wait();
+  }
+  const auto elapsed = Clock::now() - start;
+  return std::chrono::duration<double, std::micro>(elapsed).count() /
+      iterations;
+}
+
+void runRank(const std::string& path, int rank, int size, size_t maxBytes) {
+  auto store = std::make_shared<FileStore>(path, size);
+
+  ProcessGroupShm shm(std::make_shared<PrefixStore>("shm", store), rank, size);
+
+  ProcessGroupGloo::Options options;
+  ::gloo::transport::tcp::attr attr;
+  attr.hostname = "127.0.0.1";
+  options.devices.push_back(::gloo::transport::tcp::CreateDevice(attr));
+  ProcessGroupGloo gloo(
+      std::make_shared<PrefixStore>("gloo", store), rank, size, options);
+
+  if (rank == 0) {
+    std::cout << size << " processes" << std::endl;
+    std::cout << std::setw(12) << "bytes" << std::setw(14) << "shm (us)"
+              << std::setw(14) << "gloo (us)" << std::setw(10) << "speedup"
+              << std::endl;
+  }
+  for (size_t bytes = sizeof(float); bytes <= maxBytes; bytes *= 4) {
+    const auto shmTime = timeAllreduce(shm, bytes);
+    const auto glooTime = timeAllreduce(gloo, bytes);
+    if (rank == 0) {
+      std::cout << std::setw(12) << bytes << std::setw(14) << std::fixed
+                << std::setprecision(1) << shmTime << std::setw(14)
+                << glooTime << std::setw(10) << std::setprecision(2)
+                << glooTime / shmTime << std::endl;
+    }
+  }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  const int size = argc > 1 ? atoi(argv[1]) : 4;
+  const size_t maxBytes = argc > 2 ? atoll(argv[2]) : (64 << 20);
+
+  char path[] = "/tmp/shm_allreduce_benchmark_XXXXXX";
+  const int fd = mkstemp(path);
+  if (fd == -1) {
+    perror("mkstemp");
+    return EXIT_FAILURE;
+  }
+  close(fd);
+
+  std::vector<pid_t> children;
+  for (int rank = 1; rank < size; rank++) {
+    pid_t pid = fork();
+    if (pid == 0) {
+      runRank(path, rank, size, maxBytes);
+      _exit(EXIT_SUCCESS);
+    }
+    children.push_back(pid);
+  }
+  runRank(path, 0, size, maxBytes);
+  for (auto pid : children) {
+    waitpid(pid, nullptr, 0);
+  }
+  unlink(path);
+  return EXIT_SUCCESS;
+}
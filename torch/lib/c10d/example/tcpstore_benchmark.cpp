@@ -0,0 +1,158 @@
+// Simulates the rendezvous of many ranks on a TCPStore: every rank connects,
+// publishes its address, reads the addresses of a few peers and enters a
+// barrier. The ranks are threads spread over several processes.
+//
+// Usage: tcpstore_benchmark [ranks] [processes] [server threads] [peers]
+//
+// Prints the time of the slowest rank in every phase, reading the peers one
+// key at a time and then with a single multiGet.
+
+#include <c10d/TCPStore.hpp>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <thread>
+
+using namespace ::c10d;
+
+namespace {
+
+constexpr PortType kPort = 29501;
+
+enum Phase { CONNECT, SET, GET, MULTI_GET, BARRIER, NUM_PHASES };
+
+const char* kPhaseNames[] = {"connect", "set", "get", "multiGet", "barrier"};
+
+using Clock = std::chrono::steady_clock;
+
+double secondsSince(Clock::time_point start) {
+  return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+void barrier(Store& store, const std::string& name, int numRanks) {
+  if (store.add(name, 1) == numRanks) {
+    store.set(name + "_done", {1});
+  }
+  store.wait({name + "_done"});
+}
+
+// Runs one rank, and returns the time it spent in every phase.
+std::vector<double> runRank(int rank, int numRanks, int numPeers) {
+  std::vector<double> times(NUM_PHASES);
+  auto start = Clock::now();
+  TCPStore store("127.0.0.1", kPort, 1);
+  times[CONNECT] = secondsSince(start);
+
+  start = Clock::now();
+  store.set("addr/" + std::to_string(rank), std::vector<uint8_t>(64, rank));
+  times[SET] = secondsSince(start);
+  // The reads below do not wait for the peers.
+  barrier(store, "published", numRanks);
+
+  std::vector<std::string> peers;
+  for (int i = 1; i <= numPeers; i++) {
+    peers.push_back("addr/" + std::to_string((rank + i) % numRanks));
+  }
+  start = Clock::now();
+  for (const auto& peer : peers) {
+    store.get(peer);
+  }
+  times[GET] = secondsSince(start);
+
+  start = Clock::now();
+  store.multiGet(peers);
+  times[MULTI_GET] = secondsSince(start);
+
+  start = Clock::now();
+  barrier(store, "barrier", numRanks);
+  times[BARRIER] = secondsSince(start);
+  return times;
+}
+
+// Runs the ranks [begin, end), and publishes the slowest time of every phase
+// under "times/<process>".
+void runProcess(int process, int begin, int end, int numRanks, int numPeers) {
+  std::vector<std::vector<double>> times(end - begin);
+  std::vector<std::thread> threads;
+  for (int rank = begin; rank < end; rank++) {
+    threads.emplace_back([&, rank]() {
+      times[rank - begin] = runRank(rank, numRanks, numPeers);
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  std::ostringstream ss;
+  for (int phase = 0; phase < NUM_PHASES; phase++) {
+    double slowest = 0;
+    for (const auto& rankTimes : times) {
+      slowest = std::max(slowest, rankTimes[phase]);
+    }
+    ss << slowest << " ";
+  }
+  const auto str = ss.str();
+  TCPStore store("127.0.0.1", kPort, 1);
+  store.set(
+      "times/" + std::to_string(process),
+      std::vector<uint8_t>(str.begin(), str.end()));
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  const int numRanks = argc > 1 ? atoi(argv[1]) : 1024;
+  const int numProcesses = argc > 2 ? atoi(argv[2]) : 16;
+  const int numServerThreads = argc > 3 ? atoi(argv[3]) : 1;
+  const int numPeers = std::min(argc > 4 ? atoi(argv[4]) : 16, numRanks - 1);
+
+  // Fork before starting the server threads; the clients retry until the
+  // server listens.
+  std::vector<pid_t> children;
+  for (int process = 0; process < numProcesses; process++) {
+    pid_t pid = fork();
+    if (pid == 0) {
+      runProcess(
+          process,
+          process * numRanks / numProcesses,
+          (process + 1) * numRanks / numProcesses,
+          numRanks,
+          numPeers);
+      _exit(EXIT_SUCCESS);
+    }
+    children.push_back(pid);
+  }
+
+  TCPStore server("127.0.0.1", kPort, 1, true, numServerThreads);
+  std::vector<std::string> keys;
+  for (int process = 0; process < numProcesses; process++) {
+    keys.push_back("times/" + std::to_string(process));
+  }
+  std::vector<double> slowest(NUM_PHASES);
+  for (const auto& value : server.multiGet(keys)) {
+    std::istringstream ss(std::string(value.begin(), value.end()));
+    for (int phase = 0; phase < NUM_PHASES; phase++) {
+      double time;
+      ss >> time;
+      slowest[phase] = std::max(slowest[phase], time);
+    }
+  }
+  for (auto pid : children) {
+    waitpid(pid, nullptr, 0);
+  }
+
+  std::cout << numRanks << " ranks in " << numProcesses << " processes, "
+            << numServerThreads << " server threads, " << numPeers
+            << " peers per rank" << std::endl;
+  for (int phase = 0; phase < NUM_PHASES; phase++) {
+    std::cout << "  " << kPhaseNames[phase] << ": " << slowest[phase] * 1000
+              << " ms" << std::endl;
+  }
+  return EXIT_SUCCESS;
+}
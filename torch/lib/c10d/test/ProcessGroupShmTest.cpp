@@ -0,0 +1,276 @@
+#include <unistd.h>
+
+#include <iostream>
+#include <thread>
+
+#include <c10d/FileStore.hpp>
+#include <c10d/ProcessGroupShm.hpp>
+#include <c10d/test/TestUtils.hpp>
+
+using namespace c10d::test;
+
+// A slot of 1 KB holds 128 floats per chunk, so the larger tensors below
+// take several chunks.
+constexpr size_t kBufferSize = 1024;
+
+std::unique_ptr<::c10d::ProcessGroupShm> createProcessGroup(
+    const std::string& path,
+    int rank,
+    int size) {
+  auto store = std::make_shared<::c10d::FileStore>(path, size);
+  ::c10d::ProcessGroupShm::Options options;
+  options.bufferSize = kBufferSize;
+  options.timeout = std::chrono::milliseconds(1000);
+  return std::unique_ptr<::c10d::ProcessGroupShm>(
+      new ::c10d::ProcessGroupShm(store, rank, size, options));
+}
+
+std::vector<std::unique_ptr<::c10d::ProcessGroupShm>> initialize(
+    const std::string& path,
+    int size) {
+  std::vector<std::unique_ptr<::c10d::ProcessGroupShm>> pgs(size);
+  std::vector<std::thread> threads;
+  for (auto i = 0; i < size; i++) {
+    threads.push_back(std::thread(
+        [i, size, &path, &pgs] { pgs[i] = createProcessGroup(path, i, size); }));
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  return pgs;
+}
+
+void waitAll(std::vector<std::shared_ptr<::c10d::ProcessGroup::Work>>& work) {
+  for (auto& w : work) {
+    w->wait();
+  }
+}
+
+void check(const at::Tensor& tensor, const at::Tensor& expected) {
+  if (!tensor.equal(expected)) {
+    throw std::runtime_error("BOOM!");
+  }
+}
+
+void testAllreduce(const std::string& path) {
+  const auto size = 4;
+  auto pgs = initialize(path, size);
+
+  // Tensors smaller than a cache line per rank, and spanning chunks.
+  for (auto numel : {1, 15, 128, 1000}) {
+    for (auto op : {::c10d::ReduceOp::SUM, ::c10d::ReduceOp::MAX}) {
+      std::vector<std::vector<at::Tensor>> inputs(size);
+      for (auto i = 0; i < size; i++) {
+        inputs[i] = {at::arange(numel, at::kFloat) + i};
+      }
+
+      ::c10d::AllreduceOptions options;
+      options.reduceOp = op;
+      std::vector<std::shared_ptr<::c10d::ProcessGroup::Work>> work(size);
+      for (auto i = 0; i < size; i++) {
+        work[i] = pgs[i]->allreduce(inputs[i], options);
+      }
+      waitAll(work);
+
+      auto expected = op == ::c10d::ReduceOp::SUM
+          ? at::arange(numel, at::kFloat) * size + (size * (size - 1)) / 2
+          : at::arange(numel, at::kFloat) + (size - 1);
+      for (auto i = 0; i < size; i++) {
+        check(inputs[i][0], expected);
+      }
+    }
+  }
+}
+
+void testReduce(const std::string& path) {
+  const auto size = 3;
+  auto pgs = initialize(path, size);
+
+  for (auto root = 0; root < size; root++) {
+    std::vector<std::vector<at::Tensor>> inputs(size);
+    for (auto i = 0; i < size; i++) {
+      inputs[i] = {at::ones({300}, at::kLong) * (i + 1)};
+    }
+
+    ::c10d::ReduceOptions options;
+    options.reduceOp = ::c10d::ReduceOp::PRODUCT;
+    options.rootRank = root;
+    std::vector<std::shared_ptr<::c10d::ProcessGroup::Work>> work(size);
+    for (auto i = 0; i < size; i++) {
+      work[i] = pgs[i]->reduce(inputs[i], options);
+    }
+    waitAll(work);
+
+    check(inputs[root][0], at::ones({300}, at::kLong) * 6);
+  }
+}
+
+void testBroadcast(const std::string& path) {
+  const auto size = 3;
+  auto pgs = initialize(path, size);
+
+  for (auto root = 0; root < size; root++) {
+    std::vector<std::vector<at::Tensor>> inputs(size);
+    for (auto i = 0; i < size; i++) {
+      inputs[i] = {at::ones({17, 31}, at::kDouble) * i};
+    }
+
+    ::c10d::BroadcastOptions options;
+    options.rootRank = root;
+    std::vector<std::shared_ptr<::c10d::ProcessGroup::Work>> work(size);
+    for (auto i = 0; i < size; i++) {
+      work[i] = pgs[i]->broadcast(inputs[i], options);
+    }
+    waitAll(work);
+
+    for (auto i = 0; i < size; i++) {
+      check(inputs[i][0], at::ones({17, 31}, at::kDouble) * root);
+    }
+  }
+}
+
+void testAllgather(const std::string& path) {
+  const auto size = 4;
+  auto pgs = initialize(path, size);
+
+  std::vector<std::vector<at::Tensor>> inputs(size);
+  std::vector<std::vector<std::vector<at::Tensor>>> outputs(size);
+  for (auto i = 0; i < size; i++) {
+    inputs[i] = {at::ones({500}, at::kInt) * i};
+    outputs[i].resize(1);
+    for (auto j = 0; j < size; j++) {
+      outputs[i][0].push_back(at::zeros({500}, at::kInt));
+    }
+  }
+
+  std::vector<std::shared_ptr<::c10d::ProcessGroup::Work>> work(size);
+  for (auto i = 0; i < size; i++) {
+    work[i] = pgs[i]->allgather(outputs[i], inputs[i]);
+  }
+  waitAll(work);
+
+  for (auto i = 0; i < size; i++) {
+    for (auto j = 0; j < size; j++) {
+      check(outputs[i][0][j], at::ones({500}, at::kInt) * j);
+    }
+  }
+}
+
+void testReduceScatter(const std::string& path) {
+  const auto size = 4;
+  auto pgs = initialize(path, size);
+
+  std::vector<std::vector<std::vector<at::Tensor>>> inputs(size);
+  std::vector<std::vector<at::Tensor>> outputs(size);
+  for (auto i = 0; i < size; i++) {
+    inputs[i].resize(1);
+    for (auto j = 0; j < size; j++) {
+      inputs[i][0].push_back(at::arange(200, at::kFloat) * (i + 1) + j);
+    }
+    outputs[i] = {at::zeros({200}, at::kFloat)};
+  }
+
+  std::vector<std::shared_ptr<::c10d::ProcessGroup::Work>> work(size);
+  for (auto i = 0; i < size; i++) {
+    work[i] = pgs[i]->reduce_scatter(outputs[i], inputs[i]);
+  }
+  waitAll(work);
+
+  // sum over i of (arange * (i + 1) + rank)
+  for (auto i = 0; i < size; i++) {
+    check(
+        outputs[i][0],
+        at::arange(200, at::kFloat) * (size * (size + 1) / 2) + i * size);
+  }
+}
+
+void testBarrier(const std::string& path) {
+  const auto size = 2;
+  auto pgs = initialize(path, size);
+
+  std::vector<std::shared_ptr<::c10d::ProcessGroup::Work>> work(size);
+  for (auto i = 0; i < size; i++) {
+    work[i] = pgs[i]->barrier();
+  }
+  waitAll(work);
+}
+
+// The ranks are usually separate processes.
+void testMultiProcess(const std::string& path) {
+  const auto size = 2;
+  Fork fork;
+  const auto rank = fork.isChild() ? 1 : 0;
+  auto pg = createProcessGroup(path, rank, size);
+
+  std::vector<at::Tensor> tensors = {at::ones({1000}) * rank};
+  for (auto i = 0; i < 10; i++) {
+    pg->allreduce(tensors)->wait();
+  }
+  // Every iteration doubles the sum (0 + 1).
+  check(tensors[0], at::ones({1000}) * 512);
+
+  if (fork.isChild()) {
+    exit(0);
+  }
+}
+
+void testTimeout(const std::string& path) {
+  const auto size = 2;
+  auto pgs = initialize(path, size);
+
+  // Rank 1 never joins
+  std::vector<at::Tensor> tensors = {at::ones({16})};
+  auto work = pgs[0]->allreduce(tensors);
+  try {
+    work->wait();
+  } catch (const std::exception& ex) {
+    std::cout << "Timeout test got: " << ex.what() << std::endl;
+    return;
+  }
+  throw std::runtime_error("Expected a timeout");
+}
+
+int main(int argc, char** argv) {
+  {
+    TemporaryFile file;
+    testAllreduce(file.path);
+  }
+
+  {
+    TemporaryFile file;
+    testReduce(file.path);
+  }
+
+  {
+    TemporaryFile file;
+    testBroadcast(file.path);
+  }
+
+  {
+    TemporaryFile file;
+    testAllgather(file.path);
+  }
+
+  {
+    TemporaryFile file;
+    testReduceScatter(file.path);
+  }
+
+  {
+    TemporaryFile file;
+    testBarrier(file.path);
+  }
+
+  {
+    TemporaryFile file;
+    testMultiProcess(file.path);
+  }
+
+  {
+    TemporaryFile file;
+    testTimeout(file.path);
+  }
+
+  std::cout << "Test successful" << std::endl;
+  return 0;
+}
@@ -1,5 +1,6 @@
 #include <c10d/test/StoreTestCommon.hpp>
 
+#include <atomic>
 #include <cstdlib>
 #include <iostream>
 #include <thread>
@@ -7,11 +8,16 @@
 #include <c10d/PrefixStore.hpp>
 #include <c10d/TCPStore.hpp>
 
-void testHelper(const std::string& prefix = "") {
+std::vector<uint8_t> toVec(const std::string& str) {
+  return std::vector<uint8_t>(str.begin(), str.end());
+}
+
+void testHelper(const std::string& prefix = "", int numServerThreads = 1) {
   const auto numThreads = 16;
   const auto numWorkers = numThreads + 1;
   // server store
-  c10d::TCPStore serverTCPStore("127.0.0.1", 29500, numWorkers, true);
+  c10d::TCPStore serverTCPStore(
+      "127.0.0.1", 29500, numWorkers, true, numServerThreads);
   c10d::PrefixStore serverStore(prefix, serverTCPStore);
 
   // Basic set/get on the server store
@@ -32,7 +38,8 @@ void testHelper(const std::string& prefix = "") {
   std::vector<std::unique_ptr<c10d::PrefixStore>> clientStores;
   for (auto i = 0; i < numThreads; i++) {
     clientTCPStores.push_back(std::unique_ptr<c10d::TCPStore>(
-        new c10d::TCPStore("127.0.0.1", 29500, numWorkers, false)));
+        new c10d::TCPStore(
+            "127.0.0.1", 29500, numWorkers, false, numServerThreads)));
     clientStores.push_back(std::unique_ptr<c10d::PrefixStore>(
         new c10d::PrefixStore(prefix, *clientTCPStores[i])));
   }
@@ -75,6 +82,54 @@ void testHelper(const std::string& prefix = "") {
   for (auto& thread : threads) {
     thread.join();
   }
+  threads.clear();
+
+  // Every thread waits for the keys of all the others, which are set in one
+  // batch each.
+  for (auto i = 0; i < numThreads; i++) {
+    threads.push_back(std::thread([&clientStores, i] {
+      const std::string key = "batch_" + std::to_string(i);
+      clientStores[i]->multiSet({key + "_a", key + "_b"}, {toVec("a"), toVec("b")});
+      std::vector<std::string> keys;
+      for (auto j = 0; j < numThreads; j++) {
+        keys.push_back("batch_" + std::to_string(j) + "_a");
+        keys.push_back("batch_" + std::to_string(j) + "_b");
+      }
+      auto values = clientStores[i]->multiGet(keys);
+      for (size_t j = 0; j < values.size(); j++) {
+        if (values[j] != toVec(j % 2 == 0 ? "a" : "b")) {
+          throw std::runtime_error("Unexpected value for " + keys[j]);
+        }
+      }
+    }));
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  threads.clear();
+
+  // Only one thread swaps the value in.
+  std::atomic<int> numSwapped(0);
+  for (auto i = 0; i < numThreads; i++) {
+    threads.push_back(std::thread([&clientStores, &numSwapped, i] {
+      const auto desired = toVec("owner_" + std::to_string(i));
+      if (clientStores[i]->compareSet("owner", {}, desired) == desired) {
+        ++numSwapped;
+      }
+    }));
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  if (numSwapped != 1) {
+    throw std::runtime_error("Expected compareSet to succeed once");
+  }
+  const auto owner = serverStore.get("owner");
+  if (serverStore.compareSet("owner", toVec("other"), toVec("x")) != owner ||
+      serverStore.compareSet("owner", owner, toVec("x")) != toVec("x") ||
+      !serverStore.compareSet("missing", toVec("y"), toVec("x")).empty()) {
+    throw std::runtime_error("Unexpected compareSet result");
+  }
 
   // Clear the store to test that client disconnect won't shutdown the store
   clientStores.clear();
@@ -90,9 +145,75 @@ void testHelper(const std::string& prefix = "") {
     c10d::test::check(serverStore, key, val);
   }
 }
+// A wait that times out does not hold up the next queries of the client.
+void testWaitTimeout(int numServerThreads) {
+  c10d::TCPStore store("127.0.0.1", 29500, 1, true, numServerThreads);
+  const auto timeout = std::chrono::milliseconds(100);
+
+  bool timedOut = false;
+  try {
+    store.wait({"missing"}, timeout);
+  } catch (const std::runtime_error&) {
+    timedOut = true;
+  }
+  if (!timedOut) {
+    throw std::runtime_error("Expected wait to time out");
+  }
+  c10d::test::set(store, "key", "value");
+  c10d::test::check(store, "key", "value");
+
+  // The get sent along with the wait is dropped too.
+  store.setTimeout(timeout);
+  timedOut = false;
+  try {
+    store.get("late");
+  } catch (const std::runtime_error&) {
+    timedOut = true;
+  }
+  if (!timedOut) {
+    throw std::runtime_error("Expected get to time out");
+  }
+  store.setTimeout(c10d::Store::kDefaultTimeout);
+  c10d::test::set(store, "late", "value");
+  c10d::test::check(store, "late", "value");
+  if (store.add("counter", 2) != 2 || !store.check({"key", "late"})) {
+    throw std::runtime_error("Unexpected reply after a wait timed out");
+  }
+}
+
+// The last queries of a client that closes its connection right after
+// sending them are handled, also when they end on a boundary of the reads of
+// the daemon.
+void testSetBeforeClose(int numServerThreads) {
+  c10d::TCPStore serverStore("127.0.0.1", 29500, 1, true, numServerThreads);
+  // A get of a key that was dropped fails instead of blocking.
+  serverStore.setTimeout(std::chrono::seconds(10));
+  for (size_t readSizes = 1; readSizes <= 4; ++readSizes) {
+    for (size_t extra = 0; extra < 3; ++extra) {
+      const auto key = "key" + std::to_string(readSizes) + std::to_string(extra);
+      // Query type, key and value sizes, and the key with its "/" prefix.
+      const size_t headerSize = 1 + 2 * sizeof(uint64_t) + key.size() + 1;
+      const std::vector<uint8_t> value(
+          readSizes * 64 * 1024 - headerSize + extra - 1, readSizes + extra);
+      {
+        c10d::TCPStore clientStore(
+            "127.0.0.1", 29500, 1, false, numServerThreads);
+        clientStore.set(key, value);
+      }
+      if (serverStore.get(key) != value) {
+        throw std::runtime_error("Set before close was not handled");
+      }
+    }
+  }
+}
+
 int main(int argc, char** argv) {
   testHelper();
-  testHelper("testPrefix");
+  testHelper("testPrefix", 4);
+  testWaitTimeout(1);
+  testWaitTimeout(4);
+  testSetBeforeClose(1);
+  testSetBeforeClose(4);
   std::cout << "Test succeeded" << std::endl;
   return EXIT_SUCCESS;
 }
@@ -320,6 +320,27 @@ class DistributedDataParallel(Module):
             list(filter(lambda p: p.requires_grad, module.parameters()))
             for module in self._module_copies]
 
+        # Embedding layers created with `sparse=True` produce sparse gradients.
+        # These are reduced as sparse tensors, without being flattened into a
+        # bucket with other gradients, so the bytes exchanged scale with the
+        # number of looked up rows instead of the size of the table.
+        def produces_sparse_gradient(module):
+            if isinstance(module, (torch.nn.Embedding, torch.nn.EmbeddingBag)):
+                return module.sparse
+            return False
+
+        def sparse_parameters(module):
+            return set(
+                parameter
+                for submodule in module.modules()
+                if produces_sparse_gradient(submodule)
+                for parameter in submodule.parameters(recurse=False))
+
+        expect_sparse_gradient = []
+        for module, params in zip(self._module_copies, param_list):
+            sparse = sparse_parameters(module)
+            expect_sparse_gradient.append([p in sparse for p in params])
+
         # The bucket size limit is specified in the constructor.
         # Additionally, we allow for a single small bucket for parameters
         # that are defined first, such that their gradients don't spill into
@@ -327,7 +348,8 @@ class DistributedDataParallel(Module):
         # computation finishes. Experiments showed 1MB is a reasonable value.
         bucket_indices = dist._compute_bucket_assignment_by_size(
             param_list[0],
-            [1024 * 1024, self.bucket_bytes_cap])
+            [1024 * 1024, self.bucket_bytes_cap],
+            expect_sparse_gradient[0])
 
         # Note: reverse list of buckets because we want to approximate the
         # order in which their gradients are produced, and assume they
@@ -335,7 +357,8 @@ class DistributedDataParallel(Module):
         self.reducer = dist.Reducer(
             param_list,
             list(reversed(bucket_indices)),
-            self.process_group)
+            self.process_group,
+            expect_sparse_gradient)
 
         # passing a handle to torch.nn.SyncBatchNorm layer
         self._passing_sync_batchnorm_handle(self._module_copies)
@@ -1,4 +1,5 @@
 from __future__ import absolute_import, division, print_function, unicode_literals
+import time
 import torch
 import warnings
 
@@ -72,6 +73,7 @@ class CheckpointFunction(torch.autograd.Function):
         ctx.save_for_backward(*args)
         with torch.no_grad():
             outputs = run_function(*args)
+        torch.autograd._record_checkpointed_region()
         return outputs
 
     @staticmethod
@@ -79,6 +81,7 @@ class CheckpointFunction(torch.autograd.Function):
         if not torch.autograd._is_checkpoint_valid():
             raise RuntimeError("Checkpointing is not compatible with .grad(), please use .backward() if possible")
         inputs = ctx.saved_tensors
+        start = time.time()
         # Stash the surrounding rng state, and mimic the state that was
         # present at this time during forward.  Restore the surrouding state
         # when we're done.
@@ -99,6 +102,7 @@ class CheckpointFunction(torch.autograd.Function):
         torch.autograd.backward(outputs, args)
         grads = tuple(inp.grad if isinstance(inp, torch.Tensor) else inp
                       for inp in detached_inputs)
+        torch.autograd._record_recomputed_region(int((time.time() - start) * 1e9))
         return (None, None) + grads
 
 
@@ -155,6 +159,76 @@ def checkpoint(function, *args, **kwargs):
     return CheckpointFunction.apply(function, preserve, *args)
 
 
+def checkpoint_stats():
+    r"""Returns the number of regions checkpointed and recomputed so far, and
+    the time spent recomputing them.
+
+    Together with the memory estimate of :func:`plan_checkpoint_segments`, this
+    tells how much activation memory checkpointing saved and what it cost in
+    compute. Both the Python and the C++ implementations of checkpointing
+    update these counters.
+
+    Returns:
+        A dict with the keys ``checkpointed_regions``, ``recomputed_regions``
+        and ``recompute_time`` (in seconds).
+    """
+    checkpointed, recomputed, recompute_ns = torch.autograd._checkpoint_stats()
+    return {
+        'checkpointed_regions': checkpointed,
+        'recomputed_regions': recomputed,
+        'recompute_time': recompute_ns / 1e9,
+    }
+
+
+def reset_checkpoint_stats():
+    r"""Resets the counters returned by :func:`checkpoint_stats`."""
+    torch.autograd._reset_checkpoint_stats()
+
+
+def _activation_bytes(functions, inputs):
+    activation_bytes = []
+    with torch.no_grad():
+        for function in functions:
+            if isinstance(inputs, tuple):
+                inputs = function(*inputs)
+            else:
+                inputs = function(inputs)
+            outputs = inputs if isinstance(inputs, tuple) else (inputs,)
+            activation_bytes.append(sum(out.numel() * out.element_size()
+                                        for out in outputs
+                                        if isinstance(out, torch.Tensor)))
+    return activation_bytes
+
+
+def plan_checkpoint_segments(functions, memory_budget, *inputs):
+    r"""Picks checkpoint boundaries for a sequential model such that its
+    activations fit into :attr:`memory_budget` bytes.
+
+    The size of the output of every module is measured by running
+    :attr:`functions` once on :attr:`*inputs` without recording gradients.
+    Segments are chosen so that the outputs of all segment boundaries plus the
+    activations of the largest segment stay within the budget, using as few
+    segments as possible. If no split fits, the one with the smallest peak is
+    returned.
+
+    Args:
+        functions: A :class:`torch.nn.Sequential` or the list of modules or
+            functions (comprising the model) to run sequentially.
+        memory_budget (int): activation memory budget in bytes
+        inputs: tuple of Tensors that are inputs to :attr:`functions`
+
+    Returns:
+        A tuple ``(segment_ends, baseline_bytes, peak_bytes, fits_budget)``,
+        where ``segment_ends`` holds the (exclusive) end index of every segment
+        and ``baseline_bytes`` and ``peak_bytes`` are the estimated activation
+        memory without and with checkpointing.
+    """
+    if isinstance(functions, torch.nn.Sequential):
+        functions = list(functions.children())
+    return torch.autograd._plan_checkpoints(_activation_bytes(functions, inputs),
+                                            int(memory_budget))
+
+
 def checkpoint_sequential(functions, segments, *inputs, **kwargs):
     r"""A helper function for checkpointing sequential models.
 
@@ -179,10 +253,15 @@ def checkpoint_sequential(functions, segments, *inputs, **kwargs):
     Args:
         functions: A :class:`torch.nn.Sequential` or the list of modules or
             functions (comprising the model) to run sequentially.
-        segments: Number of chunks to create in the model
+        segments: Number of chunks to create in the model. Can be ``None`` if
+            :attr:`memory_budget` is given.
         inputs: tuple of Tensors that are inputs to :attr:`functions`
         preserve_rng_state(bool, optional, default=True):  Omit stashing and restoring
             the RNG state during each checkpoint.
+        memory_budget(int, optional): If given, the segments are picked by
+            :func:`plan_checkpoint_segments` to keep the activations within
+            this many bytes instead of splitting the model into
+            :attr:`segments` equal chunks.
 
     Returns:
         Output of running :attr:`functions` sequentially on :attr:`*inputs`
@@ -190,15 +269,18 @@ def checkpoint_sequential(functions, segments, *inputs, **kwargs):
     Example:
         >>> model = nn.Sequential(...)
         >>> input_var = checkpoint_sequential(model, chunks, input_var)
+        >>> input_var = checkpoint_sequential(model, None, input_var,
+        ...                                   memory_budget=1 << 30)
     """
     # Hack to mix *args with **kwargs in a python 2.7-compliant way
     preserve = kwargs.pop('preserve_rng_state', True)
+    memory_budget = kwargs.pop('memory_budget', None)
     if kwargs:
         raise ValueError("Unexpected keyword arguments: " + ",".join(arg for arg in kwargs))
 
     def run_function(start, end, functions):
         def forward(*inputs):
-            for j in range(start, end + 1):
+            for j in range(start, end):
                 if isinstance(inputs, tuple):
                     inputs = functions[j](*inputs)
                 else:
@@ -209,13 +291,19 @@ def checkpoint_sequential(functions, segments, *inputs, **kwargs):
     if isinstance(functions, torch.nn.Sequential):
         functions = list(functions.children())
 
-    segment_size = len(functions) // segments
+    if memory_budget is not None:
+        segment_ends = plan_checkpoint_segments(functions, memory_budget, *inputs)[0]
+    else:
+        segment_size = len(functions) // segments
+        segment_ends = list(range(segment_size, segment_size * segments, segment_size))
+        segment_ends.append(len(functions))
+
     # the last chunk has to be non-volatile
-    end = -1
-    for start in range(0, segment_size * (segments - 1), segment_size):
-        end = start + segment_size - 1
+    start = 0
+    for end in segment_ends[:-1]:
         inputs = checkpoint(run_function(start, end, functions), *inputs,
                             preserve_rng_state=preserve)
         if not isinstance(inputs, tuple):
             inputs = (inputs,)
-    return run_function(end + 1, len(functions) - 1, functions)(*inputs)
+        start = end
+    return run_function(start, len(functions), functions)(*inputs)